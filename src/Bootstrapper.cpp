@@ -3,17 +3,39 @@
 #include <array>
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <variant>
+#include <vector>
 
 #include "domain/HeaderFile.hpp"
 #include "domain/constants.hpp"
 #include "domain/entities/tienda/tienda.entity.hpp"
 #include "infrastructure/datasource/EntityTraits.hpp"
+#include "infrastructure/datasource/FSFormatMigrator.hpp"
+#include "infrastructure/datasource/transaccion/ParticionesTransacciones.hpp"
+#include "presentation/Batch/BatchRunner.hpp"
+#include "presentation/Servidor/ClienteLocal.hpp"
+#include "presentation/Servidor/ServidorLocal.hpp"
 
 using namespace Constants::PATHS;
 
+namespace {
+
+/// Consume `--socket ruta` al inicio de `args` (desde `inicio`); retorna la ruta a usar.
+fs::path extraerRutaSocket(const std::vector<std::string>& args, std::size_t& inicio)
+{
+    if (inicio + 1 < args.size() && args[inicio] == "--socket") {
+        inicio += 2;
+        return args[inicio - 1];
+    }
+    return SOCKET_PATH;
+}
+
+}  // namespace
+
 Bootstrapper::Bootstrapper()
-    : admin(productos, clientes, proveedores, transacciones),
-      repositories{productos, clientes, proveedores, transacciones, admin},
+    : admin(productos, clientes, proveedores, transacciones, rollups),
+      repositories{productos, clientes, proveedores, transacciones, rollups, admin},
       mainMenu(repositories)
 {
 }
@@ -43,7 +65,7 @@ bool Bootstrapper::ensureFileWithHeader(const fs::path& path)
         return false;
     }
 
-    const HeaderFile header{0, 1, 0, 1};
+    const HeaderFile header{0, 1, 0, Constants::BINARY_FORMAT::VERSION_ACTUAL};
     file.write(reinterpret_cast<const char*>(&header), sizeof(HeaderFile));
     // si la escritura es correcta, la variable file es true
     return static_cast<bool>(file);
@@ -51,8 +73,15 @@ bool Bootstrapper::ensureFileWithHeader(const fs::path& path)
 
 bool Bootstrapper::bootstrapStorage()
 {
-    const std::array<fs::path, 5> paths = {
-        PRODUCTOS_PATH, PROVEEDORES_PATH, CLIENTES_PATH, TRANSACCIONES_PATH, TIENDA_PATH,
+    const std::array<fs::path, 8> paths = {
+        PRODUCTOS_PATH,
+        PROVEEDORES_PATH,
+        CLIENTES_PATH,
+        TIENDA_PATH,
+        ROLLUP_DIARIO_PATH,
+        ROLLUP_MENSUAL_PATH,
+        ROLLUP_PRODUCTOS_DIARIO_PATH,
+        ROLLUP_PRODUCTOS_MENSUAL_PATH,
     };
 
     bool ok = true;
@@ -60,13 +89,98 @@ bool Bootstrapper::bootstrapStorage()
         ok = this->ensureFileWithHeader(path) && ok;
     }
 
+    for (const fs::path& lockPath :
+         {ROLLUP_LOCK_PATH, COMMITS_LOCK_PATH, TRANSACCIONES_LOCK_PATH}) {
+        if (!fs::exists(lockPath)) {
+            ok = std::ofstream(lockPath).is_open() && ok;
+        }
+    }
+
+    if (ok) {
+        ok = this->completePendingRestore() && ok;
+    }
+
+    if (ok) {
+        ok = this->migrateStorageFormat() && ok;
+    }
+
+    if (ok) {
+        ok = this->partitionTransactions() && ok;
+    }
+
     if (ok) {
         ok = this->ensureTiendaRecord() && ok;
     }
 
+    if (ok) {
+        ok = this->ensureRollups() && ok;
+    }
+
+    return ok;
+}
+
+/// Termina una restauracion de backup que se interrumpio despues de validar sus datos.
+bool Bootstrapper::completePendingRestore()
+{
+    try {
+        if (admin.completarRestauracionPendiente()) {
+            std::cout << "Se completo una restauracion de backup interrumpida\n";
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error completando restauracion de backup: " << e.what() << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+bool Bootstrapper::migrateStorageFormat()
+{
+    std::vector<std::variant<bool, std::string>> results = {
+        FSFormatMigrator<Producto>(PRODUCTOS_PATH).migrarAVersionActual(),
+        FSFormatMigrator<Proveedor>(PROVEEDORES_PATH).migrarAVersionActual(),
+        FSFormatMigrator<Cliente>(CLIENTES_PATH).migrarAVersionActual(),
+        FSFormatMigrator<Tienda>(TIENDA_PATH).migrarAVersionActual(),
+    };
+    // las particiones se crean en la version actual; solo el archivo unico puede ser anterior
+    if (fs::exists(TRANSACCIONES_PATH)) {
+        results.push_back(FSFormatMigrator<Transaccion>(TRANSACCIONES_PATH).migrarAVersionActual());
+    }
+
+    bool ok = true;
+    for (const auto& result : results) {
+        if (std::holds_alternative<std::string>(result)) {
+            std::cout << "Error migrando formato binario: " << std::get<std::string>(result)
+                      << "\n";
+            ok = false;
+        }
+    }
+
     return ok;
 }
 
+/// Reparte el archivo unico de transacciones en particiones mensuales (datos previos a ellas).
+bool Bootstrapper::partitionTransactions()
+{
+    std::string error;
+    if (fs::exists(TRANSACCIONES_PATH)) {
+        if (!ManifiestoParticiones::particionar(TRANSACCIONES_PATH, TRANSACCIONES_PARTICIONES_PATH,
+                                                error)) {
+            std::cout << "Error particionando transacciones: " << error << "\n";
+            return false;
+        }
+        std::cout << "Transacciones repartidas en particiones mensuales\n";
+        return true;
+    }
+
+    if (!fs::exists(TRANSACCIONES_PARTICIONES_PATH) &&
+        !ManifiestoParticiones::escribir(TRANSACCIONES_PARTICIONES_PATH, {}, error)) {
+        std::cout << "Error creando la lista de particiones: " << error << "\n";
+        return false;
+    }
+    return true;
+}
+
 bool Bootstrapper::ensureTiendaRecord()
 {
     std::fstream file(TIENDA_PATH, std::ios::binary | std::ios::in | std::ios::out);
@@ -103,6 +217,42 @@ bool Bootstrapper::ensureTiendaRecord()
     return static_cast<bool>(file);
 }
 
+/// Genera los rollups desde el historial cuando aun no existen (datos previos a los rollups) o
+/// no coinciden con el: una actualizacion fallo o se perdio porque el proceso termino entre la
+/// transaccion y sus rollups.
+bool Bootstrapper::ensureRollups()
+{
+    auto rollupHeaderResult = rollups.obtenerEstadisticas();
+    auto transHeaderResult = transacciones.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(rollupHeaderResult) ||
+        std::holds_alternative<std::string>(transHeaderResult)) {
+        return false;
+    }
+
+    const HeaderFile transHeader = std::get<HeaderFile>(transHeaderResult);
+    auto requiereResult = rollups.requiereReconstruir(transHeader.registrosActivos);
+    if (std::holds_alternative<std::string>(requiereResult)) {
+        std::cout << "Error verificando rollups de ventas: "
+                  << std::get<std::string>(requiereResult) << "\n";
+        return false;
+    }
+    if (!std::get<bool>(requiereResult)) {
+        return true;
+    }
+
+    if (std::get<HeaderFile>(rollupHeaderResult).cantidadRegistros > 0) {
+        std::cout << "Rollups de ventas desactualizados: se reconstruyen desde el historial\n";
+    }
+    auto result = rollups.reconstruir(transacciones);
+    if (std::holds_alternative<std::string>(result)) {
+        std::cout << "Error generando rollups de ventas: " << std::get<std::string>(result)
+                  << "\n";
+        return false;
+    }
+
+    return true;
+}
+
 void Bootstrapper::runMainLoop()
 {
     if (!this->bootstrapStorage()) {
@@ -112,3 +262,120 @@ void Bootstrapper::runMainLoop()
 
     mainMenu.showMenu();
 }
+
+int Bootstrapper::runBatch(const std::vector<std::string>& args)
+{
+    if (args.front() == "--ayuda" || args.front() == "-h") {
+        BatchRunner::imprimirAyuda(std::cout);
+        return 0;
+    }
+
+    if (args.front() == "--servidor") {
+        return this->runServidor(args);
+    }
+
+    if (args.front() == "--cliente") {
+        return this->runCliente(args);
+    }
+
+    // la salida batch no se mezcla con stdio de C: se evita la sincronizacion y el flush por linea
+    std::ios::sync_with_stdio(false);
+    if (!this->bootstrapStorage()) {
+        std::cerr << "Error inicializando almacenamiento base\n";
+        return 1;
+    }
+
+    BatchRunner runner(repositories, std::cout);
+    bool ok = true;
+    if (args.front() == "--batch") {
+        if (args.size() < 2) {
+            std::cerr << "Falta el archivo de comandos (use '-' para leer de la entrada)\n";
+            return 2;
+        }
+
+        const bool detenerEnError = args.size() > 2 && args[2] == "--detener-en-error";
+        int errores = 0;
+        if (args[1] == "-") {
+            errores = runner.ejecutarScript(std::cin, detenerEnError);
+        } else {
+            std::ifstream script(args[1]);
+            if (!script.is_open()) {
+                std::cerr << "No se pudo abrir el archivo de comandos: " << args[1] << "\n";
+                return 2;
+            }
+            errores = runner.ejecutarScript(script, detenerEnError);
+        }
+        ok = errores == 0;
+    } else {
+        ok = runner.ejecutar(args);
+    }
+
+    ok = runner.finalizar() && ok;
+    std::cout.flush();
+    return ok ? 0 : 1;
+}
+
+int Bootstrapper::runServidor(const std::vector<std::string>& args)
+{
+    std::size_t inicio = 1;
+    const fs::path rutaSocket = extraerRutaSocket(args, inicio);
+    if (inicio != args.size()) {
+        std::cerr << "Uso: PapayaStore --servidor [--socket ruta]\n";
+        return 2;
+    }
+
+    if (!this->bootstrapStorage()) {
+        std::cerr << "Error inicializando almacenamiento base\n";
+        return 1;
+    }
+
+    ServidorLocal servidor(repositories, rutaSocket);
+    return servidor.ejecutar();
+}
+
+int Bootstrapper::runCliente(const std::vector<std::string>& args)
+{
+    std::size_t inicio = 1;
+    const fs::path rutaSocket = extraerRutaSocket(args, inicio);
+    if (inicio == args.size()) {
+        std::cerr << "Uso: PapayaStore --cliente [--socket ruta] <comando|--batch archivo>\n";
+        return 2;
+    }
+
+    std::ios::sync_with_stdio(false);
+    ClienteLocal cliente(rutaSocket);
+    std::string error;
+    if (!cliente.conectar(error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    bool ok = true;
+    if (args[inicio] == "--batch") {
+        if (inicio + 1 >= args.size()) {
+            std::cerr << "Falta el archivo de comandos (use '-' para leer de la entrada)\n";
+            return 2;
+        }
+
+        const bool detenerEnError =
+            inicio + 2 < args.size() && args[inicio + 2] == "--detener-en-error";
+        if (args[inicio + 1] == "-") {
+            ok = cliente.ejecutarScript(std::cin, detenerEnError, std::cout) == 0;
+        } else {
+            std::ifstream script(args[inicio + 1]);
+            if (!script.is_open()) {
+                std::cerr << "No se pudo abrir el archivo de comandos: " << args[inicio + 1]
+                          << "\n";
+                return 2;
+            }
+            ok = cliente.ejecutarScript(script, detenerEnError, std::cout) == 0;
+        }
+    } else {
+        const std::vector<std::string> tokens(args.begin() + static_cast<std::ptrdiff_t>(inicio),
+                                              args.end());
+        ok = cliente.ejecutarLinea(ClienteLocal::unirTokens(tokens), std::cout);
+    }
+
+    std::cout.flush();
+    return ok ? 0 : 1;
+}
@@ -1,10 +1,13 @@
 #pragma once
 #include <filesystem>
+#include <string>
+#include <vector>
 
 #include "infrastructure/datasource/admin/FSDatabaseAdmin.hpp"
 #include "infrastructure/datasource/cliente/FSClienteRepository.hpp"
 #include "infrastructure/datasource/producto/FSProductoRepository.hpp"
 #include "infrastructure/datasource/proveedor/FSProveedorRepository.hpp"
+#include "infrastructure/datasource/rollup/FSRollupRepository.hpp"
 #include "infrastructure/datasource/transaccion/FSTransaccionRepository.hpp"
 #include "presentation/Menu/MainMenu/MainMenu.hpp"
 
@@ -17,6 +20,7 @@ class Bootstrapper
     FSClienteRepository clientes;
     FSProveedorRepository proveedores;
     FSTransaccionRepository transacciones;
+    FSRollupRepository rollups;
     FSDatabaseAdmin admin;
     AppRepositories repositories;
     MainMenu mainMenu;
@@ -25,9 +29,19 @@ class Bootstrapper
     Bootstrapper();
 
     void runMainLoop();
+    /// Modo no interactivo; retorna el codigo de salida del proceso.
+    int runBatch(const std::vector<std::string>& args);
+    /// `--servidor [--socket ruta]`: atiende clientes locales hasta SIGINT/SIGTERM.
+    int runServidor(const std::vector<std::string>& args);
+    /// `--cliente [--socket ruta] <comando|--batch archivo>`: envia comandos al servidor.
+    int runCliente(const std::vector<std::string>& args);
     Bootstrapper& bootstrapContext();
     bool bootstrapStorage();
 
     bool ensureFileWithHeader(const fs::path& path);
+    bool completePendingRestore();
+    bool migrateStorageFormat();
+    bool partitionTransactions();
     bool ensureTiendaRecord();
+    bool ensureRollups();
 };
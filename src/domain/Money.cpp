@@ -0,0 +1,94 @@
+#include "domain/Money.hpp"
+
+#include <cctype>
+#include <cmath>
+#include <limits>
+
+Money Money::fromDecimal(double valor)
+{
+    if (!std::isfinite(valor)) {
+        return Money();
+    }
+
+    return Money(static_cast<std::int64_t>(std::llround(valor * 100.0)));
+}
+
+bool Money::parse(const std::string& input, Money& outValue)
+{
+    std::size_t start = 0;
+    std::size_t end = input.size();
+    while (start < end && std::isspace(static_cast<unsigned char>(input[start]))) {
+        ++start;
+    }
+    while (end > start && std::isspace(static_cast<unsigned char>(input[end - 1]))) {
+        --end;
+    }
+
+    if (start == end) {
+        return false;
+    }
+
+    constexpr std::int64_t limite = std::numeric_limits<std::int64_t>::max() / 100;
+    std::int64_t unidades = 0;
+    std::int64_t centavos = 0;
+    int decimales = 0;
+    int digitosEnteros = 0;
+    bool enDecimales = false;
+
+    for (std::size_t i = start; i < end; ++i) {
+        const unsigned char c = static_cast<unsigned char>(input[i]);
+        if (c == '.' || c == ',') {
+            if (enDecimales) return false;
+            enDecimales = true;
+            continue;
+        }
+
+        if (!std::isdigit(c)) {
+            return false;
+        }
+
+        const int digito = c - '0';
+        if (enDecimales) {
+            if (decimales == 2) return false;
+            centavos = centavos * 10 + digito;
+            ++decimales;
+            continue;
+        }
+
+        if (unidades > (limite - digito) / 10) {
+            return false;
+        }
+        unidades = unidades * 10 + digito;
+        ++digitosEnteros;
+    }
+
+    if (digitosEnteros == 0 && decimales == 0) {
+        return false;
+    }
+
+    if (decimales == 1) {
+        centavos *= 10;
+    }
+
+    outValue = Money(unidades * 100 + centavos);
+    return true;
+}
+
+std::string Money::toString() const
+{
+    // se trabaja en unsigned para que INT64_MIN no desborde al negar
+    const bool negativo = m_centavos < 0;
+    const std::uint64_t absoluto = negativo ? (~static_cast<std::uint64_t>(m_centavos) + 1)
+                                            : static_cast<std::uint64_t>(m_centavos);
+
+    std::string resultado = negativo ? "-" : "";
+    resultado += std::to_string(absoluto / 100);
+    resultado += '.';
+
+    const std::uint64_t resto = absoluto % 100;
+    if (resto < 10) {
+        resultado += '0';
+    }
+    resultado += std::to_string(resto);
+    return resultado;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief - Monto monetario en punto fijo (centavos enteros).
+ *
+ * Reemplaza a `float` en precios y totales: la suma de enteros es exacta y asociativa, por lo que
+ * los agregados dan el mismo resultado sin importar el orden (secuencial, paralelo o SIMD).
+ * Es trivialmente copiable para poder persistirse dentro de structs binarios (TransaccionDTO).
+ */
+class Money
+{
+   private:
+    std::int64_t m_centavos{0};
+
+    constexpr explicit Money(std::int64_t centavos) : m_centavos(centavos) {}
+
+   public:
+    constexpr Money() = default;
+
+    static constexpr Money fromCents(std::int64_t centavos) { return Money(centavos); }
+
+    /// Convierte un valor decimal legado (float/double) redondeando al centavo mas cercano.
+    static Money fromDecimal(double valor);
+
+    /**
+     * Parsea texto decimal ("12", "12.5", "12.50") sin pasar por punto flotante.
+     * Rechaza signos, mas de dos decimales y caracteres no numericos.
+     */
+    static bool parse(const std::string& input, Money& outValue);
+
+    constexpr std::int64_t cents() const { return m_centavos; }
+
+    /// Valor aproximado en unidades, solo para presentacion o interoperabilidad.
+    constexpr double toDecimal() const { return static_cast<double>(m_centavos) / 100.0; }
+
+    /// Representacion decimal exacta con dos decimales ("-3.05", "1200.00").
+    std::string toString() const;
+
+    constexpr bool isNegative() const { return m_centavos < 0; }
+
+    constexpr Money& operator+=(Money other)
+    {
+        m_centavos += other.m_centavos;
+        return *this;
+    }
+
+    constexpr Money& operator-=(Money other)
+    {
+        m_centavos -= other.m_centavos;
+        return *this;
+    }
+
+    friend constexpr Money operator+(Money a, Money b) { return a += b; }
+
+    friend constexpr Money operator-(Money a, Money b) { return a -= b; }
+
+    friend constexpr Money operator*(Money a, std::int64_t cantidad)
+    {
+        return Money(a.m_centavos * cantidad);
+    }
+
+    friend constexpr Money operator*(std::int64_t cantidad, Money a) { return a * cantidad; }
+
+    friend constexpr auto operator<=>(Money a, Money b) = default;
+};
@@ -19,9 +19,29 @@ namespace PATHS {
 inline const fs::path CLIENTES_PATH = "./data/clientes.bin";
 inline const fs::path PROVEEDORES_PATH = "./data/proveedores.bin";
 inline const fs::path PRODUCTOS_PATH = "./data/productos.bin";
+// archivo unico de transacciones anterior a las particiones; se particiona al iniciar
 inline const fs::path TRANSACCIONES_PATH = "./data/transacciones.bin";
+// lista de particiones mensuales (transacciones.AAAA-MM.bin, en el mismo directorio)
+inline const fs::path TRANSACCIONES_PARTICIONES_PATH = "./data/transacciones.particiones";
+inline const fs::path TRANSACCIONES_LOCK_PATH = "./data/transacciones.lock";  // solo para flock
 inline const fs::path TIENDA_PATH = "./data/tienda.bin";
+inline const fs::path ROLLUP_DIARIO_PATH = "./data/rollup_diario.bin";
+inline const fs::path ROLLUP_MENSUAL_PATH = "./data/rollup_mensual.bin";
+inline const fs::path ROLLUP_PRODUCTOS_DIARIO_PATH = "./data/rollup_productos_diario.bin";
+inline const fs::path ROLLUP_PRODUCTOS_MENSUAL_PATH = "./data/rollup_productos_mensual.bin";
+inline const fs::path ROLLUP_LOCK_PATH = "./data/rollups.lock";  // solo para flock, sin datos
+// existe si una actualizacion de rollups fallo; el siguiente arranque los reconstruye
+inline const fs::path ROLLUP_DESACTUALIZADO_PATH = "./data/rollups.desactualizados";
+inline const fs::path COMMITS_LOCK_PATH = "./data/commits.lock";  // solo para flock, sin datos
 inline const fs::path BACKUP_PATH = "./backup/";
+inline const fs::path RESTAURACION_PATH = "./data/restauracion/";  // preparacion de restauraciones
+inline const fs::path SOCKET_PATH = "./data/papaya.sock";
 };  // namespace PATHS
 
+// Version de layout binario guardada en HeaderFile::version
+namespace BINARY_FORMAT {
+inline constexpr int VERSION_MONTOS_FLOAT = 1;  // montos persistidos como float (legado)
+inline constexpr int VERSION_ACTUAL = 2;        // montos persistidos como centavos int64
+};  // namespace BINARY_FORMAT
+
 }  // namespace Constants
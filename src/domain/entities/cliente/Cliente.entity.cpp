@@ -6,7 +6,7 @@
 Cliente::Cliente()
     : EntidadBase(0, "", false, system_clock::now(), system_clock::now()),
       m_cantidad(0),
-      m_totalCompras(0.0f),
+      m_totalCompras(),
       m_cantidadTransacciones(0)
 {
     m_telefono[0] = '\0';
@@ -25,7 +25,7 @@ Cliente::Cliente(int id, const char* nombre, const char* cedula, const char* tel
                  time_point<system_clock> fechaUltimaModificacion)
     : EntidadBase(id, nombre, eliminado, fechaCreacion, fechaUltimaModificacion),
       m_cantidad(0),
-      m_totalCompras(0.0f),
+      m_totalCompras(),
       m_cantidadTransacciones(0)
 {
     this->setTelefono(telefono);
@@ -145,9 +145,9 @@ bool Cliente::setDireccion(const char* direccion)
     return EntidadBase::copiarCadenaSeguro(this->m_direccion, sizeof(this->m_direccion), direccion);
 }
 
-bool Cliente::setTotalCompras(float totalCompras)
+bool Cliente::setTotalCompras(Money totalCompras)
 {
-    if (totalCompras < 0) {
+    if (totalCompras.isNegative()) {
         return false;
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "domain/Money.hpp"
 #include "domain/entities/entidad.entity.hpp"
 
 class Cliente : public EntidadBase
@@ -11,7 +12,7 @@ class Cliente : public EntidadBase
     int m_cantidad;           // cantidad de transacciones / productos
     int m_historialIds[100];  // Identificadores de transacciones / productos
     char m_cedula[20];        // Cédula o RIF
-    float m_totalCompras;
+    Money m_totalCompras;
     int m_transaccionesIds[100];
     int m_cantidadTransacciones;
 
@@ -40,9 +41,9 @@ class Cliente : public EntidadBase
 
     bool setDireccion(const char* direccion);
 
-    float getTotalCompras() const { return this->m_totalCompras; }
+    Money getTotalCompras() const { return this->m_totalCompras; }
 
-    bool setTotalCompras(float totalCompras);
+    bool setTotalCompras(Money totalCompras);
 
     int getCantidadTransacciones() const { return this->m_cantidadTransacciones; }
 
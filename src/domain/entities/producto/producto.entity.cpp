@@ -8,7 +8,7 @@ Producto::Producto()
 Producto::Producto(int id, const char* nombre, bool eliminado,
                    time_point<system_clock> fechaCreacion,
                    time_point<system_clock> fechaUltimaModificacion, const char* codigo,
-                   const char* descripcion, float precio, int stock, int idProveedor,
+                   const char* descripcion, Money precio, int stock, int idProveedor,
                    int stockMinimo, int totalVendido)
     : EntidadBase{id, nombre, eliminado, fechaCreacion, fechaUltimaModificacion}
 {
@@ -17,7 +17,7 @@ Producto::Producto(int id, const char* nombre, bool eliminado,
     if (codigo == nullptr || codigo[0] == '\0') throw std::invalid_argument("Codigo requerido");
     if (descripcion == nullptr || descripcion[0] == '\0')
         throw std::invalid_argument("Descripcion requerida");
-    if (precio < 0) throw std::invalid_argument("Precio invalido");
+    if (precio.isNegative()) throw std::invalid_argument("Precio invalido");
     if (stock < 0) throw std::invalid_argument("Stock invalido");
     if (stockMinimo < 0) throw std::invalid_argument("Stock minimo invalido");
     if (totalVendido < 0) throw std::invalid_argument("Total vendido invalido");
@@ -33,9 +33,9 @@ Producto::Producto(int id, const char* nombre, bool eliminado,
     setTotalVendido(totalVendido);
 }
 
-bool Producto::setPrecio(float nuevoPrecio)
+bool Producto::setPrecio(Money nuevoPrecio)
 {
-    if (nuevoPrecio < 0) {
+    if (nuevoPrecio.isNegative()) {
         return false;
     }
     m_precio = nuevoPrecio;
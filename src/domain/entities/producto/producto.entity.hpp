@@ -1,6 +1,7 @@
 #pragma once
 #include <chrono>
 
+#include "domain/Money.hpp"
 #include "domain/entities/entidad.entity.hpp"
 
 using namespace std::chrono;
@@ -12,7 +13,7 @@ class Producto : public EntidadBase
    private:
     char m_codigo[20]{0};
     char m_descripcion[200]{};  // Descripción del producto
-    float m_precio{0.0f};       // Precio unitario
+    Money m_precio{};           // Precio unitario
     int m_stock{0};             // Cantidad en inventario
     // llaves foraneas
     int m_idProveedor{0};
@@ -25,12 +26,12 @@ class Producto : public EntidadBase
 
     Producto(int id, const char* nombre, bool eliminado, time_point<system_clock> fechaCreacion,
              time_point<system_clock> fechaUltimaModificacion, const char* codigo,
-             const char* descripcion, float precio, int stock, int idProveedor, int stockMinimo,
+             const char* descripcion, Money precio, int stock, int idProveedor, int stockMinimo,
              int totalVendido);
 
-    float getPrecio() const { return m_precio; }
+    Money getPrecio() const { return m_precio; }
 
-    bool setPrecio(float nuevoPrecio);
+    bool setPrecio(Money nuevoPrecio);
 
     int getStock() const { return m_stock; }
 
@@ -6,7 +6,7 @@ Tienda::Tienda() : EntidadBase(0, "Papaya Store", false, system_clock::now(), sy
 
 Tienda::Tienda(int id, const char* nombre, const char* rif, int totalProductosActivos,
                int totalProveedoresActivos, bool eliminado, int totalClientesActivos,
-               time_point<system_clock> fechaCreacion, int montoTotalVentas, int montoTotalCompras,
+               time_point<system_clock> fechaCreacion, Money montoTotalVentas, Money montoTotalCompras,
                int totalTransaccionesActivas, time_point<system_clock> fechaUltimaModificacion)
     : EntidadBase(id, nombre, eliminado, fechaCreacion, fechaUltimaModificacion),
       m_totalProductosActivos(totalProductosActivos),
@@ -48,13 +48,13 @@ bool Tienda::setTotalTransaccionesActivas(int totalTransaccionesActivas)
     return true;
 }
 
-bool Tienda::setMontoTotalVentas(float montoTotalVentas)
+bool Tienda::setMontoTotalVentas(Money montoTotalVentas)
 {
     this->m_montoTotalVentas = montoTotalVentas;
     return true;
 }
 
-bool Tienda::setMontoTotalCompras(float montoTotalCompras)
+bool Tienda::setMontoTotalCompras(Money montoTotalCompras)
 {
     this->m_montoTotalCompras = montoTotalCompras;
     return true;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "domain/Money.hpp"
 #include "domain/entities/entidad.entity.hpp"
 
 class Tienda : public EntidadBase
@@ -10,14 +11,14 @@ class Tienda : public EntidadBase
     int m_totalProveedoresActivos{0};
     int m_totalClientesActivos{0};
     int m_totalTransaccionesActivas{0};
-    float m_montoTotalVentas{0};
-    float m_montoTotalCompras{0};
+    Money m_montoTotalVentas{};
+    Money m_montoTotalCompras{};
 
    public:
     Tienda();
     Tienda(int id, const char* nombre, const char* rif, int totalProductosActivos,
            int totalProveedoresActivos, bool eliminado, int totalClientesActivos,
-           time_point<system_clock> fechaCreacion, int montoTotalVentas, int montoTotalCompras,
+           time_point<system_clock> fechaCreacion, Money montoTotalVentas, Money montoTotalCompras,
            int totalTransaccionesActivas, time_point<system_clock> fechaUltimaModificacion);
 
     const char* getRif() const { return m_rif; }
@@ -40,13 +41,13 @@ class Tienda : public EntidadBase
 
     bool setTotalTransaccionesActivas(int totalTransaccionesActivas);
 
-    float getMontoTotalVentas() const { return m_montoTotalVentas; }
+    Money getMontoTotalVentas() const { return m_montoTotalVentas; }
 
-    bool setMontoTotalVentas(float montoTotalVentas);
+    bool setMontoTotalVentas(Money montoTotalVentas);
 
-    float getMontoTotalCompras() const { return m_montoTotalCompras; }
+    Money getMontoTotalCompras() const { return m_montoTotalCompras; }
 
-    bool setMontoTotalCompras(float montoTotalCompras);
+    bool setMontoTotalCompras(Money montoTotalCompras);
 
     ~Tienda() = default;
 };
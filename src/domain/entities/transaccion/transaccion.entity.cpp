@@ -8,7 +8,7 @@ Transaccion::Transaccion()
 Transaccion::Transaccion(int id, char* nombre, bool eliminado,
                          time_point<system_clock> fechaCreacion,
                          time_point<system_clock> fechaUltimaModificacion, TipoDeTransaccion tipo,
-                         int idRelacionado, float total, char* descripcion,
+                         int idRelacionado, Money total, char* descripcion,
                          TransaccionDTO& productos)
     : EntidadBase(id, nombre, eliminado, fechaCreacion, fechaUltimaModificacion),
       m_tipo(tipo),
@@ -31,7 +31,7 @@ bool Transaccion::setIdRelacionado(int nuevoIdRelacionado)
     return true;
 }
 
-bool Transaccion::setTotal(float nuevoTotal)
+bool Transaccion::setTotal(Money nuevoTotal)
 {
     this->m_total = nuevoTotal;
     return true;
@@ -73,7 +73,7 @@ bool Transaccion::setProductoEnIndice(int index, const TransaccionDTO& producto)
         return false;
     }
 
-    if (producto.productoId <= 0 || producto.cantidad <= 0 || producto.precio < 0) {
+    if (producto.productoId <= 0 || producto.cantidad <= 0 || producto.precio.isNegative()) {
         return false;
     }
 
@@ -84,7 +84,7 @@ bool Transaccion::setProductoEnIndice(int index, const TransaccionDTO& producto)
 bool Transaccion::setProducto(TransaccionDTO nuevoProducto)
 {
     auto isDTOValid =
-        nuevoProducto.cantidad > 0 && nuevoProducto.precio >= 0 && nuevoProducto.productoId > 0;
+        nuevoProducto.cantidad > 0 && !nuevoProducto.precio.isNegative() && nuevoProducto.productoId > 0;
 
     if (!isDTOValid) return false;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "domain/Money.hpp"
 #include "domain/entities/entidad.entity.hpp"
 
 enum TipoDeTransaccion { COMPRA, VENTA };
@@ -7,7 +8,7 @@ enum TipoDeTransaccion { COMPRA, VENTA };
 struct TransaccionDTO {
     int productoId;  // ID del producto
     int cantidad;    // Cantidad de productos
-    float precio;    // Precio unitario
+    Money precio;    // Precio unitario (centavos)
 };
 
 class Transaccion : public EntidadBase
@@ -15,7 +16,7 @@ class Transaccion : public EntidadBase
    private:
     TipoDeTransaccion m_tipo{};         // COMPRA o VENTA
     int m_idRelacionado{0};             // ID del proveedor (compra) o cliente (venta)
-    float m_total{0};                   // cantidad * precioUnitario
+    Money m_total{};                    // cantidad * precioUnitario
     char m_descripcion[200]{};          // Notas adicionales (opcional)
     TransaccionDTO m_productos[100]{};  // Productos de la transaccion (hasta 100)
     int m_productosTotales{0};          // cuantos productos existen en la transaccion
@@ -25,7 +26,7 @@ class Transaccion : public EntidadBase
 
     Transaccion(int id, char* nombre, bool eliminado, time_point<system_clock> fechaCreacion,
                 time_point<system_clock> fechaUltimaModificacion, TipoDeTransaccion tipo,
-                int idRelacionado, float total, char* descripcion, TransaccionDTO& productos);
+                int idRelacionado, Money total, char* descripcion, TransaccionDTO& productos);
 
     auto getTipoTransaccion() const { return this->m_tipo; }
 
@@ -37,7 +38,7 @@ class Transaccion : public EntidadBase
 
     auto getTotal() const { return this->m_total; }
 
-    bool setTotal(float nuevoTotal);
+    bool setTotal(Money nuevoTotal);
 
     auto getDescripcion() const { return this->m_descripcion; }
 
@@ -3,6 +3,7 @@
 #include "IDatabaseAdmin.hpp"
 #include "IProductoRepository.hpp"
 #include "IProveedorRepository.hpp"
+#include "IRollupRepository.hpp"
 #include "ITransaccionRepository.hpp"
 
 /**
@@ -13,5 +14,6 @@ struct AppRepositories {
     IClienteRepository& clientes;
     IProveedorRepository& proveedores;
     ITransaccionRepository& transacciones;
+    IRollupRepository& rollups;
     IDatabaseAdmin& admin;
 };
@@ -1,6 +1,98 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <tuple>
+#include <vector>
+
+#include "domain/Money.hpp"
+#include "domain/entities/cliente/Cliente.entity.hpp"
+#include "domain/entities/producto/producto.entity.hpp"
+
+/**
+ * @brief - Fila de un reporte agregado por proveedor.
+ * @param productos - Productos distintos que aportan a la fila.
+ * @param unidades - Unidades vendidas (ventas) o en stock (inventario).
+ * @param monto - Ingresos por ventas o valor del inventario (stock x precio).
+ */
+struct ResumenProveedor {
+    int idProveedor{0};
+    std::string nombre;
+    int productos{0};
+    std::int64_t unidades{0};
+    Money monto{};
+};
+
+/**
+ * @brief - Como se guardan los archivos de un backup nuevo.
+ *
+ * DEDUPLICADO guarda cada fragmento de 64 KiB una sola vez entre todos los backups (cada uno es
+ * completo por si mismo); COMPRIMIDO y PLANO guardan copias o bloques cambiados por backup, en
+ * cadenas de incrementales.
+ */
+enum FormatoBackup { BACKUP_DEDUPLICADO, BACKUP_COMPRIMIDO, BACKUP_PLANO };
+
+/**
+ * @brief - Resultado de crear, extraer o restaurar un backup.
+ * @param bytes - Bytes de datos respaldados o extraidos, sin comprimir.
+ * @param bytesGuardados - Lo que ocupan esos datos en el backup (sin contar el manifiesto); si es
+ * deduplicado, solo los fragmentos nuevos y las listas.
+ * @param clonados - Archivos copiados como reflink (sin duplicar bloques en disco).
+ * @param fragmentos - Fragmentos que forman el backup deduplicado; `fragmentosNuevos`, los que no
+ * estaban guardados por otro backup.
+ * @param registros - Registros activos verificados al restaurar.
+ * @param msPausa - Tiempo durante el cual las operaciones quedaron detenidas.
+ */
+struct ResumenBackup {
+    std::string ruta;
+    bool incremental{false};
+    int archivos{0};
+    std::uintmax_t bytes{0};
+    std::uintmax_t bytesGuardados{0};
+    int clonados{0};
+    int fragmentos{0};
+    int fragmentosNuevos{0};
+    int registros{0};
+    double msPausa{0};
+};
+
+/**
+ * @brief - Que backups conservar: los `ultimos` N y el mas reciente de cada una de las ultimas N
+ * horas, dias y meses (hora local) que tienen backups. 0 no conserva nada por ese criterio.
+ */
+struct PoliticaRetencion {
+    int ultimos{0};
+    int horas{0};
+    int dias{0};
+    int meses{0};
+};
+
+/**
+ * @brief - Resultado de aplicar una PoliticaRetencion.
+ * @param conservados - Backups que quedan, incluidos los que se conservan por ser la base de otro.
+ * @param objetosEliminados - Fragmentos deduplicados que ya no usaba ningun backup.
+ * @param bytesLiberados - Lo que ocupaban los backups y fragmentos borrados.
+ */
+struct ResumenRetencion {
+    int conservados{0};
+    int eliminados{0};
+    int objetosEliminados{0};
+    std::uintmax_t bytesLiberados{0};
+};
+
+/**
+ * @brief - Operacion de escritura en curso: compra, venta o cancelacion, y tambien altas,
+ * ediciones, bajas e importaciones con su sincronizacion de tienda.
+ *
+ * Mientras exista, los backups de este y de otros procesos esperan para no copiar la operacion a
+ * medias; se libera al destruirse.
+ */
+class OperacionEnCurso
+{
+   public:
+    virtual ~OperacionEnCurso() = default;
+};
 
 /**
  * @brief - Clase para tareas administrativas del sistema
@@ -8,10 +100,43 @@
 class IDatabaseAdmin
 {
    public:
-    virtual void crearBackup() = 0;
+    /// Deduplicado por defecto. En los otros formatos es incremental si hay un backup previo
+    /// valido en la cadena y `completo` fuerza una copia entera; PLANO copia los archivos tal
+    /// cual (reflink si el filesystem lo soporta).
+    virtual ResumenBackup crearBackup(bool completo = false,
+                                      FormatoBackup formato = BACKUP_DEDUPLICADO) = 0;
+
+    /// Reconstruye los datos del backup `id` (el ultimo si esta vacio) en un directorio vacio.
+    virtual ResumenBackup extraerBackup(const std::string& id, const std::string& destino) = 0;
+
+    /// Reemplaza los datos por los del backup `id` (el ultimo si esta vacio). Verifica el backup
+    /// completo antes de tocar los datos; lanza si algo no cuadra.
+    virtual ResumenBackup restaurarBackup(const std::string& id) = 0;
+
+    /// Borra los backups que la politica no conserva (nunca el ultimo ni la base de uno que
+    /// queda) y despues los fragmentos que ya no usa ninguno.
+    virtual ResumenRetencion aplicarRetencion(const PoliticaRetencion& politica) = 0;
+
+    /// Mantener durante toda operacion de varias escrituras que un backup no deba partir.
+    virtual std::unique_ptr<OperacionEnCurso> iniciarOperacion() = 0;
     virtual std::tuple<int, int, int, int> verificarIntegridadReferencial() = 0;
     virtual int reporteStockCritico() = 0;
     virtual void reporteHistorialCliente(int idCliente) = 0;
+
+    /// Compras y ventas que incluyen el producto, con el nombre de cada contraparte.
+    virtual void reporteHistorialProducto(int idProducto) = 0;
     virtual bool sincronizarContadoresTienda() = 0;
+
+    /// Top N de productos por unidades vendidas; idProveedor > 0 filtra por proveedor.
+    virtual std::vector<Producto> reporteTopProductosVendidos(int limite, int idProveedor = 0) = 0;
+
+    /// Top N de clientes por monto total comprado.
+    virtual std::vector<Cliente> reporteTopClientes(int limite) = 0;
+
+    /// Ingresos por ventas agrupados por el proveedor de cada producto vendido.
+    virtual std::vector<ResumenProveedor> reporteVentasPorProveedor() = 0;
+
+    /// Valor actual del inventario (stock x precio) agrupado por proveedor.
+    virtual std::vector<ResumenProveedor> reporteValorInventario() = 0;
     virtual ~IDatabaseAdmin() = default;
 };
@@ -1,18 +1,40 @@
 #pragma once
+#include <functional>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "domain/HeaderFile.hpp"
 #include "domain/entities/producto/producto.entity.hpp"
+#include "domain/utils/Concurrencia.hpp"
+#include "domain/utils/Generador.hpp"
+#include "domain/utils/Paginacion.hpp"
 
 class IProductoRepository
 {
    public:
     virtual std::variant<Producto, std::string> leerPorId(int id) = 0;
     virtual std::variant<Producto, std::string> leerPorNombre(const std::string& nombre) = 0;
+    /// Lee varios IDs en un solo lote; cada posicion trae el producto o su error de lectura.
+    virtual std::variant<std::vector<std::variant<Producto, std::string>>, std::string> leerVarios(
+        const std::vector<int>& ids) = 0;
     virtual std::variant<bool, std::string> guardar(const Producto& entidad) = 0;
+    /// Agrega registros con IDs consecutivos desde proximoID en una sola escritura.
+    virtual std::variant<bool, std::string> guardarLote(const std::vector<Producto>& entidades) = 0;
     virtual std::variant<bool, std::string> actualizar(int id, const Producto& entidad) = 0;
     virtual std::variant<bool, std::string> eliminarLogicamente(int id) = 0;
     virtual std::variant<HeaderFile, std::string> obtenerEstadisticas() = 0;
+    virtual std::variant<bool, std::string> recorrer(
+        const std::function<bool(const Producto&)>& visitante) = 0;
+    /// Recorrido secuencial desde un ID; base de la paginacion por cursor.
+    virtual std::variant<bool, std::string> recorrerDesde(
+        int desdeId, const std::function<bool(const Producto&)>& visitante) = 0;
+    /// Recorrido perezoso para encadenar etapas (Generador.hpp); lee un bloque por vez.
+    virtual Generador<const Producto&> generar(int desdeId = 1) = 0;
+    /// Latches de los IDs para leer-modificar-escribir sin perder cambios de otros hilos.
+    virtual LatchesRegistro::Guardia bloquearRegistros(const std::vector<int>& ids) = 0;
+    virtual EstadisticasContencion obtenerContencion() const = 0;
+    /// Formato de sus registros, para los listados ordenados en archivos temporales.
+    virtual const CodecRegistro<Producto>& codecRegistros() const = 0;
     virtual ~IProductoRepository() = default;
 };
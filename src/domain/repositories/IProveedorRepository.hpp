@@ -1,9 +1,14 @@
 #pragma once
+#include <functional>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "domain/HeaderFile.hpp"
 #include "domain/entities/proveedor/Proveedor.entity.hpp"
+#include "domain/utils/Concurrencia.hpp"
+#include "domain/utils/Generador.hpp"
+#include "domain/utils/Paginacion.hpp"
 
 class IProveedorRepository
 {
@@ -11,8 +16,21 @@ class IProveedorRepository
     virtual std::variant<Proveedor, std::string> leerPorId(int id) = 0;
     virtual std::variant<Proveedor, std::string> leerPorNombre(const std::string& nombre) = 0;
     virtual std::variant<bool, std::string> guardar(const Proveedor& entidad) = 0;
+    /// Agrega registros con IDs consecutivos desde proximoID en una sola escritura.
+    virtual std::variant<bool, std::string> guardarLote(
+        const std::vector<Proveedor>& entidades) = 0;
     virtual std::variant<bool, std::string> actualizar(int id, const Proveedor& entidad) = 0;
     virtual std::variant<bool, std::string> eliminarLogicamente(int id) = 0;
     virtual std::variant<HeaderFile, std::string> obtenerEstadisticas() = 0;
+    virtual std::variant<bool, std::string> recorrer(
+        const std::function<bool(const Proveedor&)>& visitante) = 0;
+    /// Recorrido secuencial desde un ID; base de la paginacion por cursor.
+    virtual std::variant<bool, std::string> recorrerDesde(
+        int desdeId, const std::function<bool(const Proveedor&)>& visitante) = 0;
+    /// Recorrido perezoso para encadenar etapas (Generador.hpp); lee un bloque por vez.
+    virtual Generador<const Proveedor&> generar(int desdeId = 1) = 0;
+    virtual EstadisticasContencion obtenerContencion() const = 0;
+    /// Formato de sus registros, para los listados ordenados en archivos temporales.
+    virtual const CodecRegistro<Proveedor>& codecRegistros() const = 0;
     virtual ~IProveedorRepository() = default;
 };
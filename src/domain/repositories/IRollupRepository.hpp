@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "domain/HeaderFile.hpp"
+#include "domain/entities/transaccion/transaccion.entity.hpp"
+#include "domain/repositories/ITransaccionRepository.hpp"
+#include "domain/rollups/RollupVentas.hpp"
+
+/**
+ * @brief - Agregados diarios y mensuales de transacciones, mantenidos al confirmar cada una.
+ */
+class IRollupRepository
+{
+   public:
+    /// Suma (signo = 1) o resta (signo = -1) una transaccion en los rollups de su fecha. Si falla,
+    /// los rollups quedan marcados como desactualizados hasta la proxima reconstruccion.
+    virtual std::variant<bool, std::string> registrarTransaccion(const Transaccion& transaccion,
+                                                                 int signo) = 0;
+
+    /// Periodos existentes entre dos claves inclusivas (AAAAMMDD o AAAAMM), en orden.
+    virtual std::variant<std::vector<RollupPeriodo>, std::string> leerRango(
+        GranularidadRollup granularidad, int desde, int hasta) = 0;
+
+    /// Unidades por producto de un periodo.
+    virtual std::variant<std::vector<RollupProducto>, std::string> leerProductos(
+        GranularidadRollup granularidad, int periodo) = 0;
+
+    /// Recalcula todos los rollups desde el historial de transacciones activas.
+    virtual std::variant<bool, std::string> reconstruir(ITransaccionRepository& transacciones) = 0;
+
+    /**
+     * true si los rollups no reflejan el historial: una actualizacion fallo desde la ultima
+     * reconstruccion, o no cuentan tantas ventas y compras como `transaccionesActivas`.
+     */
+    virtual std::variant<bool, std::string> requiereReconstruir(int transaccionesActivas) = 0;
+
+    /// Header del rollup diario (cantidadRegistros = dias cubiertos).
+    virtual std::variant<HeaderFile, std::string> obtenerEstadisticas() = 0;
+
+    virtual ~IRollupRepository() = default;
+};
@@ -1,9 +1,28 @@
 #pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "domain/HeaderFile.hpp"
 #include "domain/entities/transaccion/transaccion.entity.hpp"
+#include "domain/utils/Concurrencia.hpp"
+#include "domain/utils/Generador.hpp"
+
+/// Rango de IDs [desde, hasta).
+struct RangoIds {
+    int desde{1};
+    int hasta{1};
+};
+
+/// Resultado de archivar particiones: cuantas y cuanto ocupaban antes y despues.
+struct ResumenArchivado {
+    int particiones{0};
+    std::uintmax_t bytesAntes{0};
+    std::uintmax_t bytesDespues{0};
+};
 
 class ITransaccionRepository
 {
@@ -14,5 +33,33 @@ class ITransaccionRepository
     virtual std::variant<bool, std::string> actualizar(int id, const Transaccion& entidad) = 0;
     virtual std::variant<bool, std::string> eliminarLogicamente(int id) = 0;
     virtual std::variant<HeaderFile, std::string> obtenerEstadisticas() = 0;
+    virtual std::variant<bool, std::string> recorrer(
+        const std::function<bool(const Transaccion&)>& visitante) = 0;
+    /// Recorrido secuencial desde un ID; permite repartir el archivo en tramos.
+    virtual std::variant<bool, std::string> recorrerDesde(
+        int desdeId, const std::function<bool(const Transaccion&)>& visitante) = 0;
+    /// Recorrido perezoso para encadenar etapas (Generador.hpp); lee un bloque por vez.
+    virtual Generador<const Transaccion&> generar(int desdeId = 1) = 0;
+    /**
+     * IDs de las particiones que pueden tener transacciones creadas en [desde, hasta): abarca
+     * tambien otras de los mismos meses, que el llamador descarta por fecha.
+     */
+    virtual std::variant<RangoIds, std::string> rangoEntreFechas(
+        std::chrono::system_clock::time_point desde,
+        std::chrono::system_clock::time_point hasta) = 0;
+    /// Recorrido de las transacciones creadas en [desde, hasta) que solo lee sus particiones.
+    virtual std::variant<bool, std::string> recorrerEntreFechas(
+        std::chrono::system_clock::time_point desde, std::chrono::system_clock::time_point hasta,
+        const std::function<bool(const Transaccion&)>& visitante) = 0;
+    /**
+     * Comprime en segmentos de solo lectura las particiones de meses anteriores a `limite`,
+     * salvo la ultima (la que recibe altas). Sus transacciones se siguen leyendo por ID y en los
+     * recorridos, pero ya no se pueden actualizar ni cancelar.
+     */
+    virtual std::variant<ResumenArchivado, std::string> archivarAnteriores(
+        std::chrono::year_month limite) = 0;
+    /// Latch de la transaccion para que dos cancelaciones simultaneas no la reviertan dos veces.
+    virtual LatchesRegistro::Guardia bloquearRegistros(const std::vector<int>& ids) = 0;
+    virtual EstadisticasContencion obtenerContencion() const = 0;
     virtual ~ITransaccionRepository() = default;
 };
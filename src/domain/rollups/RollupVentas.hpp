@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "domain/Money.hpp"
+
+enum GranularidadRollup { DIARIO, MENSUAL };
+
+/**
+ * @brief - Agregado de transacciones de un periodo (dia o mes).
+ * @param periodo - Clave legible del periodo: AAAAMMDD (diario) o AAAAMM (mensual).
+ */
+struct RollupPeriodo {
+    int periodo{0};
+    int cantidadVentas{0};
+    int cantidadCompras{0};
+    Money ingresosVentas{};
+    Money gastoCompras{};
+    std::int64_t unidadesVendidas{0};
+    std::int64_t unidadesCompradas{0};
+
+    void acumular(const RollupPeriodo& delta)
+    {
+        cantidadVentas += delta.cantidadVentas;
+        cantidadCompras += delta.cantidadCompras;
+        ingresosVentas += delta.ingresosVentas;
+        gastoCompras += delta.gastoCompras;
+        unidadesVendidas += delta.unidadesVendidas;
+        unidadesCompradas += delta.unidadesCompradas;
+    }
+
+    bool vacio() const { return cantidadVentas == 0 && cantidadCompras == 0; }
+};
+
+/// Unidades e ingresos de un producto dentro de un periodo.
+struct RollupProducto {
+    int periodo{0};
+    int productoId{0};
+    std::int64_t unidadesVendidas{0};
+    std::int64_t unidadesCompradas{0};
+    Money ingresosVentas{};
+
+    void acumular(const RollupProducto& delta)
+    {
+        unidadesVendidas += delta.unidadesVendidas;
+        unidadesCompradas += delta.unidadesCompradas;
+        ingresosVentas += delta.ingresosVentas;
+    }
+};
+
+/**
+ * @brief - Conversion entre fechas, claves de periodo e indices consecutivos.
+ *
+ * El indice es contiguo (dias desde epoch o meses desde el anio 0) y permite direccionar
+ * los slots de los archivos de rollup sin busquedas. Las fechas se agrupan en UTC.
+ */
+class RollupCalendario
+{
+   public:
+    static int clave(GranularidadRollup granularidad, std::chrono::system_clock::time_point fecha)
+    {
+        const std::chrono::year_month_day ymd{std::chrono::floor<std::chrono::days>(fecha)};
+        const int anio = static_cast<int>(ymd.year());
+        const int mes = static_cast<int>(static_cast<unsigned>(ymd.month()));
+        if (granularidad == MENSUAL) {
+            return anio * 100 + mes;
+        }
+
+        return anio * 10000 + mes * 100 + static_cast<int>(static_cast<unsigned>(ymd.day()));
+    }
+
+    static int indice(GranularidadRollup granularidad, int clave)
+    {
+        if (granularidad == MENSUAL) {
+            return (clave / 100) * 12 + (clave % 100) - 1;
+        }
+
+        const std::chrono::year_month_day ymd{std::chrono::year{clave / 10000},
+                                              std::chrono::month{
+                                                  static_cast<unsigned>((clave / 100) % 100)},
+                                              std::chrono::day{static_cast<unsigned>(clave % 100)}};
+        return std::chrono::sys_days{ymd}.time_since_epoch().count();
+    }
+
+    static int claveDesdeIndice(GranularidadRollup granularidad, int indice)
+    {
+        if (granularidad == MENSUAL) {
+            return (indice / 12) * 100 + (indice % 12) + 1;
+        }
+
+        const std::chrono::year_month_day ymd{std::chrono::sys_days{std::chrono::days{indice}}};
+        return static_cast<int>(ymd.year()) * 10000 +
+               static_cast<int>(static_cast<unsigned>(ymd.month())) * 100 +
+               static_cast<int>(static_cast<unsigned>(ymd.day()));
+    }
+
+    /// Valida que la clave represente una fecha real para la granularidad indicada.
+    static bool claveValida(GranularidadRollup granularidad, int clave)
+    {
+        if (granularidad == MENSUAL) {
+            const int mes = clave % 100;
+            return clave > 0 && mes >= 1 && mes <= 12;
+        }
+
+        const std::chrono::year_month_day ymd{std::chrono::year{clave / 10000},
+                                              std::chrono::month{
+                                                  static_cast<unsigned>((clave / 100) % 100)},
+                                              std::chrono::day{static_cast<unsigned>(clave % 100)}};
+        return clave > 0 && ymd.ok();
+    }
+};
@@ -0,0 +1,473 @@
+#include "TransaccionService.hpp"
+
+#include <chrono>
+#include <exception>
+
+#include "domain/HeaderFile.hpp"
+
+namespace {
+
+std::vector<int> idsProductos(const std::vector<TransaccionDTO>& items)
+{
+    std::vector<int> ids;
+    ids.reserve(items.size());
+    for (const TransaccionDTO& item : items) {
+        ids.push_back(item.productoId);
+    }
+    return ids;
+}
+
+}  // namespace
+
+TransaccionService::TransaccionService(AppRepositories& repositories) : repositories(repositories)
+{
+}
+
+bool TransaccionService::obtenerItems(const Transaccion& transaccion,
+                                      std::vector<TransaccionDTO>& outItems, std::string& outError)
+{
+    outItems.clear();
+    const int itemsCount = transaccion.getProductosTotales();
+    if (itemsCount <= 0) {
+        outError = "La transacción no tiene productos asociados.";
+        return false;
+    }
+
+    for (int i = 0; i < itemsCount; ++i) {
+        TransaccionDTO item{};
+        if (!transaccion.getProductoEnIndice(i, item)) {
+            outError = "No se pudo leer el item de transacción.";
+            return false;
+        }
+
+        outItems.push_back(item);
+    }
+
+    return true;
+}
+
+Money TransaccionService::calcularTotal(const std::vector<TransaccionDTO>& items,
+                                        std::string& outError)
+{
+    Money total;
+    for (const auto& item : items) {
+        if (item.cantidad < 0 || item.precio.isNegative()) {
+            outError = "Items de transaccion invalidos para calcular total.";
+            return Money::fromCents(-1);
+        }
+
+        total += item.precio * item.cantidad;
+    }
+
+    outError.clear();
+    return total;
+}
+
+bool TransaccionService::aplicarCambiosStock(const std::vector<TransaccionDTO>& items,
+                                             bool incrementarStock, bool ajustarTotalVendido,
+                                             std::vector<Producto>& productosOriginales,
+                                             std::string& outError)
+{
+    productosOriginales.clear();
+
+    for (const auto& item : items) {
+        auto productoResult = repositories.productos.leerPorId(item.productoId);
+        if (std::holds_alternative<std::string>(productoResult)) {
+            outError = "Producto no encontrado para actualizar stock. ID: " +
+                       std::to_string(item.productoId);
+            return false;
+        }
+
+        Producto producto = std::get<Producto>(productoResult);
+        const int stockActual = producto.getStock();
+        const int totalVendidoActual = producto.getTotalVendido();
+
+        int nuevoStock = stockActual;
+        if (incrementarStock) {
+            nuevoStock += item.cantidad;
+        } else {
+            if (stockActual < item.cantidad) {
+                outError = "Stock insuficiente para producto ID " +
+                           std::to_string(item.productoId) +
+                           ". Stock actual: " + std::to_string(stockActual);
+                return false;
+            }
+            nuevoStock -= item.cantidad;
+        }
+
+        int nuevoTotalVendido = totalVendidoActual;
+        if (ajustarTotalVendido) {
+            if (incrementarStock) {
+                nuevoTotalVendido = (totalVendidoActual >= item.cantidad)
+                                        ? (totalVendidoActual - item.cantidad)
+                                        : 0;
+            } else {
+                nuevoTotalVendido += item.cantidad;
+            }
+        }
+
+        Producto productoActualizado = producto;
+        if (!productoActualizado.setStock(nuevoStock)) {
+            outError =
+                "No se pudo actualizar stock del producto ID " + std::to_string(item.productoId);
+            return false;
+        }
+
+        if (ajustarTotalVendido && !productoActualizado.setTotalVendido(nuevoTotalVendido)) {
+            outError = "No se pudo actualizar total vendido del producto ID " +
+                       std::to_string(item.productoId);
+            return false;
+        }
+
+        productoActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+
+        auto updateResult = repositories.productos.actualizar(item.productoId, productoActualizado);
+        if (std::holds_alternative<std::string>(updateResult)) {
+            outError = "Error al guardar cambios de stock. Producto ID " +
+                       std::to_string(item.productoId) + ": " + std::get<std::string>(updateResult);
+            return false;
+        }
+
+        productosOriginales.push_back(producto);
+    }
+
+    return true;
+}
+
+bool TransaccionService::rollbackStock(const std::vector<Producto>& productosOriginales)
+{
+    for (const auto& productoOriginal : productosOriginales) {
+        auto rollbackResult =
+            repositories.productos.actualizar(productoOriginal.getId(), productoOriginal);
+        if (std::holds_alternative<std::string>(rollbackResult)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::variant<Transaccion, std::string> TransaccionService::prepararTransaccion(
+    TipoDeTransaccion tipo, int idRelacionado, std::vector<TransaccionDTO>& items,
+    const std::string& descripcion)
+{
+    if (items.empty()) {
+        return "La transacción no tiene productos asociados.";
+    }
+
+    Transaccion transaccion;
+    transaccion.setTipoTransaccion(tipo);
+    transaccion.setIdRelacionado(idRelacionado);
+    transaccion.setDescripcion(descripcion.c_str());
+
+    // todos los productos de la transaccion se leen en un solo lote
+    auto lecturaResult = repositories.productos.leerVarios(idsProductos(items));
+    if (std::holds_alternative<std::string>(lecturaResult)) {
+        return "No se pudieron leer los productos: " + std::get<std::string>(lecturaResult);
+    }
+    const auto& productosLeidos =
+        std::get<std::vector<std::variant<Producto, std::string>>>(lecturaResult);
+
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        auto& item = items[i];
+        if (item.cantidad <= 0) {
+            return "Cantidad invalida para producto ID " + std::to_string(item.productoId);
+        }
+
+        const auto& productoResult = productosLeidos[i];
+        if (std::holds_alternative<std::string>(productoResult)) {
+            return "Producto invalido (ID " + std::to_string(item.productoId) +
+                   "): " + std::get<std::string>(productoResult);
+        }
+
+        const Producto& producto = std::get<Producto>(productoResult);
+        if (tipo == COMPRA && producto.getIdProveedor() != idRelacionado) {
+            return "El producto " + std::to_string(item.productoId) +
+                   " no pertenece al proveedor seleccionado.";
+        }
+
+        if (tipo == VENTA && producto.getStock() < item.cantidad) {
+            return "Stock insuficiente en validacion final para producto ID " +
+                   std::to_string(item.productoId);
+        }
+
+        item.precio = producto.getPrecio();
+        if (!transaccion.setProducto(item)) {
+            return "No se pudo agregar el producto a la transaccion.";
+        }
+    }
+
+    std::string totalError;
+    const Money total = calcularTotal(items, totalError);
+    if (total.isNegative()) {
+        return totalError;
+    }
+    transaccion.setTotal(total);
+
+    auto transHeaderResult = repositories.transacciones.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(transHeaderResult)) {
+        return std::get<std::string>(transHeaderResult);
+    }
+
+    transaccion.setId(std::get<HeaderFile>(transHeaderResult).proximoID);
+    transaccion.setEliminado(false);
+    transaccion.setFechaUltimaModificacion(std::chrono::system_clock::now());
+    return transaccion;
+}
+
+void TransaccionService::actualizarDerivados(const Transaccion& transaccion, int signo,
+                                             const char* operacion,
+                                             std::vector<std::string>& advertencias)
+{
+    if (!sincronizacionDiferida) {
+        try {
+            repositories.admin.sincronizarContadoresTienda();
+        } catch (const std::exception& e) {
+            advertencias.push_back(std::string(operacion) +
+                                   ", pero no se pudo sincronizar tienda: " + e.what());
+        }
+    }
+
+    auto rollupResult = repositories.rollups.registrarTransaccion(transaccion, signo);
+    if (std::holds_alternative<std::string>(rollupResult)) {
+        advertencias.push_back(std::string(operacion) +
+                               ", pero no se pudieron actualizar los rollups (se reconstruyen "
+                               "al reiniciar): " +
+                               std::get<std::string>(rollupResult));
+    }
+}
+
+std::variant<ResultadoTransaccion, std::string> TransaccionService::registrarCompra(
+    int idProveedor, std::vector<TransaccionDTO> items, const std::string& descripcion)
+{
+    const auto operacion = repositories.admin.iniciarOperacion();
+    auto proveedorResult = repositories.proveedores.leerPorId(idProveedor);
+    if (std::holds_alternative<std::string>(proveedorResult)) {
+        return "Proveedor invalido: " + std::get<std::string>(proveedorResult);
+    }
+
+    const auto latchProductos = repositories.productos.bloquearRegistros(idsProductos(items));
+    std::unique_lock<std::mutex> alta(mutexAlta);
+    auto preparada = prepararTransaccion(COMPRA, idProveedor, items, descripcion);
+    if (std::holds_alternative<std::string>(preparada)) {
+        return std::get<std::string>(preparada);
+    }
+    const Transaccion transaccion = std::get<Transaccion>(preparada);
+
+    auto saveResult = repositories.transacciones.guardar(transaccion);
+    alta.unlock();
+    if (std::holds_alternative<std::string>(saveResult)) {
+        return "Error al guardar transaccion: " + std::get<std::string>(saveResult);
+    }
+
+    std::vector<Producto> productosOriginales;
+    std::string stockError;
+    if (!aplicarCambiosStock(items, true, false, productosOriginales, stockError)) {
+        repositories.transacciones.eliminarLogicamente(transaccion.getId());
+        rollbackStock(productosOriginales);
+        return "Error al actualizar stock de compra: " + stockError;
+    }
+
+    ResultadoTransaccion resultado{transaccion, {}};
+    actualizarDerivados(transaccion, 1, "compra registrada", resultado.advertencias);
+    return resultado;
+}
+
+std::variant<ResultadoTransaccion, std::string> TransaccionService::registrarVenta(
+    int idCliente, std::vector<TransaccionDTO> items, const std::string& descripcion)
+{
+    const auto operacion = repositories.admin.iniciarOperacion();
+    auto clienteResult = repositories.clientes.leerPorId(idCliente);
+    if (std::holds_alternative<std::string>(clienteResult)) {
+        return "Cliente invalido: " + std::get<std::string>(clienteResult);
+    }
+
+    // el stock validado en prepararTransaccion no puede cambiar hasta aplicarCambiosStock
+    const auto latchProductos = repositories.productos.bloquearRegistros(idsProductos(items));
+    const auto latchCliente = repositories.clientes.bloquearRegistros({idCliente});
+    std::unique_lock<std::mutex> alta(mutexAlta);
+    auto preparada = prepararTransaccion(VENTA, idCliente, items, descripcion);
+    if (std::holds_alternative<std::string>(preparada)) {
+        return std::get<std::string>(preparada);
+    }
+    const Transaccion transaccion = std::get<Transaccion>(preparada);
+    const int nuevoId = transaccion.getId();
+
+    auto saveResult = repositories.transacciones.guardar(transaccion);
+    alta.unlock();
+    if (std::holds_alternative<std::string>(saveResult)) {
+        return "Error al guardar transaccion: " + std::get<std::string>(saveResult);
+    }
+
+    std::vector<Producto> productosOriginales;
+
+    // revierte stock y transaccion, agregando al mensaje lo que no se pudo revertir
+    auto revertir = [&](std::string error) {
+        const bool stockRollback = rollbackStock(productosOriginales);
+        auto deleteResult = repositories.transacciones.eliminarLogicamente(nuevoId);
+        if (!stockRollback) {
+            error += " No se pudo revertir el stock aplicado.";
+        }
+        if (std::holds_alternative<std::string>(deleteResult)) {
+            error += " No se pudo revertir la transacción: " + std::get<std::string>(deleteResult);
+        }
+        return error;
+    };
+
+    std::string stockError;
+    if (!aplicarCambiosStock(items, false, true, productosOriginales, stockError)) {
+        return revertir("Error al actualizar stock de venta: " + stockError);
+    }
+
+    auto clienteResultActual = repositories.clientes.leerPorId(idCliente);
+    if (std::holds_alternative<std::string>(clienteResultActual)) {
+        return revertir("No se pudo actualizar métricas del cliente: " +
+                        std::get<std::string>(clienteResultActual));
+    }
+
+    Cliente cliente = std::get<Cliente>(clienteResultActual);
+    const Cliente clienteOriginal = cliente;
+
+    if (!cliente.setTotalCompras(cliente.getTotalCompras() + transaccion.getTotal())) {
+        return revertir("No se pudo actualizar total de compras del cliente.");
+    }
+
+    if (!cliente.agregarTransaccionId(nuevoId)) {
+        return revertir(
+            "No se pudo actualizar historial del cliente (capacidad máxima alcanzada).");
+    }
+
+    cliente.setFechaUltimaModificacion(std::chrono::system_clock::now());
+    auto clientePersistResult = repositories.clientes.actualizar(idCliente, cliente);
+    if (std::holds_alternative<std::string>(clientePersistResult)) {
+        std::string error = revertir("No se pudo guardar métricas del cliente: " +
+                                     std::get<std::string>(clientePersistResult));
+        auto clienteRollback = repositories.clientes.actualizar(idCliente, clienteOriginal);
+        if (std::holds_alternative<std::string>(clienteRollback)) {
+            error += " No se pudo revertir el cliente: " + std::get<std::string>(clienteRollback);
+        }
+        return error;
+    }
+
+    ResultadoTransaccion resultado{transaccion, {}};
+    actualizarDerivados(transaccion, 1, "venta registrada", resultado.advertencias);
+    return resultado;
+}
+
+std::variant<ResultadoTransaccion, std::string> TransaccionService::cancelarTransaccion(
+    int idTransaccion)
+{
+    const auto operacion = repositories.admin.iniciarOperacion();
+    const auto latchTransaccion = repositories.transacciones.bloquearRegistros({idTransaccion});
+    auto transResult = repositories.transacciones.leerPorId(idTransaccion);
+    if (std::holds_alternative<std::string>(transResult)) {
+        return std::get<std::string>(transResult);
+    }
+
+    const Transaccion transaccion = std::get<Transaccion>(transResult);
+    const auto tipo = transaccion.getTipoTransaccion();
+    if (tipo != COMPRA && tipo != VENTA) {
+        return "No se puede cancelar: la transaccion tiene un tipo invalido.";
+    }
+
+    std::vector<TransaccionDTO> items;
+    std::string itemsError;
+    if (!obtenerItems(transaccion, items, itemsError)) {
+        return itemsError;
+    }
+
+    const auto latchProductos = repositories.productos.bloquearRegistros(idsProductos(items));
+    LatchesRegistro::Guardia latchCliente;
+    if (tipo == VENTA) {
+        latchCliente = repositories.clientes.bloquearRegistros({transaccion.getIdRelacionado()});
+    }
+
+    if (tipo == COMPRA) {
+        for (const auto& item : items) {
+            auto productoResult = repositories.productos.leerPorId(item.productoId);
+            if (std::holds_alternative<std::string>(productoResult)) {
+                return "No se pudo validar stock para cancelar compra. Producto ID: " +
+                       std::to_string(item.productoId);
+            }
+
+            const Producto& producto = std::get<Producto>(productoResult);
+            if (producto.getStock() < item.cantidad) {
+                return "No se puede cancelar la compra: el stock actual es menor al ajustado.";
+            }
+        }
+    }
+
+    std::vector<Producto> productosOriginales;
+    std::string stockError;
+    const bool incrementarStock = tipo == VENTA;
+    const bool ajustarTotalVendido = tipo == VENTA;
+    if (!aplicarCambiosStock(items, incrementarStock, ajustarTotalVendido, productosOriginales,
+                             stockError)) {
+        rollbackStock(productosOriginales);
+        return "Error al revertir stock: " + stockError;
+    }
+
+    Cliente clienteOriginal;
+    bool clienteActualizado = false;
+    if (tipo == VENTA) {
+        auto clienteResult = repositories.clientes.leerPorId(transaccion.getIdRelacionado());
+        if (std::holds_alternative<std::string>(clienteResult)) {
+            rollbackStock(productosOriginales);
+            return "No se pudo actualizar métricas del cliente al cancelar: " +
+                   std::get<std::string>(clienteResult);
+        }
+
+        Cliente cliente = std::get<Cliente>(clienteResult);
+        clienteOriginal = cliente;
+
+        Money totalComprasActualizado = cliente.getTotalCompras() - transaccion.getTotal();
+        if (totalComprasActualizado.isNegative()) {
+            totalComprasActualizado = Money();
+        }
+
+        if (!cliente.setTotalCompras(totalComprasActualizado)) {
+            rollbackStock(productosOriginales);
+            return "No se pudo ajustar total de compras del cliente.";
+        }
+
+        if (!cliente.removerTransaccionId(transaccion.getId())) {
+            rollbackStock(productosOriginales);
+            return "No se pudo ajustar historial del cliente.";
+        }
+
+        cliente.setFechaUltimaModificacion(std::chrono::system_clock::now());
+        auto updateClienteResult = repositories.clientes.actualizar(cliente.getId(), cliente);
+        if (std::holds_alternative<std::string>(updateClienteResult)) {
+            rollbackStock(productosOriginales);
+            return "No se pudo guardar cambios del cliente: " +
+                   std::get<std::string>(updateClienteResult);
+        }
+
+        clienteActualizado = true;
+    }
+
+    auto deleteResult = repositories.transacciones.eliminarLogicamente(idTransaccion);
+    if (std::holds_alternative<std::string>(deleteResult)) {
+        const bool stockRollback = rollbackStock(productosOriginales);
+        std::string error = "Error al cancelar transaccion: " + std::get<std::string>(deleteResult);
+
+        if (!stockRollback) {
+            error += " No se pudo revertir el stock ajustado.";
+        }
+
+        if (clienteActualizado) {
+            auto clienteRollback =
+                repositories.clientes.actualizar(clienteOriginal.getId(), clienteOriginal);
+            if (std::holds_alternative<std::string>(clienteRollback)) {
+                error += " No se pudo revertir estado del cliente: " +
+                         std::get<std::string>(clienteRollback);
+            }
+        }
+
+        return error;
+    }
+
+    ResultadoTransaccion resultado{transaccion, {}};
+    actualizarDerivados(transaccion, -1, "transaccion cancelada", resultado.advertencias);
+    return resultado;
+}
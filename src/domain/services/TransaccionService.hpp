@@ -0,0 +1,75 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "domain/Money.hpp"
+#include "domain/entities/producto/producto.entity.hpp"
+#include "domain/entities/transaccion/transaccion.entity.hpp"
+#include "domain/repositories/AppRepositories.hpp"
+
+/**
+ * @brief - Resultado de una compra, venta o cancelacion confirmada.
+ * @param advertencias - Fallos en datos derivados (tienda, rollups) que no revierten la operacion.
+ */
+struct ResultadoTransaccion {
+    Transaccion transaccion;
+    std::vector<std::string> advertencias;
+};
+
+/**
+ * @brief - Reglas de negocio de compras, ventas y cancelaciones, sin interaccion con el usuario.
+ *
+ * Compartido por el menu interactivo y el modo batch: valida los items, persiste la transaccion,
+ * ajusta stock y metricas del cliente, y revierte los pasos aplicados si alguno falla.
+ *
+ * Se puede usar desde varios hilos: cada operacion toma los latches de sus productos y cliente
+ * (en ese orden) durante toda la secuencia leer-validar-escribir, y la asignacion del ID nuevo
+ * hasta su guardado se serializa dentro de la instancia. Cada operacion es ademas una unidad para
+ * las instantaneas de lectura y para los backups (IDatabaseAdmin::iniciarOperacion): un reporte o
+ * un backup la ve completa o no la ve.
+ */
+class TransaccionService
+{
+   private:
+    AppRepositories& repositories;
+    bool sincronizacionDiferida{false};
+    /// Entre leer proximoID y guardar la transaccion nadie mas puede tomar el mismo ID.
+    std::mutex mutexAlta;
+
+    bool aplicarCambiosStock(const std::vector<TransaccionDTO>& items, bool incrementarStock,
+                             bool ajustarTotalVendido, std::vector<Producto>& productosOriginales,
+                             std::string& outError);
+    bool rollbackStock(const std::vector<Producto>& productosOriginales);
+
+    /// Completa el precio de cada item con el del producto y arma la transaccion a guardar.
+    std::variant<Transaccion, std::string> prepararTransaccion(
+        TipoDeTransaccion tipo, int idRelacionado, std::vector<TransaccionDTO>& items,
+        const std::string& descripcion);
+
+    /// Sincroniza tienda y rollups; los errores se agregan como advertencias.
+    void actualizarDerivados(const Transaccion& transaccion, int signo, const char* operacion,
+                             std::vector<std::string>& advertencias);
+
+   public:
+    explicit TransaccionService(AppRepositories& repositories);
+
+    /// Omite la sincronizacion de tienda por operacion; el llamador la ejecuta una vez al final.
+    void diferirSincronizacionTienda(bool diferir) { sincronizacionDiferida = diferir; }
+
+    static bool obtenerItems(const Transaccion& transaccion, std::vector<TransaccionDTO>& outItems,
+                             std::string& outError);
+    static Money calcularTotal(const std::vector<TransaccionDTO>& items, std::string& outError);
+
+    /// Registra una compra; cada item debe pertenecer al proveedor. El precio se toma del producto.
+    std::variant<ResultadoTransaccion, std::string> registrarCompra(
+        int idProveedor, std::vector<TransaccionDTO> items, const std::string& descripcion);
+
+    /// Registra una venta validando stock; actualiza total comprado e historial del cliente.
+    std::variant<ResultadoTransaccion, std::string> registrarVenta(
+        int idCliente, std::vector<TransaccionDTO> items, const std::string& descripcion);
+
+    /// Cancela una transaccion activa revirtiendo stock y metricas del cliente.
+    std::variant<ResultadoTransaccion, std::string> cancelarTransaccion(int idTransaccion);
+};
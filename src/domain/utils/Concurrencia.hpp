@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief - Contadores de acceso a un archivo de entidad.
+ * @param esperas* - Adquisiciones que encontraron el lock tomado por otro hilo y tuvieron que
+ * esperar; comparadas con el total indican cuanta contencion hay.
+ * @param esperasEntreProcesos - Veces que el flock del archivo estaba tomado por otro proceso.
+ */
+struct EstadisticasContencion {
+    std::uint64_t lecturas{0};
+    std::uint64_t esperasLectura{0};
+    std::uint64_t escrituras{0};
+    std::uint64_t esperasEscritura{0};
+    std::uint64_t bloqueosRegistro{0};
+    std::uint64_t esperasRegistro{0};
+    std::uint64_t esperasEntreProcesos{0};
+};
+
+/// Version atomica de EstadisticasContencion, actualizada sin locks propios.
+struct ContadoresContencion {
+    std::atomic<std::uint64_t> lecturas{0};
+    std::atomic<std::uint64_t> esperasLectura{0};
+    std::atomic<std::uint64_t> escrituras{0};
+    std::atomic<std::uint64_t> esperasEscritura{0};
+    std::atomic<std::uint64_t> bloqueosRegistro{0};
+    std::atomic<std::uint64_t> esperasRegistro{0};
+    std::atomic<std::uint64_t> esperasEntreProcesos{0};
+
+    EstadisticasContencion instantanea() const
+    {
+        constexpr auto orden = std::memory_order_relaxed;
+        return EstadisticasContencion{lecturas.load(orden),
+                                      esperasLectura.load(orden),
+                                      escrituras.load(orden),
+                                      esperasEscritura.load(orden),
+                                      bloqueosRegistro.load(orden),
+                                      esperasRegistro.load(orden),
+                                      esperasEntreProcesos.load(orden)};
+    }
+};
+
+/// Toma el lock en modo compartido o exclusivo, contando si hubo que esperar.
+inline std::shared_lock<std::shared_mutex> bloquearCompartido(std::shared_mutex& mutex,
+                                                             ContadoresContencion& contadores)
+{
+    contadores.lecturas.fetch_add(1, std::memory_order_relaxed);
+    std::shared_lock<std::shared_mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        contadores.esperasLectura.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    return lock;
+}
+
+inline std::unique_lock<std::shared_mutex> bloquearExclusivo(std::shared_mutex& mutex,
+                                                            ContadoresContencion& contadores)
+{
+    contadores.escrituras.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<std::shared_mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        contadores.esperasEscritura.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    return lock;
+}
+
+/**
+ * @brief - Latches por registro para secuencias leer-modificar-escribir (stock, metricas).
+ *
+ * En lugar de un mutex por ID se usa un arreglo fijo de franjas indexado por `id % FRANJAS`:
+ * memoria constante y sin registro de latches nuevos. Varios IDs se bloquean en orden creciente
+ * de franja, por lo que dos operaciones con registros en comun no pueden quedar en interbloqueo.
+ */
+class LatchesRegistro
+{
+   public:
+    static constexpr std::size_t FRANJAS = 64;
+
+    /// Mantiene tomados los latches hasta su destruccion.
+    class Guardia
+    {
+       private:
+        std::vector<std::unique_lock<std::mutex>> locks;
+        friend class LatchesRegistro;
+
+       public:
+        Guardia() = default;
+    };
+
+   private:
+    std::array<std::mutex, FRANJAS> franjas;
+
+   public:
+    Guardia bloquear(const std::vector<int>& ids, ContadoresContencion& contadores)
+    {
+        std::vector<std::size_t> indices;
+        indices.reserve(ids.size());
+        for (const int id : ids) {
+            indices.push_back(static_cast<std::size_t>(id < 0 ? -id : id) % FRANJAS);
+        }
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+        Guardia guardia;
+        guardia.locks.reserve(indices.size());
+        for (const std::size_t indice : indices) {
+            contadores.bloqueosRegistro.fetch_add(1, std::memory_order_relaxed);
+            std::unique_lock<std::mutex> lock(franjas[indice], std::try_to_lock);
+            if (!lock.owns_lock()) {
+                contadores.esperasRegistro.fetch_add(1, std::memory_order_relaxed);
+                lock.lock();
+            }
+            guardia.locks.push_back(std::move(lock));
+        }
+        return guardia;
+    }
+};
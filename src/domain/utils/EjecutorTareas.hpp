@@ -0,0 +1,375 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include "domain/HeaderFile.hpp"
+#include "domain/utils/Versiones.hpp"
+
+/**
+ * @brief - Ejecutor compartido con robo de trabajo para los trabajos pesados de administracion.
+ *
+ * Reportes, verificaciones de integridad, reconstruccion de rollups y exportaciones reparten su
+ * rango de IDs en tramos de REGISTROS_POR_TRAMO y los envian aqui. Cada hilo tiene su propia cola:
+ * toma sus tareas por el final (las mas recientes, todavia en cache) y, cuando se queda sin
+ * trabajo, roba por el frente de las colas de otros. El hilo que envia un trabajo tambien ejecuta
+ * tareas mientras espera, por lo que un trabajo enviado desde una tarea no puede bloquear el pool.
+ *
+ * El pool tiene un hilo menos que nucleos (el que envia es el que falta). Las tareas heredan la
+ * instantanea de lectura del hilo que las envio, y cada trabajo deja su Medicion con los tiempos
+ * por tramo; las ultimas MEDICIONES_GUARDADAS se consultan con ultimasMediciones().
+ */
+class EjecutorTareas
+{
+   public:
+    static constexpr int REGISTROS_POR_TRAMO = 2048;
+    static constexpr std::size_t MEDICIONES_GUARDADAS = 32;
+
+    /**
+     * @param msTotal - Duracion del trabajo de punta a punta.
+     * @param msTrabajo - Suma de lo que tardo cada tramo; msTrabajo / msTotal es la aceleracion.
+     */
+    struct Medicion {
+        std::string nombre;
+        std::size_t tramos{0};
+        double msTotal{0};
+        double msTrabajo{0};
+        double msTramoMaximo{0};
+    };
+
+   private:
+    struct Grupo {
+        std::size_t restantes{0};
+        std::atomic<std::int64_t> nsTrabajo{0};
+        std::atomic<std::int64_t> nsMaximo{0};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable terminado;
+    };
+
+    struct Cola {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tareas;
+    };
+
+    std::vector<std::unique_ptr<Cola>> colas;
+    std::vector<std::thread> hilos;
+    std::atomic<std::size_t> encoladas{0};
+    std::atomic<std::size_t> siguienteCola{0};
+    std::mutex mutexReposo;
+    std::condition_variable hayTareas;
+    bool detener{false};
+
+    mutable std::mutex mutexMediciones;
+    std::deque<Medicion> mediciones;
+
+    /// Cola del hilo del pool actual; -1 en hilos que no son del pool.
+    static inline thread_local int colaPropia = -1;
+
+    bool tomar(std::function<void()>& outTarea)
+    {
+        const std::size_t total = colas.size();
+        const std::size_t inicio = colaPropia >= 0
+                                       ? static_cast<std::size_t>(colaPropia)
+                                       : siguienteCola.load(std::memory_order_relaxed) % total;
+        for (std::size_t k = 0; k < total; ++k) {
+            Cola& cola = *colas[(inicio + k) % total];
+            const std::lock_guard<std::mutex> lock(cola.mutex);
+            if (cola.tareas.empty()) {
+                continue;
+            }
+
+            if (k == 0 && colaPropia >= 0) {
+                outTarea = std::move(cola.tareas.back());
+                cola.tareas.pop_back();
+            } else {
+                outTarea = std::move(cola.tareas.front());
+                cola.tareas.pop_front();
+            }
+            encoladas.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void trabajar(int indice)
+    {
+        colaPropia = indice;
+        std::function<void()> tarea;
+        while (true) {
+            if (tomar(tarea)) {
+                tarea();
+                tarea = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutexReposo);
+            hayTareas.wait(lock, [this] {
+                return detener || encoladas.load(std::memory_order_relaxed) > 0;
+            });
+            if (detener && encoladas.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+        }
+    }
+
+   public:
+    explicit EjecutorTareas(unsigned cantidadHilos)
+    {
+        for (unsigned i = 0; i < std::max(1u, cantidadHilos); ++i) {
+            colas.push_back(std::make_unique<Cola>());
+        }
+        hilos.reserve(cantidadHilos);
+        for (unsigned i = 0; i < cantidadHilos; ++i) {
+            hilos.emplace_back([this, i] { trabajar(static_cast<int>(i)); });
+        }
+    }
+
+    ~EjecutorTareas()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutexReposo);
+            detener = true;
+        }
+        hayTareas.notify_all();
+        for (std::thread& hilo : hilos) {
+            hilo.join();
+        }
+    }
+
+    EjecutorTareas(const EjecutorTareas&) = delete;
+    EjecutorTareas& operator=(const EjecutorTareas&) = delete;
+
+    /// Un hilo por nucleo contando al que envia; PAPAYA_HILOS=N fija otro total.
+    static EjecutorTareas& global()
+    {
+        static EjecutorTareas ejecutor([] {
+            unsigned total = std::max(1u, std::thread::hardware_concurrency());
+            if (const char* variable = std::getenv("PAPAYA_HILOS")) {
+                total = static_cast<unsigned>(std::clamp(std::atoi(variable), 1, 256));
+            }
+            return total - 1;
+        }());
+        return ejecutor;
+    }
+
+    /// Hilos del pool, sin contar al que envia el trabajo.
+    std::size_t cantidadHilos() const { return hilos.size(); }
+
+    static std::size_t cantidadTramos(int desde, int hasta)
+    {
+        return hasta > desde ? static_cast<std::size_t>((hasta - desde + REGISTROS_POR_TRAMO - 1) /
+                                                        REGISTROS_POR_TRAMO)
+                             : 0;
+    }
+
+    /**
+     * Ejecuta `trabajo(tramo, desdeId, hastaId)` para cada tramo de [desde, hasta) y espera a que
+     * terminen todos. Si un tramo lanza una excepcion, la primera se relanza aqui al final.
+     * Con `registrarMedicion` en false la Medicion solo se retorna, para que un trabajo hecho en
+     * varias llamadas registre una sola al terminar.
+     */
+    Medicion paraCadaTramo(const std::string& nombre, int desde, int hasta,
+                           const std::function<void(std::size_t, int, int)>& trabajo,
+                           bool registrarMedicion = true)
+    {
+        return paraCadaIndice(
+            nombre, cantidadTramos(desde, hasta),
+            [&](std::size_t tramo) {
+                const int desdeTramo = desde + static_cast<int>(tramo) * REGISTROS_POR_TRAMO;
+                trabajo(tramo, desdeTramo, std::min(hasta, desdeTramo + REGISTROS_POR_TRAMO));
+            },
+            registrarMedicion);
+    }
+
+    /// Como paraCadaTramo, para `cantidad` tareas que no son rangos de IDs (p. ej. un archivo
+    /// por tarea): ejecuta `trabajo(indice)` para cada indice de [0, cantidad).
+    Medicion paraCadaIndice(const std::string& nombre, std::size_t cantidad,
+                            const std::function<void(std::size_t)>& trabajo,
+                            bool registrarMedicion = true)
+    {
+        using Reloj = std::chrono::steady_clock;
+        const auto inicio = Reloj::now();
+        const std::size_t tramos = cantidad;
+        const ControlVersiones::Instantanea* instantanea = LecturaEnInstantanea::actual();
+
+        Grupo grupo;
+        grupo.restantes = tramos;
+        const auto ejecutar = [&](std::size_t tramo) {
+            const LecturaEnInstantanea lectura(instantanea);
+            const auto inicioTramo = Reloj::now();
+            std::exception_ptr error;
+            try {
+                trabajo(tramo);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            const std::int64_t ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Reloj::now() - inicioTramo)
+                    .count();
+            grupo.nsTrabajo.fetch_add(ns, std::memory_order_relaxed);
+            std::int64_t maximo = grupo.nsMaximo.load(std::memory_order_relaxed);
+            while (ns > maximo &&
+                   !grupo.nsMaximo.compare_exchange_weak(maximo, ns, std::memory_order_relaxed)) {
+            }
+
+            // se descuenta con el mutex tomado: el que espera no destruye el grupo antes
+            const std::lock_guard<std::mutex> lock(grupo.mutex);
+            if (error && !grupo.error) {
+                grupo.error = error;
+            }
+            if (--grupo.restantes == 0) {
+                grupo.terminado.notify_all();
+            }
+        };
+
+        if (hilos.empty() || tramos == 1) {
+            for (std::size_t tramo = 0; tramo < tramos; ++tramo) {
+                ejecutar(tramo);
+            }
+        } else {
+            encoladas.fetch_add(tramos, std::memory_order_relaxed);
+            const std::size_t primeraCola = siguienteCola.fetch_add(1, std::memory_order_relaxed);
+            for (std::size_t tramo = 0; tramo < tramos; ++tramo) {
+                // desde un hilo del pool todo va a la cola propia y los demas lo roban
+                const std::size_t indice = colaPropia >= 0 ? static_cast<std::size_t>(colaPropia)
+                                                           : (primeraCola + tramo) % colas.size();
+                Cola& cola = *colas[indice];
+                const std::lock_guard<std::mutex> lock(cola.mutex);
+                cola.tareas.push_back([&ejecutar, tramo] { ejecutar(tramo); });
+            }
+            // pasar por el mutex evita perder el aviso: un hilo que vio encoladas == 0 ya esta
+            // esperando en hayTareas, o todavia no evaluo la condicion y vera las nuevas tareas
+            {
+                const std::lock_guard<std::mutex> lock(mutexReposo);
+            }
+            hayTareas.notify_all();
+
+            std::function<void()> tarea;
+            while (true) {
+                {
+                    const std::lock_guard<std::mutex> lock(grupo.mutex);
+                    if (grupo.restantes == 0) {
+                        break;
+                    }
+                }
+                if (tomar(tarea)) {
+                    tarea();
+                    tarea = nullptr;
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(grupo.mutex);
+                grupo.terminado.wait(lock, [&grupo] { return grupo.restantes == 0; });
+            }
+        }
+
+        Medicion medicion;
+        medicion.nombre = nombre;
+        medicion.tramos = tramos;
+        medicion.msTotal =
+            std::chrono::duration<double, std::milli>(Reloj::now() - inicio).count();
+        medicion.msTrabajo = static_cast<double>(grupo.nsTrabajo.load()) / 1e6;
+        medicion.msTramoMaximo = static_cast<double>(grupo.nsMaximo.load()) / 1e6;
+        if (registrarMedicion) {
+            registrar(medicion);
+        }
+
+        if (grupo.error) {
+            std::rethrow_exception(grupo.error);
+        }
+        return medicion;
+    }
+
+    /**
+     * Encola `tarea` sin esperarla, para trabajos que avisan por su cuenta al terminar (las
+     * solicitudes del servidor local). Corre sin instantanea de lectura aunque la tome un hilo que
+     * espera su propio trabajo, y no debe lanzar. Sin hilos en el pool se ejecuta aqui mismo.
+     */
+    void enviar(std::function<void()> tarea)
+    {
+        std::function<void()> sinInstantanea = [tarea = std::move(tarea)] {
+            const LecturaEnInstantanea lectura(nullptr);
+            tarea();
+        };
+        if (hilos.empty()) {
+            sinInstantanea();
+            return;
+        }
+
+        encoladas.fetch_add(1, std::memory_order_relaxed);
+        Cola& cola = *colas[siguienteCola.fetch_add(1, std::memory_order_relaxed) % colas.size()];
+        {
+            const std::lock_guard<std::mutex> lock(cola.mutex);
+            cola.tareas.push_back(std::move(sinInstantanea));
+        }
+        {
+            const std::lock_guard<std::mutex> lock(mutexReposo);
+        }
+        hayTareas.notify_one();
+    }
+
+    void registrar(Medicion medicion)
+    {
+        const std::lock_guard<std::mutex> lock(mutexMediciones);
+        if (mediciones.size() == MEDICIONES_GUARDADAS) {
+            mediciones.pop_front();
+        }
+        mediciones.push_back(std::move(medicion));
+    }
+
+    /// Mediciones de los ultimos trabajos, del mas antiguo al mas reciente.
+    std::vector<Medicion> ultimasMediciones() const
+    {
+        const std::lock_guard<std::mutex> lock(mutexMediciones);
+        return std::vector<Medicion>(mediciones.begin(), mediciones.end());
+    }
+};
+
+/**
+ * @brief - Recorre en paralelo los registros activos [1, proximoID) de un repositorio.
+ *
+ * Cada tramo se lee con recorrerDesde en un hilo del ejecutor y `visitar(tramo, registro)` recibe
+ * el indice del tramo, para acumular en un parcial propio sin locks; los parciales se combinan al
+ * terminar. Lanza std::runtime_error con el primer error de lectura.
+ */
+template <typename T, typename Repositorio, typename Visitante>
+EjecutorTareas::Medicion recorrerEnParalelo(const std::string& nombre, Repositorio& repositorio,
+                                            int proximoID, const Visitante& visitar)
+{
+    return EjecutorTareas::global().paraCadaTramo(
+        nombre, 1, proximoID, [&](std::size_t tramo, int desde, int hasta) {
+            auto scanResult = repositorio.recorrerDesde(desde, [&](const T& registro) {
+                if (registro.getId() >= hasta) {
+                    return false;
+                }
+                visitar(tramo, registro);
+                return true;
+            });
+            if (std::holds_alternative<std::string>(scanResult)) {
+                throw std::runtime_error(std::get<std::string>(scanResult));
+            }
+        });
+}
+
+/// Cantidad de tramos en que recorrerEnParalelo divide el repositorio; para dimensionar parciales.
+inline std::size_t tramosDeRecorrido(const HeaderFile& header)
+{
+    return EjecutorTareas::cantidadTramos(1, header.proximoID);
+}
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief - Secuencia perezosa producida por una corrutina con co_yield.
+ *
+ * La corrutina arranca suspendida y avanza un elemento cada vez que se incrementa el iterador,
+ * asi que solo se calcula (o se lee del disco) lo que el consumidor pide: salir del bucle antes
+ * del final deja de producir. Con `Generador<const T&>` cada elemento es una referencia al valor
+ * que la corrutina tiene en ese momento y deja de ser valida al avanzar; hay que copiarlo si se
+ * necesita despues. Una excepcion dentro de la corrutina se relanza en quien la hizo avanzar.
+ * Solo se puede recorrer una vez.
+ */
+template <typename T>
+class Generador
+{
+   public:
+    using valor = std::remove_cvref_t<T>;
+    using referencia = std::conditional_t<std::is_reference_v<T>, T, const T&>;
+
+    struct promise_type {
+        std::add_pointer_t<referencia> actual{nullptr};
+        std::exception_ptr error;
+
+        Generador get_return_object()
+        {
+            return Generador(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        // un temporal entregado con co_yield vive hasta que la corrutina se reanuda
+        std::suspend_always yield_value(referencia elemento) noexcept
+        {
+            actual = std::addressof(elemento);
+            return {};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+
+        // sin co_await dentro: la corrutina solo entrega valores
+        template <typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    class iterator
+    {
+       private:
+        std::coroutine_handle<promise_type> corrutina;
+
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = valor;
+
+        iterator() = default;
+        explicit iterator(std::coroutine_handle<promise_type> corrutina) : corrutina(corrutina) {}
+
+        referencia operator*() const { return static_cast<referencia>(*corrutina.promise().actual); }
+
+        iterator& operator++()
+        {
+            avanzar(corrutina);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t)
+        {
+            return !it.corrutina || it.corrutina.done();
+        }
+    };
+
+   private:
+    std::coroutine_handle<promise_type> corrutina;
+
+    explicit Generador(std::coroutine_handle<promise_type> corrutina) : corrutina(corrutina) {}
+
+    static void avanzar(std::coroutine_handle<promise_type> corrutina)
+    {
+        corrutina.resume();
+        if (corrutina.promise().error) {
+            std::rethrow_exception(std::exchange(corrutina.promise().error, nullptr));
+        }
+    }
+
+   public:
+    Generador(Generador&& otro) noexcept : corrutina(std::exchange(otro.corrutina, nullptr)) {}
+
+    Generador& operator=(Generador&& otro) noexcept
+    {
+        if (this != &otro) {
+            if (corrutina) {
+                corrutina.destroy();
+            }
+            corrutina = std::exchange(otro.corrutina, nullptr);
+        }
+        return *this;
+    }
+
+    Generador(const Generador&) = delete;
+    Generador& operator=(const Generador&) = delete;
+
+    /// Destruir el generador sin terminarlo libera la corrutina (y los buffers que tuviera).
+    ~Generador()
+    {
+        if (corrutina) {
+            corrutina.destroy();
+        }
+    }
+
+    iterator begin()
+    {
+        if (corrutina && !corrutina.done()) {
+            avanzar(corrutina);
+        }
+        return iterator(corrutina);
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+};
+
+/**
+ * Etapas para encadenar sobre un Generador con `|`, como
+ * `productos.generar() | filtrar(esCritico) | transformar(nombre) | tomar(10)`.
+ * Las intermedias (filtrar, transformar, tomar, tomarMientras) retornan otro Generador y no
+ * acumulan nada; las finales (contar, acumular, paraCada) consumen la secuencia. Cada etapa
+ * recibe la referencia del elemento de la anterior, sin copiarlo.
+ */
+namespace etapas {
+
+template <typename Predicado>
+struct Filtrar {
+    Predicado predicado;
+};
+
+template <typename Funcion>
+struct Transformar {
+    Funcion funcion;
+};
+
+struct Tomar {
+    std::size_t limite;
+};
+
+template <typename Predicado>
+struct TomarMientras {
+    Predicado predicado;
+};
+
+struct Contar {
+};
+
+template <typename Valor, typename Operacion>
+struct Acumular {
+    Valor inicial;
+    Operacion operacion;
+};
+
+template <typename Funcion>
+struct ParaCada {
+    Funcion funcion;
+};
+
+template <typename T, typename Predicado>
+Generador<T> aplicar(Generador<T> fuente, Predicado predicado)
+{
+    for (auto&& elemento : fuente) {
+        if (predicado(elemento)) {
+            co_yield elemento;
+        }
+    }
+}
+
+template <typename R, typename T, typename Funcion>
+Generador<R> aplicarTransformacion(Generador<T> fuente, Funcion funcion)
+{
+    for (auto&& elemento : fuente) {
+        co_yield funcion(elemento);
+    }
+}
+
+template <typename T>
+Generador<T> aplicarLimite(Generador<T> fuente, std::size_t limite)
+{
+    if (limite == 0) {
+        co_return;
+    }
+
+    std::size_t entregados = 0;
+    for (auto&& elemento : fuente) {
+        co_yield elemento;
+        // se corta antes de pedir otro elemento a la fuente
+        if (++entregados == limite) {
+            co_return;
+        }
+    }
+}
+
+template <typename T, typename Predicado>
+Generador<T> aplicarMientras(Generador<T> fuente, Predicado predicado)
+{
+    for (auto&& elemento : fuente) {
+        if (!predicado(elemento)) {
+            co_return;
+        }
+        co_yield elemento;
+    }
+}
+
+}  // namespace etapas
+
+/// Deja pasar solo los elementos que cumplen el predicado.
+template <typename Predicado>
+etapas::Filtrar<Predicado> filtrar(Predicado predicado)
+{
+    return {std::move(predicado)};
+}
+
+/// Entrega `funcion(elemento)`; si retorna un valor, cada resultado vive hasta el siguiente.
+template <typename Funcion>
+etapas::Transformar<Funcion> transformar(Funcion funcion)
+{
+    return {std::move(funcion)};
+}
+
+/// Entrega como maximo `limite` elementos y deja de pedirle a la fuente.
+inline etapas::Tomar tomar(std::size_t limite)
+{
+    return {limite};
+}
+
+/// Entrega elementos hasta el primero que no cumple el predicado, sin pedir mas a la fuente.
+template <typename Predicado>
+etapas::TomarMientras<Predicado> tomarMientras(Predicado predicado)
+{
+    return {std::move(predicado)};
+}
+
+inline etapas::Contar contar()
+{
+    return {};
+}
+
+/// Pliega la secuencia con `operacion(acumulado, elemento)` partiendo de `inicial`.
+template <typename Valor, typename Operacion>
+etapas::Acumular<Valor, Operacion> acumular(Valor inicial, Operacion operacion)
+{
+    return {std::move(inicial), std::move(operacion)};
+}
+
+/// Llama a `funcion(elemento)` por cada elemento; retorna cuantos hubo.
+template <typename Funcion>
+etapas::ParaCada<Funcion> paraCada(Funcion funcion)
+{
+    return {std::move(funcion)};
+}
+
+template <typename T, typename Predicado>
+Generador<T> operator|(Generador<T>&& fuente, etapas::Filtrar<Predicado> etapa)
+{
+    return etapas::aplicar(std::move(fuente), std::move(etapa.predicado));
+}
+
+template <typename T, typename Funcion>
+auto operator|(Generador<T>&& fuente, etapas::Transformar<Funcion> etapa)
+{
+    using Resultado = std::invoke_result_t<Funcion&, typename Generador<T>::referencia>;
+    return etapas::aplicarTransformacion<Resultado>(std::move(fuente), std::move(etapa.funcion));
+}
+
+template <typename T>
+Generador<T> operator|(Generador<T>&& fuente, etapas::Tomar etapa)
+{
+    return etapas::aplicarLimite(std::move(fuente), etapa.limite);
+}
+
+template <typename T, typename Predicado>
+Generador<T> operator|(Generador<T>&& fuente, etapas::TomarMientras<Predicado> etapa)
+{
+    return etapas::aplicarMientras(std::move(fuente), std::move(etapa.predicado));
+}
+
+template <typename T>
+std::size_t operator|(Generador<T>&& fuente, etapas::Contar)
+{
+    std::size_t total = 0;
+    for (auto it = fuente.begin(); it != fuente.end(); ++it) {
+        ++total;
+    }
+    return total;
+}
+
+template <typename T, typename Valor, typename Operacion>
+Valor operator|(Generador<T>&& fuente, etapas::Acumular<Valor, Operacion> etapa)
+{
+    Valor acumulado = std::move(etapa.inicial);
+    for (auto&& elemento : fuente) {
+        acumulado = etapa.operacion(std::move(acumulado), elemento);
+    }
+    return acumulado;
+}
+
+template <typename T, typename Funcion>
+std::size_t operator|(Generador<T>&& fuente, etapas::ParaCada<Funcion> etapa)
+{
+    std::size_t total = 0;
+    for (auto&& elemento : fuente) {
+        etapa.funcion(elemento);
+        ++total;
+    }
+    return total;
+}
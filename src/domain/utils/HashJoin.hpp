@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief - Join por igualdad en memoria para reportes.
+ *
+ * Se construye una tabla hash con el lado menor (tipicamente una proyeccion id -> nombre de
+ * productos, clientes o proveedores) y luego se sondea con cada fila del lado que se recorre en
+ * streaming (transacciones). Reemplaza las busquedas individuales por id (patron N+1) por una
+ * pasada secuencial de cada archivo: O(construccion + sondeo), memoria O(lado menor).
+ */
+template <typename Clave, typename Fila>
+class HashJoin
+{
+   private:
+    std::unordered_map<Clave, Fila> tabla;
+
+   public:
+    HashJoin() = default;
+
+    explicit HashJoin(std::size_t filasEstimadas) { tabla.reserve(filasEstimadas); }
+
+    /// Agrega una fila al lado de construccion; una clave repetida conserva la primera fila.
+    void construir(const Clave& clave, Fila fila) { tabla.emplace(clave, std::move(fila)); }
+
+    /// Retorna la fila asociada a la clave o nullptr si no hay coincidencia.
+    const Fila* sondear(const Clave& clave) const
+    {
+        auto it = tabla.find(clave);
+        return it == tabla.end() ? nullptr : &it->second;
+    }
+
+    std::size_t size() const { return tabla.size(); }
+};
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief - Formato binario de tamano fijo de un registro, que cada repositorio expone para que
+ * los listados guarden registros en archivos temporales sin conocer el formato de disco.
+ */
+template <typename T>
+class CodecRegistro
+{
+   public:
+    /// Bytes de cada registro serializado.
+    virtual std::size_t tamano() const = 0;
+    virtual bool escribir(std::ostream& os, const T& registro) const = 0;
+    virtual bool leer(std::istream& is, T& outRegistro) const = 0;
+    virtual ~CodecRegistro() = default;
+};
+
+/**
+ * @brief - Listado ordenado por (clave, id) con un ordenamiento externo de una sola pasada.
+ *
+ * Se agregan todos los registros de un recorrido secuencial: se juntan en tramos de
+ * REGISTROS_POR_TRAMO que se ordenan en memoria y se vuelcan a un archivo temporal, y terminar
+ * los mezcla en un unico archivo ordenado. Las paginas se leen de ese archivo por posicion, asi
+ * que el recorrido se paga una vez por listado y no una vez por pagina, y la memoria queda
+ * acotada por el tramo aunque el archivo no entre en memoria. El ID desempata claves repetidas
+ * para que el orden sea estable con nombres, precios o stocks iguales; todas las paginas muestran
+ * los registros como estaban en el recorrido.
+ *
+ * Los registros se guardan con el CodecRegistro del repositorio en archivos de std::tmpfile: se
+ * borran al cerrarse, aun si el proceso termina antes.
+ */
+template <typename Clave, typename T>
+class ListadoOrdenado
+{
+   public:
+    static constexpr std::size_t REGISTROS_POR_TRAMO = 16384;
+
+   private:
+    using Archivo = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+    struct Entrada {
+        Clave clave;
+        T elemento;
+    };
+
+    /// Tramo ya volcado, leido en orden durante la mezcla.
+    struct Lector {
+        Archivo archivo;
+        Entrada actual;
+    };
+
+    std::function<Clave(const T&)> claveDe;
+    const CodecRegistro<T>& codec;
+    std::vector<Entrada> tramo;
+    std::vector<Archivo> tramos;
+    Archivo ordenado{nullptr, &std::fclose};
+    std::size_t total{0};
+
+    static bool anterior(const Entrada& a, const Entrada& b)
+    {
+        return a.clave < b.clave ||
+               (!(b.clave < a.clave) && a.elemento.getId() < b.elemento.getId());
+    }
+
+    static Archivo abrirTemporal() { return Archivo(std::tmpfile(), &std::fclose); }
+
+    /// Serializa `entradas` al final de `archivo`.
+    bool escribir(std::FILE* archivo, const std::vector<Entrada>& entradas) const
+    {
+        std::ostringstream flujo;
+        for (const Entrada& entrada : entradas) {
+            if (!codec.escribir(flujo, entrada.elemento)) {
+                return false;
+            }
+        }
+
+        const std::string datos = flujo.str();
+        return std::fwrite(datos.data(), 1, datos.size(), archivo) == datos.size();
+    }
+
+    /// Lee el siguiente registro de `archivo`; false al final o si no se pudo leer.
+    bool leerSiguiente(std::FILE* archivo, Entrada& outEntrada) const
+    {
+        std::string datos(codec.tamano(), '\0');
+        if (std::fread(datos.data(), 1, datos.size(), archivo) != datos.size()) {
+            return false;
+        }
+
+        std::istringstream flujo(std::move(datos));
+        if (!codec.leer(flujo, outEntrada.elemento)) {
+            return false;
+        }
+
+        outEntrada.clave = claveDe(outEntrada.elemento);
+        return true;
+    }
+
+    std::variant<bool, std::string> volcarTramo()
+    {
+        std::sort(tramo.begin(), tramo.end(), &ListadoOrdenado::anterior);
+        Archivo archivo = abrirTemporal();
+        if (!archivo || !escribir(archivo.get(), tramo)) {
+            return std::string("No se pudo escribir el archivo temporal del listado");
+        }
+
+        tramos.push_back(std::move(archivo));
+        tramo.clear();
+        return true;
+    }
+
+    /// Mezcla los tramos ya volcados en `ordenado`, con un heap de un registro por tramo.
+    std::variant<bool, std::string> mezclarTramos()
+    {
+        std::vector<Lector> lectores;
+        lectores.reserve(tramos.size());
+        for (Archivo& archivo : tramos) {
+            std::rewind(archivo.get());
+            Lector lector{std::move(archivo), Entrada{}};
+            if (leerSiguiente(lector.archivo.get(), lector.actual)) {
+                lectores.push_back(std::move(lector));
+            }
+        }
+        tramos.clear();
+
+        // El frente del heap es el lector con el menor registro pendiente.
+        const auto posterior = [&lectores](std::size_t a, std::size_t b) {
+            return anterior(lectores[b].actual, lectores[a].actual);
+        };
+        std::vector<std::size_t> heap;
+        for (std::size_t i = 0; i < lectores.size(); ++i) {
+            heap.push_back(i);
+        }
+        std::make_heap(heap.begin(), heap.end(), posterior);
+
+        std::vector<Entrada> salida;
+        salida.reserve(REGISTROS_POR_TRAMO);
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), posterior);
+            Lector& lector = lectores[heap.back()];
+            salida.push_back(std::move(lector.actual));
+            if (leerSiguiente(lector.archivo.get(), lector.actual)) {
+                std::push_heap(heap.begin(), heap.end(), posterior);
+            } else {
+                heap.pop_back();
+            }
+
+            if (salida.size() == REGISTROS_POR_TRAMO || heap.empty()) {
+                if (!escribir(ordenado.get(), salida)) {
+                    return std::string("No se pudo escribir el archivo temporal del listado");
+                }
+                salida.clear();
+            }
+        }
+
+        return true;
+    }
+
+   public:
+    ListadoOrdenado(std::function<Clave(const T&)> claveDe, const CodecRegistro<T>& codec)
+        : claveDe(std::move(claveDe)), codec(codec)
+    {
+        tramo.reserve(REGISTROS_POR_TRAMO);
+    }
+
+    /// Agrega un registro del recorrido; vuelca el tramo si se lleno.
+    std::variant<bool, std::string> agregar(const T& registro)
+    {
+        tramo.push_back(Entrada{claveDe(registro), registro});
+        ++total;
+        if (tramo.size() < REGISTROS_POR_TRAMO) {
+            return true;
+        }
+
+        return volcarTramo();
+    }
+
+    /// Deja el archivo ordenado listo para leer paginas; se llama una vez, tras el recorrido.
+    std::variant<bool, std::string> terminar()
+    {
+        ordenado = abrirTemporal();
+        if (!ordenado) {
+            return std::string("No se pudo crear el archivo temporal del listado");
+        }
+
+        // Un solo tramo se escribe directamente, sin pasar por la mezcla.
+        if (tramos.empty()) {
+            std::sort(tramo.begin(), tramo.end(), &ListadoOrdenado::anterior);
+            const bool escrito = escribir(ordenado.get(), tramo);
+            tramo = std::vector<Entrada>();
+            if (!escrito) {
+                return std::string("No se pudo escribir el archivo temporal del listado");
+            }
+            return true;
+        }
+
+        if (!tramo.empty()) {
+            auto volcado = volcarTramo();
+            if (std::holds_alternative<std::string>(volcado)) {
+                return volcado;
+            }
+        }
+        tramo = std::vector<Entrada>();
+
+        return mezclarTramos();
+    }
+
+    std::size_t cantidad() const { return total; }
+
+    /// Registros de la pagina `numero` (desde 0) de `tamano` registros, en orden.
+    std::variant<std::vector<T>, std::string> pagina(std::size_t numero, std::size_t tamano)
+    {
+        std::vector<T> registros;
+        const std::size_t inicio = numero * tamano;
+        if (inicio >= total) {
+            return registros;
+        }
+
+        const std::size_t cuantos = std::min(tamano, total - inicio);
+        const auto desplazamiento = static_cast<long>(inicio * codec.tamano());
+        if (std::fseek(ordenado.get(), desplazamiento, SEEK_SET) != 0) {
+            return std::string("No se pudo leer el archivo temporal del listado");
+        }
+
+        registros.reserve(cuantos);
+        Entrada entrada;
+        for (std::size_t i = 0; i < cuantos; ++i) {
+            if (!leerSiguiente(ordenado.get(), entrada)) {
+                return std::string("No se pudo leer el archivo temporal del listado");
+            }
+            registros.push_back(std::move(entrada.elemento));
+        }
+
+        return registros;
+    }
+};
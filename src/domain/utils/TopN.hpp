@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief - Seleccion de los N mejores elementos de un flujo con un heap acotado.
+ *
+ * Mantiene como maximo `limite` elementos en memoria: el frente del heap es el peor de los
+ * conservados y se reemplaza cuando llega uno mejor. Costo O(total * log N), memoria O(N).
+ * @param Mejor - Predicado `mejor(a, b)` que retorna true si `a` debe quedar antes que `b`.
+ */
+template <typename T, typename Mejor>
+class TopN
+{
+   private:
+    std::size_t limite;
+    Mejor mejor;
+    std::vector<T> heap;
+
+   public:
+    TopN(std::size_t limite, Mejor mejor) : limite(limite), mejor(std::move(mejor))
+    {
+        heap.reserve(limite);
+    }
+
+    /// Considera un elemento; se conserva solo si esta entre los N mejores vistos.
+    void ofrecer(const T& elemento)
+    {
+        if (limite == 0) {
+            return;
+        }
+
+        if (heap.size() < limite) {
+            heap.push_back(elemento);
+            std::push_heap(heap.begin(), heap.end(), mejor);
+            return;
+        }
+
+        if (!mejor(elemento, heap.front())) {
+            return;
+        }
+
+        std::pop_heap(heap.begin(), heap.end(), mejor);
+        heap.back() = elemento;
+        std::push_heap(heap.begin(), heap.end(), mejor);
+    }
+
+    /// Retorna los elementos conservados del mejor al peor y vacia la seleccion.
+    std::vector<T> extraerOrdenado()
+    {
+        std::sort_heap(heap.begin(), heap.end(), mejor);
+        return std::move(heap);
+    }
+};
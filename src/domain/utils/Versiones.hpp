@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+
+/**
+ * @brief - Secuencia global de commits e instantaneas de lectura (MVCC dentro del proceso).
+ *
+ * Cada escritura de un repositorio toma un numero de secuencia creciente. Una instantanea guarda
+ * la secuencia vigente al abrirse; mientras exista, los repositorios conservan en memoria la
+ * imagen anterior de cada registro o header que se sobrescriba, y un lector en esa instantanea ve
+ * la imagen previa a la primera escritura posterior. Sin instantaneas abiertas no se guarda nada.
+ *
+ * Las operaciones de varias escrituras que deben verse completas o no verse (una venta toca
+ * transacciones, productos y cliente) se envuelven en iniciarOperacion(); abrir una instantanea
+ * espera a que terminen las operaciones en curso, asi la secuencia capturada es un punto de corte
+ * consistente. Los escritores nunca esperan a los lectores de una instantanea.
+ */
+class ControlVersiones
+{
+   public:
+    /// Resultado de registrar una escritura: su secuencia y que versiones hay que conservar.
+    struct Escritura {
+        std::uint64_t secuencia{0};
+        /// true si alguna instantanea abierta es anterior a esta escritura.
+        bool conservarAnterior{false};
+        /// Las versiones con secuencia <= este valor ya no las necesita ninguna instantanea.
+        std::uint64_t descartarHasta{0};
+    };
+
+    /// Punto de lectura consistente; se libera al destruirse.
+    class Instantanea
+    {
+       private:
+        ControlVersiones* control{nullptr};
+        std::uint64_t secuencia{0};
+        friend class ControlVersiones;
+
+        Instantanea(ControlVersiones* control, std::uint64_t secuencia)
+            : control(control), secuencia(secuencia)
+        {
+        }
+
+       public:
+        Instantanea(Instantanea&& otra) noexcept : control(otra.control), secuencia(otra.secuencia)
+        {
+            otra.control = nullptr;
+        }
+        Instantanea(const Instantanea&) = delete;
+        Instantanea& operator=(const Instantanea&) = delete;
+        Instantanea& operator=(Instantanea&&) = delete;
+
+        ~Instantanea()
+        {
+            if (control != nullptr) {
+                control->cerrar(secuencia);
+            }
+        }
+
+        std::uint64_t obtenerSecuencia() const { return secuencia; }
+    };
+
+   private:
+    std::shared_mutex puerta;
+    std::mutex mutexSecuencia;
+    std::uint64_t secuencia{0};
+    std::multiset<std::uint64_t> activas;
+
+    void cerrar(std::uint64_t secuenciaInstantanea)
+    {
+        const std::lock_guard<std::mutex> lock(mutexSecuencia);
+        activas.erase(activas.find(secuenciaInstantanea));
+    }
+
+   public:
+    static ControlVersiones& global()
+    {
+        static ControlVersiones control;
+        return control;
+    }
+
+    Instantanea abrir()
+    {
+        const std::unique_lock<std::shared_mutex> sinOperaciones(puerta);
+        const std::lock_guard<std::mutex> lock(mutexSecuencia);
+        activas.insert(secuencia);
+        return Instantanea(this, secuencia);
+    }
+
+    /// Mantener mientras dura una operacion de varias escrituras que debe verse atomica.
+    std::shared_lock<std::shared_mutex> iniciarOperacion()
+    {
+        return std::shared_lock<std::shared_mutex>(puerta);
+    }
+
+    /// Espera a que terminen las operaciones en curso y no deja empezar otras mientras se mantenga.
+    std::unique_lock<std::shared_mutex> detenerOperaciones()
+    {
+        return std::unique_lock<std::shared_mutex>(puerta);
+    }
+
+    /// Llamar con el lock exclusivo del archivo tomado, antes de escribir.
+    Escritura registrarEscritura()
+    {
+        const std::lock_guard<std::mutex> lock(mutexSecuencia);
+        Escritura escritura;
+        escritura.secuencia = ++secuencia;
+        escritura.conservarAnterior = !activas.empty();
+        escritura.descartarHasta = activas.empty() ? secuencia : *activas.begin();
+        return escritura;
+    }
+};
+
+/**
+ * @brief - Hace que las lecturas de repositorios del hilo actual usen una instantanea.
+ *
+ * Los reportes largos la activan al comenzar; todas las lecturas que hagan (por ID, por nombre o
+ * recorridos) ven los datos tal como estaban al abrir la instantanea, sin cambiar sus firmas.
+ * Es solo para lectura: un hilo con instantanea activa no debe escribir en los repositorios.
+ */
+class LecturaEnInstantanea
+{
+   private:
+    static inline thread_local const ControlVersiones::Instantanea* vigente = nullptr;
+    const ControlVersiones::Instantanea* anterior;
+
+   public:
+    explicit LecturaEnInstantanea(const ControlVersiones::Instantanea& instantanea)
+        : LecturaEnInstantanea(&instantanea)
+    {
+    }
+    /// Con nullptr el hilo vuelve a leer el estado actual hasta que se destruya el objeto.
+    explicit LecturaEnInstantanea(const ControlVersiones::Instantanea* instantanea)
+        : anterior(vigente)
+    {
+        vigente = instantanea;
+    }
+    ~LecturaEnInstantanea() { vigente = anterior; }
+
+    LecturaEnInstantanea(const LecturaEnInstantanea&) = delete;
+    LecturaEnInstantanea& operator=(const LecturaEnInstantanea&) = delete;
+
+    /// Instantanea activa en este hilo, o nullptr para leer el estado actual.
+    static const ControlVersiones::Instantanea* actual() { return vigente; }
+};
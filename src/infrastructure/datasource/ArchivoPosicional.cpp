@@ -0,0 +1,124 @@
+#include "ArchivoPosicional.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+
+ArchivoPosicional::ArchivoPosicional(fs::path ruta) : ruta(std::move(ruta)), cambios(this->ruta) {}
+
+ArchivoPosicional::~ArchivoPosicional()
+{
+    const int abierto = descriptor.load();
+    if (abierto >= 0) {
+        ::close(abierto);
+    }
+}
+
+bool ArchivoPosicional::abrir()
+{
+    if (descriptor.load(std::memory_order_acquire) >= 0) {
+        return true;
+    }
+
+    const std::lock_guard<std::mutex> lock(mutexApertura);
+    if (descriptor.load(std::memory_order_relaxed) >= 0) {
+        return true;
+    }
+
+    int abierto = ::open(ruta.c_str(), O_RDWR | O_CLOEXEC);
+    if (abierto < 0 && (errno == EACCES || errno == EROFS)) {
+        abierto = ::open(ruta.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    if (abierto < 0) {
+        return false;
+    }
+
+    descriptor.store(abierto, std::memory_order_release);
+    return true;
+}
+
+bool ArchivoPosicional::leerEn(void* destino, std::size_t bytes, off_t offset) const
+{
+    const int fd = descriptor.load(std::memory_order_acquire);
+    char* cursor = static_cast<char*>(destino);
+    while (bytes > 0) {
+        const ssize_t leidos = ::pread(fd, cursor, bytes, offset);
+        if (leidos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (leidos == 0) {
+            return false;
+        }
+
+        cursor += leidos;
+        bytes -= static_cast<std::size_t>(leidos);
+        offset += leidos;
+    }
+    return true;
+}
+
+bool ArchivoPosicional::escribirEn(const void* origen, std::size_t bytes, off_t offset) const
+{
+    // se marca antes de escribir: si el proceso cae en medio, el bloque igual entra al backup
+    cambios.marcar(offset, bytes);
+    const int fd = descriptor.load(std::memory_order_acquire);
+    const char* cursor = static_cast<const char*>(origen);
+    while (bytes > 0) {
+        const ssize_t escritos = ::pwrite(fd, cursor, bytes, offset);
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        cursor += escritos;
+        bytes -= static_cast<std::size_t>(escritos);
+        offset += escritos;
+    }
+    return true;
+}
+
+ssize_t ArchivoPosicional::leerVariosEn(iovec* segmentos, int cantidad, off_t offset) const
+{
+    const int fd = descriptor.load(std::memory_order_acquire);
+    ssize_t total = 0;
+    while (cantidad > 0) {
+        const ssize_t leidos = ::preadv(fd, segmentos, cantidad, offset);
+        if (leidos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (leidos == 0) {
+            break;
+        }
+
+        total += leidos;
+        offset += leidos;
+
+        // una lectura parcial deja segmentos pendientes: se descartan los completos
+        std::size_t restantes = static_cast<std::size_t>(leidos);
+        while (cantidad > 0 && restantes >= segmentos->iov_len) {
+            restantes -= segmentos->iov_len;
+            ++segmentos;
+            --cantidad;
+        }
+        if (cantidad > 0) {
+            segmentos->iov_base = static_cast<char*>(segmentos->iov_base) + restantes;
+            segmentos->iov_len -= restantes;
+        }
+    }
+    return total;
+}
+
+bool ArchivoPosicional::leerLote(std::vector<SolicitudLectura>& solicitudes) const
+{
+    return MotorLecturas::global().leerTodas(descriptor.load(std::memory_order_acquire),
+                                             solicitudes);
+}
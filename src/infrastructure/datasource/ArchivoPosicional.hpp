@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <vector>
+
+#include "infrastructure/datasource/MotorLecturas.hpp"
+#include "infrastructure/datasource/RegistroCambios.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Acceso por posicion (pread/pwrite) a un archivo de datos sobre un descriptor crudo.
+ *
+ * Cada lectura o escritura indica su propio offset, asi que no hay un cursor compartido que mover:
+ * varios hilos pueden leer a la vez sobre el mismo descriptor sin seek ni stream por operacion.
+ * El descriptor se abre en el primer acceso (el archivo puede no existir al construir el
+ * repositorio) y se mantiene abierto hasta destruir el objeto. Si el archivo no admite escritura
+ * se abre solo para lectura y las escrituras fallan. Cada escritura marca antes sus bloques en el
+ * RegistroCambios del archivo, que usan los backups incrementales.
+ */
+class ArchivoPosicional
+{
+   private:
+    fs::path ruta;
+    std::atomic<int> descriptor{-1};
+    std::mutex mutexApertura;
+    RegistroCambios cambios;
+
+   public:
+    explicit ArchivoPosicional(fs::path ruta);
+    ~ArchivoPosicional();
+
+    ArchivoPosicional(const ArchivoPosicional&) = delete;
+    ArchivoPosicional& operator=(const ArchivoPosicional&) = delete;
+
+    /// Abre el descriptor si todavia no lo esta; false si el archivo no se puede abrir.
+    bool abrir();
+
+    /// Lee exactamente `bytes` desde `offset`; false ante error o fin de archivo anticipado.
+    bool leerEn(void* destino, std::size_t bytes, off_t offset) const;
+
+    /// Escribe exactamente `bytes` en `offset`.
+    bool escribirEn(const void* origen, std::size_t bytes, off_t offset) const;
+
+    /**
+     * Lee un rango contiguo del archivo repartido en varios buffers con una sola llamada (preadv).
+     * Retorna los bytes leidos, que pueden ser menos que el total si se llega al fin del archivo,
+     * o -1 ante error. Los segmentos pueden quedar modificados.
+     */
+    ssize_t leerVariosEn(iovec* segmentos, int cantidad, off_t offset) const;
+
+    /// Lee un lote de rangos independientes con varias lecturas en vuelo (MotorLecturas).
+    bool leerLote(std::vector<SolicitudLectura>& solicitudes) const;
+};
+
+/**
+ * @brief - Adapta un bloque de memoria a los streams que usa EntityTraits.
+ *
+ * Permite (de)serializar un registro leido o por escribir con pread/pwrite sin copiarlo a un
+ * stream propio. Leer o escribir mas alla del bloque deja el stream en estado de error.
+ */
+class RegistroEnMemoria : private std::streambuf
+{
+   private:
+    std::iostream flujo{this};
+
+   public:
+    RegistroEnMemoria() = default;
+    RegistroEnMemoria(const RegistroEnMemoria&) = delete;
+    RegistroEnMemoria& operator=(const RegistroEnMemoria&) = delete;
+
+    std::istream& leerDesde(const char* datos, std::size_t bytes)
+    {
+        char* inicio = const_cast<char*>(datos);
+        setg(inicio, inicio, inicio + bytes);
+        flujo.clear();
+        return flujo;
+    }
+
+    std::ostream& escribirEn(char* datos, std::size_t bytes)
+    {
+        setp(datos, datos + bytes);
+        flujo.clear();
+        return flujo;
+    }
+};
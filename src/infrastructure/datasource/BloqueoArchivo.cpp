@@ -0,0 +1,130 @@
+#include "BloqueoArchivo.hpp"
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/file.h>
+#include <unistd.h>
+
+struct BloqueoArchivo::Estado {
+    std::mutex mutex;
+    std::condition_variable liberado;
+    int descriptor{-1};
+    int lectores{0};
+    bool escritor{false};
+    /// Ya se aviso por stderr que este archivo no se pudo bloquear.
+    bool avisado{false};
+};
+
+namespace {
+
+ContadoresContencion contadoresSinRegistro;
+
+BloqueoArchivo::Estado& estadoDe(const fs::path& path)
+{
+    static std::mutex mutexEstados;
+    static std::map<std::string, std::unique_ptr<BloqueoArchivo::Estado>> estados;
+    const std::lock_guard<std::mutex> lock(mutexEstados);
+    auto& estado = estados[path.lexically_normal().string()];
+    if (estado == nullptr) {
+        estado = std::make_unique<BloqueoArchivo::Estado>();
+    }
+    return *estado;
+}
+
+void avisar(BloqueoArchivo::Estado& estado, const fs::path& path, const char* motivo, int error)
+{
+    if (!estado.avisado) {
+        estado.avisado = true;
+        std::cerr << "Advertencia: no se pudo " << motivo << ' ' << path.string() << ": "
+                  << std::strerror(error) << "\n";
+    }
+}
+
+/// flock bloqueante sobre el descriptor del archivo; false si el sistema no lo permite.
+bool tomarFlock(int descriptor, int operacion, ContadoresContencion& contadores, int& outError)
+{
+    if (::flock(descriptor, operacion | LOCK_NB) == 0) {
+        return true;
+    }
+    if (errno == EWOULDBLOCK) {
+        contadores.esperasEntreProcesos.fetch_add(1, std::memory_order_relaxed);
+    }
+    while (::flock(descriptor, operacion) < 0) {
+        if (errno != EINTR) {
+            outError = errno;
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+BloqueoArchivo::BloqueoArchivo(const fs::path& path, Modo modo, ContadoresContencion& contadores)
+    : modo(modo)
+{
+    Estado& candidato = estadoDe(path);
+    std::unique_lock<std::mutex> lock(candidato.mutex);
+    if (candidato.descriptor < 0) {
+        // se reintenta en cada uso mientras falte: el archivo puede crearse despues
+        candidato.descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (candidato.descriptor < 0) {
+            if (errno != ENOENT) {
+                avisar(candidato, path, "abrir para bloquear", errno);
+            }
+            return;
+        }
+    }
+
+    // sin otros titulares en el proceso nadie mas necesita el mutex: se espera el flock con el
+    if (modo == EXCLUSIVO) {
+        candidato.liberado.wait(
+            lock, [&] { return !candidato.escritor && candidato.lectores == 0; });
+        int error = 0;
+        if (!tomarFlock(candidato.descriptor, LOCK_EX, contadores, error)) {
+            avisar(candidato, path, "bloquear", error);
+            return;
+        }
+        candidato.escritor = true;
+    } else {
+        candidato.liberado.wait(lock, [&] { return !candidato.escritor; });
+        int error = 0;
+        if (candidato.lectores == 0 &&
+            !tomarFlock(candidato.descriptor, LOCK_SH, contadores, error)) {
+            avisar(candidato, path, "bloquear", error);
+            return;
+        }
+        candidato.lectores += 1;
+    }
+    estado = &candidato;
+}
+
+BloqueoArchivo::BloqueoArchivo(const fs::path& path, Modo modo)
+    : BloqueoArchivo(path, modo, contadoresSinRegistro)
+{
+}
+
+BloqueoArchivo::~BloqueoArchivo()
+{
+    if (estado == nullptr) {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(estado->mutex);
+    if (modo == EXCLUSIVO) {
+        estado->escritor = false;
+    } else {
+        estado->lectores -= 1;
+    }
+    if (!estado->escritor && estado->lectores == 0) {
+        ::flock(estado->descriptor, LOCK_UN);
+        estado->liberado.notify_all();
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+
+#include "domain/utils/Concurrencia.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Lock advisory (flock) sobre un archivo de datos, valido entre procesos.
+ *
+ * Complementa los locks entre hilos de FSBaseRepository: un proceso que solo consulta toma el
+ * archivo en modo compartido y puede correr en paralelo con la tienda, mientras que cualquier
+ * escritura (altas, actualizaciones, header) lo toma exclusivo.
+ *
+ * Cada archivo tiene un unico descriptor por proceso, abierto en el primer uso y nunca cerrado
+ * (flock pertenece al descriptor). Los hilos del proceso se coordinan en memoria como un lock de
+ * lectura/escritura y el flock se toma al entrar el primero y se suelta al salir el ultimo, asi
+ * que varias lecturas simultaneas cuestan un solo flock. Si no se puede bloquear (el archivo no
+ * existe, o flock falla) activo() es false; salvo que falte el archivo se avisa por stderr, y
+ * quien escribe no debe seguir sin el lock.
+ */
+class BloqueoArchivo
+{
+   public:
+    enum Modo { COMPARTIDO, EXCLUSIVO };
+
+    /// Descriptor y titulares en este proceso de un archivo; vive hasta terminar el proceso.
+    struct Estado;
+
+   private:
+    Estado* estado{nullptr};
+    Modo modo;
+
+   public:
+    /// Bloquea hasta obtener el lock; si hubo que esperar a otro proceso lo suma a `contadores`.
+    BloqueoArchivo(const fs::path& path, Modo modo, ContadoresContencion& contadores);
+    BloqueoArchivo(const fs::path& path, Modo modo);
+    ~BloqueoArchivo();
+
+    BloqueoArchivo(const BloqueoArchivo&) = delete;
+    BloqueoArchivo& operator=(const BloqueoArchivo&) = delete;
+
+    bool activo() const { return estado != nullptr; }
+};
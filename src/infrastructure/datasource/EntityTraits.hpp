@@ -5,16 +5,58 @@
 #include <cstring>
 #include <istream>
 #include <ostream>
+#include <type_traits>
 
+#include "domain/Money.hpp"
+#include "domain/constants.hpp"
 #include "domain/entities/cliente/Cliente.entity.hpp"
 #include "domain/entities/producto/producto.entity.hpp"
 #include "domain/entities/proveedor/Proveedor.entity.hpp"
 #include "domain/entities/tienda/tienda.entity.hpp"
 #include "domain/entities/transaccion/transaccion.entity.hpp"
+#include "domain/utils/Paginacion.hpp"
 
 template <typename T>
 struct EntityTraits;
 
+static_assert(std::is_trivially_copyable_v<TransaccionDTO> && sizeof(TransaccionDTO) == 16,
+              "TransaccionDTO se persiste en bloque; su layout debe ser estable");
+
+/// Campos monetarios segun la version de formato del archivo.
+/// La version legada guardaba float; la actual guarda centavos en int64.
+namespace MoneyField {
+inline constexpr int VERSION_ACTUAL = Constants::BINARY_FORMAT::VERSION_ACTUAL;
+
+/// Tamano en disco de un monto para la version indicada.
+inline std::streamoff size(int version)
+{
+    return version <= Constants::BINARY_FORMAT::VERSION_MONTOS_FLOAT ? sizeof(float)
+                                                                      : sizeof(std::int64_t);
+}
+
+/// Escribe un monto en el formato actual (centavos int64).
+inline void write(std::ostream& os, Money monto)
+{
+    const std::int64_t centavos = monto.cents();
+    os.write(reinterpret_cast<const char*>(&centavos), sizeof(centavos));
+}
+
+/// Lee un monto en el formato de la version indicada, convirtiendo float legado a centavos.
+inline void read(std::istream& is, Money& outMonto, int version)
+{
+    if (version <= Constants::BINARY_FORMAT::VERSION_MONTOS_FLOAT) {
+        float legado = 0.0f;
+        is.read(reinterpret_cast<char*>(&legado), sizeof(legado));
+        outMonto = Money::fromDecimal(legado);
+        return;
+    }
+
+    std::int64_t centavos = 0;
+    is.read(reinterpret_cast<char*>(&centavos), sizeof(centavos));
+    outMonto = Money::fromCents(centavos);
+}
+}  // namespace MoneyField
+
 /// Adaptador binario para Producto.
 /// Define metadatos para CRUD generico y serializacion deterministica.
 template <>
@@ -29,11 +71,11 @@ struct EntityTraits<Producto> {
     static void setDeleted(Producto& p, bool val) { p.setEliminado(val); }
 
     /// Tamano fijo de un registro de Producto en disco.
-    static std::streamoff recordSize()
+    static std::streamoff recordSize(int version = MoneyField::VERSION_ACTUAL)
     {
         return sizeof(int) + 100 + sizeof(std::int8_t) + sizeof(std::int64_t) +
-               sizeof(std::int64_t) + 20 + 200 + sizeof(float) + sizeof(int) + sizeof(int) +
-               sizeof(int) + sizeof(int);
+               sizeof(std::int64_t) + 20 + 200 + MoneyField::size(version) + sizeof(int) +
+               sizeof(int) + sizeof(int) + sizeof(int);
     }
 
     /// Serializa Producto en orden fijo de campos para escritura binaria.
@@ -55,7 +97,6 @@ struct EntityTraits<Producto> {
         std::strncpy(codigo, p.getCodigo(), sizeof(codigo) - 1);
         char descripcion[200] = {0};
         std::strncpy(descripcion, p.getDescripcion(), sizeof(descripcion) - 1);
-        const float precio = p.getPrecio();
         const int stock = p.getStock();
         const int idProveedor = p.getIdProveedor();
         const int stockMinimo = p.getStockMinimo();
@@ -68,7 +109,7 @@ struct EntityTraits<Producto> {
         os.write(reinterpret_cast<const char*>(&fechaModificacion), sizeof(fechaModificacion));
         os.write(codigo, sizeof(codigo));
         os.write(descripcion, sizeof(descripcion));
-        os.write(reinterpret_cast<const char*>(&precio), sizeof(precio));
+        MoneyField::write(os, p.getPrecio());
         os.write(reinterpret_cast<const char*>(&stock), sizeof(stock));
         os.write(reinterpret_cast<const char*>(&idProveedor), sizeof(idProveedor));
         os.write(reinterpret_cast<const char*>(&stockMinimo), sizeof(stockMinimo));
@@ -78,7 +119,8 @@ struct EntityTraits<Producto> {
     }
 
     /// Deserializa un Producto desde stream binario y lo reconstruye via setters.
-    static bool readFromStream(std::istream& is, Producto& p)
+    static bool readFromStream(std::istream& is, Producto& p,
+                               int version = MoneyField::VERSION_ACTUAL)
     {
         int id = 0;
         char nombre[100] = {0};
@@ -87,7 +129,7 @@ struct EntityTraits<Producto> {
         std::int64_t fechaModificacion = 0;
         char codigo[20] = {0};
         char descripcion[200] = {0};
-        float precio = 0.0f;
+        Money precio;
         int stock = 0;
         int idProveedor = 0;
         int stockMinimo = 0;
@@ -100,7 +142,7 @@ struct EntityTraits<Producto> {
         is.read(reinterpret_cast<char*>(&fechaModificacion), sizeof(fechaModificacion));
         is.read(codigo, sizeof(codigo));
         is.read(descripcion, sizeof(descripcion));
-        is.read(reinterpret_cast<char*>(&precio), sizeof(precio));
+        MoneyField::read(is, precio, version);
         is.read(reinterpret_cast<char*>(&stock), sizeof(stock));
         is.read(reinterpret_cast<char*>(&idProveedor), sizeof(idProveedor));
         is.read(reinterpret_cast<char*>(&stockMinimo), sizeof(stockMinimo));
@@ -143,11 +185,11 @@ struct EntityTraits<Cliente> {
     static void setDeleted(Cliente& c, bool val) { c.setEliminado(val); }
 
     /// Tamano fijo de un registro de Cliente en disco.
-    static std::streamoff recordSize()
+    static std::streamoff recordSize(int version = MoneyField::VERSION_ACTUAL)
     {
         return sizeof(int) + 100 + sizeof(std::int8_t) + sizeof(std::int64_t) +
                sizeof(std::int64_t) + 20 + 20 + 100 + 200 + sizeof(int) + (sizeof(int) * 100) +
-               sizeof(float) + (sizeof(int) * 100) + sizeof(int);
+               MoneyField::size(version) + (sizeof(int) * 100) + sizeof(int);
     }
 
     /// Serializa Cliente en orden fijo de campos para escritura binaria.
@@ -174,7 +216,6 @@ struct EntityTraits<Cliente> {
         char direccion[200] = {0};
         std::strncpy(direccion, c.getDireccion(), sizeof(direccion) - 1);
         const int cantidad = c.getCantidad();
-        const float totalCompras = c.getTotalCompras();
         const int cantidadTransacciones = c.getCantidadTransacciones();
 
         os.write(reinterpret_cast<const char*>(&id), sizeof(id));
@@ -188,7 +229,7 @@ struct EntityTraits<Cliente> {
         os.write(direccion, sizeof(direccion));
         os.write(reinterpret_cast<const char*>(&cantidad), sizeof(cantidad));
         os.write(reinterpret_cast<const char*>(c.getHistorialIds()), sizeof(int) * 100);
-        os.write(reinterpret_cast<const char*>(&totalCompras), sizeof(totalCompras));
+        MoneyField::write(os, c.getTotalCompras());
         os.write(reinterpret_cast<const char*>(c.getTransaccionesIds()), sizeof(int) * 100);
         os.write(reinterpret_cast<const char*>(&cantidadTransacciones),
                  sizeof(cantidadTransacciones));
@@ -197,7 +238,8 @@ struct EntityTraits<Cliente> {
     }
 
     /// Deserializa un Cliente desde stream binario y lo reconstruye via setters.
-    static bool readFromStream(std::istream& is, Cliente& c)
+    static bool readFromStream(std::istream& is, Cliente& c,
+                               int version = MoneyField::VERSION_ACTUAL)
     {
         int id = 0;
         char nombre[100] = {0};
@@ -210,7 +252,7 @@ struct EntityTraits<Cliente> {
         char direccion[200] = {0};
         int cantidad = 0;
         int historialIds[100] = {0};
-        float totalCompras = 0.0f;
+        Money totalCompras;
         int transaccionesIds[100] = {0};
         int cantidadTransacciones = 0;
 
@@ -225,7 +267,7 @@ struct EntityTraits<Cliente> {
         is.read(direccion, sizeof(direccion));
         is.read(reinterpret_cast<char*>(&cantidad), sizeof(cantidad));
         is.read(reinterpret_cast<char*>(historialIds), sizeof(historialIds));
-        is.read(reinterpret_cast<char*>(&totalCompras), sizeof(totalCompras));
+        MoneyField::read(is, totalCompras, version);
         is.read(reinterpret_cast<char*>(transaccionesIds), sizeof(transaccionesIds));
         is.read(reinterpret_cast<char*>(&cantidadTransacciones), sizeof(cantidadTransacciones));
 
@@ -271,8 +313,8 @@ struct EntityTraits<Proveedor> {
     /// Marca el estado de borrado logico de la entidad.
     static void setDeleted(Proveedor& p, bool val) { p.setEliminado(val); }
 
-    /// Tamano fijo de un registro de Proveedor en disco.
-    static std::streamoff recordSize()
+    /// Tamano fijo de un registro de Proveedor en disco (sin montos: igual en toda version).
+    static std::streamoff recordSize(int = MoneyField::VERSION_ACTUAL)
     {
         return sizeof(int) + 100 + sizeof(std::int8_t) + sizeof(std::int64_t) +
                sizeof(std::int64_t) + 20 + (sizeof(int) * 100) + sizeof(int) + 20 + 100 + 200 +
@@ -323,7 +365,8 @@ struct EntityTraits<Proveedor> {
     }
 
     /// Deserializa un Proveedor desde stream binario y lo reconstruye via setters.
-    static bool readFromStream(std::istream& is, Proveedor& p)
+    static bool readFromStream(std::istream& is, Proveedor& p,
+                               int = MoneyField::VERSION_ACTUAL)
     {
         int id = 0;
         char nombre[100] = {0};
@@ -394,12 +437,18 @@ struct EntityTraits<Transaccion> {
     /// Marca el estado de borrado logico de la entidad.
     static void setDeleted(Transaccion& t, bool val) { t.setEliminado(val); }
 
+    /// Tamano en disco de un item (TransaccionDTO) para la version indicada.
+    static std::streamoff itemSize(int version)
+    {
+        return sizeof(int) + sizeof(int) + MoneyField::size(version);
+    }
+
     /// Tamano fijo de un registro de Transaccion en disco.
-    static std::streamoff recordSize()
+    static std::streamoff recordSize(int version = MoneyField::VERSION_ACTUAL)
     {
         return sizeof(int) + 100 + sizeof(std::int8_t) + sizeof(std::int64_t) +
-               sizeof(std::int64_t) + sizeof(int) + sizeof(int) + sizeof(float) + 200 +
-               (sizeof(TransaccionDTO) * 100) + sizeof(int);
+               sizeof(std::int64_t) + sizeof(int) + sizeof(int) + MoneyField::size(version) + 200 +
+               (itemSize(version) * 100) + sizeof(int);
     }
 
     /// Serializa Transaccion en orden fijo de campos para escritura binaria.
@@ -416,7 +465,6 @@ struct EntityTraits<Transaccion> {
                 .count();
         int tipo = static_cast<int>(t.getTipoTransaccion());
         const int idRelacionado = t.getIdRelacionado();
-        const float total = t.getTotal();
 
         char nombre[100] = {0};
         std::strncpy(nombre, t.getNombre(), sizeof(nombre) - 1);
@@ -436,7 +484,7 @@ struct EntityTraits<Transaccion> {
         os.write(reinterpret_cast<const char*>(&fechaModificacion), sizeof(fechaModificacion));
         os.write(reinterpret_cast<const char*>(&tipo), sizeof(tipo));
         os.write(reinterpret_cast<const char*>(&idRelacionado), sizeof(idRelacionado));
-        os.write(reinterpret_cast<const char*>(&total), sizeof(total));
+        MoneyField::write(os, t.getTotal());
         os.write(descripcion, sizeof(descripcion));
         os.write(reinterpret_cast<const char*>(productos), sizeof(productos));
         os.write(reinterpret_cast<const char*>(&productosTotales), sizeof(productosTotales));
@@ -445,7 +493,8 @@ struct EntityTraits<Transaccion> {
     }
 
     /// Deserializa una Transaccion desde stream binario y la reconstruye via setters.
-    static bool readFromStream(std::istream& is, Transaccion& t)
+    static bool readFromStream(std::istream& is, Transaccion& t,
+                               int version = MoneyField::VERSION_ACTUAL)
     {
         int id = 0;
         char nombre[100] = {0};
@@ -454,7 +503,7 @@ struct EntityTraits<Transaccion> {
         std::int64_t fechaModificacion = 0;
         int tipo = 0;
         int idRelacionado = 0;
-        float total = 0.0f;
+        Money total;
         char descripcion[200] = {0};
         TransaccionDTO productos[100] = {};
         int productosTotales = 0;
@@ -466,9 +515,17 @@ struct EntityTraits<Transaccion> {
         is.read(reinterpret_cast<char*>(&fechaModificacion), sizeof(fechaModificacion));
         is.read(reinterpret_cast<char*>(&tipo), sizeof(tipo));
         is.read(reinterpret_cast<char*>(&idRelacionado), sizeof(idRelacionado));
-        is.read(reinterpret_cast<char*>(&total), sizeof(total));
+        MoneyField::read(is, total, version);
         is.read(descripcion, sizeof(descripcion));
-        is.read(reinterpret_cast<char*>(productos), sizeof(productos));
+        if (version == MoneyField::VERSION_ACTUAL) {
+            is.read(reinterpret_cast<char*>(productos), sizeof(productos));
+        } else {
+            for (TransaccionDTO& item : productos) {
+                is.read(reinterpret_cast<char*>(&item.productoId), sizeof(item.productoId));
+                is.read(reinterpret_cast<char*>(&item.cantidad), sizeof(item.cantidad));
+                MoneyField::read(is, item.precio, version);
+            }
+        }
         is.read(reinterpret_cast<char*>(&productosTotales), sizeof(productosTotales));
 
         if (!is) {
@@ -509,11 +566,11 @@ struct EntityTraits<Transaccion> {
 template <>
 struct EntityTraits<Tienda> {
     /// Tamano fijo de un registro de Tienda en disco.
-    static std::streamoff recordSize()
+    static std::streamoff recordSize(int version = MoneyField::VERSION_ACTUAL)
     {
         return sizeof(int) + 100 + sizeof(std::int8_t) + sizeof(std::int64_t) +
                sizeof(std::int64_t) + 20 + sizeof(int) + sizeof(int) + sizeof(int) + sizeof(int) +
-               sizeof(float) + sizeof(float);
+               MoneyField::size(version) + MoneyField::size(version);
     }
 
     /// Serializa Tienda en orden fijo de campos para escritura binaria.
@@ -537,8 +594,6 @@ struct EntityTraits<Tienda> {
         const int totalProveedoresActivos = t.getTotalProveedoresActivos();
         const int totalClientesActivos = t.getTotalClientesActivos();
         const int totalTransaccionesActivas = t.getTotalTransaccionesActivas();
-        const float montoTotalVentas = t.getMontoTotalVentas();
-        const float montoTotalCompras = t.getMontoTotalCompras();
 
         os.write(reinterpret_cast<const char*>(&id), sizeof(id));
         os.write(nombre, sizeof(nombre));
@@ -554,14 +609,15 @@ struct EntityTraits<Tienda> {
                  sizeof(totalClientesActivos));
         os.write(reinterpret_cast<const char*>(&totalTransaccionesActivas),
                  sizeof(totalTransaccionesActivas));
-        os.write(reinterpret_cast<const char*>(&montoTotalVentas), sizeof(montoTotalVentas));
-        os.write(reinterpret_cast<const char*>(&montoTotalCompras), sizeof(montoTotalCompras));
+        MoneyField::write(os, t.getMontoTotalVentas());
+        MoneyField::write(os, t.getMontoTotalCompras());
 
         return static_cast<bool>(os);
     }
 
     /// Deserializa Tienda desde stream binario y reconstruye su estado.
-    static bool readFromStream(std::istream& is, Tienda& t)
+    static bool readFromStream(std::istream& is, Tienda& t,
+                               int version = MoneyField::VERSION_ACTUAL)
     {
         int id = 0;
         char nombre[100] = {0};
@@ -573,8 +629,8 @@ struct EntityTraits<Tienda> {
         int totalProveedoresActivos = 0;
         int totalClientesActivos = 0;
         int totalTransaccionesActivas = 0;
-        float montoTotalVentas = 0.0f;
-        float montoTotalCompras = 0.0f;
+        Money montoTotalVentas;
+        Money montoTotalCompras;
 
         is.read(reinterpret_cast<char*>(&id), sizeof(id));
         is.read(nombre, sizeof(nombre));
@@ -587,8 +643,8 @@ struct EntityTraits<Tienda> {
         is.read(reinterpret_cast<char*>(&totalClientesActivos), sizeof(totalClientesActivos));
         is.read(reinterpret_cast<char*>(&totalTransaccionesActivas),
                 sizeof(totalTransaccionesActivas));
-        is.read(reinterpret_cast<char*>(&montoTotalVentas), sizeof(montoTotalVentas));
-        is.read(reinterpret_cast<char*>(&montoTotalCompras), sizeof(montoTotalCompras));
+        MoneyField::read(is, montoTotalVentas, version);
+        MoneyField::read(is, montoTotalCompras, version);
 
         if (!is) {
             return false;
@@ -612,3 +668,24 @@ struct EntityTraits<Tienda> {
         return true;
     }
 };
+
+/// CodecRegistro del dominio sobre el formato actual de EntityTraits; lo exponen los repositorios.
+template <typename T>
+class CodecEntidad : public CodecRegistro<T>
+{
+   public:
+    std::size_t tamano() const override
+    {
+        return static_cast<std::size_t>(EntityTraits<T>::recordSize());
+    }
+
+    bool escribir(std::ostream& os, const T& registro) const override
+    {
+        return EntityTraits<T>::writeToStream(os, registro);
+    }
+
+    bool leer(std::istream& is, T& outRegistro) const override
+    {
+        return EntityTraits<T>::readFromStream(is, outRegistro);
+    }
+};
@@ -1,100 +1,331 @@
 #pragma once
 
+#include <algorithm>
 #include <filesystem>
-#include <fstream>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "domain/HeaderFile.hpp"
+#include "domain/constants.hpp"
+#include "domain/utils/Concurrencia.hpp"
+#include "domain/utils/Generador.hpp"
+#include "domain/utils/Versiones.hpp"
 #include "domain/utils/utils.hpp"
+#include "infrastructure/datasource/ArchivoPosicional.hpp"
+#include "infrastructure/datasource/BloqueoArchivo.hpp"
 #include "infrastructure/datasource/EntityTraits.hpp"
 
 namespace fs = std::filesystem;
 
+/**
+ * @brief - Acceso generico a un archivo de registros de tamano fijo, seguro entre hilos.
+ *
+ * Todo acceso a registros y header es posicional (pread/pwrite sobre un ArchivoPosicional que se
+ * abre una vez y comparten todos los hilos), sin cursor que mover ni stream por operacion; los
+ * recorridos leen bloques de varios registros por llamada. Las lecturas toman el lock del archivo
+ * en modo compartido y pueden correr en paralelo; las escrituras lo toman exclusivo, lo que
+ * serializa a los escritores de un mismo archivo sin bloquear a los de otras entidades. Las
+ * secuencias leer-modificar-escribir de un registro (stock, metricas de cliente) se protegen
+ * ademas con bloquearRegistrosTemplate.
+ * Cada operacion toma tambien el flock del archivo en el mismo modo (BloqueoArchivo), de modo que
+ * otro proceso no lea un header a medio escribir ni asigne el mismo proximoID.
+ *
+ * Si el hilo tiene una LecturaEnInstantanea activa, las lecturas devuelven el estado de esa
+ * instantanea: mientras haya instantaneas abiertas, cada escritura conserva en memoria la imagen
+ * anterior del registro o del header, y los recorridos leen por tramos liberando los locks entre
+ * tramos para no frenar a los escritores durante un reporte largo.
+ *
+ * Un archivo puede empezar en un ID distinto de 1 (las particiones mensuales de transacciones):
+ * el registro `id` ocupa la posicion `id - primerId` y el header cuenta solo los de ese archivo,
+ * con proximoID global.
+ */
 template <typename T>
 class FSBaseRepository
 {
    private:
+    static constexpr std::size_t SCAN_BUFFER_SIZE = 1 << 16;
+    static constexpr int BLOQUES_EN_VUELO = 8;
+    static constexpr int REGISTROS_POR_TRAMO = 1024;
+
     fs::path filePath;
+    int primerIdArchivo;
+    ArchivoPosicional archivo;
+    std::shared_mutex accesoArchivo;
+    ContadoresContencion contencion;
+    LatchesRegistro latches;
+
+    /// Imagenes previas a escrituras hechas con instantaneas abiertas, en orden de secuencia.
+    /// Solo se modifican con el lock exclusivo del archivo; se leen con el compartido.
+    std::unordered_map<int, std::vector<std::pair<std::uint64_t, T>>> versionesRegistro;
+    std::vector<std::pair<std::uint64_t, HeaderFile>> versionesHeader;
+
+    /// Error de una escritura que no pudo tomar el flock del archivo: no se escribe sin el.
+    std::string errorSinBloqueo() const
+    {
+        return "No se pudo bloquear " + filePath.string() + " para escribir";
+    }
+
+    /// Verifica que el header leido corresponda al formato actual.
+    std::variant<HeaderFile, std::string> validarHeader(const HeaderFile& header) const
+    {
+        // el layout de registros depende de la version; solo se opera sobre archivos migrados
+        if (header.version != Constants::BINARY_FORMAT::VERSION_ACTUAL) {
+            return "Version de formato no soportada en " + filePath.string() +
+                   " (reinicie la aplicacion para migrar)";
+        }
+
+        return header;
+    }
 
-    /// Lee el HeaderFile del archivo asociado y posiciona el cursor al inicio.
-    std::variant<HeaderFile, std::string> readHeader(std::fstream& file)
+    /// Lee el HeaderFile del archivo asociado; el descriptor ya debe estar abierto.
+    std::variant<HeaderFile, std::string> readHeader()
     {
         HeaderFile header = {};
-        file.seekg(0, std::ios::beg);
-        file.read(reinterpret_cast<char*>(&header), sizeof(HeaderFile));
-        if (!file) {
+        if (!archivo.leerEn(&header, sizeof(HeaderFile), 0)) {
             return "No se pudo leer el encabezado del archivo";
         }
 
-        return header;
+        return validarHeader(header);
     }
 
     /// Escribe el HeaderFile en el inicio del archivo asociado.
-    std::variant<bool, std::string> writeHeader(std::fstream& file, const HeaderFile& header)
+    std::variant<bool, std::string> writeHeader(const HeaderFile& header)
     {
-        file.seekp(0, std::ios::beg);
-        file.write(reinterpret_cast<const char*>(&header), sizeof(HeaderFile));
-        if (!file) {
+        if (!archivo.escribirEn(&header, sizeof(HeaderFile), 0)) {
             return "No se pudo escribir el encabezado del archivo";
         }
 
         return true;
     }
 
-    /// Calcula el offset binario de un registro por ID usando tamano fijo.
-    std::streampos getRecordOffset(int id) const
+    /**
+     * Lee el header y, si `primerId` es el primer registro, tambien el bloque inicial de registros
+     * en la misma llamada (preadv): en disco el header y el registro 1 son contiguos. En
+     * `outPrecargados` quedan los bytes de registros ya cargados al inicio de `bloque`.
+     */
+    std::variant<HeaderFile, std::string> readHeaderYBloque(int primerId, std::vector<char>& bloque,
+                                                            std::size_t& outPrecargados)
     {
-        return static_cast<std::streampos>(sizeof(HeaderFile)) +
-               static_cast<std::streampos>(id - 1) * EntityTraits<T>::recordSize();
+        outPrecargados = 0;
+        if (primerId != primerIdArchivo) {
+            return readHeader();
+        }
+
+        HeaderFile header = {};
+        iovec segmentos[2] = {{&header, sizeof(HeaderFile)}, {bloque.data(), bloque.size()}};
+        const ssize_t leidos = archivo.leerVariosEn(segmentos, 2, 0);
+        if (leidos < static_cast<ssize_t>(sizeof(HeaderFile))) {
+            return "No se pudo leer el encabezado del archivo";
+        }
+
+        outPrecargados = static_cast<std::size_t>(leidos) - sizeof(HeaderFile);
+        return validarHeader(header);
     }
 
-   public:
-    explicit FSBaseRepository(fs::path path) : filePath(std::move(path)) {}
+    static std::size_t tamanoRegistro()
+    {
+        return static_cast<std::size_t>(EntityTraits<T>::recordSize());
+    }
 
-    /// Retorna estadisticas del archivo (HeaderFile) para la entidad T.
-    std::variant<HeaderFile, std::string> obtenerEstadisticasTemplate()
+    /// Bloque de lectura para recorridos: tantos registros completos como entren en el buffer.
+    static std::vector<char> nuevoBloque()
     {
-        std::fstream file(filePath, std::ios::in | std::ios::binary);
-        if (!file.is_open()) {
-            return "Error abriendo archivo para obtener estadísticas: " + filePath.string();
+        const std::size_t registros = std::max<std::size_t>(1, SCAN_BUFFER_SIZE / tamanoRegistro());
+        return std::vector<char>(registros * tamanoRegistro());
+    }
+
+    /// Lee y deserializa un registro por ID con un unico pread.
+    bool leerRegistro(int id, T& registro)
+    {
+        std::vector<char> bytes(tamanoRegistro());
+        if (!archivo.leerEn(bytes.data(), bytes.size(), getRecordOffset(id))) {
+            return false;
         }
 
-        auto headerResult = readHeader(file);
-        if (std::holds_alternative<std::string>(headerResult)) {
-            return std::get<std::string>(headerResult);
+        RegistroEnMemoria memoria;
+        return EntityTraits<T>::readFromStream(memoria.leerDesde(bytes.data(), bytes.size()),
+                                               registro);
+    }
+
+    /// Serializa y escribe un registro por ID con un unico pwrite.
+    bool escribirRegistro(int id, const T& entidad)
+    {
+        std::vector<char> bytes(tamanoRegistro());
+        RegistroEnMemoria memoria;
+        if (!EntityTraits<T>::writeToStream(memoria.escribirEn(bytes.data(), bytes.size()),
+                                            entidad)) {
+            return false;
         }
 
-        return std::get<HeaderFile>(headerResult);
+        return archivo.escribirEn(bytes.data(), bytes.size(), getRecordOffset(id));
     }
 
-    /// Lee un registro activo por ID usando acceso aleatorio y EntityTraits<T>.
-    std::variant<T, std::string> leerTemplate(int id)
+    /**
+     * Entrega a `visitante(id, registro)` los registros [primerId, finId), incluidos los
+     * eliminados, leyendolos por bloques completos. Los primeros `precargados` bytes de `bloque`
+     * ya contienen el inicio del rango. Si quedan varios bloques por leer se piden hasta
+     * BLOQUES_EN_VUELO juntos al MotorLecturas, que los lee en paralelo. El visitante retorna
+     * false para detener la lectura.
+     */
+    std::variant<bool, std::string> leerRango(int primerId, int finId, std::vector<char>& bloque,
+                                              std::size_t precargados,
+                                              const std::function<bool(int, T&)>& visitante)
     {
-        std::fstream file(filePath, std::ios::in | std::ios::binary);
-        if (!file.is_open()) {
+        const std::size_t tamano = tamanoRegistro();
+        const int registrosPorBloque = static_cast<int>(bloque.size() / tamano);
+        int disponibles = static_cast<int>(precargados / tamano);
+        const char* datos = bloque.data();
+        std::vector<char> ventana;
+        std::vector<SolicitudLectura> solicitudes;
+        RegistroEnMemoria memoria;
+
+        for (int id = primerId; id < finId;) {
+            const int faltantes = finId - id;
+            if (disponibles == 0 && faltantes <= registrosPorBloque) {
+                disponibles = faltantes;
+                datos = bloque.data();
+                if (!archivo.leerEn(bloque.data(), static_cast<std::size_t>(disponibles) * tamano,
+                                    getRecordOffset(id))) {
+                    return "Error leyendo registro " + std::to_string(id) + " desde archivo";
+                }
+            } else if (disponibles == 0) {
+                const int bloques = std::min<int>(
+                    BLOQUES_EN_VUELO, (faltantes + registrosPorBloque - 1) / registrosPorBloque);
+                ventana.resize(static_cast<std::size_t>(bloques) * bloque.size());
+                solicitudes.clear();
+                for (int b = 0; b < bloques; ++b) {
+                    const int desde = id + b * registrosPorBloque;
+                    const int cantidad = std::min(registrosPorBloque, finId - desde);
+                    solicitudes.push_back(SolicitudLectura{
+                        ventana.data() + static_cast<std::size_t>(b) * bloque.size(),
+                        static_cast<std::size_t>(cantidad) * tamano, getRecordOffset(desde)});
+                    disponibles += cantidad;
+                }
+                datos = ventana.data();
+                if (!archivo.leerLote(solicitudes)) {
+                    return "Error leyendo registros desde " + std::to_string(id) + " en archivo";
+                }
+            }
+
+            const int enMemoria = std::min(disponibles, faltantes);
+            for (int i = 0; i < enMemoria; ++i, ++id) {
+                T registro;
+                const char* actual = datos + static_cast<std::size_t>(i) * tamano;
+                if (!EntityTraits<T>::readFromStream(memoria.leerDesde(actual, tamano), registro)) {
+                    return "Error leyendo registro " + std::to_string(id) + " desde archivo";
+                }
+                if (!visitante(id, registro)) {
+                    return true;
+                }
+            }
+            disponibles = 0;
+        }
+
+        return true;
+    }
+
+    /// Header que debe ver el hilo: el de su instantanea si tiene una activa.
+    HeaderFile headerVisible(const HeaderFile& actual) const
+    {
+        const auto* instantanea = LecturaEnInstantanea::actual();
+        if (instantanea != nullptr) {
+            for (const auto& [secuencia, anterior] : versionesHeader) {
+                if (secuencia > instantanea->obtenerSecuencia()) {
+                    return anterior;
+                }
+            }
+        }
+        return actual;
+    }
+
+    /// Reemplaza `registro` por la imagen que tenia al abrirse la instantanea del hilo.
+    void aplicarVersionVisible(int id, T& registro) const
+    {
+        const auto* instantanea = LecturaEnInstantanea::actual();
+        if (instantanea == nullptr || versionesRegistro.empty()) {
+            return;
+        }
+
+        const auto it = versionesRegistro.find(id);
+        if (it == versionesRegistro.end()) {
+            return;
+        }
+
+        for (const auto& [secuencia, anterior] : it->second) {
+            if (secuencia > instantanea->obtenerSecuencia()) {
+                registro = anterior;
+                return;
+            }
+        }
+    }
+
+    /// Toma la secuencia de una escritura y descarta versiones que ninguna instantanea puede leer.
+    /// Requiere el lock exclusivo del archivo.
+    ControlVersiones::Escritura iniciarEscritura()
+    {
+        const ControlVersiones::Escritura escritura =
+            ControlVersiones::global().registrarEscritura();
+        const std::uint64_t hasta = escritura.descartarHasta;
+
+        std::size_t vencidas = 0;
+        while (vencidas < versionesHeader.size() && versionesHeader[vencidas].first <= hasta) {
+            ++vencidas;
+        }
+        versionesHeader.erase(versionesHeader.begin(),
+                              versionesHeader.begin() + static_cast<std::ptrdiff_t>(vencidas));
+
+        for (auto it = versionesRegistro.begin(); it != versionesRegistro.end();) {
+            auto& versiones = it->second;
+            std::size_t vencidasRegistro = 0;
+            while (vencidasRegistro < versiones.size() &&
+                   versiones[vencidasRegistro].first <= hasta) {
+                ++vencidasRegistro;
+            }
+            versiones.erase(versiones.begin(),
+                            versiones.begin() + static_cast<std::ptrdiff_t>(vencidasRegistro));
+            it = versiones.empty() ? versionesRegistro.erase(it) : std::next(it);
+        }
+
+        return escritura;
+    }
+
+    /// Calcula el offset binario de un registro por ID usando tamano fijo.
+    off_t getRecordOffset(int id) const
+    {
+        return static_cast<off_t>(sizeof(HeaderFile)) +
+               static_cast<off_t>(id - primerIdArchivo) *
+                   static_cast<off_t>(EntityTraits<T>::recordSize());
+    }
+
+    /// Lee un registro activo por ID; el llamador ya tiene tomado el lock del archivo.
+    std::variant<T, std::string> leerSinBloqueo(int id)
+    {
+        if (!archivo.abrir()) {
             return "Error abriendo archivo para lectura: " + filePath.string();
         }
 
-        auto headerResult = readHeader(file);
+        auto headerResult = readHeader();
         if (std::holds_alternative<std::string>(headerResult)) {
             return std::get<std::string>(headerResult);
         }
 
-        const HeaderFile header = std::get<HeaderFile>(headerResult);
-        if (id <= 0 || id >= header.proximoID) {
+        const HeaderFile header = headerVisible(std::get<HeaderFile>(headerResult));
+        if (id < primerIdArchivo || id >= header.proximoID) {
             return "ID fuera de rango o registro no existe";
         }
 
-        file.seekg(getRecordOffset(id), std::ios::beg);
-        if (!file) {
-            return "Error moviendo el puntero de lectura";
-        }
-
         T registro;
-        if (!EntityTraits<T>::readFromStream(file, registro)) {
+        if (!leerRegistro(id, registro)) {
             return "Error leyendo registro desde archivo";
         }
+        aplicarVersionVisible(id, registro);
 
         if (EntityTraits<T>::isDeleted(registro)) {
             return "El registro ha sido eliminado";
@@ -103,107 +334,382 @@ class FSBaseRepository
         return registro;
     }
 
-    std::variant<T, std::string> leerPorNombreTemplate(const std::string& nombreBuscado)
+    /// Sobrescribe un registro existente; el llamador ya tiene el lock exclusivo del archivo.
+    std::variant<bool, std::string> actualizarSinBloqueo(
+        int id, const T& entidad, const ControlVersiones::Escritura& escritura)
     {
-        const std::string nombreNormalizadoBuscado = DomainUtils::normalizeName(nombreBuscado);
-        if (nombreNormalizadoBuscado.empty()) {
-            return "El nombre de búsqueda no puede estar vacío";
+        if (!archivo.abrir()) {
+            return "Error abriendo archivo para escritura";
+        }
+
+        auto headerResult = readHeader();
+        if (std::holds_alternative<std::string>(headerResult)) {
+            return std::get<std::string>(headerResult);
         }
 
-        std::fstream file(filePath, std::ios::in | std::ios::binary);
-        if (!file.is_open()) {
+        const HeaderFile header = std::get<HeaderFile>(headerResult);
+        if (id < primerIdArchivo || id >= header.proximoID) {
+            return "ID fuera de rango o registro no existe";
+        }
+
+        if (escritura.conservarAnterior) {
+            T anterior;
+            if (!leerRegistro(id, anterior)) {
+                return "Error leyendo la version anterior del registro";
+            }
+            versionesRegistro[id].emplace_back(escritura.secuencia, anterior);
+        }
+
+        if (!escribirRegistro(id, entidad)) {
+            return "Error escribiendo registro en archivo";
+        }
+
+        return true;
+    }
+
+    /**
+     * Recorrido para un hilo con instantanea: lee tramos de REGISTROS_POR_TRAMO con los locks
+     * tomados, los suelta y recien entonces llama al visitante, asi un reporte lento no retiene
+     * a los escritores. Cada registro se corrige con su version visible antes de entregarse.
+     */
+    std::variant<bool, std::string> recorrerEnInstantanea(
+        int desdeId, const std::function<bool(const T&)>& visitante)
+    {
+        std::vector<char> bloque = nuevoBloque();
+        std::vector<T> tramo;
+        tramo.reserve(REGISTROS_POR_TRAMO);
+        int proximoVisible = -1;
+        int id = std::max(desdeId, primerIdArchivo);
+
+        while (proximoVisible < 0 || id < proximoVisible) {
+            tramo.clear();
+            {
+                const auto lock = bloquearCompartido(accesoArchivo, contencion);
+                const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::COMPARTIDO, contencion);
+                if (!archivo.abrir()) {
+                    return "Error abriendo archivo para lectura: " + filePath.string();
+                }
+
+                // el header solo hace falta en el primer tramo: fija el rango de la instantanea
+                std::size_t precargados = 0;
+                if (proximoVisible < 0) {
+                    auto headerResult = readHeaderYBloque(id, bloque, precargados);
+                    if (std::holds_alternative<std::string>(headerResult)) {
+                        return std::get<std::string>(headerResult);
+                    }
+                    proximoVisible = headerVisible(std::get<HeaderFile>(headerResult)).proximoID;
+                }
+
+                const int finTramo = std::min(proximoVisible, id + REGISTROS_POR_TRAMO);
+                auto lectura = leerRango(id, finTramo, bloque, precargados,
+                                         [this, &tramo](int idRegistro, T& registro) {
+                                             aplicarVersionVisible(idRegistro, registro);
+                                             if (!EntityTraits<T>::isDeleted(registro)) {
+                                                 tramo.push_back(registro);
+                                             }
+                                             return true;
+                                         });
+                if (std::holds_alternative<std::string>(lectura)) {
+                    return std::get<std::string>(lectura);
+                }
+                id = finTramo;
+            }
+
+            for (const T& registro : tramo) {
+                if (!visitante(registro)) {
+                    return true;
+                }
+            }
+        }
+
+        return true;
+    }
+
+   public:
+    explicit FSBaseRepository(fs::path path, int primerId = 1)
+        : filePath(path), primerIdArchivo(primerId), archivo(std::move(path))
+    {
+    }
+
+    /// Retorna estadisticas del archivo (HeaderFile) para la entidad T.
+    std::variant<HeaderFile, std::string> obtenerEstadisticasTemplate()
+    {
+        const auto lock = bloquearCompartido(accesoArchivo, contencion);
+        const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::COMPARTIDO, contencion);
+        if (!archivo.abrir()) {
+            return "Error abriendo archivo para obtener estadísticas: " + filePath.string();
+        }
+
+        auto headerResult = readHeader();
+        if (std::holds_alternative<std::string>(headerResult)) {
+            return std::get<std::string>(headerResult);
+        }
+
+        return headerVisible(std::get<HeaderFile>(headerResult));
+    }
+
+    /// Lee un registro activo por ID usando acceso aleatorio y EntityTraits<T>.
+    std::variant<T, std::string> leerTemplate(int id)
+    {
+        const auto lock = bloquearCompartido(accesoArchivo, contencion);
+        const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::COMPARTIDO, contencion);
+        return leerSinBloqueo(id);
+    }
+
+    /**
+     * Lee varios registros por ID como un solo lote de lecturas en vuelo (MotorLecturas). Cada
+     * posicion del resultado corresponde al ID pedido en esa posicion y contiene el registro o el
+     * mismo error que daria leerTemplate; el error externo indica que no se pudo leer el archivo.
+     */
+    std::variant<std::vector<std::variant<T, std::string>>, std::string> leerVariosTemplate(
+        const std::vector<int>& ids)
+    {
+        const auto lock = bloquearCompartido(accesoArchivo, contencion);
+        const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::COMPARTIDO, contencion);
+        if (!archivo.abrir()) {
             return "Error abriendo archivo para lectura: " + filePath.string();
         }
 
-        auto headerResult = readHeader(file);
+        auto headerResult = readHeader();
         if (std::holds_alternative<std::string>(headerResult)) {
             return std::get<std::string>(headerResult);
         }
 
-        const HeaderFile header = std::get<HeaderFile>(headerResult);
-        for (int id = 1; id < header.proximoID; ++id) {
-            file.seekg(getRecordOffset(id), std::ios::beg);
-            if (!file) {
-                return "Error moviendo el puntero de lectura";
+        const HeaderFile header = headerVisible(std::get<HeaderFile>(headerResult));
+        const auto enRango = [this, &header](int id) {
+            return id >= primerIdArchivo && id < header.proximoID;
+        };
+        const std::size_t tamano = tamanoRegistro();
+        std::vector<char> bytes(ids.size() * tamano);
+        std::vector<SolicitudLectura> solicitudes;
+        solicitudes.reserve(ids.size());
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (enRango(ids[i])) {
+                solicitudes.push_back(
+                    SolicitudLectura{bytes.data() + i * tamano, tamano, getRecordOffset(ids[i])});
             }
+        }
+        if (!archivo.leerLote(solicitudes)) {
+            return "Error leyendo registros desde archivo";
+        }
 
-            T registro;
-            if (!EntityTraits<T>::readFromStream(file, registro)) {
-                file.clear();
+        std::vector<std::variant<T, std::string>> resultados;
+        resultados.reserve(ids.size());
+        RegistroEnMemoria memoria;
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (!enRango(ids[i])) {
+                resultados.emplace_back("ID fuera de rango o registro no existe");
                 continue;
             }
 
-            if (EntityTraits<T>::isDeleted(registro)) {
+            T registro;
+            std::istream& origen = memoria.leerDesde(bytes.data() + i * tamano, tamano);
+            if (!EntityTraits<T>::readFromStream(origen, registro)) {
+                resultados.emplace_back("Error leyendo registro desde archivo");
                 continue;
             }
+            aplicarVersionVisible(ids[i], registro);
 
-            const char* nombreRegistro = registro.getNombre();
-            const std::string nombreNormalizadoRegistro =
-                DomainUtils::normalizeName(nombreRegistro != nullptr ? nombreRegistro : "");
-            if (nombreNormalizadoRegistro == nombreNormalizadoBuscado) {
-                return registro;
+            if (EntityTraits<T>::isDeleted(registro)) {
+                resultados.emplace_back("El registro ha sido eliminado");
+            } else {
+                resultados.emplace_back(std::move(registro));
             }
         }
 
-        return "No existe registro con el nombre solicitado";
+        return resultados;
     }
 
-    /// Sobrescribe un registro existente por ID usando serializacion deterministica.
-    std::variant<bool, std::string> actualizarTemplate(int id, const T& entidad)
+    /**
+     * Recorre secuencialmente los registros activos leyendo bloques de SCAN_BUFFER_SIZE con
+     * pread; el primer bloque llega junto con el header en una sola lectura. El visitante
+     * retorna false para detener el recorrido antes de llegar al final.
+     */
+    std::variant<bool, std::string> recorrerTemplate(
+        const std::function<bool(const T&)>& visitante)
     {
-        std::fstream file(filePath, std::ios::in | std::ios::out | std::ios::binary);
-        if (!file.is_open()) {
-            return "Error abriendo archivo para escritura";
+        return recorrerDesdeTemplate(1, visitante);
+    }
+
+    /**
+     * Igual que recorrerTemplate pero comienza en el registro `desdeId`, leido por su offset;
+     * permite paginar por ID reanudando desde el ultimo ID entregado + 1.
+     */
+    std::variant<bool, std::string> recorrerDesdeTemplate(
+        int desdeId, const std::function<bool(const T&)>& visitante)
+    {
+        if (LecturaEnInstantanea::actual() != nullptr) {
+            return recorrerEnInstantanea(desdeId, visitante);
+        }
+
+        const auto lock = bloquearCompartido(accesoArchivo, contencion);
+        const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::COMPARTIDO, contencion);
+        if (!archivo.abrir()) {
+            return "Error abriendo archivo para lectura: " + filePath.string();
         }
 
-        auto headerResult = readHeader(file);
+        const int primerId = std::max(desdeId, primerIdArchivo);
+        std::vector<char> bloque = nuevoBloque();
+        std::size_t precargados = 0;
+        auto headerResult = readHeaderYBloque(primerId, bloque, precargados);
         if (std::holds_alternative<std::string>(headerResult)) {
             return std::get<std::string>(headerResult);
         }
 
         const HeaderFile header = std::get<HeaderFile>(headerResult);
-        if (id <= 0 || id >= header.proximoID) {
-            return "ID fuera de rango o registro no existe";
+        return leerRango(primerId, header.proximoID, bloque, precargados,
+                         [&visitante](int, T& registro) {
+                             return EntityTraits<T>::isDeleted(registro) || visitante(registro);
+                         });
+    }
+
+    /**
+     * Recorrido perezoso desde `desdeId`: lee un bloque de registros con los locks tomados, los
+     * suelta y entrega los activos uno a uno. El bloque siguiente se lee recien cuando el
+     * consumidor lo pide, asi que cortar el bucle (o una etapa tomar) deja de leer el archivo.
+     * Cada bloque es consistente por si mismo; para ver un unico momento se abre una
+     * LecturaEnInstantanea en el hilo que consume. Los errores de lectura se lanzan como
+     * std::runtime_error.
+     */
+    Generador<const T&> generarTemplate(int desdeId)
+    {
+        std::vector<char> bloque = nuevoBloque();
+        const int registrosPorBloque = static_cast<int>(bloque.size() / tamanoRegistro());
+        std::vector<T> pendientes;
+        pendientes.reserve(static_cast<std::size_t>(registrosPorBloque));
+        int proximoVisible = -1;
+        int id = std::max(desdeId, primerIdArchivo);
+
+        while (proximoVisible < 0 || id < proximoVisible) {
+            pendientes.clear();
+            {
+                const auto lock = bloquearCompartido(accesoArchivo, contencion);
+                const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::COMPARTIDO, contencion);
+                if (!archivo.abrir()) {
+                    throw std::runtime_error("Error abriendo archivo para lectura: " +
+                                             filePath.string());
+                }
+
+                std::size_t precargados = 0;
+                if (proximoVisible < 0) {
+                    auto headerResult = readHeaderYBloque(id, bloque, precargados);
+                    if (std::holds_alternative<std::string>(headerResult)) {
+                        throw std::runtime_error(std::get<std::string>(headerResult));
+                    }
+                    proximoVisible = headerVisible(std::get<HeaderFile>(headerResult)).proximoID;
+                }
+
+                const int finBloque = std::min(proximoVisible, id + registrosPorBloque);
+                auto lectura = leerRango(id, finBloque, bloque, precargados,
+                                         [this, &pendientes](int idRegistro, T& registro) {
+                                             aplicarVersionVisible(idRegistro, registro);
+                                             if (!EntityTraits<T>::isDeleted(registro)) {
+                                                 pendientes.push_back(registro);
+                                             }
+                                             return true;
+                                         });
+                if (std::holds_alternative<std::string>(lectura)) {
+                    throw std::runtime_error(std::get<std::string>(lectura));
+                }
+                id = finBloque;
+            }
+
+            // los locks ya se soltaron: el consumidor puede escribir en este mismo repositorio
+            for (const T& registro : pendientes) {
+                co_yield registro;
+            }
         }
+    }
 
-        file.seekp(getRecordOffset(id), std::ios::beg);
-        if (!file) {
-            return "Error moviendo el puntero de escritura";
+    std::variant<T, std::string> leerPorNombreTemplate(const std::string& nombreBuscado)
+    {
+        const std::string nombreNormalizadoBuscado = DomainUtils::normalizeName(nombreBuscado);
+        if (nombreNormalizadoBuscado.empty()) {
+            return "El nombre de búsqueda no puede estar vacío";
         }
 
-        if (!EntityTraits<T>::writeToStream(file, entidad)) {
-            return "Error escribiendo registro en archivo";
+        const auto lock = bloquearCompartido(accesoArchivo, contencion);
+        const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::COMPARTIDO, contencion);
+        if (!archivo.abrir()) {
+            return "Error abriendo archivo para lectura: " + filePath.string();
         }
 
-        return true;
+        std::vector<char> bloque = nuevoBloque();
+        std::size_t precargados = 0;
+        auto headerResult = readHeaderYBloque(primerIdArchivo, bloque, precargados);
+        if (std::holds_alternative<std::string>(headerResult)) {
+            return std::get<std::string>(headerResult);
+        }
+
+        const HeaderFile header = headerVisible(std::get<HeaderFile>(headerResult));
+        std::optional<T> encontrado;
+        auto lectura = leerRango(
+            primerIdArchivo, header.proximoID, bloque, precargados, [&](int id, T& registro) {
+                aplicarVersionVisible(id, registro);
+                if (EntityTraits<T>::isDeleted(registro)) {
+                    return true;
+                }
+
+                const char* nombreRegistro = registro.getNombre();
+                const std::string nombreNormalizadoRegistro =
+                    DomainUtils::normalizeName(nombreRegistro != nullptr ? nombreRegistro : "");
+                if (nombreNormalizadoRegistro == nombreNormalizadoBuscado) {
+                    encontrado = registro;
+                    return false;
+                }
+                return true;
+            });
+        if (std::holds_alternative<std::string>(lectura)) {
+            return std::get<std::string>(lectura);
+        }
+
+        if (encontrado.has_value()) {
+            return *encontrado;
+        }
+
+        return "No existe registro con el nombre solicitado";
+    }
+
+    /// Sobrescribe un registro existente por ID usando serializacion deterministica.
+    std::variant<bool, std::string> actualizarTemplate(int id, const T& entidad)
+    {
+        const auto lock = bloquearExclusivo(accesoArchivo, contencion);
+        const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::EXCLUSIVO, contencion);
+        if (!bloqueo.activo()) {
+            return errorSinBloqueo();
+        }
+        return actualizarSinBloqueo(id, entidad, iniciarEscritura());
     }
 
     /// Guarda un nuevo registro al final logico del archivo y actualiza el header.
     std::variant<bool, std::string> guardarTemplate(const T& entidad)
     {
-        std::fstream file(filePath, std::ios::in | std::ios::out | std::ios::binary);
-        if (!file.is_open()) {
+        const auto lock = bloquearExclusivo(accesoArchivo, contencion);
+        const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::EXCLUSIVO, contencion);
+        if (!bloqueo.activo()) {
+            return errorSinBloqueo();
+        }
+        if (!archivo.abrir()) {
             return "Error abriendo archivo para guardar";
         }
 
-        auto headerResult = readHeader(file);
+        auto headerResult = readHeader();
         if (std::holds_alternative<std::string>(headerResult)) {
             return std::get<std::string>(headerResult);
         }
 
         HeaderFile header = std::get<HeaderFile>(headerResult);
+        const ControlVersiones::Escritura escritura = iniciarEscritura();
+        if (escritura.conservarAnterior) {
+            versionesHeader.emplace_back(escritura.secuencia, header);
+        }
         const int nuevoId = header.proximoID;
         const int entidadId = EntityTraits<T>::getId(entidad);
         if (entidadId != nuevoId) {
             return "El ID de la entidad no coincide con proximoID";
         }
 
-        file.seekp(getRecordOffset(nuevoId), std::ios::beg);
-        if (!file) {
-            return "Error moviendo el puntero de escritura";
-        }
-
-        if (!EntityTraits<T>::writeToStream(file, entidad)) {
+        if (!escribirRegistro(nuevoId, entidad)) {
             return "Error escribiendo registro en archivo";
         }
 
@@ -211,7 +717,70 @@ class FSBaseRepository
         header.registrosActivos += 1;
         header.proximoID += 1;
 
-        auto headerWriteResult = writeHeader(file, header);
+        auto headerWriteResult = writeHeader(header);
+        if (std::holds_alternative<std::string>(headerWriteResult)) {
+            return std::get<std::string>(headerWriteResult);
+        }
+
+        return true;
+    }
+
+    /**
+     * Agrega varios registros nuevos serializandolos en un buffer que se escribe con un solo
+     * pwrite, seguido de una unica actualizacion del header. Los IDs deben ser consecutivos desde
+     * proximoID; el header solo se escribe si todos los registros se escribieron completos.
+     */
+    std::variant<bool, std::string> guardarLoteTemplate(const std::vector<T>& entidades)
+    {
+        if (entidades.empty()) {
+            return true;
+        }
+
+        const auto lock = bloquearExclusivo(accesoArchivo, contencion);
+        const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::EXCLUSIVO, contencion);
+        if (!bloqueo.activo()) {
+            return errorSinBloqueo();
+        }
+        if (!archivo.abrir()) {
+            return "Error abriendo archivo para guardar";
+        }
+
+        auto headerResult = readHeader();
+        if (std::holds_alternative<std::string>(headerResult)) {
+            return std::get<std::string>(headerResult);
+        }
+
+        HeaderFile header = std::get<HeaderFile>(headerResult);
+        const ControlVersiones::Escritura escritura = iniciarEscritura();
+        if (escritura.conservarAnterior) {
+            versionesHeader.emplace_back(escritura.secuencia, header);
+        }
+        for (std::size_t i = 0; i < entidades.size(); ++i) {
+            if (EntityTraits<T>::getId(entidades[i]) != header.proximoID + static_cast<int>(i)) {
+                return "Los IDs del lote deben ser consecutivos desde proximoID";
+            }
+        }
+
+        const std::size_t tamano = tamanoRegistro();
+        std::vector<char> bytes(entidades.size() * tamano);
+        RegistroEnMemoria memoria;
+        for (std::size_t i = 0; i < entidades.size(); ++i) {
+            std::ostream& destino = memoria.escribirEn(bytes.data() + i * tamano, tamano);
+            if (!EntityTraits<T>::writeToStream(destino, entidades[i])) {
+                return "Error escribiendo registro en archivo";
+            }
+        }
+
+        if (!archivo.escribirEn(bytes.data(), bytes.size(), getRecordOffset(header.proximoID))) {
+            return "Error escribiendo el lote en archivo";
+        }
+
+        const int cantidad = static_cast<int>(entidades.size());
+        header.cantidadRegistros += cantidad;
+        header.registrosActivos += cantidad;
+        header.proximoID += cantidad;
+
+        auto headerWriteResult = writeHeader(header);
         if (std::holds_alternative<std::string>(headerWriteResult)) {
             return std::get<std::string>(headerWriteResult);
         }
@@ -222,7 +791,13 @@ class FSBaseRepository
     /// Marca un registro como eliminado y decrementa registros activos en header.
     std::variant<bool, std::string> eliminarLogicamenteTemplate(int id)
     {
-        auto result = leerTemplate(id);
+        const auto lock = bloquearExclusivo(accesoArchivo, contencion);
+        const BloqueoArchivo bloqueo(filePath, BloqueoArchivo::EXCLUSIVO, contencion);
+        if (!bloqueo.activo()) {
+            return errorSinBloqueo();
+        }
+        const ControlVersiones::Escritura escritura = iniciarEscritura();
+        auto result = leerSinBloqueo(id);
         if (std::holds_alternative<std::string>(result)) {
             return std::get<std::string>(result);
         }
@@ -230,31 +805,40 @@ class FSBaseRepository
         T registro = std::get<T>(result);
         EntityTraits<T>::setDeleted(registro, true);
 
-        auto updateResult = actualizarTemplate(id, registro);
+        auto updateResult = actualizarSinBloqueo(id, registro, escritura);
         if (std::holds_alternative<std::string>(updateResult)) {
             return std::get<std::string>(updateResult);
         }
 
-        std::fstream file(filePath, std::ios::in | std::ios::out | std::ios::binary);
-        if (!file.is_open()) {
-            return "Registro eliminado, pero no se pudo abrir archivo para actualizar header";
-        }
-
-        auto headerResult = readHeader(file);
+        auto headerResult = readHeader();
         if (std::holds_alternative<std::string>(headerResult)) {
             return std::get<std::string>(headerResult);
         }
 
         HeaderFile header = std::get<HeaderFile>(headerResult);
+        if (escritura.conservarAnterior) {
+            versionesHeader.emplace_back(escritura.secuencia, header);
+        }
         if (header.registrosActivos > 0) {
             header.registrosActivos -= 1;
         }
 
-        auto headerWriteResult = writeHeader(file, header);
+        auto headerWriteResult = writeHeader(header);
         if (std::holds_alternative<std::string>(headerWriteResult)) {
             return std::get<std::string>(headerWriteResult);
         }
 
         return true;
     }
+
+    /**
+     * Toma los latches de los registros indicados hasta que se destruya la guardia. Protege una
+     * secuencia leerTemplate + actualizarTemplate de otros hilos que modifiquen los mismos IDs.
+     */
+    LatchesRegistro::Guardia bloquearRegistrosTemplate(const std::vector<int>& ids)
+    {
+        return latches.bloquear(ids, contencion);
+    }
+
+    EstadisticasContencion obtenerContencionTemplate() const { return contencion.instantanea(); }
 };
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <variant>
+
+#include "domain/HeaderFile.hpp"
+#include "domain/constants.hpp"
+#include "infrastructure/datasource/EntityTraits.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Migra un archivo .bin de la entidad T al layout binario actual.
+ *
+ * Lee cada registro con el layout de la version guardada en el header, lo reescribe con el
+ * layout actual en un archivo temporal y lo reemplaza con rename. El archivo original se
+ * conserva como `<archivo>.v<version>.bak` para poder revertir manualmente.
+ */
+template <typename T>
+class FSFormatMigrator
+{
+   private:
+    fs::path filePath;
+
+   public:
+    explicit FSFormatMigrator(fs::path path) : filePath(std::move(path)) {}
+
+    /// Retorna true si el archivo ya estaba o quedo en la version actual.
+    std::variant<bool, std::string> migrarAVersionActual()
+    {
+        constexpr int versionActual = Constants::BINARY_FORMAT::VERSION_ACTUAL;
+
+        std::ifstream origen(filePath, std::ios::binary);
+        if (!origen.is_open()) {
+            return "No se pudo abrir para migrar: " + filePath.string();
+        }
+
+        HeaderFile header = {};
+        origen.read(reinterpret_cast<char*>(&header), sizeof(HeaderFile));
+        if (!origen) {
+            return "No se pudo leer el encabezado para migrar: " + filePath.string();
+        }
+
+        if (header.version == versionActual) {
+            return true;
+        }
+
+        if (header.version > versionActual || header.version < 1) {
+            return "Version de formato no soportada (" + std::to_string(header.version) +
+                   "): " + filePath.string();
+        }
+
+        const int versionOrigen = header.version;
+        const fs::path tmpPath = fs::path(filePath).concat(".migrando");
+        std::ofstream destino(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!destino.is_open()) {
+            return "No se pudo crear archivo temporal de migracion: " + tmpPath.string();
+        }
+
+        header.version = versionActual;
+        destino.write(reinterpret_cast<const char*>(&header), sizeof(HeaderFile));
+
+        // se recorren todos los slots asignados, incluidos los eliminados logicamente
+        for (int id = 1; id < header.proximoID; ++id) {
+            origen.seekg(static_cast<std::streamoff>(sizeof(HeaderFile)) +
+                             static_cast<std::streamoff>(id - 1) *
+                                 EntityTraits<T>::recordSize(versionOrigen),
+                         std::ios::beg);
+
+            T registro;
+            if (!EntityTraits<T>::readFromStream(origen, registro, versionOrigen)) {
+                destino.close();
+                fs::remove(tmpPath);
+                return "Registro " + std::to_string(id) + " ilegible durante la migracion de " +
+                       filePath.string();
+            }
+
+            if (!EntityTraits<T>::writeToStream(destino, registro)) {
+                destino.close();
+                fs::remove(tmpPath);
+                return "Error escribiendo registro migrado en " + tmpPath.string();
+            }
+        }
+
+        destino.flush();
+        if (!destino) {
+            return "Error finalizando archivo migrado: " + tmpPath.string();
+        }
+        destino.close();
+        origen.close();
+
+        std::error_code ec;
+        const fs::path backupPath =
+            fs::path(filePath).concat(".v" + std::to_string(versionOrigen) + ".bak");
+        fs::copy_file(filePath, backupPath, fs::copy_options::skip_existing, ec);
+        if (ec) {
+            fs::remove(tmpPath);
+            return "No se pudo respaldar el archivo legado: " + ec.message();
+        }
+
+        fs::rename(tmpPath, filePath, ec);
+        if (ec) {
+            return "No se pudo reemplazar el archivo migrado: " + ec.message();
+        }
+
+        return true;
+    }
+};
@@ -0,0 +1,455 @@
+#include "MotorLecturas.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <linux/io_uring.h>
+#include <memory>
+#include <mutex>
+#include <poll.h>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+/// Lecturas en vuelo por anillo de io_uring.
+constexpr unsigned PROFUNDIDAD_COLA = 64;
+/// Hilos del pool de E/S; pasan casi todo el tiempo bloqueados en pread, no en CPU.
+constexpr unsigned HILOS_E_S = 8;
+
+/// Completa una solicitud con pread, reintentando lecturas parciales.
+bool leerCompleto(int descriptor, SolicitudLectura solicitud)
+{
+    char* cursor = static_cast<char*>(solicitud.destino);
+    while (solicitud.bytes > 0) {
+        const ssize_t leidos = ::pread(descriptor, cursor, solicitud.bytes, solicitud.offset);
+        if (leidos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (leidos == 0) {
+            return false;
+        }
+
+        cursor += leidos;
+        solicitud.bytes -= static_cast<std::size_t>(leidos);
+        solicitud.offset += leidos;
+    }
+    return true;
+}
+
+class MotorSincrono : public MotorLecturas
+{
+   public:
+    bool leerTodas(int descriptor, std::vector<SolicitudLectura>& solicitudes) override
+    {
+        for (const SolicitudLectura& solicitud : solicitudes) {
+            if (!leerCompleto(descriptor, solicitud)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const char* nombre() const override { return "sincrono"; }
+};
+
+/// Reparte las solicitudes de cada lote entre hilos que hacen pread en paralelo.
+class MotorPoolHilos : public MotorLecturas
+{
+   private:
+    struct Lote {
+        std::size_t pendientes{0};
+        bool fallo{false};
+        std::condition_variable terminado;
+    };
+
+    struct Tarea {
+        Lote* lote;
+        int descriptor;
+        SolicitudLectura solicitud;
+    };
+
+    std::mutex mutex;
+    std::condition_variable hayTrabajo;
+    std::deque<Tarea> cola;
+    std::vector<std::thread> hilos;
+    bool detener{false};
+
+    void trabajar()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            hayTrabajo.wait(lock, [this] { return detener || !cola.empty(); });
+            if (cola.empty()) {
+                return;
+            }
+
+            const Tarea tarea = cola.front();
+            cola.pop_front();
+            lock.unlock();
+            const bool leida = leerCompleto(tarea.descriptor, tarea.solicitud);
+            lock.lock();
+
+            if (!leida) {
+                tarea.lote->fallo = true;
+            }
+            if (--tarea.lote->pendientes == 0) {
+                tarea.lote->terminado.notify_all();
+            }
+        }
+    }
+
+   public:
+    explicit MotorPoolHilos(unsigned cantidadHilos)
+    {
+        hilos.reserve(cantidadHilos);
+        for (unsigned i = 0; i < cantidadHilos; ++i) {
+            hilos.emplace_back([this] { trabajar(); });
+        }
+    }
+
+    ~MotorPoolHilos() override
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            detener = true;
+        }
+        hayTrabajo.notify_all();
+        for (std::thread& hilo : hilos) {
+            hilo.join();
+        }
+    }
+
+    bool leerTodas(int descriptor, std::vector<SolicitudLectura>& solicitudes) override
+    {
+        if (solicitudes.size() <= 1) {
+            return solicitudes.empty() || leerCompleto(descriptor, solicitudes.front());
+        }
+
+        Lote lote;
+        lote.pendientes = solicitudes.size();
+        std::unique_lock<std::mutex> lock(mutex);
+        for (const SolicitudLectura& solicitud : solicitudes) {
+            cola.push_back(Tarea{&lote, descriptor, solicitud});
+        }
+        hayTrabajo.notify_all();
+        lote.terminado.wait(lock, [&lote] { return lote.pendientes == 0; });
+        return !lote.fallo;
+    }
+
+    const char* nombre() const override { return "hilos"; }
+};
+
+MotorPoolHilos& poolHilos()
+{
+    static MotorPoolHilos pool(HILOS_E_S);
+    return pool;
+}
+
+int ioUringSetup(unsigned entradas, io_uring_params* parametros)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entradas, parametros));
+}
+
+int ioUringEnter(int fd, unsigned aEnviar, unsigned minimoCompletadas, unsigned flags)
+{
+    return static_cast<int>(
+        ::syscall(__NR_io_uring_enter, fd, aEnviar, minimoCompletadas, flags, nullptr, 0));
+}
+
+/// Resultado de un lote en el anillo; con INUTILIZABLE el lote se repite en otro motor.
+enum class ResultadoAnillo { LEIDAS, FALLO, INUTILIZABLE };
+
+/**
+ * Anillo de io_uring manejado con syscalls directas (sin liburing). Lo usa un solo hilo a la
+ * vez, por eso no necesita locks: solo barreras al publicar la cola de envio y consumir la de
+ * completadas, que comparte con el kernel.
+ */
+class AnilloIoUring
+{
+   private:
+    int fd{-1};
+    unsigned entradas{0};
+    void* mapaEnvio{nullptr};
+    std::size_t tamanoEnvio{0};
+    void* mapaCompletadas{nullptr};
+    std::size_t tamanoCompletadas{0};
+    io_uring_sqe* sqes{nullptr};
+    std::size_t tamanoSqes{0};
+
+    unsigned* sqHead{nullptr};
+    unsigned* sqTail{nullptr};
+    unsigned sqMask{0};
+    unsigned* sqArray{nullptr};
+    unsigned* cqHead{nullptr};
+    unsigned* cqTail{nullptr};
+    unsigned cqMask{0};
+    io_uring_cqe* cqes{nullptr};
+
+    static void* mapear(int fd, std::size_t tamano, off_t offset)
+    {
+        void* mapa = ::mmap(nullptr, tamano, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                            offset);
+        return mapa == MAP_FAILED ? nullptr : mapa;
+    }
+
+   public:
+    AnilloIoUring() = default;
+    AnilloIoUring(const AnilloIoUring&) = delete;
+    AnilloIoUring& operator=(const AnilloIoUring&) = delete;
+
+    ~AnilloIoUring()
+    {
+        if (sqes != nullptr) {
+            ::munmap(sqes, tamanoSqes);
+        }
+        if (mapaCompletadas != nullptr && mapaCompletadas != mapaEnvio) {
+            ::munmap(mapaCompletadas, tamanoCompletadas);
+        }
+        if (mapaEnvio != nullptr) {
+            ::munmap(mapaEnvio, tamanoEnvio);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    /// false si el kernel no soporta io_uring o lo tiene deshabilitado.
+    bool iniciar(unsigned profundidad)
+    {
+        io_uring_params parametros;
+        std::memset(&parametros, 0, sizeof(parametros));
+        fd = ioUringSetup(profundidad, &parametros);
+        if (fd < 0) {
+            return false;
+        }
+
+        entradas = parametros.sq_entries;
+        tamanoEnvio = parametros.sq_off.array + parametros.sq_entries * sizeof(unsigned);
+        tamanoCompletadas = parametros.cq_off.cqes + parametros.cq_entries * sizeof(io_uring_cqe);
+        const bool mapaUnico = (parametros.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (mapaUnico) {
+            tamanoEnvio = std::max(tamanoEnvio, tamanoCompletadas);
+            tamanoCompletadas = tamanoEnvio;
+        }
+
+        mapaEnvio = mapear(fd, tamanoEnvio, IORING_OFF_SQ_RING);
+        if (mapaEnvio == nullptr) {
+            return false;
+        }
+        mapaCompletadas =
+            mapaUnico ? mapaEnvio : mapear(fd, tamanoCompletadas, IORING_OFF_CQ_RING);
+        if (mapaCompletadas == nullptr) {
+            return false;
+        }
+        tamanoSqes = parametros.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(mapear(fd, tamanoSqes, IORING_OFF_SQES));
+        if (sqes == nullptr) {
+            return false;
+        }
+
+        char* envio = static_cast<char*>(mapaEnvio);
+        sqHead = reinterpret_cast<unsigned*>(envio + parametros.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(envio + parametros.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(envio + parametros.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(envio + parametros.sq_off.array);
+
+        char* completadas = static_cast<char*>(mapaCompletadas);
+        cqHead = reinterpret_cast<unsigned*>(completadas + parametros.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(completadas + parametros.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(completadas + parametros.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(completadas + parametros.cq_off.cqes);
+        return true;
+    }
+
+    /**
+     * Mantiene hasta `entradas` lecturas en vuelo. Las lecturas parciales y las interrumpidas se
+     * reenvian por lo que falta; ante un error se dejan de enviar nuevas pero se espera a las
+     * que ya estan en vuelo, porque el kernel todavia escribe en sus buffers. Si io_uring_enter
+     * falla, tambien se esperan y el anillo queda INUTILIZABLE: los envios que el kernel no tomo
+     * se descartan con el anillo.
+     */
+    ResultadoAnillo leerTodas(int descriptor, std::vector<SolicitudLectura>& solicitudes)
+    {
+        const std::size_t total = solicitudes.size();
+        std::vector<iovec> restantes(total);
+        std::vector<off_t> offsets(total);
+        std::vector<std::size_t> porPreparar;
+        porPreparar.reserve(total);
+        for (std::size_t i = 0; i < total; ++i) {
+            restantes[i] = iovec{solicitudes[i].destino, solicitudes[i].bytes};
+            offsets[i] = solicitudes[i].offset;
+            porPreparar.push_back(total - 1 - i);
+        }
+
+        unsigned enVuelo = 0;
+        unsigned porEnviar = 0;
+        bool fallo = false;
+        // consume las completadas; con `descartar` solo cuenta las que ya no estan en vuelo
+        const auto consumirCompletadas = [&](bool descartar) {
+            unsigned cabeza = *cqHead;
+            const unsigned fin = std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire);
+            for (; cabeza != fin; ++cabeza) {
+                const io_uring_cqe& cqe = cqes[cabeza & cqMask];
+                const auto i = static_cast<std::size_t>(cqe.user_data);
+                const int resultado = cqe.res;
+                --enVuelo;
+
+                if (descartar) {
+                    continue;
+                }
+                if (resultado == -EINTR || resultado == -EAGAIN) {
+                    porPreparar.push_back(i);
+                    continue;
+                }
+                if (resultado <= 0) {
+                    fallo = true;
+                    continue;
+                }
+
+                restantes[i].iov_base = static_cast<char*>(restantes[i].iov_base) + resultado;
+                restantes[i].iov_len -= static_cast<std::size_t>(resultado);
+                offsets[i] += resultado;
+                if (restantes[i].iov_len > 0) {
+                    porPreparar.push_back(i);
+                }
+            }
+            std::atomic_ref<unsigned>(*cqHead).store(cabeza, std::memory_order_release);
+        };
+
+        while (enVuelo + porEnviar > 0 || (!fallo && !porPreparar.empty())) {
+            unsigned cola = *sqTail;
+            while (!fallo && !porPreparar.empty() && enVuelo + porEnviar < entradas) {
+                const std::size_t i = porPreparar.back();
+                porPreparar.pop_back();
+
+                const unsigned indice = cola & sqMask;
+                io_uring_sqe& sqe = sqes[indice];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = IORING_OP_READV;
+                sqe.fd = descriptor;
+                sqe.addr = reinterpret_cast<std::uint64_t>(&restantes[i]);
+                sqe.len = 1;
+                sqe.off = static_cast<std::uint64_t>(offsets[i]);
+                sqe.user_data = i;
+                sqArray[indice] = indice;
+                ++cola;
+                ++porEnviar;
+            }
+            std::atomic_ref<unsigned>(*sqTail).store(cola, std::memory_order_release);
+
+            const unsigned cabezaEnvio =
+                std::atomic_ref<unsigned>(*sqHead).load(std::memory_order_acquire);
+            const int enviadas = ioUringEnter(fd, porEnviar, 1, IORING_ENTER_GETEVENTS);
+            if (enviadas < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                    continue;
+                }
+                // en vuelo quedan tambien las que el kernel haya tomado de la cola antes del error
+                enVuelo += std::atomic_ref<unsigned>(*sqHead).load(std::memory_order_acquire) -
+                           cabezaEnvio;
+                esperarEnVuelo(enVuelo, consumirCompletadas);
+                return ResultadoAnillo::INUTILIZABLE;
+            }
+            porEnviar -= static_cast<unsigned>(enviadas);
+            enVuelo += static_cast<unsigned>(enviadas);
+            consumirCompletadas(false);
+        }
+
+        return fallo ? ResultadoAnillo::FALLO : ResultadoAnillo::LEIDAS;
+    }
+
+   private:
+    /// Bloquea hasta que no quede ninguna lectura en vuelo, aunque io_uring_enter siga fallando.
+    template <typename Consumir>
+    void esperarEnVuelo(unsigned& enVuelo, const Consumir& consumirCompletadas)
+    {
+        consumirCompletadas(true);
+        while (enVuelo > 0) {
+            if (ioUringEnter(fd, 0, 1, IORING_ENTER_GETEVENTS) < 0) {
+                // el fd del anillo queda legible cuando hay completadas
+                pollfd espera{fd, POLLIN, 0};
+                ::poll(&espera, 1, -1);
+            }
+            consumirCompletadas(true);
+        }
+    }
+};
+
+/// Un anillo por hilo, creado en su primer lote; si no se puede crear o deja de funcionar se usa
+/// el pool de hilos.
+class MotorIoUring : public MotorLecturas
+{
+   public:
+    bool leerTodas(int descriptor, std::vector<SolicitudLectura>& solicitudes) override
+    {
+        if (solicitudes.size() <= 1) {
+            return solicitudes.empty() || leerCompleto(descriptor, solicitudes.front());
+        }
+
+        thread_local std::unique_ptr<AnilloIoUring> anillo;
+        thread_local bool sinAnillo = false;
+        if (anillo == nullptr && !sinAnillo) {
+            auto nuevo = std::make_unique<AnilloIoUring>();
+            if (nuevo->iniciar(PROFUNDIDAD_COLA)) {
+                anillo = std::move(nuevo);
+            } else {
+                sinAnillo = true;
+            }
+        }
+
+        if (anillo != nullptr) {
+            const ResultadoAnillo resultado = anillo->leerTodas(descriptor, solicitudes);
+            if (resultado != ResultadoAnillo::INUTILIZABLE) {
+                return resultado == ResultadoAnillo::LEIDAS;
+            }
+            // sin lecturas en vuelo ya se puede cerrar; el lote se repite completo en el pool
+            anillo.reset();
+            sinAnillo = true;
+        }
+        return poolHilos().leerTodas(descriptor, solicitudes);
+    }
+
+    const char* nombre() const override { return "io_uring"; }
+};
+
+MotorLecturas& elegirMotor()
+{
+    const char* variable = std::getenv("PAPAYA_IO");
+    const std::string_view pedido = variable != nullptr ? variable : "";
+
+    if (pedido == "sincrono") {
+        static MotorSincrono sincrono;
+        return sincrono;
+    }
+
+    if (pedido != "hilos") {
+        AnilloIoUring prueba;
+        if (prueba.iniciar(PROFUNDIDAD_COLA)) {
+            static MotorIoUring ioUring;
+            return ioUring;
+        }
+    }
+
+    return poolHilos();
+}
+
+}  // namespace
+
+MotorLecturas& MotorLecturas::global()
+{
+    static MotorLecturas& motor = elegirMotor();
+    return motor;
+}
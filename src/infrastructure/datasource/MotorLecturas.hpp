@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <sys/types.h>
+#include <vector>
+
+/// Una lectura posicional de un lote: `bytes` desde `offset` hacia `destino`.
+struct SolicitudLectura {
+    void* destino{nullptr};
+    std::size_t bytes{0};
+    off_t offset{0};
+};
+
+/**
+ * @brief - Ejecuta lotes de lecturas posicionales con varias lecturas en vuelo a la vez.
+ *
+ * Los recorridos grandes y las busquedas por lotes de FSBaseRepository envian todas sus lecturas
+ * juntas en lugar de esperar una por una, lo que permite al disco atenderlas en paralelo cuando
+ * los datos no estan en cache. El motor del proceso se elige al primer uso:
+ * - io_uring (syscalls directas, un anillo por hilo) si el kernel lo permite;
+ * - si no, un pool de hilos de E/S que hace pread en paralelo.
+ * La variable de entorno PAPAYA_IO=uring|hilos|sincrono fuerza un motor; `sincrono` lee una
+ * solicitud tras otra y sirve de referencia para comparar.
+ */
+class MotorLecturas
+{
+   public:
+    virtual ~MotorLecturas() = default;
+
+    /**
+     * Lee todas las solicitudes desde `descriptor` y retorna cuando terminaron. Retorna false si
+     * alguna fallo o encontro el fin del archivo antes de completar sus bytes.
+     */
+    virtual bool leerTodas(int descriptor, std::vector<SolicitudLectura>& solicitudes) = 0;
+
+    virtual const char* nombre() const = 0;
+
+    static MotorLecturas& global();
+};
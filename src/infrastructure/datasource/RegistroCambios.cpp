@@ -0,0 +1,252 @@
+#include "RegistroCambios.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char FIRMA[8] = {'P', 'A', 'P', 'C', 'A', 'M', 'B', '1'};
+
+struct EncabezadoMapa {
+    char firma[8];
+    std::uint64_t generacion;
+    std::uint64_t inodo;
+};
+
+bool escribirTodo(int fd, const void* datos, std::size_t bytes, off_t offset)
+{
+    const char* cursor = static_cast<const char*>(datos);
+    while (bytes > 0) {
+        const ssize_t escritos = ::pwrite(fd, cursor, bytes, offset);
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        cursor += escritos;
+        bytes -= static_cast<std::size_t>(escritos);
+        offset += escritos;
+    }
+    return true;
+}
+
+/**
+ * Contador de `cambios.epoca` en `directorio`, mapeado una vez por proceso. nullptr si no se pudo
+ * crear o mapear; quien lo usa vuelve entonces a mirar el mapa en cada escritura.
+ */
+std::uint64_t* mapearEpoca(const fs::path& directorio)
+{
+    static std::mutex mutexEpocas;
+    static std::map<fs::path, std::uint64_t*> epocas;
+    const std::lock_guard<std::mutex> lock(mutexEpocas);
+    const fs::path ruta = directorio / "cambios.epoca";
+    auto it = epocas.find(ruta);
+    if (it != epocas.end()) {
+        return it->second;
+    }
+
+    const int fd = ::open(ruta.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info = {};
+    void* mapa = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 &&
+        (info.st_size >= static_cast<off_t>(sizeof(std::uint64_t)) ||
+         ::ftruncate(fd, sizeof(std::uint64_t)) == 0)) {
+        mapa = ::mmap(nullptr, sizeof(std::uint64_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mapa == MAP_FAILED) {
+        return nullptr;
+    }
+    return epocas.emplace(ruta, static_cast<std::uint64_t*>(mapa)).first->second;
+}
+
+std::uint64_t leerEpoca(const std::uint64_t* epoca)
+{
+    return std::atomic_ref<const std::uint64_t>(*epoca).load(std::memory_order_acquire);
+}
+
+}  // namespace
+
+RegistroCambios::RegistroCambios(const fs::path& archivoDatos) : ruta(rutaMapa(archivoDatos)) {}
+
+RegistroCambios::~RegistroCambios()
+{
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+}
+
+fs::path RegistroCambios::rutaMapa(const fs::path& archivoDatos)
+{
+    fs::path mapa = archivoDatos;
+    mapa += ".cambios";
+    return mapa;
+}
+
+void RegistroCambios::actualizarVista(std::uint64_t epocaActual) const
+{
+    if (abierto && epocaActual == epocaVista) {
+        return;
+    }
+
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+    descriptor = ::open(ruta.c_str(), O_RDWR | O_CLOEXEC);
+    marcados.clear();
+    epocaVista = epocaActual;
+    // sin epoca compartida no se puede saber si el mapa cambio: se vuelve a mirar cada vez
+    abierto = epoca != nullptr;
+}
+
+bool RegistroCambios::yaMarcados(std::size_t primero, std::size_t ultimo) const
+{
+    return ultimo < marcados.size() &&
+           std::all_of(marcados.begin() + static_cast<std::ptrdiff_t>(primero),
+                       marcados.begin() + static_cast<std::ptrdiff_t>(ultimo) + 1,
+                       [](char marcado) { return marcado != 0; });
+}
+
+void RegistroCambios::marcar(off_t offset, std::size_t bytes) const
+{
+    if (bytes == 0 || offset < 0) {
+        return;
+    }
+
+    const std::size_t primero = static_cast<std::size_t>(offset) / TAMANO_BLOQUE;
+    const std::size_t ultimo = (static_cast<std::size_t>(offset) + bytes - 1) / TAMANO_BLOQUE;
+    {
+        // caso comun: nada cambio desde la ultima escritura y no hay mapa o ya estan marcados
+        const std::shared_lock<std::shared_mutex> lock(mutexDescriptor);
+        if (abierto && leerEpoca(epoca) == epocaVista &&
+            (descriptor < 0 || yaMarcados(primero, ultimo))) {
+            return;
+        }
+    }
+
+    const std::unique_lock<std::shared_mutex> lock(mutexDescriptor);
+    if (epoca == nullptr) {
+        epoca = mapearEpoca(ruta.parent_path());
+    }
+    actualizarVista(epoca != nullptr ? leerEpoca(epoca) : 0);
+    if (descriptor < 0 || yaMarcados(primero, ultimo)) {
+        return;
+    }
+
+    const std::vector<char> marcas(ultimo - primero + 1, 1);
+    if (!escribirTodo(descriptor, marcas.data(), marcas.size(),
+                      static_cast<off_t>(sizeof(EncabezadoMapa) + primero))) {
+        // un cambio sin marca haria incompleto el proximo incremental: se invalida el mapa
+        const std::uint64_t sinGeneracion = 0;
+        escribirTodo(descriptor, &sinGeneracion, sizeof(sinGeneracion),
+                     static_cast<off_t>(offsetof(EncabezadoMapa, generacion)));
+        return;
+    }
+    if (marcados.size() <= ultimo) {
+        marcados.resize(ultimo + 1, 0);
+    }
+    std::fill(marcados.begin() + static_cast<std::ptrdiff_t>(primero),
+              marcados.begin() + static_cast<std::ptrdiff_t>(ultimo) + 1, 1);
+}
+
+bool RegistroCambios::leer(const fs::path& archivoDatos, Estado& outEstado)
+{
+    outEstado = Estado{};
+    struct stat datos = {};
+    if (::stat(archivoDatos.c_str(), &datos) != 0) {
+        return false;
+    }
+
+    const fs::path mapa = rutaMapa(archivoDatos);
+    const int fd = ::open(mapa.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    std::vector<char> contenido;
+    char buffer[1 << 14];
+    while (true) {
+        const ssize_t leidos = ::read(fd, buffer, sizeof(buffer));
+        if (leidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (leidos <= 0) {
+            ::close(fd);
+            if (leidos < 0) {
+                return false;
+            }
+            break;
+        }
+        contenido.insert(contenido.end(), buffer, buffer + leidos);
+    }
+
+    EncabezadoMapa encabezado = {};
+    if (contenido.size() < sizeof(encabezado)) {
+        return false;
+    }
+    std::memcpy(&encabezado, contenido.data(), sizeof(encabezado));
+    if (std::memcmp(encabezado.firma, FIRMA, sizeof(FIRMA)) != 0 || encabezado.generacion == 0 ||
+        encabezado.inodo != static_cast<std::uint64_t>(datos.st_ino)) {
+        return false;
+    }
+
+    outEstado.generacion = encabezado.generacion;
+    for (std::size_t i = sizeof(encabezado); i < contenido.size(); ++i) {
+        if (contenido[i] != 0) {
+            outEstado.bloques.push_back(i - sizeof(encabezado));
+        }
+    }
+    return true;
+}
+
+bool RegistroCambios::reiniciar(const fs::path& archivoDatos, std::uint64_t generacion,
+                                std::string& outError)
+{
+    struct stat datos = {};
+    if (::stat(archivoDatos.c_str(), &datos) != 0) {
+        outError = "No se pudo leer " + archivoDatos.string() + ": " + std::strerror(errno);
+        return false;
+    }
+
+    const fs::path mapa = rutaMapa(archivoDatos);
+    const int fd = ::open(mapa.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        outError = "No se pudo abrir " + mapa.string() + ": " + std::strerror(errno);
+        return false;
+    }
+
+    EncabezadoMapa encabezado = {};
+    std::memcpy(encabezado.firma, FIRMA, sizeof(FIRMA));
+    encabezado.generacion = generacion;
+    encabezado.inodo = static_cast<std::uint64_t>(datos.st_ino);
+    const bool ok = ::ftruncate(fd, sizeof(encabezado)) == 0 &&
+                    escribirTodo(fd, &encabezado, sizeof(encabezado), 0);
+    if (!ok) {
+        outError = "No se pudo reiniciar " + mapa.string() + ": " + std::strerror(errno);
+    }
+    ::close(fd);
+
+    // los procesos que recordaban bloques marcados (o que el mapa no existia) lo vuelven a abrir
+    std::uint64_t* epoca = mapearEpoca(archivoDatos.parent_path());
+    if (epoca == nullptr) {
+        if (ok) {
+            outError = "No se pudo abrir la epoca de cambios de " + archivoDatos.string();
+        }
+        return false;
+    }
+    std::atomic_ref<std::uint64_t>(*epoca).fetch_add(1, std::memory_order_acq_rel);
+    return ok;
+}
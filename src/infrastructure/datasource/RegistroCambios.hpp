@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <shared_mutex>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Bloques de un archivo de datos modificados desde el ultimo backup.
+ *
+ * Se guarda junto al archivo en `<archivo>.cambios`: un encabezado con la generacion del ultimo
+ * backup y el inodo del archivo de datos, seguido de un byte por bloque de TAMANO_BLOQUE bytes
+ * (distinto de cero = modificado). ArchivoPosicional marca cada escritura antes de hacerla. Toda
+ * escritura de datos ocurre con el flock exclusivo del archivo, asi que un backup que lee y
+ * reinicia el mapa con el flock compartido ve todos los cambios, tambien los de otros procesos.
+ *
+ * El mapa solo existe a partir del primer backup (es el backup quien lo crea). Si falta, si su
+ * generacion no es la del backup anterior o si el archivo de datos fue reemplazado (otro inodo,
+ * p. ej. tras una migracion de formato), el archivo se respalda completo.
+ *
+ * Cada proceso recuerda si el mapa existe y que bloques ya marco, y solo vuelve a mirar el
+ * archivo cuando cambia la epoca de su directorio: un contador en `cambios.epoca`, mapeado en
+ * memoria, que reiniciar incrementa. Asi una escritura no hace syscalls extra salvo la primera
+ * vez que toca un bloque despues de cada backup.
+ */
+class RegistroCambios
+{
+   public:
+    static constexpr std::size_t TAMANO_BLOQUE = 4096;
+
+    struct Estado {
+        std::uint64_t generacion{0};
+        /// Indices de bloque modificados, en orden creciente.
+        std::vector<std::size_t> bloques;
+    };
+
+   private:
+    fs::path ruta;
+    /// Compartido para ver si los bloques ya estan marcados, exclusivo para marcar o reabrir.
+    mutable std::shared_mutex mutexDescriptor;
+    mutable int descriptor{-1};
+    /// Epoca del directorio (memoria compartida entre procesos) y la vista al abrir el mapa.
+    mutable const std::uint64_t* epoca{nullptr};
+    mutable std::uint64_t epocaVista{0};
+    mutable bool abierto{false};
+    /// Bloques ya marcados en esta epoca (un byte por bloque, como el mapa).
+    mutable std::vector<char> marcados;
+
+    /// Vuelve a abrir el mapa (o registra que no existe) si la epoca cambio desde la ultima vez.
+    void actualizarVista(std::uint64_t epocaActual) const;
+    bool yaMarcados(std::size_t primero, std::size_t ultimo) const;
+
+   public:
+    explicit RegistroCambios(const fs::path& archivoDatos);
+    ~RegistroCambios();
+
+    RegistroCambios(const RegistroCambios&) = delete;
+    RegistroCambios& operator=(const RegistroCambios&) = delete;
+
+    static fs::path rutaMapa(const fs::path& archivoDatos);
+
+    /**
+     * Marca como modificados los bloques que toca [offset, offset + bytes). Sin mapa no hace
+     * nada; si no se puede escribir la marca invalida el mapa para forzar un backup completo.
+     */
+    void marcar(off_t offset, std::size_t bytes) const;
+
+    /// Lee el mapa de `archivoDatos`; false si no hay seguimiento valido para ese archivo.
+    static bool leer(const fs::path& archivoDatos, Estado& outEstado);
+
+    /**
+     * Deja el mapa vacio para la generacion `generacion`, creandolo si no existe. Se reinicia en
+     * el mismo archivo (sin reemplazarlo) para que los descriptores abiertos sigan validos, y se
+     * incrementa la epoca para que los procesos olviden los bloques que ya habian marcado.
+     */
+    static bool reiniciar(const fs::path& archivoDatos, std::uint64_t generacion,
+                          std::string& outError);
+};
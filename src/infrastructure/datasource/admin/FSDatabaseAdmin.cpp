@@ -1,32 +1,127 @@
 #include "FSDatabaseAdmin.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 
 #include "domain/HeaderFile.hpp"
+#include "domain/Money.hpp"
 #include "domain/constants.hpp"
 #include "domain/entities/producto/producto.entity.hpp"
 #include "domain/entities/tienda/tienda.entity.hpp"
 #include "domain/entities/transaccion/transaccion.entity.hpp"
+#include "domain/utils/EjecutorTareas.hpp"
+#include "domain/utils/Generador.hpp"
+#include "domain/utils/HashJoin.hpp"
+#include "domain/utils/TopN.hpp"
+#include "domain/utils/Versiones.hpp"
+#include "infrastructure/datasource/BloqueoArchivo.hpp"
 #include "infrastructure/datasource/EntityTraits.hpp"
+#include "infrastructure/datasource/backup/GestorBackups.hpp"
 
 namespace fs = std::filesystem;
 using namespace Constants::ASCII_CODES;
 using namespace Constants::PATHS;
 using namespace std::chrono;
 
+namespace {
+
+/// Gate de operaciones: el shared_mutex de ControlVersiones dentro del proceso y el flock
+/// compartido de COMMITS_LOCK_PATH entre procesos, tomados en ese orden igual que en los backups.
+class OperacionFS : public OperacionEnCurso
+{
+   private:
+    std::shared_lock<std::shared_mutex> enProceso;
+    BloqueoArchivo entreProcesos;
+
+   public:
+    OperacionFS()
+        : enProceso(ControlVersiones::global().iniciarOperacion()),
+          entreProcesos(COMMITS_LOCK_PATH, BloqueoArchivo::COMPARTIDO)
+    {
+    }
+};
+
+/// Proyeccion id -> nombre de las entidades activas de un repositorio, en una sola pasada.
+template <typename T, typename Repositorio>
+std::variant<HashJoin<int, std::string>, std::string> proyectarNombres(Repositorio& repositorio)
+{
+    auto headerResult = repositorio.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(headerResult)) {
+        return std::get<std::string>(headerResult);
+    }
+
+    HashJoin<int, std::string> nombres(
+        static_cast<std::size_t>(std::get<HeaderFile>(headerResult).registrosActivos));
+    auto scanResult = repositorio.recorrer([&](const T& entidad) {
+        nombres.construir(entidad.getId(), entidad.getNombre());
+        return true;
+    });
+
+    if (std::holds_alternative<std::string>(scanResult)) {
+        return std::get<std::string>(scanResult);
+    }
+
+    return nombres;
+}
+
+/// Registros activos de [desde, hasta) como generador: deja de leer al pasar `hasta`.
+template <typename Repositorio>
+auto generarTramo(Repositorio& repositorio, int desde, int hasta)
+{
+    return repositorio.generar(desde) |
+           tomarMientras([hasta](const auto& registro) { return registro.getId() < hasta; });
+}
+
+/// Completa nombres de proveedor y ordena las filas por monto descendente (empate: ID menor).
+std::vector<ResumenProveedor> ordenarResumenProveedores(
+    std::unordered_map<int, ResumenProveedor>& agregado, IProveedorRepository& proveedores)
+{
+    auto nombresResult = proyectarNombres<Proveedor>(proveedores);
+    if (std::holds_alternative<std::string>(nombresResult)) {
+        throw std::runtime_error(std::get<std::string>(nombresResult));
+    }
+    const auto& nombres = std::get<HashJoin<int, std::string>>(nombresResult);
+
+    std::vector<ResumenProveedor> filas;
+    filas.reserve(agregado.size());
+    for (auto& [idProveedor, fila] : agregado) {
+        const std::string* nombre = nombres.sondear(idProveedor);
+        fila.idProveedor = idProveedor;
+        fila.nombre = nombre ? *nombre : "(Sin proveedor valido)";
+        filas.push_back(std::move(fila));
+    }
+
+    std::sort(filas.begin(), filas.end(), [](const ResumenProveedor& a, const ResumenProveedor& b) {
+        if (a.monto != b.monto) {
+            return a.monto > b.monto;
+        }
+        return a.idProveedor < b.idProveedor;
+    });
+    return filas;
+}
+
+}  // namespace
+
 FSDatabaseAdmin::FSDatabaseAdmin(IProductoRepository& productos, IClienteRepository& clientes,
                                  IProveedorRepository& proveedores,
-                                 ITransaccionRepository& transacciones)
+                                 ITransaccionRepository& transacciones,
+                                 IRollupRepository& rollups)
     : productos(productos),
       clientes(clientes),
       proveedores(proveedores),
-      transacciones(transacciones)
+      transacciones(transacciones),
+      rollups(rollups)
 {
 }
 
@@ -94,35 +189,52 @@ std::variant<bool, std::string> FSDatabaseAdmin::guardarRegistroTienda(const Tie
     return true;
 }
 
-void FSDatabaseAdmin::crearBackup()
+ResumenBackup FSDatabaseAdmin::crearBackup(bool completo, FormatoBackup formato)
 {
-    fs::create_directories(BACKUP_PATH);
+    return GestorBackups(BACKUP_PATH).crear(completo, formato);
+}
 
-    const fs::path paths[5] = {PRODUCTOS_PATH, PROVEEDORES_PATH, CLIENTES_PATH, TRANSACCIONES_PATH,
-                               TIENDA_PATH};
+ResumenBackup FSDatabaseAdmin::extraerBackup(const std::string& id, const std::string& destino)
+{
+    return GestorBackups(BACKUP_PATH).extraer(id, destino);
+}
 
-    const auto now = system_clock::now();
-    const auto currentDate = time_point_cast<days>(now);
-    const year_month_day ymd{currentDate};
-    const auto nowSec = time_point_cast<seconds>(now);
-    const zoned_time localTime{current_zone(), nowSec};
+void FSDatabaseAdmin::reconstruirRollups()
+{
+    auto result = rollups.reconstruir(transacciones);
+    if (std::holds_alternative<std::string>(result)) {
+        throw std::runtime_error(
+            "Datos restaurados, pero no se pudieron reconstruir los rollups: " +
+            std::get<std::string>(result));
+    }
+}
 
-    for (const fs::path& path : paths) {
-        if (!fs::exists(path)) {
-            continue;
-        }
+ResumenBackup FSDatabaseAdmin::restaurarBackup(const std::string& id)
+{
+    return GestorBackups(BACKUP_PATH).restaurar(id, RESTAURACION_PATH,
+                                                [this]() { reconstruirRollups(); });
+}
 
-        const std::string baseName = path.stem().string();
-        const fs::path backupName =
-            fs::path(std::format("{}.{:%Y-%m-%d}.{:%T}.bin", baseName, ymd, localTime));
-        const fs::path backupPath = BACKUP_PATH / backupName;
+ResumenRetencion FSDatabaseAdmin::aplicarRetencion(const PoliticaRetencion& politica)
+{
+    return GestorBackups(BACKUP_PATH).aplicarRetencion(politica);
+}
 
-        fs::copy_file(path, backupPath, fs::copy_options::overwrite_existing);
-    }
+bool FSDatabaseAdmin::completarRestauracionPendiente()
+{
+    return GestorBackups::completarPendiente(RESTAURACION_PATH,
+                                             [this]() { reconstruirRollups(); });
+}
+
+std::unique_ptr<OperacionEnCurso> FSDatabaseAdmin::iniciarOperacion()
+{
+    return std::make_unique<OperacionFS>();
 }
 
 std::tuple<int, int, int, int> FSDatabaseAdmin::verificarIntegridadReferencial()
 {
+    const auto instantanea = ControlVersiones::global().abrir();
+    const LecturaEnInstantanea lectura(instantanea);
     int erroresProductosProveedor = 0, erroresTransaccionRelacionado = 0,
         erroresTransaccionProducto = 0, erroresTipoTransaccion = 0;
 
@@ -131,21 +243,22 @@ std::tuple<int, int, int, int> FSDatabaseAdmin::verificarIntegridadReferencial()
         throw std::runtime_error(std::get<std::string>(productosHeader));
     }
 
+    // cada tramo cuenta en su propia posicion y se suman al final
     const HeaderFile productosStats = std::get<HeaderFile>(productosHeader);
-    for (int id = 1; id < productosStats.proximoID; ++id) {
-        auto productoResult = productos.leerPorId(id);
-        if (!std::holds_alternative<Producto>(productoResult)) {
-            continue;
-        }
-
-        const Producto& producto = std::get<Producto>(productoResult);
-        const int proveedorId = producto.getIdProveedor();
-        if (proveedorId > 0) {
-            auto proveedorResult = proveedores.leerPorId(proveedorId);
-            if (std::holds_alternative<std::string>(proveedorResult)) {
-                ++erroresProductosProveedor;
+    std::vector<int> productosSinProveedor(tramosDeRecorrido(productosStats), 0);
+    recorrerEnParalelo<Producto>(
+        "integridad productos", productos, productosStats.proximoID,
+        [&](std::size_t tramo, const Producto& producto) {
+            const int proveedorId = producto.getIdProveedor();
+            if (proveedorId > 0) {
+                auto proveedorResult = proveedores.leerPorId(proveedorId);
+                if (std::holds_alternative<std::string>(proveedorResult)) {
+                    ++productosSinProveedor[tramo];
+                }
             }
-        }
+        });
+    for (const int errores : productosSinProveedor) {
+        erroresProductosProveedor += errores;
     }
 
     auto transactionsHeader = this->transacciones.obtenerEstadisticas();
@@ -153,46 +266,54 @@ std::tuple<int, int, int, int> FSDatabaseAdmin::verificarIntegridadReferencial()
         throw std::runtime_error(std::get<std::string>(transactionsHeader));
     }
 
+    struct ErroresTransacciones {
+        int relacionado{0};
+        int producto{0};
+        int tipo{0};
+    };
     const HeaderFile transaccionesStats = std::get<HeaderFile>(transactionsHeader);
-    for (int id = 1; id < transaccionesStats.proximoID; ++id) {
-        auto transaccionResult = transacciones.leerPorId(id);
-        if (!std::holds_alternative<Transaccion>(transaccionResult)) {
-            continue;
-        }
-
-        const Transaccion& transaccion = std::get<Transaccion>(transaccionResult);
-        const auto tipo = transaccion.getTipoTransaccion();
-        if (tipo != COMPRA && tipo != VENTA) {
-            ++erroresTipoTransaccion;
-            continue;
-        }
-
-        const int relacionadoId = transaccion.getIdRelacionado();
-        if (tipo == COMPRA) {
-            auto proveedorResult = proveedores.leerPorId(relacionadoId);
-            if (std::holds_alternative<std::string>(proveedorResult)) {
-                ++erroresTransaccionRelacionado;
+    std::vector<ErroresTransacciones> erroresPorTramo(tramosDeRecorrido(transaccionesStats));
+    recorrerEnParalelo<Transaccion>(
+        "integridad transacciones", transacciones, transaccionesStats.proximoID,
+        [&](std::size_t tramo, const Transaccion& transaccion) {
+            ErroresTransacciones& errores = erroresPorTramo[tramo];
+            const auto tipo = transaccion.getTipoTransaccion();
+            if (tipo != COMPRA && tipo != VENTA) {
+                ++errores.tipo;
+                return;
             }
-        } else {
-            auto clienteResult = clientes.leerPorId(relacionadoId);
-            if (std::holds_alternative<std::string>(clienteResult)) {
-                ++erroresTransaccionRelacionado;
-            }
-        }
 
-        const int productosTotales = transaccion.getProductosTotales();
-        for (int i = 0; i < productosTotales; ++i) {
-            TransaccionDTO productoTransaccion = {};
-            if (!transaccion.getProductoEnIndice(i, productoTransaccion)) {
-                ++erroresTransaccionProducto;
-                continue;
+            const int relacionadoId = transaccion.getIdRelacionado();
+            if (tipo == COMPRA) {
+                auto proveedorResult = proveedores.leerPorId(relacionadoId);
+                if (std::holds_alternative<std::string>(proveedorResult)) {
+                    ++errores.relacionado;
+                }
+            } else {
+                auto clienteResult = clientes.leerPorId(relacionadoId);
+                if (std::holds_alternative<std::string>(clienteResult)) {
+                    ++errores.relacionado;
+                }
             }
 
-            auto productoResult = productos.leerPorId(productoTransaccion.productoId);
-            if (std::holds_alternative<std::string>(productoResult)) {
-                ++erroresTransaccionProducto;
+            const int productosTotales = transaccion.getProductosTotales();
+            for (int i = 0; i < productosTotales; ++i) {
+                TransaccionDTO productoTransaccion = {};
+                if (!transaccion.getProductoEnIndice(i, productoTransaccion)) {
+                    ++errores.producto;
+                    continue;
+                }
+
+                auto productoResult = productos.leerPorId(productoTransaccion.productoId);
+                if (std::holds_alternative<std::string>(productoResult)) {
+                    ++errores.producto;
+                }
             }
-        }
+        });
+    for (const ErroresTransacciones& errores : erroresPorTramo) {
+        erroresTransaccionRelacionado += errores.relacionado;
+        erroresTransaccionProducto += errores.producto;
+        erroresTipoTransaccion += errores.tipo;
     }
 
     return {erroresProductosProveedor, erroresTransaccionRelacionado, erroresTransaccionProducto,
@@ -201,32 +322,36 @@ std::tuple<int, int, int, int> FSDatabaseAdmin::verificarIntegridadReferencial()
 
 int FSDatabaseAdmin::reporteStockCritico()
 {
+    const auto instantanea = ControlVersiones::global().abrir();
+    const LecturaEnInstantanea lectura(instantanea);
     const auto productosHeader = this->productos.obtenerEstadisticas();
     if (std::get_if<std::string>(&productosHeader)) {
         throw std::runtime_error(std::get<std::string>(productosHeader));
     }
 
-    int totalCriticos = 0;
-
     const HeaderFile productosStats = std::get<HeaderFile>(productosHeader);
-    for (int id = 1; id < productosStats.proximoID; ++id) {
-        auto productoResult = productos.leerPorId(id);
-        if (!std::holds_alternative<Producto>(productoResult)) {
-            continue;
-        }
-
-        const Producto& producto = std::get<Producto>(productoResult);
-
-        if (producto.getStock() <= producto.getStockMinimo()) {
-            totalCriticos++;
-        }
+    std::vector<std::size_t> criticosPorTramo(tramosDeRecorrido(productosStats), 0);
+    const auto esCritico = [](const Producto& producto) {
+        return producto.getStock() <= producto.getStockMinimo();
+    };
+    EjecutorTareas::global().paraCadaTramo(
+        "stock critico", 1, productosStats.proximoID,
+        [&](std::size_t tramo, int desde, int hasta) {
+            criticosPorTramo[tramo] =
+                generarTramo(productos, desde, hasta) | filtrar(esCritico) | contar();
+        });
+
+    std::size_t totalCriticos = 0;
+    for (const std::size_t criticos : criticosPorTramo) {
+        totalCriticos += criticos;
     }
-
-    return totalCriticos;
+    return static_cast<int>(totalCriticos);
 }
 
 void FSDatabaseAdmin::reporteHistorialCliente(int idCliente)
 {
+    const auto instantanea = ControlVersiones::global().abrir();
+    const LecturaEnInstantanea lectura(instantanea);
     auto clienteResult = clientes.leerPorId(idCliente);
     if (std::holds_alternative<std::string>(clienteResult)) {
         std::cout << "No se pudo generar historial del cliente: "
@@ -236,6 +361,15 @@ void FSDatabaseAdmin::reporteHistorialCliente(int idCliente)
 
     const Cliente& cliente = std::get<Cliente>(clienteResult);
 
+    // lado de construccion: nombres de productos; se sondea con los items de cada venta
+    auto nombresResult = proyectarNombres<Producto>(productos);
+    if (std::holds_alternative<std::string>(nombresResult)) {
+        std::cout << "No se pudo leer productos: " << std::get<std::string>(nombresResult)
+                  << std::endl;
+        return;
+    }
+    const auto& nombresProductos = std::get<HashJoin<int, std::string>>(nombresResult);
+
     std::cout << COLOR_CYAN << "========================================" << COLOR_RESET << std::endl;
     std::cout << COLOR_CYAN << "      REPORTE: HISTORIAL DE CLIENTE    " << COLOR_RESET << std::endl;
     std::cout << COLOR_CYAN << "========================================" << COLOR_RESET << std::endl;
@@ -245,39 +379,21 @@ void FSDatabaseAdmin::reporteHistorialCliente(int idCliente)
               << COLOR_RESET << std::endl;
     std::cout << std::format("{}Cedula: {}{}", COLOR_YELLOW, COLOR_GREEN, cliente.getCedula())
               << COLOR_RESET << std::endl;
-    std::cout << std::format("{}Total compras acumuladas: {}${:.2f}", COLOR_YELLOW, COLOR_GREEN,
-                             cliente.getTotalCompras())
+    std::cout << std::format("{}Total compras acumuladas: {}${}", COLOR_YELLOW, COLOR_GREEN,
+                             cliente.getTotalCompras().toString())
               << COLOR_RESET << std::endl;
 
-    auto transaccionesHeader = transacciones.obtenerEstadisticas();
-    if (std::holds_alternative<std::string>(transaccionesHeader)) {
-        std::cout << "No se pudo leer transacciones: " << std::get<std::string>(transaccionesHeader)
-                  << std::endl;
-        return;
-    }
-
-    const HeaderFile transStats = std::get<HeaderFile>(transaccionesHeader);
-    int transaccionesMostradas = 0;
-
-    for (int idTransaccion = 1; idTransaccion < transStats.proximoID; ++idTransaccion) {
-        auto transaccionResult = transacciones.leerPorId(idTransaccion);
-        if (!std::holds_alternative<Transaccion>(transaccionResult)) {
-            continue;
-        }
-
-        const Transaccion& transaccion = std::get<Transaccion>(transaccionResult);
-        if (transaccion.getTipoTransaccion() != VENTA ||
-            transaccion.getIdRelacionado() != cliente.getId()) {
-            continue;
-        }
-
-        ++transaccionesMostradas;
+    const auto esVentaDelCliente = [&cliente](const Transaccion& transaccion) {
+        return transaccion.getTipoTransaccion() == VENTA &&
+               transaccion.getIdRelacionado() == cliente.getId();
+    };
+    const auto imprimirVenta = [&](const Transaccion& transaccion) {
         std::cout << "\n" << COLOR_YELLOW << "Transaccion #" << COLOR_GREEN << transaccion.getId()
                   << COLOR_RESET << std::endl;
         std::cout << std::format("{}Tipo: {}VENTA", COLOR_YELLOW, COLOR_GREEN) << COLOR_RESET
                   << std::endl;
-        std::cout << std::format("{}Total: {}${:.2f}", COLOR_YELLOW, COLOR_GREEN,
-                                 transaccion.getTotal())
+        std::cout << std::format("{}Total: {}${}", COLOR_YELLOW, COLOR_GREEN,
+                                 transaccion.getTotal().toString())
                   << COLOR_RESET << std::endl;
         std::cout << std::format("{}Descripcion: {}{}", COLOR_YELLOW, COLOR_GREEN,
                                  transaccion.getDescripcion())
@@ -298,18 +414,24 @@ void FSDatabaseAdmin::reporteHistorialCliente(int idCliente)
                 continue;
             }
 
-            std::string nombreProducto = "(No encontrado)";
-            auto productoResult = productos.leerPorId(item.productoId);
-            if (std::holds_alternative<Producto>(productoResult)) {
-                nombreProducto = std::get<Producto>(productoResult).getNombre();
-            }
-
-            const float subtotal = static_cast<float>(item.cantidad) * item.precio;
-            std::cout << std::format("{:<10} | {:<24} | {:<10} | ${:<11.2f} | ${:<11.2f}",
-                                     item.productoId, nombreProducto, item.cantidad, item.precio,
-                                     subtotal)
+            const std::string* nombreProducto = nombresProductos.sondear(item.productoId);
+            const Money subtotal = item.precio * item.cantidad;
+            std::cout << std::format("{:<10} | {:<24} | {:<10} | ${:<11} | ${:<11}",
+                                     item.productoId,
+                                     nombreProducto ? *nombreProducto : "(No encontrado)",
+                                     item.cantidad, item.precio.toString(), subtotal.toString())
                       << std::endl;
         }
+    };
+
+    // cada venta se imprime apenas se lee; no se arma la lista de transacciones del cliente
+    std::size_t transaccionesMostradas = 0;
+    try {
+        transaccionesMostradas =
+            transacciones.generar() | filtrar(esVentaDelCliente) | paraCada(imprimirVenta);
+    } catch (const std::exception& e) {
+        std::cout << "No se pudo leer transacciones: " << e.what() << std::endl;
+        return;
     }
 
     if (transaccionesMostradas == 0) {
@@ -322,8 +444,119 @@ void FSDatabaseAdmin::reporteHistorialCliente(int idCliente)
               << std::endl;
 }
 
+void FSDatabaseAdmin::reporteHistorialProducto(int idProducto)
+{
+    const auto instantanea = ControlVersiones::global().abrir();
+    const LecturaEnInstantanea lectura(instantanea);
+    auto productoResult = productos.leerPorId(idProducto);
+    if (std::holds_alternative<std::string>(productoResult)) {
+        std::cout << "No se pudo generar historial del producto: "
+                  << std::get<std::string>(productoResult) << std::endl;
+        return;
+    }
+
+    const Producto& producto = std::get<Producto>(productoResult);
+
+    // contrapartes de cada movimiento: clientes para ventas, proveedores para compras
+    auto clientesResult = proyectarNombres<Cliente>(clientes);
+    if (std::holds_alternative<std::string>(clientesResult)) {
+        std::cout << "No se pudo leer clientes: " << std::get<std::string>(clientesResult)
+                  << std::endl;
+        return;
+    }
+    auto proveedoresResult = proyectarNombres<Proveedor>(proveedores);
+    if (std::holds_alternative<std::string>(proveedoresResult)) {
+        std::cout << "No se pudo leer proveedores: " << std::get<std::string>(proveedoresResult)
+                  << std::endl;
+        return;
+    }
+    const auto& nombresClientes = std::get<HashJoin<int, std::string>>(clientesResult);
+    const auto& nombresProveedores = std::get<HashJoin<int, std::string>>(proveedoresResult);
+
+    std::cout << COLOR_CYAN << "========================================" << COLOR_RESET << std::endl;
+    std::cout << COLOR_CYAN << "      REPORTE: HISTORIAL DE PRODUCTO   " << COLOR_RESET << std::endl;
+    std::cout << COLOR_CYAN << "========================================" << COLOR_RESET << std::endl;
+    std::cout << std::format("{}ID Producto: {}{}", COLOR_YELLOW, COLOR_GREEN, producto.getId())
+              << COLOR_RESET << std::endl;
+    std::cout << std::format("{}Nombre: {}{}", COLOR_YELLOW, COLOR_GREEN, producto.getNombre())
+              << COLOR_RESET << std::endl;
+    std::cout << std::format("{}Codigo: {}{}", COLOR_YELLOW, COLOR_GREEN, producto.getCodigo())
+              << COLOR_RESET << std::endl;
+    std::cout << std::format("{}Stock actual: {}{}", COLOR_YELLOW, COLOR_GREEN,
+                             producto.getStock())
+              << COLOR_RESET << std::endl;
+
+    std::cout << "\n"
+              << std::format("{:<8} | {:<8} | {:<10} | {:<24} | {:<10} | {:<12} | {:<12}",
+                             "Trans ID", "Tipo", "Fecha", "Contraparte", "Cantidad", "Precio U.",
+                             "Subtotal")
+              << std::endl;
+    std::cout << "------------------------------------------------------------------------------"
+                 "-------------------"
+              << std::endl;
+
+    int movimientos = 0;
+    std::int64_t unidadesCompradas = 0;
+    std::int64_t unidadesVendidas = 0;
+    auto scanResult = transacciones.recorrer([&](const Transaccion& transaccion) {
+        const bool esVenta = transaccion.getTipoTransaccion() == VENTA;
+        const std::string* contraparte =
+            esVenta ? nombresClientes.sondear(transaccion.getIdRelacionado())
+                    : nombresProveedores.sondear(transaccion.getIdRelacionado());
+        const year_month_day fecha{floor<days>(transaccion.getFechaCreacion())};
+
+        for (int i = 0; i < transaccion.getProductosTotales(); ++i) {
+            TransaccionDTO item = {};
+            if (!transaccion.getProductoEnIndice(i, item) || item.productoId != idProducto) {
+                continue;
+            }
+
+            ++movimientos;
+            if (esVenta) {
+                unidadesVendidas += item.cantidad;
+            } else {
+                unidadesCompradas += item.cantidad;
+            }
+            const Money subtotal = item.precio * item.cantidad;
+            std::cout << std::format(
+                             "{:<8} | {:<8} | {:04}-{:02}-{:02} | {:<24} | {:<10} | ${:<11} | "
+                             "${:<11}",
+                             transaccion.getId(), esVenta ? "VENTA" : "COMPRA",
+                             static_cast<int>(fecha.year()),
+                             static_cast<unsigned>(fecha.month()),
+                             static_cast<unsigned>(fecha.day()),
+                             contraparte ? *contraparte : "(No encontrado)", item.cantidad,
+                             item.precio.toString(), subtotal.toString())
+                      << std::endl;
+        }
+        return true;
+    });
+
+    if (std::holds_alternative<std::string>(scanResult)) {
+        std::cout << "No se pudo leer transacciones: " << std::get<std::string>(scanResult)
+                  << std::endl;
+        return;
+    }
+
+    if (movimientos == 0) {
+        std::cout << COLOR_GREEN << "Este producto no tiene movimientos asociados." << COLOR_RESET
+                  << std::endl;
+        return;
+    }
+
+    std::cout << "\n"
+              << std::format("Movimientos: {} | Unidades compradas: {} | Unidades vendidas: {}",
+                             movimientos, unidadesCompradas, unidadesVendidas)
+              << std::endl;
+}
+
 bool FSDatabaseAdmin::sincronizarContadoresTienda()
 {
+    const std::lock_guard<std::mutex> lock(mutexTienda);
+    const BloqueoArchivo bloqueo(TIENDA_PATH, BloqueoArchivo::EXCLUSIVO);
+    if (!bloqueo.activo()) {
+        throw std::runtime_error("No se pudo bloquear " + TIENDA_PATH.string());
+    }
     const auto productosHeader = this->productos.obtenerEstadisticas();
     const auto proveedoresHeader = this->proveedores.obtenerEstadisticas();
     const auto clientesHeader = this->clientes.obtenerEstadisticas();
@@ -342,8 +575,9 @@ bool FSDatabaseAdmin::sincronizarContadoresTienda()
 
     HeaderFile tiendaHeader = std::get<HeaderFile>(headerResult);
     Tienda tienda;
-    float montoTotalVentas = 0.0f;
-    float montoTotalCompras = 0.0f;
+    // suma entera en centavos: exacta e independiente del orden de acumulacion
+    Money montoTotalVentas;
+    Money montoTotalCompras;
 
     if (tiendaHeader.cantidadRegistros > 0) {
         auto tiendaResult = leerRegistroTienda();
@@ -366,18 +600,20 @@ bool FSDatabaseAdmin::sincronizarContadoresTienda()
     tienda.setTotalTransaccionesActivas(std::get<HeaderFile>(transaccionesHeader).registrosActivos);
 
     const HeaderFile transStats = std::get<HeaderFile>(transaccionesHeader);
-    for (int id = 1; id < transStats.proximoID; ++id) {
-        auto transaccionResult = transacciones.leerPorId(id);
-        if (!std::holds_alternative<Transaccion>(transaccionResult)) {
-            continue;
-        }
-
-        const Transaccion& transaccion = std::get<Transaccion>(transaccionResult);
-        if (transaccion.getTipoTransaccion() == VENTA) {
-            montoTotalVentas += transaccion.getTotal();
-        } else if (transaccion.getTipoTransaccion() == COMPRA) {
-            montoTotalCompras += transaccion.getTotal();
-        }
+    std::vector<std::pair<Money, Money>> montosPorTramo(tramosDeRecorrido(transStats));
+    recorrerEnParalelo<Transaccion>(
+        "sincronizar tienda", transacciones, transStats.proximoID,
+        [&](std::size_t tramo, const Transaccion& transaccion) {
+            auto& [ventas, compras] = montosPorTramo[tramo];
+            if (transaccion.getTipoTransaccion() == VENTA) {
+                ventas += transaccion.getTotal();
+            } else if (transaccion.getTipoTransaccion() == COMPRA) {
+                compras += transaccion.getTotal();
+            }
+        });
+    for (const auto& [ventas, compras] : montosPorTramo) {
+        montoTotalVentas += ventas;
+        montoTotalCompras += compras;
     }
 
     tienda.setMontoTotalVentas(montoTotalVentas);
@@ -391,3 +627,194 @@ bool FSDatabaseAdmin::sincronizarContadoresTienda()
 
     return true;
 }
+
+std::vector<Producto> FSDatabaseAdmin::reporteTopProductosVendidos(int limite, int idProveedor)
+{
+    const auto instantanea = ControlVersiones::global().abrir();
+    const LecturaEnInstantanea lectura(instantanea);
+    if (limite <= 0) {
+        throw std::invalid_argument("El limite del reporte debe ser mayor a 0");
+    }
+
+    // empates: se prioriza el ID menor para que el resultado sea deterministico
+    auto masVendido = [](const Producto& a, const Producto& b) {
+        if (a.getTotalVendido() != b.getTotalVendido()) {
+            return a.getTotalVendido() > b.getTotalVendido();
+        }
+        return a.getId() < b.getId();
+    };
+
+    auto productosHeader = productos.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(productosHeader)) {
+        throw std::runtime_error(std::get<std::string>(productosHeader));
+    }
+
+    // un top por tramo; el top global sale de ofrecer los candidatos de cada tramo
+    const HeaderFile productosStats = std::get<HeaderFile>(productosHeader);
+    using TopProductos = TopN<Producto, decltype(masVendido)>;
+    const TopProductos topVacio(static_cast<std::size_t>(limite), masVendido);
+    std::vector<TopProductos> topPorTramo(tramosDeRecorrido(productosStats), topVacio);
+    recorrerEnParalelo<Producto>("top productos", productos, productosStats.proximoID,
+                                 [&](std::size_t tramo, const Producto& producto) {
+                                     if (idProveedor <= 0 ||
+                                         producto.getIdProveedor() == idProveedor) {
+                                         topPorTramo[tramo].ofrecer(producto);
+                                     }
+                                 });
+
+    TopProductos top = topVacio;
+    for (TopProductos& parcial : topPorTramo) {
+        for (const Producto& producto : parcial.extraerOrdenado()) {
+            top.ofrecer(producto);
+        }
+    }
+    return top.extraerOrdenado();
+}
+
+std::vector<Cliente> FSDatabaseAdmin::reporteTopClientes(int limite)
+{
+    const auto instantanea = ControlVersiones::global().abrir();
+    const LecturaEnInstantanea lectura(instantanea);
+    if (limite <= 0) {
+        throw std::invalid_argument("El limite del reporte debe ser mayor a 0");
+    }
+
+    auto mayorCompra = [](const Cliente& a, const Cliente& b) {
+        if (a.getTotalCompras() != b.getTotalCompras()) {
+            return a.getTotalCompras() > b.getTotalCompras();
+        }
+        return a.getId() < b.getId();
+    };
+
+    auto clientesHeader = clientes.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(clientesHeader)) {
+        throw std::runtime_error(std::get<std::string>(clientesHeader));
+    }
+
+    const HeaderFile clientesStats = std::get<HeaderFile>(clientesHeader);
+    using TopClientes = TopN<Cliente, decltype(mayorCompra)>;
+    const TopClientes topVacio(static_cast<std::size_t>(limite), mayorCompra);
+    std::vector<TopClientes> topPorTramo(tramosDeRecorrido(clientesStats), topVacio);
+    recorrerEnParalelo<Cliente>("top clientes", clientes, clientesStats.proximoID,
+                                [&](std::size_t tramo, const Cliente& cliente) {
+                                    topPorTramo[tramo].ofrecer(cliente);
+                                });
+
+    TopClientes top = topVacio;
+    for (TopClientes& parcial : topPorTramo) {
+        for (const Cliente& cliente : parcial.extraerOrdenado()) {
+            top.ofrecer(cliente);
+        }
+    }
+    return top.extraerOrdenado();
+}
+
+std::vector<ResumenProveedor> FSDatabaseAdmin::reporteVentasPorProveedor()
+{
+    const auto instantanea = ControlVersiones::global().abrir();
+    const LecturaEnInstantanea lectura(instantanea);
+    // lado de construccion: producto -> proveedor; se sondea con cada item vendido
+    auto productosHeader = productos.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(productosHeader)) {
+        throw std::runtime_error(std::get<std::string>(productosHeader));
+    }
+
+    HashJoin<int, int> proveedorDeProducto(
+        static_cast<std::size_t>(std::get<HeaderFile>(productosHeader).registrosActivos));
+    auto productosScan = productos.recorrer([&](const Producto& producto) {
+        proveedorDeProducto.construir(producto.getId(), producto.getIdProveedor());
+        return true;
+    });
+    if (std::holds_alternative<std::string>(productosScan)) {
+        throw std::runtime_error(std::get<std::string>(productosScan));
+    }
+
+    auto transaccionesHeader = transacciones.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(transaccionesHeader)) {
+        throw std::runtime_error(std::get<std::string>(transaccionesHeader));
+    }
+
+    // cada tramo agrega por su cuenta; los productos distintos se cuentan al unir los conjuntos
+    struct ParcialVentas {
+        std::unordered_map<int, ResumenProveedor> agregado;
+        std::unordered_set<std::uint64_t> claves;
+    };
+    const HeaderFile transaccionesStats = std::get<HeaderFile>(transaccionesHeader);
+    std::vector<ParcialVentas> parciales(tramosDeRecorrido(transaccionesStats));
+    recorrerEnParalelo<Transaccion>(
+        "ventas por proveedor", transacciones, transaccionesStats.proximoID,
+        [&](std::size_t tramo, const Transaccion& transaccion) {
+            if (transaccion.getTipoTransaccion() != VENTA) {
+                return;
+            }
+
+            ParcialVentas& parcial = parciales[tramo];
+            for (int i = 0; i < transaccion.getProductosTotales(); ++i) {
+                TransaccionDTO item = {};
+                if (!transaccion.getProductoEnIndice(i, item)) {
+                    continue;
+                }
+
+                // items de productos eliminados quedan en el grupo 0 (sin proveedor)
+                const int* idProveedor = proveedorDeProducto.sondear(item.productoId);
+                const int grupo = idProveedor ? *idProveedor : 0;
+                ResumenProveedor& fila = parcial.agregado[grupo];
+                fila.unidades += item.cantidad;
+                fila.monto += item.precio * item.cantidad;
+                parcial.claves.insert(
+                    (static_cast<std::uint64_t>(static_cast<std::uint32_t>(grupo)) << 32) |
+                    static_cast<std::uint32_t>(item.productoId));
+            }
+        });
+
+    std::unordered_map<int, ResumenProveedor> agregado;
+    std::unordered_set<std::uint64_t> productosContados;
+    for (const ParcialVentas& parcial : parciales) {
+        for (const auto& [grupo, filaTramo] : parcial.agregado) {
+            ResumenProveedor& fila = agregado[grupo];
+            fila.unidades += filaTramo.unidades;
+            fila.monto += filaTramo.monto;
+        }
+        for (const std::uint64_t clave : parcial.claves) {
+            if (productosContados.insert(clave).second) {
+                ++agregado[static_cast<int>(static_cast<std::uint32_t>(clave >> 32))].productos;
+            }
+        }
+    }
+
+    return ordenarResumenProveedores(agregado, proveedores);
+}
+
+std::vector<ResumenProveedor> FSDatabaseAdmin::reporteValorInventario()
+{
+    const auto instantanea = ControlVersiones::global().abrir();
+    const LecturaEnInstantanea lectura(instantanea);
+    auto productosHeader = productos.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(productosHeader)) {
+        throw std::runtime_error(std::get<std::string>(productosHeader));
+    }
+
+    const HeaderFile productosStats = std::get<HeaderFile>(productosHeader);
+    std::vector<std::unordered_map<int, ResumenProveedor>> parciales(
+        tramosDeRecorrido(productosStats));
+    recorrerEnParalelo<Producto>("valor inventario", productos, productosStats.proximoID,
+                                 [&](std::size_t tramo, const Producto& producto) {
+                                     ResumenProveedor& fila =
+                                         parciales[tramo][producto.getIdProveedor()];
+                                     ++fila.productos;
+                                     fila.unidades += producto.getStock();
+                                     fila.monto += producto.getPrecio() * producto.getStock();
+                                 });
+
+    std::unordered_map<int, ResumenProveedor> agregado;
+    for (const auto& parcial : parciales) {
+        for (const auto& [idProveedor, filaTramo] : parcial) {
+            ResumenProveedor& fila = agregado[idProveedor];
+            fila.productos += filaTramo.productos;
+            fila.unidades += filaTramo.unidades;
+            fila.monto += filaTramo.monto;
+        }
+    }
+
+    return ordenarResumenProveedores(agregado, proveedores);
+}
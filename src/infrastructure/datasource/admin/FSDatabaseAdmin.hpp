@@ -1,4 +1,5 @@
 #pragma once
+#include <mutex>
 #include <string>
 
 #include "domain/HeaderFile.hpp"
@@ -7,6 +8,7 @@
 #include "domain/repositories/IDatabaseAdmin.hpp"
 #include "domain/repositories/IProductoRepository.hpp"
 #include "domain/repositories/IProveedorRepository.hpp"
+#include "domain/repositories/IRollupRepository.hpp"
 #include "domain/repositories/ITransaccionRepository.hpp"
 
 class FSDatabaseAdmin : public IDatabaseAdmin
@@ -16,6 +18,9 @@ class FSDatabaseAdmin : public IDatabaseAdmin
     IClienteRepository& clientes;
     IProveedorRepository& proveedores;
     ITransaccionRepository& transacciones;
+    IRollupRepository& rollups;
+    /// Serializa la sincronizacion de tienda.bin entre hilos.
+    std::mutex mutexTienda;
 
     /// Lee el encabezado de tienda.bin para obtener contadores y version.
     std::variant<HeaderFile, std::string> leerHeaderTienda();
@@ -27,13 +32,29 @@ class FSDatabaseAdmin : public IDatabaseAdmin
     std::variant<bool, std::string> guardarRegistroTienda(const Tienda& tienda,
                                                           const HeaderFile& header);
 
+    /// Los rollups se derivan de las transacciones: se rehacen despues de restaurarlas.
+    void reconstruirRollups();
+
    public:
     FSDatabaseAdmin(IProductoRepository& productos, IClienteRepository& clientes,
-                    IProveedorRepository& proveedores, ITransaccionRepository& transacciones);
+                    IProveedorRepository& proveedores, ITransaccionRepository& transacciones,
+                    IRollupRepository& rollups);
 
-    void crearBackup() override;
+    ResumenBackup crearBackup(bool completo = false,
+                              FormatoBackup formato = BACKUP_DEDUPLICADO) override;
+    ResumenBackup extraerBackup(const std::string& id, const std::string& destino) override;
+    ResumenBackup restaurarBackup(const std::string& id) override;
+    ResumenRetencion aplicarRetencion(const PoliticaRetencion& politica) override;
+    /// Al arrancar: termina una restauracion interrumpida; false si no habia ninguna.
+    bool completarRestauracionPendiente();
+    std::unique_ptr<OperacionEnCurso> iniciarOperacion() override;
     std::tuple<int, int, int, int> verificarIntegridadReferencial() override;
     int reporteStockCritico() override;
     void reporteHistorialCliente(int idCliente) override;
+    void reporteHistorialProducto(int idProducto) override;
     bool sincronizarContadoresTienda() override;
+    std::vector<Producto> reporteTopProductosVendidos(int limite, int idProveedor = 0) override;
+    std::vector<Cliente> reporteTopClientes(int limite) override;
+    std::vector<ResumenProveedor> reporteVentasPorProveedor() override;
+    std::vector<ResumenProveedor> reporteValorInventario() override;
 };
@@ -0,0 +1,189 @@
+#include "AlmacenFragmentos.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+#include "infrastructure/datasource/backup/CompresorLZ.hpp"
+#include "infrastructure/datasource/backup/DescriptorArchivo.hpp"
+#include "infrastructure/datasource/backup/Sha256.hpp"
+
+namespace {
+
+constexpr char FIRMA[8] = {'P', 'A', 'P', 'F', 'R', 'G', '0', '1'};
+constexpr std::uint32_t COMPRIMIDO = 1;
+
+struct EncabezadoObjeto {
+    char firma[8];
+    std::uint32_t tamanoOriginal;
+    std::uint32_t opciones;
+};
+
+bool esHash(std::string_view texto)
+{
+    if (texto.size() != 64) {
+        return false;
+    }
+    for (const char c : texto) {
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+AlmacenFragmentos::AlmacenFragmentos(const fs::path& raiz) : directorio(raiz / "objetos") {}
+
+fs::path AlmacenFragmentos::rutaObjeto(const std::string& hash) const
+{
+    if (!esHash(hash)) {
+        throw std::runtime_error("Hash de fragmento invalido: " + hash);
+    }
+    return directorio / hash.substr(0, 2) / hash;
+}
+
+bool AlmacenFragmentos::existe(const std::string& hash) const
+{
+    std::error_code ec;
+    return fs::exists(rutaObjeto(hash), ec);
+}
+
+std::uintmax_t AlmacenFragmentos::guardar(const std::string& hash, const char* datos,
+                                          std::size_t bytes) const
+{
+    const fs::path ruta = rutaObjeto(hash);
+    if (existe(hash)) {
+        return 0;
+    }
+
+    std::vector<char> objeto(sizeof(EncabezadoObjeto) + CompresorLZ::cotaComprimido(bytes));
+    EncabezadoObjeto encabezado = {};
+    std::memcpy(encabezado.firma, FIRMA, sizeof(FIRMA));
+    encabezado.tamanoOriginal = static_cast<std::uint32_t>(bytes);
+    std::size_t guardados = CompresorLZ::comprimir(
+        datos, bytes, objeto.data() + sizeof(EncabezadoObjeto), objeto.size() - sizeof(encabezado));
+    if (guardados > 0 && guardados < bytes) {
+        encabezado.opciones = COMPRIMIDO;
+    } else {
+        guardados = bytes;
+        std::memcpy(objeto.data() + sizeof(EncabezadoObjeto), datos, bytes);
+    }
+    std::memcpy(objeto.data(), &encabezado, sizeof(encabezado));
+
+    // varios hilos (o procesos) pueden guardar el mismo fragmento: cada uno con su temporal, y el
+    // rename deja uno de ellos completo
+    static std::atomic<std::uint64_t> contador{0};
+    fs::create_directories(ruta.parent_path());
+    const fs::path temporal =
+        ruta.string() + ".tmp" + std::to_string(::getpid()) + "." + std::to_string(++contador);
+    try {
+        const DescriptorArchivo salida(temporal, O_WRONLY | O_CREAT | O_TRUNC);
+        salida.escribir(objeto.data(), sizeof(EncabezadoObjeto) + guardados);
+    } catch (...) {
+        std::error_code ec;
+        fs::remove(temporal, ec);
+        throw;
+    }
+    fs::rename(temporal, ruta);
+    return sizeof(EncabezadoObjeto) + guardados;
+}
+
+std::size_t AlmacenFragmentos::leer(const std::string& hash, char* destino,
+                                    std::uintmax_t& outGuardados) const
+{
+    const fs::path ruta = rutaObjeto(hash);
+    std::error_code ec;
+    const std::uintmax_t tamano = fs::file_size(ruta, ec);
+    if (ec) {
+        throw std::runtime_error("Falta el fragmento " + ruta.string());
+    }
+    if (tamano < sizeof(EncabezadoObjeto) ||
+        tamano > sizeof(EncabezadoObjeto) + CompresorLZ::cotaComprimido(TAMANO_FRAGMENTO)) {
+        throw std::runtime_error("Fragmento danado: " + ruta.string());
+    }
+
+    std::vector<char> objeto(static_cast<std::size_t>(tamano));
+    DescriptorArchivo(ruta, O_RDONLY).leerEn(objeto.data(), objeto.size(), 0);
+    EncabezadoObjeto encabezado;
+    std::memcpy(&encabezado, objeto.data(), sizeof(encabezado));
+    const char* carga = objeto.data() + sizeof(EncabezadoObjeto);
+    const std::size_t bytesCarga = objeto.size() - sizeof(EncabezadoObjeto);
+    const std::size_t bytes = encabezado.tamanoOriginal;
+
+    bool valido = std::memcmp(encabezado.firma, FIRMA, sizeof(FIRMA)) == 0 &&
+                  bytes <= TAMANO_FRAGMENTO && (encabezado.opciones & ~COMPRIMIDO) == 0;
+    if (valido && (encabezado.opciones & COMPRIMIDO) != 0) {
+        valido = CompresorLZ::descomprimir(carga, bytesCarga, destino, bytes);
+    } else if (valido && bytesCarga == bytes) {
+        std::memcpy(destino, carga, bytes);
+    } else {
+        valido = false;
+    }
+    if (!valido || Sha256::hex(destino, bytes) != hash) {
+        throw std::runtime_error("Fragmento danado: " + ruta.string());
+    }
+    outGuardados = tamano;
+    return bytes;
+}
+
+AlmacenFragmentos::Limpieza AlmacenFragmentos::limpiar(
+    const std::unordered_set<std::string>& referenciados) const
+{
+    Limpieza limpieza;
+    std::error_code ec;
+    std::vector<fs::path> sobrantes;
+    for (const fs::directory_entry& prefijo : fs::directory_iterator(directorio, ec)) {
+        for (const fs::directory_entry& objeto : fs::directory_iterator(prefijo.path(), ec)) {
+            if (!referenciados.contains(objeto.path().filename().string())) {
+                sobrantes.push_back(objeto.path());
+            }
+        }
+    }
+
+    for (const fs::path& sobrante : sobrantes) {
+        std::error_code errorTamano;
+        const std::uintmax_t bytes = fs::file_size(sobrante, errorTamano);
+        if (fs::remove(sobrante, ec)) {
+            ++limpieza.objetos;
+            limpieza.bytes += errorTamano ? 0 : bytes;
+        }
+    }
+    return limpieza;
+}
+
+void AlmacenFragmentos::escribirLista(const fs::path& ruta, const std::vector<std::string>& hashes)
+{
+    std::string texto;
+    texto.reserve(hashes.size() * 65);
+    for (const std::string& hash : hashes) {
+        texto += hash;
+        texto += '\n';
+    }
+    const DescriptorArchivo salida(ruta, O_WRONLY | O_CREAT | O_TRUNC);
+    salida.escribir(texto.data(), texto.size());
+}
+
+std::vector<std::string> AlmacenFragmentos::leerLista(const fs::path& ruta)
+{
+    std::ifstream entrada(ruta);
+    if (!entrada.is_open()) {
+        throw std::runtime_error("No se pudo abrir " + ruta.string());
+    }
+    std::vector<std::string> hashes;
+    std::string linea;
+    while (std::getline(entrada, linea)) {
+        if (!esHash(linea)) {
+            throw std::runtime_error("Lista de fragmentos invalida: " + ruta.string());
+        }
+        hashes.push_back(std::move(linea));
+    }
+    return hashes;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Deposito de fragmentos direccionado por contenido, compartido por todos los backups.
+ *
+ * Cada archivo de datos se corta en fragmentos de TAMANO_FRAGMENTO bytes (el ultimo puede ser
+ * mas corto) y cada fragmento se guarda una sola vez en `objetos/<2 hex>/<SHA-256>`, comprimido
+ * con CompresorLZ si se achica. Un backup solo guarda la lista de hashes de cada archivo, asi que
+ * los fragmentos que no cambiaron entre un backup y otro no vuelven a ocupar espacio: conservar
+ * un mes de backups horarios cuesta los datos una vez mas lo que cambio.
+ *
+ * Los fragmentos son de tamano fijo porque los archivos de datos tienen registros de tamano fijo
+ * que se modifican en su lugar o se agregan al final: un cambio nunca desplaza los bytes
+ * siguientes, que es lo que resuelven los cortes por contenido. TAMANO_FRAGMENTO es multiplo de
+ * RegistroCambios::TAMANO_BLOQUE, asi que el mapa de cambios dice que fragmentos hay que volver a
+ * leer.
+ *
+ * Cada objeto se escribe en un temporal y se renombra: uno con el nombre final esta completo. Al
+ * leerlo se recalcula su SHA-256. Los errores se lanzan como std::runtime_error.
+ */
+class AlmacenFragmentos
+{
+   public:
+    static constexpr std::size_t TAMANO_FRAGMENTO = std::size_t{64} << 10;
+
+    /// Lo que borro limpiar().
+    struct Limpieza {
+        int objetos{0};
+        std::uintmax_t bytes{0};
+    };
+
+   private:
+    fs::path directorio;
+
+    fs::path rutaObjeto(const std::string& hash) const;
+
+   public:
+    /// El deposito vive en `<raiz>/objetos`.
+    explicit AlmacenFragmentos(const fs::path& raiz);
+
+    bool existe(const std::string& hash) const;
+
+    /**
+     * Guarda `bytes` (hasta TAMANO_FRAGMENTO) bajo su `hash` si no estaba. Retorna lo que ocupo
+     * el objeto nuevo, o 0 si ya existia.
+     */
+    std::uintmax_t guardar(const std::string& hash, const char* datos, std::size_t bytes) const;
+
+    /**
+     * Copia el fragmento `hash` en `destino` (con lugar para TAMANO_FRAGMENTO bytes) y verifica
+     * su SHA-256. Retorna su tamano original; en `outGuardados`, lo que ocupa el objeto.
+     */
+    std::size_t leer(const std::string& hash, char* destino, std::uintmax_t& outGuardados) const;
+
+    /// Borra los objetos que no estan en `referenciados` y los temporales de escrituras cortadas.
+    Limpieza limpiar(const std::unordered_set<std::string>& referenciados) const;
+
+    /// Lista de fragmentos de un archivo: un hash por linea, en orden.
+    static void escribirLista(const fs::path& ruta, const std::vector<std::string>& hashes);
+    static std::vector<std::string> leerLista(const fs::path& ruta);
+};
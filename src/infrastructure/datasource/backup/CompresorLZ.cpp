@@ -0,0 +1,211 @@
+#include "CompresorLZ.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr int BITS_HASH = 16;
+constexpr std::size_t COPIA_MINIMA = 4;
+/// El formato exige que los ultimos 5 bytes sean literales y que la ultima copia empiece al
+/// menos 12 bytes antes del final del bloque.
+constexpr std::size_t LITERALES_FINALES = 5;
+constexpr std::size_t LIMITE_COPIAS = 12;
+constexpr std::size_t DISTANCIA_MAXIMA = 65535;
+
+using Byte = unsigned char;
+
+std::uint32_t leer32(const Byte* datos)
+{
+    std::uint32_t valor;
+    std::memcpy(&valor, datos, sizeof(valor));
+    return valor;
+}
+
+std::uint32_t hash4(std::uint32_t valor)
+{
+    return (valor * 2654435761u) >> (32 - BITS_HASH);
+}
+
+/// Escribe 255 por cada 255 unidades de `resto` y luego el sobrante (largos mayores a 15).
+Byte* escribirLargo(Byte* salida, std::size_t resto)
+{
+    for (; resto >= 255; resto -= 255) {
+        *salida++ = 255;
+    }
+    *salida++ = static_cast<Byte>(resto);
+    return salida;
+}
+
+/**
+ * Emite una secuencia: literales [literales, literales + largoLiterales) y, si largoCopia > 0,
+ * una copia de largoCopia bytes desde `distancia` atras. Retorna nullptr si no hay espacio.
+ */
+Byte* emitir(Byte* salida, const Byte* finSalida, const Byte* literales,
+             std::size_t largoLiterales, std::size_t distancia, std::size_t largoCopia)
+{
+    const std::size_t maximo =
+        1 + largoLiterales / 255 + 1 + largoLiterales + 2 + largoCopia / 255 + 1;
+    if (static_cast<std::size_t>(finSalida - salida) < maximo) {
+        return nullptr;
+    }
+
+    Byte* token = salida++;
+    *token = static_cast<Byte>(std::min<std::size_t>(largoLiterales, 15) << 4);
+    if (largoLiterales >= 15) {
+        salida = escribirLargo(salida, largoLiterales - 15);
+    }
+    std::memcpy(salida, literales, largoLiterales);
+    salida += largoLiterales;
+    if (largoCopia == 0) {
+        return salida;
+    }
+
+    *salida++ = static_cast<Byte>(distancia & 0xFF);
+    *salida++ = static_cast<Byte>(distancia >> 8);
+    const std::size_t extra = largoCopia - COPIA_MINIMA;
+    *token |= static_cast<Byte>(std::min<std::size_t>(extra, 15));
+    if (extra >= 15) {
+        salida = escribirLargo(salida, extra - 15);
+    }
+    return salida;
+}
+
+/// Lee la extension de un largo que llego a 15 en el token; false si la entrada se termina.
+bool leerLargo(const Byte*& entrada, const Byte* finEntrada, std::size_t& largo)
+{
+    Byte valor = 255;
+    while (valor == 255) {
+        if (entrada >= finEntrada) {
+            return false;
+        }
+        valor = *entrada++;
+        largo += valor;
+    }
+    return true;
+}
+
+}  // namespace
+
+namespace CompresorLZ {
+
+std::size_t cotaComprimido(std::size_t bytes)
+{
+    return bytes + bytes / 255 + 16;
+}
+
+std::size_t comprimir(const char* origen, std::size_t bytes, char* destino, std::size_t capacidad)
+{
+    const Byte* const inicio = reinterpret_cast<const Byte*>(origen);
+    const Byte* const fin = inicio + bytes;
+    Byte* salida = reinterpret_cast<Byte*>(destino);
+    const Byte* const finSalida = salida + capacidad;
+    const Byte* ancla = inicio;
+
+    if (bytes > LIMITE_COPIAS) {
+        // posicion + 1 de la ultima aparicion de cada hash; 0 es "sin aparicion"
+        std::vector<std::uint32_t> tabla(std::size_t{1} << BITS_HASH, 0);
+        const Byte* const limiteCopias = fin - LIMITE_COPIAS;
+        const Byte* const limiteExtension = fin - LITERALES_FINALES;
+        const Byte* cursor = inicio;
+
+        while (cursor < limiteCopias) {
+            const std::uint32_t secuencia = leer32(cursor);
+            std::uint32_t& entrada = tabla[hash4(secuencia)];
+            const Byte* candidato = entrada > 0 ? inicio + entrada - 1 : nullptr;
+            entrada = static_cast<std::uint32_t>(cursor - inicio) + 1;
+            if (candidato == nullptr ||
+                static_cast<std::size_t>(cursor - candidato) > DISTANCIA_MAXIMA ||
+                leer32(candidato) != secuencia) {
+                // en zonas sin repeticiones se avanza cada vez mas rapido
+                cursor += 1 + (static_cast<std::size_t>(cursor - ancla) >> 6);
+                continue;
+            }
+
+            while (cursor > ancla && candidato > inicio && cursor[-1] == candidato[-1]) {
+                --cursor;
+                --candidato;
+            }
+            std::size_t largo = COPIA_MINIMA;
+            while (cursor + largo < limiteExtension && cursor[largo] == candidato[largo]) {
+                ++largo;
+            }
+
+            salida = emitir(salida, finSalida, ancla, static_cast<std::size_t>(cursor - ancla),
+                            static_cast<std::size_t>(cursor - candidato), largo);
+            if (salida == nullptr) {
+                return 0;
+            }
+            cursor += largo;
+            ancla = cursor;
+            if (cursor < limiteCopias) {
+                const Byte* anterior = cursor - 2;
+                tabla[hash4(leer32(anterior))] = static_cast<std::uint32_t>(anterior - inicio) + 1;
+            }
+        }
+    }
+
+    salida = emitir(salida, finSalida, ancla, static_cast<std::size_t>(fin - ancla), 0, 0);
+    if (salida == nullptr) {
+        return 0;
+    }
+    return static_cast<std::size_t>(salida - reinterpret_cast<Byte*>(destino));
+}
+
+bool descomprimir(const char* origen, std::size_t bytes, char* destino,
+                  std::size_t bytesOriginales)
+{
+    const Byte* entrada = reinterpret_cast<const Byte*>(origen);
+    const Byte* const finEntrada = entrada + bytes;
+    Byte* const inicioSalida = reinterpret_cast<Byte*>(destino);
+    Byte* salida = inicioSalida;
+    Byte* const finSalida = salida + bytesOriginales;
+
+    while (entrada < finEntrada) {
+        const Byte token = *entrada++;
+        std::size_t largoLiterales = token >> 4;
+        if (largoLiterales == 15 && !leerLargo(entrada, finEntrada, largoLiterales)) {
+            return false;
+        }
+        if (largoLiterales > static_cast<std::size_t>(finEntrada - entrada) ||
+            largoLiterales > static_cast<std::size_t>(finSalida - salida)) {
+            return false;
+        }
+        std::memcpy(salida, entrada, largoLiterales);
+        entrada += largoLiterales;
+        salida += largoLiterales;
+        if (entrada == finEntrada) {
+            break;  // la ultima secuencia solo tiene literales
+        }
+
+        if (finEntrada - entrada < 2) {
+            return false;
+        }
+        const std::size_t distancia = entrada[0] | (static_cast<std::size_t>(entrada[1]) << 8);
+        entrada += 2;
+        std::size_t largo = token & 0x0F;
+        if (largo == 15 && !leerLargo(entrada, finEntrada, largo)) {
+            return false;
+        }
+        largo += COPIA_MINIMA;
+        if (distancia == 0 || distancia > static_cast<std::size_t>(salida - inicioSalida) ||
+            largo > static_cast<std::size_t>(finSalida - salida)) {
+            return false;
+        }
+
+        // con solapamiento el patron se duplica: cada copia puede ser el doble que la anterior
+        const Byte* copia = salida - distancia;
+        while (largo > 0) {
+            const std::size_t parte = std::min(largo, static_cast<std::size_t>(salida - copia));
+            std::memcpy(salida, copia, parte);
+            salida += parte;
+            largo -= parte;
+        }
+    }
+
+    return salida == finSalida;
+}
+
+}  // namespace CompresorLZ
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief - Compresor rapido en el formato de bloque de LZ4 (secuencias de literales + copias).
+ *
+ * Implementacion propia, sin dependencias: busqueda voraz con una tabla hash de 4 bytes y
+ * descompresion que valida cada offset y largo, asi que un bloque corrupto falla en vez de
+ * escribir fuera del buffer. Cada llamada comprime un bloque independiente; el paralelismo y el
+ * formato de archivo estan en ContenedorComprimido.
+ *
+ * Los registros de tamano fijo (nombres, descripciones y el arreglo de items de las
+ * transacciones rellenos con ceros) se reducen muchas veces su tamano a varios cientos de MB/s.
+ */
+namespace CompresorLZ {
+
+/// Tamano maximo que puede ocupar `bytes` de entrada una vez comprimidos.
+std::size_t cotaComprimido(std::size_t bytes);
+
+/// Comprime `origen` en `destino`; retorna los bytes escritos, o 0 si no caben en `capacidad`.
+std::size_t comprimir(const char* origen, std::size_t bytes, char* destino, std::size_t capacidad);
+
+/// Descomprime un bloque que debe producir exactamente `bytesOriginales`.
+bool descomprimir(const char* origen, std::size_t bytes, char* destino,
+                  std::size_t bytesOriginales);
+
+}  // namespace CompresorLZ
@@ -0,0 +1,204 @@
+#include "ContenedorComprimido.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+
+#include "domain/utils/EjecutorTareas.hpp"
+#include "infrastructure/datasource/backup/CompresorLZ.hpp"
+#include "infrastructure/datasource/backup/DescriptorArchivo.hpp"
+
+namespace {
+
+constexpr char FIRMA[8] = {'P', 'A', 'P', 'L', 'Z', 'B', '0', '1'};
+constexpr std::uint32_t SIN_COMPRIMIR = 0x80000000u;
+/// Bloques que se comprimen por hilo antes de escribir la ola.
+constexpr std::size_t BLOQUES_POR_HILO = 2;
+/// Limite al leer contenedores ajenos: un encabezado danado no debe pedir memoria sin control.
+constexpr std::uint32_t TAMANO_BLOQUE_MAXIMO = 64u << 20;
+
+struct EncabezadoContenedor {
+    char firma[8];
+    std::uint32_t tamanoBloque;
+    std::uint32_t reservado;
+    std::uint64_t tamanoOriginal;
+    std::uint64_t bloques;
+};
+
+/// Copia a `destino` los bytes [desde, desde + bytes) del flujo formado por los rangos.
+void leerDelFlujo(const DescriptorArchivo& entrada,
+                  const std::vector<ContenedorComprimido::Rango>& rangos,
+                  const std::vector<std::uintmax_t>& inicios, std::uintmax_t desde, char* destino,
+                  std::size_t bytes)
+{
+    // primer rango que contiene `desde`: el ultimo cuyo inicio es <= desde
+    std::size_t indice = static_cast<std::size_t>(
+        std::upper_bound(inicios.begin(), inicios.end(), desde) - inicios.begin() - 1);
+    while (bytes > 0) {
+        const ContenedorComprimido::Rango& rango = rangos[indice];
+        const std::uintmax_t dentro = desde - inicios[indice];
+        const std::size_t parte =
+            static_cast<std::size_t>(std::min<std::uintmax_t>(bytes, rango.bytes - dentro));
+        entrada.leerEn(destino, parte, static_cast<off_t>(rango.offset + dentro));
+        destino += parte;
+        desde += parte;
+        bytes -= parte;
+        ++indice;
+    }
+}
+
+void sumarOla(EjecutorTareas::Medicion& total, const EjecutorTareas::Medicion& ola)
+{
+    total.tramos += ola.tramos;
+    total.msTrabajo += ola.msTrabajo;
+    total.msTramoMaximo = std::max(total.msTramoMaximo, ola.msTramoMaximo);
+}
+
+}  // namespace
+
+std::uintmax_t ContenedorComprimido::comprimir(const fs::path& origen,
+                                               const std::vector<Rango>& rangos,
+                                               const fs::path& destino)
+{
+    using Reloj = std::chrono::steady_clock;
+    const auto inicio = Reloj::now();
+
+    std::vector<Rango> conDatos;
+    std::vector<std::uintmax_t> inicios;
+    std::uintmax_t tamanoOriginal = 0;
+    for (const Rango& rango : rangos) {
+        if (rango.bytes > 0) {
+            conDatos.push_back(rango);
+            inicios.push_back(tamanoOriginal);
+            tamanoOriginal += rango.bytes;
+        }
+    }
+    const std::size_t bloques =
+        static_cast<std::size_t>((tamanoOriginal + TAMANO_BLOQUE - 1) / TAMANO_BLOQUE);
+
+    const DescriptorArchivo entrada(origen, O_RDONLY);
+    const DescriptorArchivo salida(destino, O_WRONLY | O_CREAT | O_TRUNC);
+    std::vector<std::uint32_t> tamanos(bloques);
+    std::uintmax_t posicion = sizeof(EncabezadoContenedor) + bloques * sizeof(std::uint32_t);
+
+    EjecutorTareas& ejecutor = EjecutorTareas::global();
+    const std::size_t porOla = BLOQUES_POR_HILO * (ejecutor.cantidadHilos() + 1);
+    EjecutorTareas::Medicion total;
+    total.nombre = "comprimir " + origen.filename().string();
+    std::vector<std::vector<char>> comprimidos;
+    for (std::size_t primero = 0; primero < bloques; primero += porOla) {
+        const std::size_t cantidad = std::min(porOla, bloques - primero);
+        comprimidos.assign(cantidad, {});
+        const EjecutorTareas::Medicion ola = ejecutor.paraCadaIndice(
+            total.nombre, cantidad,
+            [&](std::size_t i) {
+                const std::size_t bloque = primero + i;
+                const std::uintmax_t desde = static_cast<std::uintmax_t>(bloque) * TAMANO_BLOQUE;
+                const std::size_t bytes = static_cast<std::size_t>(
+                    std::min<std::uintmax_t>(TAMANO_BLOQUE, tamanoOriginal - desde));
+                std::vector<char> datos(bytes);
+                leerDelFlujo(entrada, conDatos, inicios, desde, datos.data(), bytes);
+
+                std::vector<char>& comprimido = comprimidos[i];
+                comprimido.resize(CompresorLZ::cotaComprimido(bytes));
+                const std::size_t largo = CompresorLZ::comprimir(datos.data(), bytes,
+                                                                 comprimido.data(),
+                                                                 comprimido.size());
+                if (largo == 0 || largo >= bytes) {
+                    comprimido = std::move(datos);
+                    tamanos[bloque] = static_cast<std::uint32_t>(bytes) | SIN_COMPRIMIR;
+                } else {
+                    comprimido.resize(largo);
+                    tamanos[bloque] = static_cast<std::uint32_t>(largo);
+                }
+            },
+            false);
+        sumarOla(total, ola);
+
+        for (const std::vector<char>& comprimido : comprimidos) {
+            salida.escribirEn(comprimido.data(), comprimido.size(), static_cast<off_t>(posicion));
+            posicion += comprimido.size();
+        }
+    }
+
+    EncabezadoContenedor encabezado = {};
+    std::memcpy(encabezado.firma, FIRMA, sizeof(FIRMA));
+    encabezado.tamanoBloque = static_cast<std::uint32_t>(TAMANO_BLOQUE);
+    encabezado.tamanoOriginal = tamanoOriginal;
+    encabezado.bloques = bloques;
+    salida.escribirEn(reinterpret_cast<const char*>(&encabezado), sizeof(encabezado), 0);
+    salida.escribirEn(reinterpret_cast<const char*>(tamanos.data()),
+                      tamanos.size() * sizeof(std::uint32_t), sizeof(encabezado));
+
+    if (bloques > 0) {
+        total.msTotal = std::chrono::duration<double, std::milli>(Reloj::now() - inicio).count();
+        ejecutor.registrar(total);
+    }
+    return posicion;
+}
+
+std::uintmax_t ContenedorComprimido::descomprimir(const fs::path& origen, const fs::path& destino)
+{
+    const DescriptorArchivo entrada(origen, O_RDONLY);
+    const std::uintmax_t tamanoContenedor = fs::file_size(origen);
+    const std::string danado = "Contenedor comprimido danado: " + origen.string();
+
+    EncabezadoContenedor encabezado = {};
+    if (tamanoContenedor < sizeof(encabezado)) {
+        throw std::runtime_error(danado);
+    }
+    entrada.leerEn(reinterpret_cast<char*>(&encabezado), sizeof(encabezado), 0);
+    const std::uint64_t tamanoBloque = encabezado.tamanoBloque;
+    if (std::memcmp(encabezado.firma, FIRMA, sizeof(FIRMA)) != 0 || tamanoBloque == 0 ||
+        tamanoBloque > TAMANO_BLOQUE_MAXIMO ||
+        encabezado.bloques != (encabezado.tamanoOriginal + tamanoBloque - 1) / tamanoBloque ||
+        encabezado.bloques > (tamanoContenedor - sizeof(encabezado)) / sizeof(std::uint32_t)) {
+        throw std::runtime_error(danado);
+    }
+
+    const std::size_t bloques = static_cast<std::size_t>(encabezado.bloques);
+    std::vector<std::uint32_t> tamanos(bloques);
+    entrada.leerEn(reinterpret_cast<char*>(tamanos.data()), bloques * sizeof(std::uint32_t),
+                   sizeof(encabezado));
+    std::vector<std::uintmax_t> posiciones(bloques);
+    std::uintmax_t posicion = sizeof(encabezado) + bloques * sizeof(std::uint32_t);
+    for (std::size_t bloque = 0; bloque < bloques; ++bloque) {
+        posiciones[bloque] = posicion;
+        posicion += tamanos[bloque] & ~SIN_COMPRIMIR;
+    }
+    if (posicion != tamanoContenedor) {
+        throw std::runtime_error(danado);
+    }
+
+    const DescriptorArchivo salida(destino, O_WRONLY | O_CREAT | O_TRUNC);
+    salida.truncar(static_cast<off_t>(encabezado.tamanoOriginal));
+    EjecutorTareas::global().paraCadaIndice(
+        "descomprimir " + origen.filename().string(), bloques, [&](std::size_t bloque) {
+            const std::uintmax_t desde = bloque * tamanoBloque;
+            const std::size_t bytes = static_cast<std::size_t>(
+                std::min<std::uintmax_t>(tamanoBloque, encabezado.tamanoOriginal - desde));
+            const bool sinComprimir = (tamanos[bloque] & SIN_COMPRIMIR) != 0;
+            const std::size_t guardado = tamanos[bloque] & ~SIN_COMPRIMIR;
+            if (guardado > CompresorLZ::cotaComprimido(bytes) ||
+                (sinComprimir && guardado != bytes)) {
+                throw std::runtime_error(danado);
+            }
+
+            std::vector<char> leido(guardado);
+            entrada.leerEn(leido.data(), guardado, static_cast<off_t>(posiciones[bloque]));
+            if (sinComprimir) {
+                salida.escribirEn(leido.data(), bytes, static_cast<off_t>(desde));
+                return;
+            }
+            std::vector<char> datos(bytes);
+            if (!CompresorLZ::descomprimir(leido.data(), guardado, datos.data(), bytes)) {
+                throw std::runtime_error(danado);
+            }
+            salida.escribirEn(datos.data(), bytes, static_cast<off_t>(desde));
+        });
+
+    return encabezado.tamanoOriginal;
+}
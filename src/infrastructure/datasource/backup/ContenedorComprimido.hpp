@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Archivo de backup comprimido con CompresorLZ en bloques independientes.
+ *
+ * Formato: un encabezado (firma "PAPLZB01", tamano de bloque, tamano original y cantidad de
+ * bloques), un uint32 por bloque con su tamano comprimido y despues los bloques uno tras otro. Un
+ * bloque que no se achica se guarda tal cual y lo indica el bit alto de su tamano.
+ *
+ * Los bloques se comprimen en paralelo en el EjecutorTareas, en olas que se escriben en orden
+ * antes de pasar a la siguiente; al descomprimir cada bloque se escribe directo en su posicion,
+ * tambien en paralelo. Los errores y los contenedores danados se lanzan como std::runtime_error.
+ */
+class ContenedorComprimido
+{
+   public:
+    static constexpr std::size_t TAMANO_BLOQUE = std::size_t{1} << 20;
+
+    /// Rango [offset, offset + bytes) de un archivo.
+    struct Rango {
+        std::uintmax_t offset{0};
+        std::uintmax_t bytes{0};
+    };
+
+    /**
+     * Comprime en `destino` los `rangos` de `origen`, uno a continuacion del otro (un archivo
+     * entero es un solo rango). Retorna el tamano del contenedor.
+     */
+    static std::uintmax_t comprimir(const fs::path& origen, const std::vector<Rango>& rangos,
+                                    const fs::path& destino);
+
+    /// Escribe en `destino` los datos originales; retorna cuantos bytes son.
+    static std::uintmax_t descomprimir(const fs::path& origen, const fs::path& destino);
+};
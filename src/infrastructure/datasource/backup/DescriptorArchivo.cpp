@@ -0,0 +1,88 @@
+#include "DescriptorArchivo.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+DescriptorArchivo::DescriptorArchivo(const fs::path& ruta, int flags)
+    : descriptor(::open(ruta.c_str(), flags | O_CLOEXEC, 0644)), ruta(ruta)
+{
+    if (descriptor < 0) {
+        throw std::runtime_error("No se pudo abrir " + ruta.string() + ": " +
+                                 std::strerror(errno));
+    }
+}
+
+DescriptorArchivo::~DescriptorArchivo()
+{
+    ::close(descriptor);
+}
+
+void DescriptorArchivo::leerEn(char* destino, std::size_t bytes, off_t offset) const
+{
+    while (bytes > 0) {
+        const ssize_t leidos = ::pread(descriptor, destino, bytes, offset);
+        if (leidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (leidos <= 0) {
+            throw std::runtime_error("Error leyendo " + ruta.string() + ": " +
+                                     (leidos < 0 ? std::strerror(errno) : "fin de archivo"));
+        }
+        destino += leidos;
+        bytes -= static_cast<std::size_t>(leidos);
+        offset += leidos;
+    }
+}
+
+void DescriptorArchivo::escribirEn(const char* origen, std::size_t bytes, off_t offset) const
+{
+    while (bytes > 0) {
+        const ssize_t escritos = ::pwrite(descriptor, origen, bytes, offset);
+        if (escritos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (escritos < 0) {
+            throw std::runtime_error("Error escribiendo " + ruta.string() + ": " +
+                                     std::strerror(errno));
+        }
+        origen += escritos;
+        bytes -= static_cast<std::size_t>(escritos);
+        offset += escritos;
+    }
+}
+
+void DescriptorArchivo::escribir(const char* origen, std::size_t bytes) const
+{
+    while (bytes > 0) {
+        const ssize_t escritos = ::write(descriptor, origen, bytes);
+        if (escritos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (escritos < 0) {
+            throw std::runtime_error("Error escribiendo " + ruta.string() + ": " +
+                                     std::strerror(errno));
+        }
+        origen += escritos;
+        bytes -= static_cast<std::size_t>(escritos);
+    }
+}
+
+void DescriptorArchivo::truncar(off_t bytes) const
+{
+    if (::ftruncate(descriptor, bytes) != 0) {
+        throw std::runtime_error("No se pudo truncar " + ruta.string() + ": " +
+                                 std::strerror(errno));
+    }
+}
+
+void DescriptorArchivo::sincronizar() const
+{
+    if (::fsync(descriptor) != 0) {
+        throw std::runtime_error("No se pudo sincronizar " + ruta.string() + ": " +
+                                 std::strerror(errno));
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <sys/types.h>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Descriptor de archivo que se cierra solo, para copiar datos de y hacia los backups.
+ *
+ * A diferencia de ArchivoPosicional no marca cambios ni se comparte entre repositorios: cada
+ * copia abre el suyo. Todos los errores (incluido leer menos de lo pedido) se lanzan como
+ * std::runtime_error con la ruta del archivo.
+ */
+class DescriptorArchivo
+{
+   private:
+    int descriptor{-1};
+    fs::path ruta;
+
+   public:
+    DescriptorArchivo(const fs::path& ruta, int flags);
+    ~DescriptorArchivo();
+
+    DescriptorArchivo(const DescriptorArchivo&) = delete;
+    DescriptorArchivo& operator=(const DescriptorArchivo&) = delete;
+
+    int get() const { return descriptor; }
+
+    void leerEn(char* destino, std::size_t bytes, off_t offset) const;
+    void escribirEn(const char* origen, std::size_t bytes, off_t offset) const;
+    /// Escribe en la posicion actual del descriptor.
+    void escribir(const char* origen, std::size_t bytes) const;
+    void truncar(off_t bytes) const;
+    /// fsync: los datos (o las entradas, si es un directorio) quedan en disco al retornar.
+    void sincronizar() const;
+};
@@ -0,0 +1,1207 @@
+#include "GestorBackups.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <functional>
+#include <linux/fs.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/ioctl.h>
+#include <system_error>
+#include <unistd.h>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "domain/HeaderFile.hpp"
+#include "domain/constants.hpp"
+#include "domain/utils/EjecutorTareas.hpp"
+#include "domain/utils/Versiones.hpp"
+#include "infrastructure/datasource/ArchivoPosicional.hpp"
+#include "infrastructure/datasource/BloqueoArchivo.hpp"
+#include "infrastructure/datasource/EntityTraits.hpp"
+#include "infrastructure/datasource/RegistroCambios.hpp"
+#include "infrastructure/datasource/backup/AlmacenFragmentos.hpp"
+#include "infrastructure/datasource/backup/ContenedorComprimido.hpp"
+#include "infrastructure/datasource/backup/DescriptorArchivo.hpp"
+#include "infrastructure/datasource/backup/Sha256.hpp"
+#include "infrastructure/datasource/backup/SumaVerificacion.hpp"
+#include "infrastructure/datasource/transaccion/ParticionesTransacciones.hpp"
+#include "infrastructure/datasource/transaccion/SegmentoFrio.hpp"
+
+using namespace Constants::PATHS;
+using namespace std::chrono;
+
+namespace {
+
+constexpr std::size_t COPIA_BUFFER_SIZE = 1 << 20;
+/// Archivo que deja una restauracion validada en su preparacion antes de tocar los datos.
+constexpr char DIARIO_RESTAURACION[] = "pendiente";
+/// Bloques del mapa de cambios que cubre cada fragmento deduplicado.
+constexpr std::size_t BLOQUES_POR_FRAGMENTO =
+    AlmacenFragmentos::TAMANO_FRAGMENTO / RegistroCambios::TAMANO_BLOQUE;
+static_assert(AlmacenFragmentos::TAMANO_FRAGMENTO % RegistroCambios::TAMANO_BLOQUE == 0);
+
+/// Un backup o una restauracion no siguen sin el flock que los coordina con otros procesos.
+void exigirBloqueo(const BloqueoArchivo& bloqueo, const fs::path& ruta)
+{
+    if (!bloqueo.activo()) {
+        throw std::runtime_error("No se pudo bloquear " + ruta.string());
+    }
+}
+
+/**
+ * Comprueba un archivo de registros reconstruido: version actual, header coherente con el tamano
+ * y cada registro en la posicion de su ID (desde `primerId`, distinto de 1 en las particiones de
+ * transacciones), con tantos activos como indica el header. Retorna la cantidad de registros
+ * activos.
+ */
+template <typename T>
+int validarRegistrosDesde(const fs::path& archivo, int primerId)
+{
+    const std::string invalido = "Datos restaurados invalidos en " + archivo.string() + ": ";
+    const std::size_t tamanoRegistro = static_cast<std::size_t>(EntityTraits<T>::recordSize());
+    const std::uintmax_t tamano = fs::file_size(archivo);
+    const DescriptorArchivo entrada(archivo, O_RDONLY);
+
+    HeaderFile header = {};
+    if (tamano < sizeof(HeaderFile)) {
+        throw std::runtime_error(invalido + "sin header");
+    }
+    entrada.leerEn(reinterpret_cast<char*>(&header), sizeof(HeaderFile), 0);
+    if (header.version != Constants::BINARY_FORMAT::VERSION_ACTUAL) {
+        throw std::runtime_error(invalido + "version de formato " +
+                                 std::to_string(header.version));
+    }
+    if (header.cantidadRegistros < 0 || header.proximoID != primerId + header.cantidadRegistros ||
+        header.registrosActivos < 0 || header.registrosActivos > header.cantidadRegistros ||
+        tamano < sizeof(HeaderFile) +
+                     static_cast<std::uintmax_t>(header.cantidadRegistros) * tamanoRegistro) {
+        throw std::runtime_error(invalido + "header incoherente con el archivo");
+    }
+
+    const int porBloque =
+        static_cast<int>(std::max<std::size_t>(1, COPIA_BUFFER_SIZE / tamanoRegistro));
+    std::vector<char> bloque(static_cast<std::size_t>(porBloque) * tamanoRegistro);
+    RegistroEnMemoria memoria;
+    int activos = 0;
+    for (int id = primerId; id < header.proximoID;) {
+        const int cantidad = std::min(porBloque, header.proximoID - id);
+        entrada.leerEn(bloque.data(), static_cast<std::size_t>(cantidad) * tamanoRegistro,
+                       static_cast<off_t>(sizeof(HeaderFile) + static_cast<std::size_t>(
+                                                                   id - primerId) *
+                                                                   tamanoRegistro));
+        for (int i = 0; i < cantidad; ++i, ++id) {
+            T registro;
+            std::istream& flujo = memoria.leerDesde(
+                bloque.data() + static_cast<std::size_t>(i) * tamanoRegistro, tamanoRegistro);
+            if (!EntityTraits<T>::readFromStream(flujo, registro) || registro.getId() != id) {
+                throw std::runtime_error(invalido + "el registro " + std::to_string(id) +
+                                         " no corresponde a su posicion");
+            }
+            activos += registro.getEliminado() ? 0 : 1;
+        }
+    }
+    if (activos != header.registrosActivos) {
+        throw std::runtime_error(invalido +
+                                 std::format("{} registros activos y el header indica {}", activos,
+                                             header.registrosActivos));
+    }
+    return activos;
+}
+
+template <typename T>
+int validarRegistros(const fs::path& archivo)
+{
+    return validarRegistrosDesde<T>(archivo, 1);
+}
+
+/// Como validarRegistrosDesde para una particion archivada: la decodifica entera.
+int validarArchivada(const fs::path& archivo, int primerId)
+{
+    auto verificado = SegmentoFrio(archivo).verificar();
+    if (std::holds_alternative<std::string>(verificado)) {
+        throw std::runtime_error("Datos restaurados invalidos: " +
+                                 std::get<std::string>(verificado));
+    }
+    const HeaderFile& header = std::get<HeaderFile>(verificado);
+    if (header.proximoID - header.cantidadRegistros != primerId) {
+        throw std::runtime_error("Datos restaurados invalidos en " + archivo.string() +
+                                 ": no empieza en el ID de su particion");
+    }
+    return header.registrosActivos;
+}
+
+/// Comprueba que las particiones de una lista reconstruida sean contiguas: cada una termina donde
+/// empieza la siguiente (cada archivo se valida por separado).
+int validarParticiones(const fs::path& manifiesto)
+{
+    std::vector<ParticionTransacciones> particiones;
+    std::string error;
+    if (!ManifiestoParticiones::leer(manifiesto, particiones, error)) {
+        throw std::runtime_error(error);
+    }
+    for (std::size_t i = 0; i + 1 < particiones.size(); ++i) {
+        HeaderFile header = {};
+        const fs::path archivo = ManifiestoParticiones::rutaArchivo(manifiesto, particiones[i]);
+        if (!ManifiestoParticiones::leerHeader(archivo, header, error)) {
+            throw std::runtime_error(error);
+        }
+        if (header.proximoID != particiones[i + 1].primerId) {
+            throw std::runtime_error("Datos restaurados invalidos en " + archivo.string() +
+                                     ": no termina donde empieza la particion siguiente");
+        }
+    }
+    return 0;
+}
+
+/// Archivo que entra en un backup; los de entidades llevan mapa de cambios.
+struct ArchivoDatos {
+    fs::path ruta;
+    bool conSeguimiento;
+    /// Valida una copia reconstruida del archivo (validarRegistros del tipo que guarda).
+    std::function<int(const fs::path&)> validar;
+};
+
+/**
+ * Archivos de datos: los de entidades, la lista de particiones de transacciones y las particiones
+ * que nombra la lista `particiones` (la de data/ al crear un backup, la reconstruida al
+ * restaurarlo). Cada uno se guarda con su nombre en data/.
+ */
+std::vector<ArchivoDatos> archivosDatos(const fs::path& particiones)
+{
+    std::vector<ArchivoDatos> archivos = {
+        {PRODUCTOS_PATH, true, validarRegistros<Producto>},
+        {PROVEEDORES_PATH, true, validarRegistros<Proveedor>},
+        {CLIENTES_PATH, true, validarRegistros<Cliente>},
+        {TIENDA_PATH, false, validarRegistros<Tienda>},
+        {TRANSACCIONES_PARTICIONES_PATH, false, validarParticiones},
+    };
+
+    std::vector<ParticionTransacciones> lista;
+    std::string error;
+    if (!ManifiestoParticiones::leer(particiones, lista, error)) {
+        throw std::runtime_error(error);
+    }
+    for (const ParticionTransacciones& particion : lista) {
+        // las archivadas no cambian: su mapa queda vacio y los incrementales no las copian
+        archivos.push_back(
+            {ManifiestoParticiones::rutaArchivo(TRANSACCIONES_PARTICIONES_PATH, particion), true,
+             [primerId = particion.primerId, archivada = particion.archivada](
+                 const fs::path& archivo) {
+                 return archivada ? validarArchivada(archivo, primerId)
+                                  : validarRegistrosDesde<Transaccion>(archivo, primerId);
+             }});
+    }
+    return archivos;
+}
+
+/// El kernel o el filesystem no soportan la copia pedida; se usa el metodo siguiente.
+bool sinSoporte(int error)
+{
+    return error == EXDEV || error == ENOSYS || error == EOPNOTSUPP || error == EINVAL;
+}
+
+/**
+ * Copia [offset, offset + bytes) de `entrada` a la posicion actual de `salida`. Con
+ * copy_file_range los datos no pasan por el proceso (y algunos filesystems los comparten); si no
+ * esta disponible se copia con pread/write.
+ */
+void copiarRango(const DescriptorArchivo& entrada, off_t offset, const DescriptorArchivo& salida,
+                 std::size_t bytes)
+{
+    while (bytes > 0) {
+        off_t desde = offset;
+        const ssize_t copiados =
+            ::copy_file_range(entrada.get(), &desde, salida.get(), nullptr, bytes, 0);
+        if (copiados < 0 && errno == EINTR) {
+            continue;
+        }
+        if (copiados < 0 && sinSoporte(errno)) {
+            std::vector<char> buffer(std::min(bytes, COPIA_BUFFER_SIZE));
+            while (bytes > 0) {
+                const std::size_t parte = std::min(bytes, buffer.size());
+                entrada.leerEn(buffer.data(), parte, offset);
+                salida.escribir(buffer.data(), parte);
+                offset += static_cast<off_t>(parte);
+                bytes -= parte;
+            }
+            return;
+        }
+        if (copiados <= 0) {
+            throw std::runtime_error(std::string("Error copiando datos al backup: ") +
+                                     (copiados < 0 ? std::strerror(errno) : "fin de archivo"));
+        }
+        offset += copiados;
+        bytes -= static_cast<std::size_t>(copiados);
+    }
+}
+
+/// Copia un archivo entero; retorna true si se pudo hacer como reflink (FICLONE).
+bool copiarArchivo(const fs::path& origen, const fs::path& destino, std::uintmax_t tamano)
+{
+    const DescriptorArchivo entrada(origen, O_RDONLY);
+    const DescriptorArchivo salida(destino, O_WRONLY | O_CREAT | O_TRUNC);
+#ifdef FICLONE
+    if (::ioctl(salida.get(), FICLONE, entrada.get()) == 0) {
+        return true;
+    }
+#endif
+    copiarRango(entrada, 0, salida, static_cast<std::size_t>(tamano));
+    return false;
+}
+
+/// Rangos del archivo que ocupan los bloques indicados; los consecutivos van juntos y el ultimo
+/// bloque del archivo puede ser mas corto.
+std::vector<ContenedorComprimido::Rango> rangosDeBloques(const std::vector<std::size_t>& bloques,
+                                                         std::uintmax_t tamano)
+{
+    constexpr std::uintmax_t BLOQUE = RegistroCambios::TAMANO_BLOQUE;
+    std::vector<ContenedorComprimido::Rango> rangos;
+    for (std::size_t i = 0; i < bloques.size();) {
+        std::size_t fin = i + 1;
+        while (fin < bloques.size() && bloques[fin] == bloques[fin - 1] + 1) {
+            ++fin;
+        }
+        const std::uintmax_t offset = bloques[i] * BLOQUE;
+        if (offset < tamano) {
+            rangos.push_back({offset, std::min<std::uintmax_t>((fin - i) * BLOQUE,
+                                                               tamano - offset)});
+        }
+        i = fin;
+    }
+    return rangos;
+}
+
+std::uintmax_t bytesDeRangos(const std::vector<ContenedorComprimido::Rango>& rangos)
+{
+    std::uintmax_t total = 0;
+    for (const ContenedorComprimido::Rango& rango : rangos) {
+        total += rango.bytes;
+    }
+    return total;
+}
+
+std::size_t cantidadFragmentos(std::uintmax_t tamano)
+{
+    return static_cast<std::size_t>((tamano + AlmacenFragmentos::TAMANO_FRAGMENTO - 1) /
+                                    AlmacenFragmentos::TAMANO_FRAGMENTO);
+}
+
+/// Bytes del fragmento `indice` en un archivo de `tamano` bytes (el ultimo puede ser mas corto).
+std::size_t largoFragmento(std::uintmax_t tamano, std::size_t indice)
+{
+    const std::uintmax_t offset =
+        static_cast<std::uintmax_t>(indice) * AlmacenFragmentos::TAMANO_FRAGMENTO;
+    return offset >= tamano ? 0
+                            : static_cast<std::size_t>(std::min<std::uintmax_t>(
+                                  AlmacenFragmentos::TAMANO_FRAGMENTO, tamano - offset));
+}
+
+/// Un archivo de datos a respaldar y lo que se copio de el.
+struct Captura {
+    const ArchivoDatos* datos{nullptr};
+    ArchivoRespaldado respaldado;
+    bool clonado{false};
+    std::uintmax_t bytes{0};
+    std::uintmax_t bytesGuardados{0};
+    /// Deduplicado: hash de cada fragmento; los vacios se leen del archivo al capturar.
+    std::vector<std::string> fragmentos;
+    int fragmentosNuevos{0};
+    /// Copia del original tomada durante la pausa, si se tomo; se guarda desde ella despues.
+    fs::path copia;
+
+    /// Archivo del que se leen los datos a guardar: la copia o, si no hay, el original.
+    const fs::path& origen() const { return copia.empty() ? datos->ruta : copia; }
+};
+
+/// Rangos del archivo que guarda `respaldado`: todo, o los bloques cambiados.
+std::vector<ContenedorComprimido::Rango> rangosGuardados(const ArchivoRespaldado& respaldado)
+{
+    return respaldado.completo
+               ? std::vector<ContenedorComprimido::Rango>{{0, respaldado.tamano}}
+               : rangosDeBloques(respaldado.bloques, respaldado.tamano);
+}
+
+/**
+ * Copia a `directorio`, durante la pausa, lo que despues se va a comprimir del archivo (o,
+ * deduplicado, los fragmentos que planificarFragmentos dejo vacios): entero (como reflink si se
+ * puede) o solo esos rangos, cada uno en su posicion y el resto como hueco.
+ */
+void copiarParaCapturar(Captura& captura, const fs::path& directorio)
+{
+    const ArchivoRespaldado& respaldado = captura.respaldado;
+    std::vector<ContenedorComprimido::Rango> rangos;
+    if (respaldado.formato == GUARDADO_FRAGMENTOS) {
+        for (std::size_t i = 0; i < captura.fragmentos.size(); ++i) {
+            if (captura.fragmentos[i].empty()) {
+                rangos.push_back({static_cast<std::uintmax_t>(i) *
+                                      AlmacenFragmentos::TAMANO_FRAGMENTO,
+                                  largoFragmento(respaldado.tamano, i)});
+            }
+        }
+    } else {
+        rangos = rangosGuardados(respaldado);
+    }
+    captura.copia = directorio / respaldado.nombre;
+    if (bytesDeRangos(rangos) == respaldado.tamano) {
+        copiarArchivo(captura.datos->ruta, captura.copia, respaldado.tamano);
+        return;
+    }
+
+    const DescriptorArchivo entrada(captura.datos->ruta, O_RDONLY);
+    const DescriptorArchivo salida(captura.copia, O_WRONLY | O_CREAT | O_TRUNC);
+    salida.truncar(static_cast<off_t>(respaldado.tamano));
+    for (const ContenedorComprimido::Rango& rango : rangos) {
+        if (::lseek(salida.get(), static_cast<off_t>(rango.offset), SEEK_SET) < 0) {
+            throw std::runtime_error("No se pudo posicionar en " + captura.copia.string());
+        }
+        copiarRango(entrada, static_cast<off_t>(rango.offset), salida,
+                    static_cast<std::size_t>(rango.bytes));
+    }
+}
+
+/**
+ * Decide si el archivo va entero o solo con sus bloques cambiados: esto ultimo requiere que su
+ * mapa de cambios se haya reiniciado en `generacionAnterior` (0 si el backup es completo).
+ */
+Captura planificar(const ArchivoDatos& datos, std::uint64_t generacionAnterior,
+                   FormatoGuardado formato)
+{
+    Captura captura;
+    captura.datos = &datos;
+    captura.respaldado.nombre = datos.ruta.filename().string();
+    captura.respaldado.tamano = fs::file_size(datos.ruta);
+    captura.respaldado.formato = formato;
+
+    RegistroCambios::Estado cambios;
+    if (generacionAnterior == 0 || !datos.conSeguimiento ||
+        !RegistroCambios::leer(datos.ruta, cambios) || cambios.generacion != generacionAnterior) {
+        return captura;
+    }
+
+    const std::size_t bloquesArchivo =
+        static_cast<std::size_t>((captura.respaldado.tamano + RegistroCambios::TAMANO_BLOQUE - 1) /
+                                 RegistroCambios::TAMANO_BLOQUE);
+    captura.respaldado.completo = false;
+    for (const std::size_t bloque : cambios.bloques) {
+        if (bloque < bloquesArchivo) {
+            captura.respaldado.bloques.push_back(bloque);
+        }
+    }
+    return captura;
+}
+
+/// Lee, hashea y guarda en el almacen los fragmentos que planificarFragmentos dejo vacios, y
+/// escribe la lista completa en el backup.
+void capturarFragmentos(Captura& captura, const fs::path& directorio,
+                        const AlmacenFragmentos& almacen)
+{
+    const std::uintmax_t tamano = captura.respaldado.tamano;
+    std::vector<std::size_t> pendientes;
+    for (std::size_t i = 0; i < captura.fragmentos.size(); ++i) {
+        if (captura.fragmentos[i].empty()) {
+            pendientes.push_back(i);
+        }
+    }
+
+    std::vector<std::uintmax_t> guardados(pendientes.size());
+    if (!pendientes.empty()) {
+        const DescriptorArchivo entrada(captura.origen(), O_RDONLY);
+        EjecutorTareas::global().paraCadaIndice(
+            "backup fragmentos", pendientes.size(), [&](std::size_t j) {
+                const std::size_t indice = pendientes[j];
+                std::vector<char> datos(largoFragmento(tamano, indice));
+                entrada.leerEn(datos.data(), datos.size(),
+                               static_cast<off_t>(indice * AlmacenFragmentos::TAMANO_FRAGMENTO));
+                captura.fragmentos[indice] = Sha256::hex(datos.data(), datos.size());
+                guardados[j] = almacen.guardar(captura.fragmentos[indice], datos.data(),
+                                               datos.size());
+            });
+    }
+
+    const fs::path lista = directorio / captura.respaldado.nombreGuardado();
+    AlmacenFragmentos::escribirLista(lista, captura.fragmentos);
+    captura.bytes = tamano;
+    captura.bytesGuardados = fs::file_size(lista);
+    for (const std::uintmax_t bytes : guardados) {
+        captura.bytesGuardados += bytes;
+        captura.fragmentosNuevos += bytes > 0 ? 1 : 0;
+    }
+}
+
+void capturar(Captura& captura, const fs::path& directorio, const AlmacenFragmentos& almacen)
+{
+    if (captura.respaldado.formato == GUARDADO_FRAGMENTOS) {
+        capturarFragmentos(captura, directorio, almacen);
+        return;
+    }
+
+    const fs::path& origen = captura.origen();
+    const ArchivoRespaldado& respaldado = captura.respaldado;
+    const fs::path destino = directorio / respaldado.nombreGuardado();
+    const std::vector<ContenedorComprimido::Rango> rangos = rangosGuardados(respaldado);
+    captura.bytes = bytesDeRangos(rangos);
+
+    if (respaldado.formato == GUARDADO_LZ4) {
+        captura.bytesGuardados = ContenedorComprimido::comprimir(origen, rangos, destino);
+        return;
+    }
+    if (respaldado.completo) {
+        captura.clonado = copiarArchivo(origen, destino, respaldado.tamano);
+    } else {
+        const DescriptorArchivo entrada(origen, O_RDONLY);
+        const DescriptorArchivo salida(destino, O_WRONLY | O_CREAT | O_TRUNC);
+        for (const ContenedorComprimido::Rango& rango : rangos) {
+            copiarRango(entrada, static_cast<off_t>(rango.offset), salida,
+                        static_cast<std::size_t>(rango.bytes));
+        }
+    }
+    captura.bytesGuardados = captura.bytes;
+}
+
+/// Verifica la suma del archivo guardado, si el manifiesto la tiene.
+void verificarSuma(const fs::path& directorio, const ArchivoRespaldado& respaldado)
+{
+    if (!respaldado.suma) {
+        return;
+    }
+    const fs::path guardado = directorio / respaldado.nombreGuardado();
+    std::uint64_t suma = 0;
+    std::string error;
+    if (!SumaVerificacion::deArchivo(guardado, suma, error)) {
+        throw std::runtime_error(error);
+    }
+    if (suma != *respaldado.suma) {
+        throw std::runtime_error("La suma de " + guardado.string() + " no coincide");
+    }
+}
+
+/**
+ * Deduplicado: el archivo va entero como lista de fragmentos. Si su mapa de cambios se reinicio
+ * en el backup `anterior` y este lo guardo igual, los fragmentos sin bloques cambiados reusan el
+ * hash de su lista y no se vuelven a leer; los demas quedan vacios para capturarFragmentos.
+ */
+Captura planificarFragmentos(const ArchivoDatos& datos, const ManifiestoBackup* anterior,
+                             const fs::path& raiz, const AlmacenFragmentos& almacen)
+{
+    Captura captura;
+    captura.datos = &datos;
+    captura.respaldado.nombre = datos.ruta.filename().string();
+    captura.respaldado.tamano = fs::file_size(datos.ruta);
+    captura.respaldado.formato = GUARDADO_FRAGMENTOS;
+    captura.fragmentos.resize(cantidadFragmentos(captura.respaldado.tamano));
+
+    RegistroCambios::Estado cambios;
+    if (anterior == nullptr || !datos.conSeguimiento ||
+        !RegistroCambios::leer(datos.ruta, cambios) || cambios.generacion != anterior->generacion) {
+        return captura;
+    }
+    const auto previo =
+        std::find_if(anterior->archivos.begin(), anterior->archivos.end(),
+                     [&](const ArchivoRespaldado& a) {
+                         return a.nombre == captura.respaldado.nombre &&
+                                a.formato == GUARDADO_FRAGMENTOS;
+                     });
+    if (previo == anterior->archivos.end()) {
+        return captura;
+    }
+    std::vector<std::string> hashes;
+    try {
+        verificarSuma(raiz / anterior->id, *previo);
+        hashes = AlmacenFragmentos::leerLista(raiz / anterior->id / previo->nombreGuardado());
+    } catch (const std::exception&) {
+        // una lista danada no se hereda: se vuelven a leer todos los fragmentos
+        return captura;
+    }
+    if (hashes.size() != cantidadFragmentos(previo->tamano)) {
+        return captura;
+    }
+
+    std::vector<bool> cambiados(captura.fragmentos.size());
+    for (const std::size_t bloque : cambios.bloques) {
+        if (bloque / BLOQUES_POR_FRAGMENTO < cambiados.size()) {
+            cambiados[bloque / BLOQUES_POR_FRAGMENTO] = true;
+        }
+    }
+    for (std::size_t i = 0; i < std::min(cambiados.size(), hashes.size()); ++i) {
+        if (!cambiados[i] &&
+            largoFragmento(captura.respaldado.tamano, i) == largoFragmento(previo->tamano, i) &&
+            almacen.existe(hashes[i])) {
+            captura.fragmentos[i] = std::move(hashes[i]);
+        }
+    }
+    return captura;
+}
+
+/// Reconstruye en `destino` un archivo guardado como lista de fragmentos, en paralelo; suma a
+/// `outLeidos` lo que ocupan los fragmentos en el almacen.
+void materializarFragmentos(const AlmacenFragmentos& almacen, const fs::path& lista,
+                            const ArchivoRespaldado& respaldado, const fs::path& destino,
+                            std::uintmax_t& outLeidos)
+{
+    const std::vector<std::string> hashes = AlmacenFragmentos::leerLista(lista);
+    if (hashes.size() != cantidadFragmentos(respaldado.tamano)) {
+        throw std::runtime_error("La lista " + lista.string() + " no cubre el archivo");
+    }
+
+    const DescriptorArchivo salida(destino, O_WRONLY | O_CREAT | O_TRUNC);
+    salida.truncar(static_cast<off_t>(respaldado.tamano));
+    std::vector<std::uintmax_t> leidos(hashes.size());
+    if (!hashes.empty()) {
+        EjecutorTareas::global().paraCadaIndice(
+            "extraer fragmentos", hashes.size(), [&](std::size_t i) {
+                std::vector<char> datos(AlmacenFragmentos::TAMANO_FRAGMENTO);
+                const std::size_t bytes = almacen.leer(hashes[i], datos.data(), leidos[i]);
+                if (bytes != largoFragmento(respaldado.tamano, i)) {
+                    throw std::runtime_error("Fragmento " + hashes[i] +
+                                             " de tamano inesperado en " + lista.string());
+                }
+                salida.escribirEn(datos.data(), bytes,
+                                  static_cast<off_t>(i * AlmacenFragmentos::TAMANO_FRAGMENTO));
+            });
+    }
+    for (const std::uintmax_t bytes : leidos) {
+        outLeidos += bytes;
+    }
+}
+
+/**
+ * Escribe en `destino` lo que el backup guardo del archivo (descomprimido o armado con sus
+ * fragmentos si hace falta) y comprueba que tenga el tamano esperado. Retorna true si la copia
+ * fue un reflink.
+ */
+bool materializar(const AlmacenFragmentos& almacen, const fs::path& directorio,
+                  const ArchivoRespaldado& respaldado, const fs::path& destino,
+                  std::uintmax_t bytesEsperados, std::uintmax_t& outLeidos)
+{
+    const fs::path guardado = directorio / respaldado.nombreGuardado();
+    outLeidos += fs::file_size(guardado);
+    bool clonado = false;
+    std::uintmax_t bytes = 0;
+    if (respaldado.formato == GUARDADO_FRAGMENTOS) {
+        materializarFragmentos(almacen, guardado, respaldado, destino, outLeidos);
+        bytes = respaldado.tamano;
+    } else if (respaldado.formato == GUARDADO_LZ4) {
+        bytes = ContenedorComprimido::descomprimir(guardado, destino);
+    } else {
+        bytes = fs::file_size(guardado);
+        clonado = copiarArchivo(guardado, destino, bytes);
+    }
+    if (bytes != bytesEsperados) {
+        throw std::runtime_error("Tamano inesperado en " + guardado.string());
+    }
+    return clonado;
+}
+
+/// Escribe los bloques guardados en `bloques` (uno tras otro) en su posicion dentro de `archivo`.
+void aplicarBloques(const fs::path& bloques, const ArchivoRespaldado& respaldado,
+                    const fs::path& archivo)
+{
+    const DescriptorArchivo entrada(bloques, O_RDONLY);
+    const DescriptorArchivo salida(archivo, O_WRONLY);
+    salida.truncar(static_cast<off_t>(respaldado.tamano));
+    std::vector<char> buffer(COPIA_BUFFER_SIZE);
+    std::uintmax_t leidos = 0;
+    for (const ContenedorComprimido::Rango& rango :
+         rangosDeBloques(respaldado.bloques, respaldado.tamano)) {
+        for (std::uintmax_t hecho = 0; hecho < rango.bytes;) {
+            const std::size_t parte = static_cast<std::size_t>(
+                std::min<std::uintmax_t>(buffer.size(), rango.bytes - hecho));
+            entrada.leerEn(buffer.data(), parte, static_cast<off_t>(leidos));
+            salida.escribirEn(buffer.data(), parte, static_cast<off_t>(rango.offset + hecho));
+            leidos += parte;
+            hecho += parte;
+        }
+    }
+}
+
+/// Borra el contenido de `directorio` sin borrarlo a el (sobre el se toma el flock).
+void vaciar(const fs::path& directorio)
+{
+    std::error_code ec;
+    std::vector<fs::path> entradas;
+    for (const fs::directory_entry& entrada : fs::directory_iterator(directorio, ec)) {
+        entradas.push_back(entrada.path());
+    }
+    for (const fs::path& entrada : entradas) {
+        fs::remove_all(entrada, ec);
+    }
+}
+
+/**
+ * Copia los archivos validados en `preparacion` sobre los de datos y borra el diario. Se escribe
+ * en los mismos inodos (sin rename) para que los descriptores abiertos de este y otros procesos
+ * vean los datos restaurados; repetirlo tras una interrupcion da el mismo resultado. Los mapas
+ * de cambios se reinician en la generacion 0, que no es la de ningun backup: el siguiente copia
+ * todo. Retorna cuanto estuvieron detenidas las operaciones.
+ */
+double aplicarRestauracion(const fs::path& preparacion, const std::function<void()>& alAplicar)
+{
+    const auto inicio = steady_clock::now();
+    {
+        const auto sinOperaciones = ControlVersiones::global().detenerOperaciones();
+        const BloqueoArchivo puerta(COMMITS_LOCK_PATH, BloqueoArchivo::EXCLUSIVO);
+        exigirBloqueo(puerta, COMMITS_LOCK_PATH);
+        // ni altas de transacciones ni meses nuevos mientras cambia la lista de particiones
+        const BloqueoArchivo sinAltas(TRANSACCIONES_LOCK_PATH, BloqueoArchivo::EXCLUSIVO);
+        exigirBloqueo(sinAltas, TRANSACCIONES_LOCK_PATH);
+        {
+            const fs::path particiones = preparacion / TRANSACCIONES_PARTICIONES_PATH.filename();
+            std::vector<ArchivoDatos> archivos = archivosDatos(particiones);
+            std::erase_if(archivos, [](const ArchivoDatos& datos) {
+                return datos.ruta == TRANSACCIONES_PARTICIONES_PATH;
+            });
+
+            // particiones actuales que el backup no tiene: se vacian en su inodo y salen de la
+            // lista. Si la lista actual no se puede leer no hay nada que vaciar.
+            std::vector<fs::path> sobrantes;
+            std::vector<ParticionTransacciones> actuales;
+            std::string error;
+            if (ManifiestoParticiones::leer(TRANSACCIONES_PARTICIONES_PATH, actuales, error)) {
+                for (const ParticionTransacciones& particion : actuales) {
+                    const fs::path ruta = ManifiestoParticiones::rutaArchivo(
+                        TRANSACCIONES_PARTICIONES_PATH, particion);
+                    if (std::ranges::none_of(archivos, [&](const ArchivoDatos& datos) {
+                            return datos.ruta == ruta;
+                        })) {
+                        sobrantes.push_back(ruta);
+                    }
+                }
+            }
+
+            std::vector<std::unique_ptr<BloqueoArchivo>> bloqueos;
+            for (const ArchivoDatos& datos : archivos) {
+                bloqueos.push_back(
+                    std::make_unique<BloqueoArchivo>(datos.ruta, BloqueoArchivo::EXCLUSIVO));
+                // uno que todavia no existe no lo puede estar usando nadie
+                if (fs::exists(datos.ruta)) {
+                    exigirBloqueo(*bloqueos.back(), datos.ruta);
+                }
+            }
+            for (const fs::path& ruta : sobrantes) {
+                bloqueos.push_back(
+                    std::make_unique<BloqueoArchivo>(ruta, BloqueoArchivo::EXCLUSIVO));
+                exigirBloqueo(*bloqueos.back(), ruta);
+            }
+            EjecutorTareas::global().paraCadaIndice(
+                "restaurar copia", archivos.size(), [&](std::size_t i) {
+                    const ArchivoDatos& datos = archivos[i];
+                    const fs::path origen = preparacion / datos.ruta.filename();
+                    const std::uintmax_t tamano = fs::file_size(origen);
+                    const DescriptorArchivo entrada(origen, O_RDONLY);
+                    const DescriptorArchivo salida(datos.ruta, O_WRONLY | O_CREAT);
+                    copiarRango(entrada, 0, salida, static_cast<std::size_t>(tamano));
+                    salida.truncar(static_cast<off_t>(tamano));
+                    salida.sincronizar();
+
+                    std::string error;
+                    if (datos.conSeguimiento && !RegistroCambios::reiniciar(datos.ruta, 0, error)) {
+                        throw std::runtime_error(error);
+                    }
+                });
+            for (const fs::path& ruta : sobrantes) {
+                const DescriptorArchivo salida(ruta, O_WRONLY);
+                salida.truncar(0);
+                salida.sincronizar();
+                if (!RegistroCambios::reiniciar(ruta, 0, error)) {
+                    throw std::runtime_error(error);
+                }
+            }
+
+            // la lista va ultima y de una vez: quien la lee sin locks ve la anterior o la nueva
+            const fs::path temporal =
+                fs::path(TRANSACCIONES_PARTICIONES_PATH).concat(".restaurando");
+            fs::copy_file(particiones, temporal, fs::copy_options::overwrite_existing);
+            DescriptorArchivo(temporal, O_RDONLY).sincronizar();
+            fs::rename(temporal, TRANSACCIONES_PARTICIONES_PATH);
+        }
+
+        // sin los flocks de datos: alAplicar puede leer los repositorios de este proceso
+        alAplicar();
+        fs::remove(preparacion / DIARIO_RESTAURACION);
+    }
+    vaciar(preparacion);
+    return duration<double, std::milli>(steady_clock::now() - inicio).count();
+}
+
+/**
+ * Ids de los backups que conserva la politica. Se recorren del mas reciente al mas antiguo: se
+ * toman los `ultimos` N y, para cada criterio, el primero (el mas reciente) de cada hora, dia o
+ * mes distinto hasta juntar N periodos. El mas reciente se conserva siempre.
+ */
+std::unordered_set<std::string> seleccionarConservados(
+    const std::vector<ManifiestoBackup>& backups, const PoliticaRetencion& politica)
+{
+    struct Criterio {
+        int cantidad;
+        std::string_view formato;
+        std::string ultimoPeriodo;
+    };
+    Criterio criterios[] = {
+        {politica.horas, "{:%Y-%m-%d %H}", ""},
+        {politica.dias, "{:%Y-%m-%d}", ""},
+        {politica.meses, "{:%Y-%m}", ""},
+    };
+
+    std::unordered_set<std::string> conservados;
+    int ultimos = politica.ultimos;
+    for (auto backup = backups.rbegin(); backup != backups.rend(); ++backup) {
+        bool conservar = backup == backups.rbegin();
+        if (ultimos > 0) {
+            --ultimos;
+            conservar = true;
+        }
+
+        const sys_seconds momento{duration_cast<seconds>(nanoseconds(backup->generacion))};
+        const zoned_time horaLocal{current_zone(), momento};
+        for (Criterio& criterio : criterios) {
+            const std::string periodo =
+                std::vformat(criterio.formato, std::make_format_args(horaLocal));
+            if (criterio.cantidad > 0 && periodo != criterio.ultimoPeriodo) {
+                --criterio.cantidad;
+                criterio.ultimoPeriodo = periodo;
+                conservar = true;
+            }
+        }
+        if (conservar) {
+            conservados.insert(backup->id);
+        }
+    }
+    return conservados;
+}
+
+std::uintmax_t tamanoDirectorio(const fs::path& directorio)
+{
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for (const fs::directory_entry& entrada : fs::recursive_directory_iterator(directorio, ec)) {
+        if (entrada.is_regular_file(ec)) {
+            total += entrada.file_size(ec);
+        }
+    }
+    return total;
+}
+
+/// Nombre del directorio del backup: fecha y hora local, con sufijo si ya existe.
+std::string nuevoId(const fs::path& raiz)
+{
+    const auto ahora = time_point_cast<seconds>(system_clock::now());
+    const zoned_time horaLocal{current_zone(), ahora};
+    const std::string base = std::format("{:%Y-%m-%d.%H:%M:%S}", horaLocal);
+    std::string id = base;
+    for (int sufijo = 2; fs::exists(raiz / id) || fs::exists(raiz / (id + ".parcial")); ++sufijo) {
+        id = std::format("{}-{}", base, sufijo);
+    }
+    return id;
+}
+
+}  // namespace
+
+GestorBackups::GestorBackups(fs::path raiz) : raiz(std::move(raiz)) {}
+
+ResumenBackup GestorBackups::crear(bool forzarCompleto, FormatoBackup formato)
+{
+    fs::create_directories(raiz);
+    // aplicarRetencion no borra backups ni fragmentos mientras se crea uno
+    const BloqueoArchivo sinRetencion(raiz, BloqueoArchivo::COMPARTIDO);
+    exigirBloqueo(sinRetencion, raiz);
+    const AlmacenFragmentos almacen(raiz);
+    const std::vector<ManifiestoBackup> previos = ManifiestoBackup::listar(raiz);
+    const ManifiestoBackup* anterior = previos.empty() ? nullptr : &previos.back();
+    const bool deduplicado = formato == BACKUP_DEDUPLICADO;
+    const bool incremental = !deduplicado && !forzarCompleto && anterior != nullptr &&
+                             anterior->eslabon < INCREMENTALES_POR_COMPLETO;
+
+    ManifiestoBackup manifiesto;
+    manifiesto.id = nuevoId(raiz);
+    manifiesto.tipo = incremental ? BACKUP_INCREMENTAL : BACKUP_COMPLETO;
+    const auto ahora = duration_cast<nanoseconds>(system_clock::now().time_since_epoch());
+    manifiesto.generacion = std::max<std::uint64_t>(static_cast<std::uint64_t>(ahora.count()),
+                                                    anterior ? anterior->generacion + 1 : 1);
+    if (incremental) {
+        manifiesto.base = anterior->id;
+        manifiesto.completo = anterior->completo;
+        manifiesto.eslabon = anterior->eslabon + 1;
+    } else {
+        manifiesto.completo = manifiesto.id;
+    }
+
+    const fs::path destino = raiz / manifiesto.id;
+    const fs::path parcial = raiz / (manifiesto.id + ".parcial");
+    fs::create_directory(parcial);
+
+    ResumenBackup resumen;
+    resumen.incremental = incremental;
+    try {
+        std::vector<ArchivoDatos> archivos;
+        std::vector<Captura> capturas;
+        const fs::path copias = parcial / "copias";
+        const auto inicioPausa = steady_clock::now();
+        {
+            // punto consistente: ninguna venta/compra/cancelacion a medias, en este proceso ni
+            // en otros, y ninguna escritura suelta mientras se copia y se reinician los mapas
+            const auto sinOperaciones = ControlVersiones::global().detenerOperaciones();
+            const BloqueoArchivo puerta(COMMITS_LOCK_PATH, BloqueoArchivo::EXCLUSIVO);
+            exigirBloqueo(puerta, COMMITS_LOCK_PATH);
+            // tampoco se abre una particion nueva: la lista queda fija hasta copiarla
+            const BloqueoArchivo sinParticionNueva(TRANSACCIONES_LOCK_PATH,
+                                                   BloqueoArchivo::COMPARTIDO);
+            exigirBloqueo(sinParticionNueva, TRANSACCIONES_LOCK_PATH);
+            archivos = archivosDatos(TRANSACCIONES_PARTICIONES_PATH);
+            std::vector<std::unique_ptr<BloqueoArchivo>> bloqueos;
+            for (const ArchivoDatos& datos : archivos) {
+                if (!fs::exists(datos.ruta)) {
+                    continue;
+                }
+                bloqueos.push_back(
+                    std::make_unique<BloqueoArchivo>(datos.ruta, BloqueoArchivo::COMPARTIDO));
+                exigirBloqueo(*bloqueos.back(), datos.ruta);
+                if (deduplicado) {
+                    capturas.push_back(planificarFragmentos(
+                        datos, forzarCompleto ? nullptr : anterior, raiz, almacen));
+                } else {
+                    capturas.push_back(
+                        planificar(datos, incremental ? anterior->generacion : 0,
+                                   formato == BACKUP_COMPRIMIDO ? GUARDADO_LZ4 : GUARDADO_PLANO));
+                }
+            }
+
+            // en la pausa solo se copia: comprimir y hashear se hace despues desde la copia
+            fs::create_directory(copias);
+            EjecutorTareas::global().paraCadaIndice(
+                "backup copia", capturas.size(), [&](std::size_t i) {
+                    if (capturas[i].respaldado.formato != GUARDADO_PLANO) {
+                        copiarParaCapturar(capturas[i], copias);
+                    } else {
+                        capturar(capturas[i], parcial, almacen);
+                    }
+                });
+
+            for (const Captura& captura : capturas) {
+                std::string error;
+                if (captura.datos->conSeguimiento &&
+                    !RegistroCambios::reiniciar(captura.datos->ruta, manifiesto.generacion,
+                                                error)) {
+                    throw std::runtime_error(error);
+                }
+            }
+        }
+        resumen.msPausa = duration<double, std::milli>(steady_clock::now() - inicioPausa).count();
+
+        EjecutorTareas::global().paraCadaIndice(
+            "backup comprimir", capturas.size(), [&](std::size_t i) {
+                if (!capturas[i].copia.empty()) {
+                    capturar(capturas[i], parcial, almacen);
+                }
+            });
+        fs::remove_all(copias);
+
+        // las sumas se calculan sobre la copia, ya sin detener a nadie
+        EjecutorTareas::global().paraCadaIndice(
+            "backup sumas", capturas.size(), [&](std::size_t i) {
+                std::uint64_t suma = 0;
+                std::string error;
+                const fs::path guardado = parcial / capturas[i].respaldado.nombreGuardado();
+                if (!SumaVerificacion::deArchivo(guardado, suma, error)) {
+                    throw std::runtime_error(error);
+                }
+                capturas[i].respaldado.suma = suma;
+            });
+
+        for (Captura& captura : capturas) {
+            resumen.bytes += captura.bytes;
+            resumen.bytesGuardados += captura.bytesGuardados;
+            resumen.clonados += captura.clonado ? 1 : 0;
+            resumen.fragmentos += static_cast<int>(captura.fragmentos.size());
+            resumen.fragmentosNuevos += captura.fragmentosNuevos;
+            manifiesto.archivos.push_back(std::move(captura.respaldado));
+        }
+
+        std::string error;
+        if (!manifiesto.escribir(parcial, error)) {
+            throw std::runtime_error(error);
+        }
+        fs::rename(parcial, destino);
+    } catch (...) {
+        std::error_code ec;
+        fs::remove_all(parcial, ec);
+        throw;
+    }
+
+    resumen.ruta = destino.string();
+    resumen.archivos = static_cast<int>(manifiesto.archivos.size());
+    return resumen;
+}
+
+std::string GestorBackups::ultimo() const
+{
+    const std::vector<ManifiestoBackup> backups = ManifiestoBackup::listar(raiz);
+    if (backups.empty()) {
+        throw std::runtime_error("No hay backups en " + raiz.string());
+    }
+    return backups.back().id;
+}
+
+std::vector<ManifiestoBackup> GestorBackups::cadena(const std::string& id) const
+{
+    std::vector<ManifiestoBackup> eslabones;
+    std::string siguiente = id;
+    while (true) {
+        ManifiestoBackup manifiesto;
+        std::string error;
+        if (!ManifiestoBackup::leer(raiz / siguiente, manifiesto, error)) {
+            throw std::runtime_error(error);
+        }
+
+        // cada eslabon tiene que ser el anterior del que lo nombra como base
+        if (manifiesto.id != siguiente ||
+            (!eslabones.empty() &&
+             (manifiesto.eslabon != eslabones.back().eslabon - 1 ||
+              manifiesto.completo != eslabones.back().completo ||
+              manifiesto.generacion >= eslabones.back().generacion))) {
+            throw std::runtime_error("Cadena de backups inconsistente en " + siguiente);
+        }
+        eslabones.push_back(std::move(manifiesto));
+        if (eslabones.back().tipo == BACKUP_COMPLETO) {
+            break;
+        }
+        siguiente = eslabones.back().base;
+    }
+
+    std::reverse(eslabones.begin(), eslabones.end());
+    return eslabones;
+}
+
+ResumenBackup GestorBackups::extraer(const std::string& id, const fs::path& destino)
+{
+    const BloqueoArchivo sinRetencion(raiz, BloqueoArchivo::COMPARTIDO);
+    exigirBloqueo(sinRetencion, raiz);
+    const AlmacenFragmentos almacen(raiz);
+    const std::vector<ManifiestoBackup> eslabones = cadena(id.empty() ? ultimo() : id);
+    std::error_code ec;
+    if (fs::exists(destino) && !fs::is_empty(destino, ec)) {
+        throw std::runtime_error("El destino " + destino.string() + " no esta vacio");
+    }
+    fs::create_directories(destino);
+
+    // primero las sumas de toda la cadena, en paralelo: un archivo danado no deja nada escrito
+    std::vector<std::pair<fs::path, const ArchivoRespaldado*>> guardados;
+    for (const ManifiestoBackup& eslabon : eslabones) {
+        for (const ArchivoRespaldado& respaldado : eslabon.archivos) {
+            guardados.emplace_back(raiz / eslabon.id, &respaldado);
+        }
+    }
+    EjecutorTareas::global().paraCadaIndice(
+        "backup verificar", guardados.size(),
+        [&](std::size_t i) { verificarSuma(guardados[i].first, *guardados[i].second); });
+
+    // cada archivo se reconstruye por separado: su copia completa y luego, en orden, los bloques
+    // de cada incremental de la cadena
+    const ManifiestoBackup& objetivo = eslabones.back();
+    std::vector<Captura> extraidos(objetivo.archivos.size());
+    try {
+        EjecutorTareas::global().paraCadaIndice(
+            "backup extraer", objetivo.archivos.size(), [&](std::size_t i) {
+                const std::string& nombre = objetivo.archivos[i].nombre;
+                const fs::path archivo = destino / nombre;
+                Captura& extraido = extraidos[i];
+                bool conBase = false;
+                for (const ManifiestoBackup& eslabon : eslabones) {
+                    const auto respaldado = std::find_if(
+                        eslabon.archivos.begin(), eslabon.archivos.end(),
+                        [&](const ArchivoRespaldado& a) { return a.nombre == nombre; });
+                    if (respaldado == eslabon.archivos.end()) {
+                        continue;
+                    }
+
+                    const fs::path directorio = raiz / eslabon.id;
+                    if (respaldado->completo) {
+                        extraido.clonado =
+                            materializar(almacen, directorio, *respaldado, archivo,
+                                         respaldado->tamano, extraido.bytesGuardados);
+                        conBase = true;
+                        continue;
+                    }
+                    if (!conBase) {
+                        throw std::runtime_error("Falta la copia completa de " + nombre +
+                                                 " en la cadena de " + objetivo.id);
+                    }
+                    fs::path bloques = archivo;
+                    bloques += ".bloques";
+                    const std::uintmax_t bytesBloques =
+                        bytesDeRangos(rangosDeBloques(respaldado->bloques, respaldado->tamano));
+                    materializar(almacen, directorio, *respaldado, bloques, bytesBloques,
+                                 extraido.bytesGuardados);
+                    aplicarBloques(bloques, *respaldado, archivo);
+                    fs::remove(bloques);
+                    extraido.clonado = false;
+                }
+                extraido.bytes = objetivo.archivos[i].tamano;
+            });
+    } catch (...) {
+        // el destino estaba vacio: no se dejan archivos a medio reconstruir
+        for (const fs::directory_entry& entrada : fs::directory_iterator(destino, ec)) {
+            fs::remove_all(entrada.path(), ec);
+        }
+        throw;
+    }
+
+    ResumenBackup resumen;
+    resumen.ruta = destino.string();
+    resumen.incremental = objetivo.tipo == BACKUP_INCREMENTAL;
+    resumen.archivos = static_cast<int>(extraidos.size());
+    for (const Captura& extraido : extraidos) {
+        resumen.bytes += extraido.bytes;
+        resumen.bytesGuardados += extraido.bytesGuardados;
+        resumen.clonados += extraido.clonado ? 1 : 0;
+    }
+    return resumen;
+}
+
+ResumenBackup GestorBackups::restaurar(const std::string& id, const fs::path& preparacion,
+                                       const std::function<void()>& alAplicar)
+{
+    const std::string objetivo = id.empty() ? ultimo() : id;
+    fs::create_directories(preparacion);
+    // una restauracion a la vez; tambien excluye a completarPendiente de otros procesos
+    const BloqueoArchivo unaALaVez(preparacion, BloqueoArchivo::EXCLUSIVO);
+    exigirBloqueo(unaALaVez, preparacion);
+    if (fs::exists(preparacion / DIARIO_RESTAURACION)) {
+        aplicarRestauracion(preparacion, alAplicar);
+    }
+    vaciar(preparacion);
+
+    // todo lo que puede fallar ocurre aca, sin detener operaciones ni tocar los datos
+    ResumenBackup resumen;
+    try {
+        resumen = extraer(objetivo, preparacion);
+        // un backup anterior a las particiones trae el archivo unico: se reparte aca
+        const fs::path particiones = preparacion / TRANSACCIONES_PARTICIONES_PATH.filename();
+        const fs::path archivoUnico = preparacion / TRANSACCIONES_PATH.filename();
+        std::string error;
+        if (!fs::exists(particiones) && fs::exists(archivoUnico) &&
+            !ManifiestoParticiones::particionar(archivoUnico, particiones, error)) {
+            throw std::runtime_error(error);
+        }
+
+        const std::vector<ArchivoDatos> archivos = archivosDatos(particiones);
+        for (const ArchivoDatos& datos : archivos) {
+            if (!fs::exists(preparacion / datos.ruta.filename())) {
+                throw std::runtime_error("El backup no incluye " + datos.ruta.filename().string());
+            }
+        }
+
+        std::vector<int> activos(archivos.size());
+        EjecutorTareas::global().paraCadaIndice(
+            "restaurar validar", archivos.size(), [&](std::size_t i) {
+                const fs::path archivo = preparacion / archivos[i].ruta.filename();
+                activos[i] = archivos[i].validar(archivo);
+                DescriptorArchivo(archivo, O_RDONLY).sincronizar();
+            });
+        for (const int cantidad : activos) {
+            resumen.registros += cantidad;
+        }
+
+        // con el diario en disco la restauracion ya no se pierde: si se interrumpe, se repite
+        const std::string contenido = objetivo + "\n";
+        {
+            const DescriptorArchivo diario(preparacion / DIARIO_RESTAURACION,
+                                           O_WRONLY | O_CREAT | O_TRUNC);
+            diario.escribir(contenido.data(), contenido.size());
+            diario.sincronizar();
+        }
+        DescriptorArchivo(preparacion, O_RDONLY).sincronizar();
+    } catch (...) {
+        vaciar(preparacion);
+        throw;
+    }
+
+    resumen.msPausa = aplicarRestauracion(preparacion, alAplicar);
+    resumen.ruta = objetivo;
+    return resumen;
+}
+
+bool GestorBackups::completarPendiente(const fs::path& preparacion,
+                                       const std::function<void()>& alAplicar)
+{
+    if (!fs::exists(preparacion / DIARIO_RESTAURACION)) {
+        return false;
+    }
+    const BloqueoArchivo unaALaVez(preparacion, BloqueoArchivo::EXCLUSIVO);
+    exigirBloqueo(unaALaVez, preparacion);
+    // la restauracion que lo escribio pudo terminar mientras se esperaba el flock
+    if (!fs::exists(preparacion / DIARIO_RESTAURACION)) {
+        return false;
+    }
+    aplicarRestauracion(preparacion, alAplicar);
+    return true;
+}
+
+ResumenRetencion GestorBackups::aplicarRetencion(const PoliticaRetencion& politica)
+{
+    if (politica.ultimos <= 0 && politica.horas <= 0 && politica.dias <= 0 &&
+        politica.meses <= 0) {
+        throw std::runtime_error(
+            "La politica no conserva ningun backup (indique ultimos, horas, dias o meses)");
+    }
+    fs::create_directories(raiz);
+    // con el flock exclusivo ningun backup se esta creando, extrayendo ni restaurando
+    const BloqueoArchivo exclusivo(raiz, BloqueoArchivo::EXCLUSIVO);
+    exigirBloqueo(exclusivo, raiz);
+    const std::vector<ManifiestoBackup> backups = ManifiestoBackup::listar(raiz);
+
+    // un incremental no se puede reconstruir sin los backups anteriores de su cadena
+    std::unordered_set<std::string> conservados = seleccionarConservados(backups, politica);
+    for (const std::string& id : std::vector<std::string>(conservados.begin(), conservados.end())) {
+        for (const ManifiestoBackup& eslabon : cadena(id)) {
+            conservados.insert(eslabon.id);
+        }
+    }
+
+    ResumenRetencion resumen;
+    std::error_code ec;
+    for (const ManifiestoBackup& backup : backups) {
+        if (conservados.contains(backup.id)) {
+            continue;
+        }
+        const std::uintmax_t bytes = tamanoDirectorio(raiz / backup.id);
+        fs::remove_all(raiz / backup.id);
+        ++resumen.eliminados;
+        resumen.bytesLiberados += bytes;
+    }
+    resumen.conservados = static_cast<int>(backups.size()) - resumen.eliminados;
+
+    // marcar: toda lista de fragmentos que quede bajo `raiz`, aunque su manifiesto no se pueda
+    // leer; los `.parcial` son backups que no terminaron (ninguno esta en curso) y se borran antes
+    std::unordered_set<std::string> referenciados;
+    for (const fs::directory_entry& directorio : fs::directory_iterator(raiz)) {
+        const fs::path ruta = directorio.path();
+        if (!directorio.is_directory(ec) || ruta.filename() == "objetos") {
+            continue;
+        }
+        if (ruta.extension() == ".parcial") {
+            resumen.bytesLiberados += tamanoDirectorio(ruta);
+            fs::remove_all(ruta);
+            continue;
+        }
+        for (const fs::directory_entry& archivo : fs::directory_iterator(ruta)) {
+            if (archivo.path().extension() == ".fragmentos") {
+                for (std::string& hash : AlmacenFragmentos::leerLista(archivo.path())) {
+                    referenciados.insert(std::move(hash));
+                }
+            }
+        }
+    }
+
+    // barrer: una lista ilegible ya lanzo antes de llegar aca, sin borrar ningun fragmento
+    const AlmacenFragmentos::Limpieza limpieza = AlmacenFragmentos(raiz).limpiar(referenciados);
+    resumen.objetosEliminados = limpieza.objetos;
+    resumen.bytesLiberados += limpieza.bytes;
+    return resumen;
+}
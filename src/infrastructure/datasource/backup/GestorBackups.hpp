@@ -0,0 +1,101 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "domain/repositories/IDatabaseAdmin.hpp"
+#include "infrastructure/datasource/backup/ManifiestoBackup.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Crea backups de los archivos de datos bajo `raiz`: deduplicados, o completos e
+ * incrementales.
+ *
+ * Cada backup es un directorio con su ManifiestoBackup. Deduplicado (el modo por defecto), cada
+ * archivo se guarda como una lista de fragmentos del AlmacenFragmentos en `raiz/objetos`, que
+ * comparten todos los backups: cada backup es completo por si mismo pero solo ocupa los fragmentos
+ * que no guardo otro, y los que el mapa de cambios no marco ni siquiera se vuelven a leer.
+ * aplicarRetencion borra los backups que la PoliticaRetencion no conserva y despues los
+ * fragmentos que ya no nombra ninguna lista. Crear, extraer y restaurar toman un flock compartido
+ * sobre `raiz`; la retencion, uno exclusivo.
+ *
+ * En los formatos comprimido y plano, el primero de una cadena copia todos los archivos; los
+ * siguientes guardan solo los bloques que RegistroCambios marco desde el backup anterior, asi que
+ * un backup horario con pocas ventas ocupa kilobytes. Cada INCREMENTALES_POR_COMPLETO
+ * incrementales se empieza una cadena nueva con un completo, para acotar cuantos backups hay que
+ * aplicar al restaurar. tienda.bin (un registro) va siempre entero, igual que cualquier archivo
+ * cuyo mapa de cambios no corresponde al backup anterior.
+ *
+ * Las transacciones se guardan como la lista de particiones mas un archivo por particion; la
+ * lista se toma con el flock de TRANSACCIONES_LOCK_PATH para que no aparezca un mes nuevo durante
+ * la copia. Al restaurar, las particiones que el backup no tiene se vacian y un backup anterior a
+ * las particiones se reparte en `preparacion` antes de validarlo.
+ *
+ * Todos los archivos se copian en un mismo punto consistente: se detienen las operaciones de
+ * varias escrituras (en este proceso con ControlVersiones, en otros con el flock exclusivo de
+ * COMMITS_LOCK_PATH) y se toman los flocks compartidos de todos los archivos. La pausa dura lo que
+ * la copia: los archivos se copian en paralelo, como reflink (FICLONE) si el filesystem lo
+ * soporta, o con copy_file_range, y las sumas de verificacion se calculan despues sobre la copia.
+ * Comprimidos y deduplicados, en la pausa solo se copian a `<id>.parcial/copias` los rangos a
+ * guardar (los fragmentos que hay que volver a leer, si es deduplicado), y ya con las operaciones
+ * reanudadas cada archivo se comprime como ContenedorComprimido, o cada fragmento se hashea y se
+ * guarda con CompresorLZ, desde esa copia: los registros de tamano fijo rellenos con ceros ocupan
+ * una fraccion y se escribe mucho menos que en una copia.
+ *
+ * El backup se arma en `<id>.parcial` y se renombra al terminar: un directorio con manifiesto
+ * esta siempre completo. Los errores se lanzan como std::runtime_error.
+ *
+ * Restaurar hace todo lo que puede fallar (sumas, descompresion, validacion de headers y
+ * registros) en un directorio de preparacion, con la tienda funcionando; solo al final detiene
+ * las operaciones para copiar los archivos ya validados, asi la pausa depende del tamano de los
+ * datos y no de la cadena de backups.
+ */
+class GestorBackups
+{
+   public:
+    static constexpr int INCREMENTALES_POR_COMPLETO = 24;
+
+   private:
+    fs::path raiz;
+
+   public:
+    explicit GestorBackups(fs::path raiz);
+
+    /// Con `forzarCompleto`, un deduplicado vuelve a leer y hashear todos los fragmentos.
+    ResumenBackup crear(bool forzarCompleto, FormatoBackup formato);
+
+    /// Id del backup mas reciente; lanza si no hay ninguno.
+    std::string ultimo() const;
+
+    /// Manifiestos desde el completo hasta `id`, en el orden en que se aplican.
+    std::vector<ManifiestoBackup> cadena(const std::string& id) const;
+
+    /**
+     * Reconstruye en `destino` (vacio o inexistente) los archivos de datos tal como estaban en el
+     * backup `id` (el ultimo si esta vacio), verificando las sumas de cada eslabon.
+     */
+    ResumenBackup extraer(const std::string& id, const fs::path& destino);
+
+    /**
+     * Reemplaza los archivos de datos por los del backup `id` (el ultimo si esta vacio). Los
+     * reconstruye y valida en `preparacion`, deja ahi un diario y recien entonces los copia sobre
+     * los datos con las operaciones detenidas, como al crear un backup. `alAplicar` corre antes
+     * de reanudarlas (p. ej. para reconstruir datos derivados). Si algo falla antes del diario,
+     * los datos no se tocan; despues, completarPendiente termina la copia.
+     */
+    ResumenBackup restaurar(const std::string& id, const fs::path& preparacion,
+                            const std::function<void()>& alAplicar);
+
+    /**
+     * Borra los backups que la politica no conserva, salvo los que son base de uno conservado,
+     * los `.parcial` abandonados y los fragmentos que ya no usa ninguna lista.
+     */
+    ResumenRetencion aplicarRetencion(const PoliticaRetencion& politica);
+
+    /// Termina una restauracion interrumpida con su diario escrito; false si no habia ninguna.
+    static bool completarPendiente(const fs::path& preparacion,
+                                   const std::function<void()>& alAplicar);
+};
@@ -0,0 +1,261 @@
+#include "ManifiestoBackup.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+#include "SumaVerificacion.hpp"
+
+namespace {
+
+constexpr const char* FIRMA = "papaya-backup 1";
+constexpr std::string_view CLAVE_SUMA = "suma=";
+
+/// Indices crecientes como rangos: 0-3,17,40-41.
+std::string formatearBloques(const std::vector<std::size_t>& bloques)
+{
+    std::string texto;
+    for (std::size_t i = 0; i < bloques.size();) {
+        std::size_t fin = i;
+        while (fin + 1 < bloques.size() && bloques[fin + 1] == bloques[fin] + 1) {
+            ++fin;
+        }
+        if (!texto.empty()) {
+            texto += ',';
+        }
+        texto += std::to_string(bloques[i]);
+        if (fin > i) {
+            texto += '-' + std::to_string(bloques[fin]);
+        }
+        i = fin + 1;
+    }
+    return texto;
+}
+
+template <typename Numero>
+bool parsearNumero(std::string_view texto, Numero& outValor)
+{
+    const auto [fin, error] = std::from_chars(texto.data(), texto.data() + texto.size(), outValor);
+    return error == std::errc() && fin == texto.data() + texto.size();
+}
+
+bool parsearBloques(std::string_view texto, std::vector<std::size_t>& outBloques)
+{
+    outBloques.clear();
+    while (!texto.empty()) {
+        const std::size_t coma = texto.find(',');
+        const std::string_view rango = texto.substr(0, coma);
+        texto = coma == std::string_view::npos ? std::string_view() : texto.substr(coma + 1);
+
+        const std::size_t guion = rango.find('-');
+        std::size_t desde = 0;
+        std::size_t hasta = 0;
+        if (!parsearNumero(rango.substr(0, guion), desde)) {
+            return false;
+        }
+        hasta = desde;
+        if (guion != std::string_view::npos && !parsearNumero(rango.substr(guion + 1), hasta)) {
+            return false;
+        }
+        if (hasta < desde || (!outBloques.empty() && desde <= outBloques.back())) {
+            return false;
+        }
+        for (std::size_t bloque = desde; bloque <= hasta; ++bloque) {
+            outBloques.push_back(bloque);
+        }
+    }
+    return true;
+}
+
+bool parsearArchivo(const std::string& linea, ArchivoRespaldado& outArchivo)
+{
+    std::istringstream campos(linea);
+    std::string campo;
+    campos >> campo;  // "archivo"
+    bool conTamano = false;
+    bool conBloques = false;
+    while (campos >> campo) {
+        const std::size_t igual = campo.find('=');
+        if (igual == std::string::npos) {
+            return false;
+        }
+        const std::string clave = campo.substr(0, igual);
+        const std::string_view valor = std::string_view(campo).substr(igual + 1);
+        if (clave == "nombre") {
+            outArchivo.nombre = valor;
+        } else if (clave == "tamano") {
+            conTamano = parsearNumero(valor, outArchivo.tamano);
+        } else if (clave == "bloques") {
+            outArchivo.completo = valor == "*";
+            conBloques = outArchivo.completo || parsearBloques(valor, outArchivo.bloques);
+        } else if (clave == "formato") {
+            if (valor == "lz4") {
+                outArchivo.formato = GUARDADO_LZ4;
+            } else if (valor == "fragmentos") {
+                outArchivo.formato = GUARDADO_FRAGMENTOS;
+            } else if (valor != "plano") {
+                return false;
+            }
+        } else if (clave == "suma") {
+            std::uint64_t suma = 0;
+            if (!SumaVerificacion::parsear(std::string(valor), suma)) {
+                return false;
+            }
+            outArchivo.suma = suma;
+        }
+    }
+
+    // solo nombres simples: el manifiesto no puede apuntar fuera de data/ ni del backup
+    return conTamano && conBloques && !outArchivo.nombre.empty() &&
+           (outArchivo.completo || outArchivo.formato != GUARDADO_FRAGMENTOS) &&
+           outArchivo.nombre.find('/') == std::string::npos && outArchivo.nombre != "." &&
+           outArchivo.nombre != "..";
+}
+
+}  // namespace
+
+bool ManifiestoBackup::escribir(const fs::path& directorio, std::string& outError) const
+{
+    const fs::path ruta = directorio / NOMBRE_ARCHIVO;
+    std::ofstream archivo(ruta, std::ios::trunc);
+    if (!archivo.is_open()) {
+        outError = "No se pudo crear " + ruta.string();
+        return false;
+    }
+
+    std::ostringstream texto;
+    texto << FIRMA << '\n'
+          << "id=" << id << '\n'
+          << "tipo=" << (tipo == BACKUP_COMPLETO ? "completo" : "incremental") << '\n'
+          << "generacion=" << generacion << '\n'
+          << "base=" << base << '\n'
+          << "completo=" << completo << '\n'
+          << "eslabon=" << eslabon << '\n';
+    for (const ArchivoRespaldado& respaldado : archivos) {
+        texto << "archivo nombre=" << respaldado.nombre << " tamano=" << respaldado.tamano
+              << " bloques=" << (respaldado.completo ? "*" : formatearBloques(respaldado.bloques));
+        if (respaldado.formato == GUARDADO_LZ4) {
+            texto << " formato=lz4";
+        } else if (respaldado.formato == GUARDADO_FRAGMENTOS) {
+            texto << " formato=fragmentos";
+        }
+        if (respaldado.suma) {
+            texto << " suma=" << SumaVerificacion::texto(*respaldado.suma);
+        }
+        texto << '\n';
+    }
+
+    const std::string contenido = texto.str();
+    SumaVerificacion suma;
+    suma.agregar(contenido.data(), contenido.size());
+    archivo << contenido << CLAVE_SUMA << SumaVerificacion::texto(suma.valor()) << '\n';
+    archivo.flush();
+    if (!archivo) {
+        outError = "Error escribiendo " + ruta.string();
+        return false;
+    }
+    return true;
+}
+
+bool ManifiestoBackup::leer(const fs::path& directorio, ManifiestoBackup& outManifiesto,
+                            std::string& outError)
+{
+    const fs::path ruta = directorio / NOMBRE_ARCHIVO;
+    std::ifstream entrada(ruta);
+    std::ostringstream leido;
+    leido << entrada.rdbuf();
+    std::string contenido = leido.str();
+
+    // la linea de suma cubre todo lo anterior y tiene que ser la ultima
+    const std::size_t inicioSuma = contenido.rfind('\n' + std::string(CLAVE_SUMA));
+    if (inicioSuma != std::string::npos) {
+        std::string texto = contenido.substr(inicioSuma + 1 + CLAVE_SUMA.size());
+        if (!texto.empty() && texto.back() == '\n') {
+            texto.pop_back();
+        }
+        contenido.resize(inicioSuma + 1);
+        SumaVerificacion suma;
+        suma.agregar(contenido.data(), contenido.size());
+        std::uint64_t esperada = 0;
+        if (!SumaVerificacion::parsear(texto, esperada) || esperada != suma.valor()) {
+            outError = "La suma del manifiesto no coincide: " + ruta.string();
+            return false;
+        }
+    }
+
+    std::istringstream archivo(contenido);
+    std::string linea;
+    if (!entrada.is_open() || !std::getline(archivo, linea) || linea != FIRMA) {
+        outError = "Manifiesto ausente o invalido: " + ruta.string();
+        return false;
+    }
+
+    outManifiesto = ManifiestoBackup{};
+    bool conTipo = false;
+    while (std::getline(archivo, linea)) {
+        if (linea.rfind("archivo ", 0) == 0) {
+            ArchivoRespaldado respaldado;
+            if (!parsearArchivo(linea, respaldado)) {
+                outError = "Linea de archivo invalida en " + ruta.string() + ": " + linea;
+                return false;
+            }
+            outManifiesto.archivos.push_back(std::move(respaldado));
+            continue;
+        }
+
+        const std::size_t igual = linea.find('=');
+        const std::string clave = linea.substr(0, igual);
+        const std::string valor = igual == std::string::npos ? "" : linea.substr(igual + 1);
+        bool valido = igual != std::string::npos;
+        if (clave == "id") {
+            outManifiesto.id = valor;
+        } else if (clave == "tipo") {
+            conTipo = valor == "completo" || valor == "incremental";
+            outManifiesto.tipo = valor == "completo" ? BACKUP_COMPLETO : BACKUP_INCREMENTAL;
+        } else if (clave == "generacion") {
+            valido = valido && parsearNumero(std::string_view(valor), outManifiesto.generacion);
+        } else if (clave == "base") {
+            outManifiesto.base = valor;
+        } else if (clave == "completo") {
+            outManifiesto.completo = valor;
+        } else if (clave == "eslabon") {
+            valido = valido && parsearNumero(std::string_view(valor), outManifiesto.eslabon);
+        }
+
+        if (!valido) {
+            outError = "Linea invalida en " + ruta.string() + ": " + linea;
+            return false;
+        }
+    }
+
+    const bool incrementalCompleto = outManifiesto.tipo == BACKUP_COMPLETO ||
+                                     (!outManifiesto.base.empty() && outManifiesto.eslabon > 0);
+    if (!conTipo || outManifiesto.id.empty() || outManifiesto.generacion == 0 ||
+        outManifiesto.completo.empty() || !incrementalCompleto) {
+        outError = "Manifiesto incompleto: " + ruta.string();
+        return false;
+    }
+    return true;
+}
+
+std::vector<ManifiestoBackup> ManifiestoBackup::listar(const fs::path& raiz)
+{
+    std::vector<ManifiestoBackup> manifiestos;
+    std::error_code ec;
+    for (const fs::directory_entry& entrada : fs::directory_iterator(raiz, ec)) {
+        ManifiestoBackup manifiesto;
+        std::string error;
+        if (entrada.is_directory(ec) && leer(entrada.path(), manifiesto, error) &&
+            manifiesto.id == entrada.path().filename().string()) {
+            manifiestos.push_back(std::move(manifiesto));
+        }
+    }
+
+    std::sort(manifiestos.begin(), manifiestos.end(),
+              [](const ManifiestoBackup& a, const ManifiestoBackup& b) {
+                  return a.generacion < b.generacion;
+              });
+    return manifiestos;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+enum TipoBackup { BACKUP_COMPLETO, BACKUP_INCREMENTAL };
+
+/// Como quedo guardado un archivo dentro del backup (clave `formato=` del manifiesto).
+enum FormatoGuardado { GUARDADO_PLANO, GUARDADO_LZ4, GUARDADO_FRAGMENTOS };
+
+/**
+ * @brief - Un archivo de datos dentro de un backup.
+ * @param tamano - Tamano del archivo original al respaldarlo; al restaurar se trunca a este valor.
+ * @param bloques - Si no es completo, indices de bloque (RegistroCambios::TAMANO_BLOQUE) en el
+ * orden en que se guardaron uno tras otro en el archivo del backup.
+ * @param formato - Copia directa; ContenedorComprimido en `<nombre>.lz4` (formato=lz4); o lista de
+ * fragmentos del AlmacenFragmentos en `<nombre>.fragmentos` (formato=fragmentos, siempre completo).
+ * @param suma - SumaVerificacion del archivo tal como quedo en el backup (para fragmentos, de la
+ * lista; cada fragmento se verifica con su SHA-256).
+ */
+struct ArchivoRespaldado {
+    std::string nombre;
+    std::uintmax_t tamano{0};
+    bool completo{true};
+    std::vector<std::size_t> bloques;
+    FormatoGuardado formato{GUARDADO_PLANO};
+    std::optional<std::uint64_t> suma;
+
+    /// Nombre del archivo dentro del directorio del backup.
+    std::string nombreGuardado() const
+    {
+        return formato == GUARDADO_LZ4          ? nombre + ".lz4"
+               : formato == GUARDADO_FRAGMENTOS ? nombre + ".fragmentos"
+                                                : nombre;
+    }
+};
+
+/**
+ * @brief - Descripcion de un backup, guardada como texto en `<backup>/manifiesto.txt`.
+ *
+ * Un backup completo tiene una copia entera de cada archivo. Uno incremental guarda solo los
+ * bloques que cambiaron desde `base` (el backup anterior) y apunta al completo con que empieza
+ * la cadena; `eslabon` es su posicion en ella (0 para el completo). Para reconstruir un
+ * incremental se parte del completo y se aplican en orden los incrementales hasta llegar a el.
+ *
+ * La ultima linea (`suma=`) es la SumaVerificacion de todo el texto anterior: un manifiesto
+ * truncado o editado no se acepta. Los manifiestos sin esa linea se leen igual, sin verificar.
+ */
+struct ManifiestoBackup {
+    static constexpr const char* NOMBRE_ARCHIVO = "manifiesto.txt";
+
+    std::string id;
+    TipoBackup tipo{BACKUP_COMPLETO};
+    std::uint64_t generacion{0};
+    std::string base;
+    std::string completo;
+    int eslabon{0};
+    std::vector<ArchivoRespaldado> archivos;
+
+    bool escribir(const fs::path& directorio, std::string& outError) const;
+    static bool leer(const fs::path& directorio, ManifiestoBackup& outManifiesto,
+                     std::string& outError);
+
+    /// Backups validos bajo `raiz`, de la generacion mas antigua a la mas reciente.
+    static std::vector<ManifiestoBackup> listar(const fs::path& raiz);
+};
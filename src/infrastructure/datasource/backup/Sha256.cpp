@@ -0,0 +1,146 @@
+#include "Sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr std::uint32_t CONSTANTES[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+std::uint32_t rotar(std::uint32_t valor, int bits)
+{
+    return (valor >> bits) | (valor << (32 - bits));
+}
+
+std::uint32_t leerBigEndian(const std::uint8_t* datos)
+{
+    return (static_cast<std::uint32_t>(datos[0]) << 24) |
+           (static_cast<std::uint32_t>(datos[1]) << 16) |
+           (static_cast<std::uint32_t>(datos[2]) << 8) | static_cast<std::uint32_t>(datos[3]);
+}
+
+}  // namespace
+
+Sha256::Sha256()
+    : estado{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+             0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+      pendiente{}
+{
+}
+
+void Sha256::procesarBloque(const std::uint8_t* bloque)
+{
+    std::uint32_t palabras[64];
+    for (int i = 0; i < 16; ++i) {
+        palabras[i] = leerBigEndian(bloque + i * 4);
+    }
+    for (int i = 16; i < 64; ++i) {
+        const std::uint32_t s0 =
+            rotar(palabras[i - 15], 7) ^ rotar(palabras[i - 15], 18) ^ (palabras[i - 15] >> 3);
+        const std::uint32_t s1 =
+            rotar(palabras[i - 2], 17) ^ rotar(palabras[i - 2], 19) ^ (palabras[i - 2] >> 10);
+        palabras[i] = palabras[i - 16] + s0 + palabras[i - 7] + s1;
+    }
+
+    std::uint32_t a = estado[0], b = estado[1], c = estado[2], d = estado[3];
+    std::uint32_t e = estado[4], f = estado[5], g = estado[6], h = estado[7];
+    for (int i = 0; i < 64; ++i) {
+        const std::uint32_t t1 = h + (rotar(e, 6) ^ rotar(e, 11) ^ rotar(e, 25)) +
+                                 ((e & f) ^ (~e & g)) + CONSTANTES[i] + palabras[i];
+        const std::uint32_t t2 =
+            (rotar(a, 2) ^ rotar(a, 13) ^ rotar(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    estado[0] += a;
+    estado[1] += b;
+    estado[2] += c;
+    estado[3] += d;
+    estado[4] += e;
+    estado[5] += f;
+    estado[6] += g;
+    estado[7] += h;
+}
+
+void Sha256::agregar(const void* datos, std::size_t bytes)
+{
+    const std::uint8_t* entrada = static_cast<const std::uint8_t*>(datos);
+    total += bytes;
+
+    if (bytesPendientes > 0) {
+        const std::size_t faltan = std::min(bytes, sizeof(pendiente) - bytesPendientes);
+        std::memcpy(pendiente + bytesPendientes, entrada, faltan);
+        bytesPendientes += faltan;
+        entrada += faltan;
+        bytes -= faltan;
+        if (bytesPendientes < sizeof(pendiente)) {
+            return;
+        }
+        procesarBloque(pendiente);
+        bytesPendientes = 0;
+    }
+
+    for (; bytes >= sizeof(pendiente); entrada += sizeof(pendiente), bytes -= sizeof(pendiente)) {
+        procesarBloque(entrada);
+    }
+    std::memcpy(pendiente, entrada, bytes);
+    bytesPendientes = bytes;
+}
+
+Sha256::Resumen Sha256::valor()
+{
+    // relleno: un bit 1, ceros hasta 56 bytes modulo 64 y el largo en bits (big endian)
+    const std::uint64_t bits = total * 8;
+    const std::uint8_t uno = 0x80;
+    agregar(&uno, 1);
+    const std::uint8_t ceros[64] = {};
+    agregar(ceros, (bytesPendientes <= 56 ? 56 : 120) - bytesPendientes);
+    std::uint8_t largo[8];
+    for (int i = 0; i < 8; ++i) {
+        largo[i] = static_cast<std::uint8_t>(bits >> (56 - 8 * i));
+    }
+    agregar(largo, sizeof(largo));
+
+    Resumen resumen;
+    for (int i = 0; i < 8; ++i) {
+        resumen[i * 4] = static_cast<std::uint8_t>(estado[i] >> 24);
+        resumen[i * 4 + 1] = static_cast<std::uint8_t>(estado[i] >> 16);
+        resumen[i * 4 + 2] = static_cast<std::uint8_t>(estado[i] >> 8);
+        resumen[i * 4 + 3] = static_cast<std::uint8_t>(estado[i]);
+    }
+    return resumen;
+}
+
+std::string Sha256::hex(const void* datos, std::size_t bytes)
+{
+    Sha256 hash;
+    hash.agregar(datos, bytes);
+    return hex(hash.valor());
+}
+
+std::string Sha256::hex(const Resumen& resumen)
+{
+    constexpr char DIGITOS[] = "0123456789abcdef";
+    std::string texto(resumen.size() * 2, '0');
+    for (std::size_t i = 0; i < resumen.size(); ++i) {
+        texto[i * 2] = DIGITOS[resumen[i] >> 4];
+        texto[i * 2 + 1] = DIGITOS[resumen[i] & 0x0F];
+    }
+    return texto;
+}
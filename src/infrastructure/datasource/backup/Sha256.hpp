@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief - Hash SHA-256 calculado por partes (FIPS 180-4).
+ *
+ * A diferencia de SumaVerificacion, que solo detecta corrupcion, es un hash criptografico: dos
+ * fragmentos con el mismo SHA-256 se tratan como iguales en el AlmacenFragmentos, asi que el
+ * nombre de cada fragmento tiene que identificar su contenido sin colisiones practicas.
+ */
+class Sha256
+{
+   public:
+    using Resumen = std::array<std::uint8_t, 32>;
+
+   private:
+    std::uint32_t estado[8];
+    std::uint8_t pendiente[64];
+    std::size_t bytesPendientes{0};
+    std::uint64_t total{0};
+
+    void procesarBloque(const std::uint8_t* bloque);
+
+   public:
+    Sha256();
+
+    void agregar(const void* datos, std::size_t bytes);
+    /// Termina el calculo; el objeto no se puede seguir usando despues.
+    Resumen valor();
+
+    /// Hash de un bloque de memoria en 64 digitos hexadecimales.
+    static std::string hex(const void* datos, std::size_t bytes);
+    static std::string hex(const Resumen& resumen);
+};
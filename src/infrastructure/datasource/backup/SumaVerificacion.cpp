@@ -0,0 +1,169 @@
+#include "SumaVerificacion.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr std::uint64_t PRIMO1 = 11400714785074694791ULL;
+constexpr std::uint64_t PRIMO2 = 14029467366897019727ULL;
+constexpr std::uint64_t PRIMO3 = 1609587929392839161ULL;
+constexpr std::uint64_t PRIMO4 = 9650029242287828579ULL;
+constexpr std::uint64_t PRIMO5 = 2870177450012600261ULL;
+
+constexpr std::size_t LECTURA_BUFFER_SIZE = 1 << 20;
+
+std::uint64_t rotar(std::uint64_t valor, int bits)
+{
+    return (valor << bits) | (valor >> (64 - bits));
+}
+
+std::uint64_t leer64(const unsigned char* datos)
+{
+    std::uint64_t valor;
+    std::memcpy(&valor, datos, sizeof(valor));
+    return valor;
+}
+
+std::uint32_t leer32(const unsigned char* datos)
+{
+    std::uint32_t valor;
+    std::memcpy(&valor, datos, sizeof(valor));
+    return valor;
+}
+
+std::uint64_t ronda(std::uint64_t acumulador, std::uint64_t entrada)
+{
+    acumulador += entrada * PRIMO2;
+    return rotar(acumulador, 31) * PRIMO1;
+}
+
+std::uint64_t combinar(std::uint64_t hash, std::uint64_t acumulador)
+{
+    hash ^= ronda(0, acumulador);
+    return hash * PRIMO1 + PRIMO4;
+}
+
+}  // namespace
+
+SumaVerificacion::SumaVerificacion()
+    : acumuladores{PRIMO1 + PRIMO2, PRIMO2, 0, 0 - PRIMO1}, pendiente{}
+{
+}
+
+void SumaVerificacion::agregar(const void* datos, std::size_t bytes)
+{
+    const unsigned char* cursor = static_cast<const unsigned char*>(datos);
+    total += bytes;
+
+    if (bytesPendientes > 0) {
+        const std::size_t faltan = std::min(bytes, sizeof(pendiente) - bytesPendientes);
+        std::memcpy(pendiente + bytesPendientes, cursor, faltan);
+        bytesPendientes += faltan;
+        cursor += faltan;
+        bytes -= faltan;
+        if (bytesPendientes < sizeof(pendiente)) {
+            return;
+        }
+        for (int i = 0; i < 4; ++i) {
+            acumuladores[i] = ronda(acumuladores[i], leer64(pendiente + i * 8));
+        }
+        bytesPendientes = 0;
+    }
+
+    for (; bytes >= sizeof(pendiente); cursor += sizeof(pendiente), bytes -= sizeof(pendiente)) {
+        for (int i = 0; i < 4; ++i) {
+            acumuladores[i] = ronda(acumuladores[i], leer64(cursor + i * 8));
+        }
+    }
+
+    std::memcpy(pendiente, cursor, bytes);
+    bytesPendientes = bytes;
+}
+
+std::uint64_t SumaVerificacion::valor() const
+{
+    std::uint64_t hash;
+    if (total >= sizeof(pendiente)) {
+        hash = rotar(acumuladores[0], 1) + rotar(acumuladores[1], 7) +
+               rotar(acumuladores[2], 12) + rotar(acumuladores[3], 18);
+        for (const std::uint64_t acumulador : acumuladores) {
+            hash = combinar(hash, acumulador);
+        }
+    } else {
+        hash = PRIMO5;
+    }
+    hash += total;
+
+    std::size_t i = 0;
+    for (; i + 8 <= bytesPendientes; i += 8) {
+        hash ^= ronda(0, leer64(pendiente + i));
+        hash = rotar(hash, 27) * PRIMO1 + PRIMO4;
+    }
+    if (i + 4 <= bytesPendientes) {
+        hash ^= static_cast<std::uint64_t>(leer32(pendiente + i)) * PRIMO1;
+        hash = rotar(hash, 23) * PRIMO2 + PRIMO3;
+        i += 4;
+    }
+    for (; i < bytesPendientes; ++i) {
+        hash ^= pendiente[i] * PRIMO5;
+        hash = rotar(hash, 11) * PRIMO1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIMO2;
+    hash ^= hash >> 29;
+    hash *= PRIMO3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+bool SumaVerificacion::deArchivo(const fs::path& ruta, std::uint64_t& outSuma,
+                                 std::string& outError)
+{
+    const int fd = ::open(ruta.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        outError = "No se pudo abrir " + ruta.string() + ": " + std::strerror(errno);
+        return false;
+    }
+
+    SumaVerificacion suma;
+    std::vector<char> buffer(LECTURA_BUFFER_SIZE);
+    while (true) {
+        const ssize_t leidos = ::read(fd, buffer.data(), buffer.size());
+        if (leidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (leidos < 0) {
+            outError = "Error leyendo " + ruta.string() + ": " + std::strerror(errno);
+            ::close(fd);
+            return false;
+        }
+        if (leidos == 0) {
+            break;
+        }
+        suma.agregar(buffer.data(), static_cast<std::size_t>(leidos));
+    }
+
+    ::close(fd);
+    outSuma = suma.valor();
+    return true;
+}
+
+std::string SumaVerificacion::texto(std::uint64_t suma)
+{
+    return std::format("{:016x}", suma);
+}
+
+bool SumaVerificacion::parsear(const std::string& texto, std::uint64_t& outSuma)
+{
+    const auto [fin, error] =
+        std::from_chars(texto.data(), texto.data() + texto.size(), outSuma, 16);
+    return texto.size() == 16 && error == std::errc() && fin == texto.data() + texto.size();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Suma de verificacion XXH64 (semilla 0) calculada por partes.
+ *
+ * Se usa para los archivos de un backup y para el propio manifiesto: no protege contra
+ * modificaciones intencionales, solo detecta archivos truncados o corrompidos antes de restaurar.
+ * Procesa varios GB/s por hilo, asi que verificar un backup cuesta poco mas que leerlo.
+ */
+class SumaVerificacion
+{
+   private:
+    std::uint64_t acumuladores[4];
+    unsigned char pendiente[32];
+    std::size_t bytesPendientes{0};
+    std::uint64_t total{0};
+
+   public:
+    SumaVerificacion();
+
+    void agregar(const void* datos, std::size_t bytes);
+    std::uint64_t valor() const;
+
+    /// Suma de todo el contenido de un archivo.
+    static bool deArchivo(const fs::path& ruta, std::uint64_t& outSuma, std::string& outError);
+
+    /// 16 digitos hexadecimales, como se guarda en el manifiesto.
+    static std::string texto(std::uint64_t suma);
+    static bool parsear(const std::string& texto, std::uint64_t& outSuma);
+};
@@ -19,6 +19,12 @@ std::variant<bool, std::string> FSClienteRepository::guardar(const Cliente& enti
     return m_baseRepository.guardarTemplate(entidad);
 }
 
+std::variant<bool, std::string> FSClienteRepository::guardarLote(
+    const std::vector<Cliente>& entidades)
+{
+    return m_baseRepository.guardarLoteTemplate(entidades);
+}
+
 std::variant<bool, std::string> FSClienteRepository::actualizar(int id, const Cliente& entidad)
 {
     return m_baseRepository.actualizarTemplate(id, entidad);
@@ -33,3 +39,36 @@ std::variant<HeaderFile, std::string> FSClienteRepository::obtenerEstadisticas()
 {
     return m_baseRepository.obtenerEstadisticasTemplate();
 }
+
+std::variant<bool, std::string> FSClienteRepository::recorrer(
+    const std::function<bool(const Cliente&)>& visitante)
+{
+    return m_baseRepository.recorrerTemplate(visitante);
+}
+
+std::variant<bool, std::string> FSClienteRepository::recorrerDesde(
+    int desdeId, const std::function<bool(const Cliente&)>& visitante)
+{
+    return m_baseRepository.recorrerDesdeTemplate(desdeId, visitante);
+}
+
+Generador<const Cliente&> FSClienteRepository::generar(int desdeId)
+{
+    return m_baseRepository.generarTemplate(desdeId);
+}
+
+LatchesRegistro::Guardia FSClienteRepository::bloquearRegistros(const std::vector<int>& ids)
+{
+    return m_baseRepository.bloquearRegistrosTemplate(ids);
+}
+
+EstadisticasContencion FSClienteRepository::obtenerContencion() const
+{
+    return m_baseRepository.obtenerContencionTemplate();
+}
+
+const CodecRegistro<Cliente>& FSClienteRepository::codecRegistros() const
+{
+    static const CodecEntidad<Cliente> codec;
+    return codec;
+}
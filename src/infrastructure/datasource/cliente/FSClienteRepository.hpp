@@ -15,10 +15,19 @@ class FSClienteRepository : public IClienteRepository
     std::variant<Cliente, std::string> leerPorNombre(const std::string& nombre) override;
 
     std::variant<bool, std::string> guardar(const Cliente& entidad) override;
+    std::variant<bool, std::string> guardarLote(const std::vector<Cliente>& entidades) override;
 
     std::variant<bool, std::string> actualizar(int id, const Cliente& entidad) override;
 
     std::variant<bool, std::string> eliminarLogicamente(int id) override;
 
     std::variant<HeaderFile, std::string> obtenerEstadisticas() override;
+    std::variant<bool, std::string> recorrer(
+        const std::function<bool(const Cliente&)>& visitante) override;
+    std::variant<bool, std::string> recorrerDesde(
+        int desdeId, const std::function<bool(const Cliente&)>& visitante) override;
+    Generador<const Cliente&> generar(int desdeId = 1) override;
+    LatchesRegistro::Guardia bloquearRegistros(const std::vector<int>& ids) override;
+    EstadisticasContencion obtenerContencion() const override;
+    const CodecRegistro<Cliente>& codecRegistros() const override;
 };
@@ -14,11 +14,23 @@ std::variant<Producto, std::string> FSProductoRepository::leerPorNombre(const st
     return baseRepository.leerPorNombreTemplate(nombre);
 }
 
+std::variant<std::vector<std::variant<Producto, std::string>>, std::string>
+FSProductoRepository::leerVarios(const std::vector<int>& ids)
+{
+    return baseRepository.leerVariosTemplate(ids);
+}
+
 std::variant<bool, std::string> FSProductoRepository::guardar(const Producto& entidad)
 {
     return baseRepository.guardarTemplate(entidad);
 }
 
+std::variant<bool, std::string> FSProductoRepository::guardarLote(
+    const std::vector<Producto>& entidades)
+{
+    return baseRepository.guardarLoteTemplate(entidades);
+}
+
 std::variant<bool, std::string> FSProductoRepository::actualizar(int id, const Producto& entidad)
 {
     return baseRepository.actualizarTemplate(id, entidad);
@@ -33,3 +45,36 @@ std::variant<HeaderFile, std::string> FSProductoRepository::obtenerEstadisticas(
 {
     return baseRepository.obtenerEstadisticasTemplate();
 }
+
+std::variant<bool, std::string> FSProductoRepository::recorrer(
+    const std::function<bool(const Producto&)>& visitante)
+{
+    return baseRepository.recorrerTemplate(visitante);
+}
+
+std::variant<bool, std::string> FSProductoRepository::recorrerDesde(
+    int desdeId, const std::function<bool(const Producto&)>& visitante)
+{
+    return baseRepository.recorrerDesdeTemplate(desdeId, visitante);
+}
+
+Generador<const Producto&> FSProductoRepository::generar(int desdeId)
+{
+    return baseRepository.generarTemplate(desdeId);
+}
+
+LatchesRegistro::Guardia FSProductoRepository::bloquearRegistros(const std::vector<int>& ids)
+{
+    return baseRepository.bloquearRegistrosTemplate(ids);
+}
+
+EstadisticasContencion FSProductoRepository::obtenerContencion() const
+{
+    return baseRepository.obtenerContencionTemplate();
+}
+
+const CodecRegistro<Producto>& FSProductoRepository::codecRegistros() const
+{
+    static const CodecEntidad<Producto> codec;
+    return codec;
+}
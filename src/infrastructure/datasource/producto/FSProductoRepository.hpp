@@ -13,8 +13,19 @@ class FSProductoRepository : public IProductoRepository
 
     std::variant<Producto, std::string> leerPorId(int id) override;
     std::variant<Producto, std::string> leerPorNombre(const std::string& nombre) override;
+    std::variant<std::vector<std::variant<Producto, std::string>>, std::string> leerVarios(
+        const std::vector<int>& ids) override;
     std::variant<bool, std::string> guardar(const Producto& entidad) override;
+    std::variant<bool, std::string> guardarLote(const std::vector<Producto>& entidades) override;
     std::variant<bool, std::string> actualizar(int id, const Producto& entidad) override;
     std::variant<bool, std::string> eliminarLogicamente(int id) override;
     std::variant<HeaderFile, std::string> obtenerEstadisticas() override;
+    std::variant<bool, std::string> recorrer(
+        const std::function<bool(const Producto&)>& visitante) override;
+    std::variant<bool, std::string> recorrerDesde(
+        int desdeId, const std::function<bool(const Producto&)>& visitante) override;
+    Generador<const Producto&> generar(int desdeId = 1) override;
+    LatchesRegistro::Guardia bloquearRegistros(const std::vector<int>& ids) override;
+    EstadisticasContencion obtenerContencion() const override;
+    const CodecRegistro<Producto>& codecRegistros() const override;
 };
@@ -21,6 +21,12 @@ std::variant<bool, std::string> FSProveedorRepository::guardar(const Proveedor&
     return baseRepository.guardarTemplate(entidad);
 }
 
+std::variant<bool, std::string> FSProveedorRepository::guardarLote(
+    const std::vector<Proveedor>& entidades)
+{
+    return baseRepository.guardarLoteTemplate(entidades);
+}
+
 std::variant<bool, std::string> FSProveedorRepository::actualizar(int id, const Proveedor& entidad)
 {
     return baseRepository.actualizarTemplate(id, entidad);
@@ -35,3 +41,31 @@ std::variant<HeaderFile, std::string> FSProveedorRepository::obtenerEstadisticas
 {
     return baseRepository.obtenerEstadisticasTemplate();
 }
+
+std::variant<bool, std::string> FSProveedorRepository::recorrer(
+    const std::function<bool(const Proveedor&)>& visitante)
+{
+    return baseRepository.recorrerTemplate(visitante);
+}
+
+std::variant<bool, std::string> FSProveedorRepository::recorrerDesde(
+    int desdeId, const std::function<bool(const Proveedor&)>& visitante)
+{
+    return baseRepository.recorrerDesdeTemplate(desdeId, visitante);
+}
+
+Generador<const Proveedor&> FSProveedorRepository::generar(int desdeId)
+{
+    return baseRepository.generarTemplate(desdeId);
+}
+
+EstadisticasContencion FSProveedorRepository::obtenerContencion() const
+{
+    return baseRepository.obtenerContencionTemplate();
+}
+
+const CodecRegistro<Proveedor>& FSProveedorRepository::codecRegistros() const
+{
+    static const CodecEntidad<Proveedor> codec;
+    return codec;
+}
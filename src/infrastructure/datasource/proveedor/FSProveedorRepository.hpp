@@ -14,7 +14,15 @@ class FSProveedorRepository : public IProveedorRepository
     std::variant<Proveedor, std::string> leerPorId(int id) override;
     std::variant<Proveedor, std::string> leerPorNombre(const std::string& nombre) override;
     std::variant<bool, std::string> guardar(const Proveedor& entidad) override;
+    std::variant<bool, std::string> guardarLote(const std::vector<Proveedor>& entidades) override;
     std::variant<bool, std::string> actualizar(int id, const Proveedor& entidad) override;
     std::variant<bool, std::string> eliminarLogicamente(int id) override;
     std::variant<HeaderFile, std::string> obtenerEstadisticas() override;
+    std::variant<bool, std::string> recorrer(
+        const std::function<bool(const Proveedor&)>& visitante) override;
+    std::variant<bool, std::string> recorrerDesde(
+        int desdeId, const std::function<bool(const Proveedor&)>& visitante) override;
+    Generador<const Proveedor&> generar(int desdeId = 1) override;
+    EstadisticasContencion obtenerContencion() const override;
+    const CodecRegistro<Proveedor>& codecRegistros() const override;
 };
@@ -0,0 +1,696 @@
+#include "FSRollupRepository.hpp"
+
+#include <algorithm>
+#include <system_error>
+
+#include "domain/constants.hpp"
+#include "domain/utils/EjecutorTareas.hpp"
+#include "infrastructure/datasource/BloqueoArchivo.hpp"
+
+namespace {
+
+constexpr std::streamoff PERIODO_RECORD_SIZE =
+    sizeof(int) * 3 + sizeof(std::int64_t) * 4;  // periodo, cantidades, montos y unidades
+constexpr std::streamoff PRODUCTO_RECORD_SIZE = sizeof(int) * 2 + sizeof(std::int64_t) * 3;
+constexpr std::size_t SCAN_BUFFER_SIZE = 1 << 16;
+
+std::streamoff slotOffset(int slot, std::streamoff recordSize)
+{
+    return static_cast<std::streamoff>(sizeof(HeaderFile)) +
+           static_cast<std::streamoff>(slot - 1) * recordSize;
+}
+
+std::uint64_t claveProducto(int periodo, int productoId)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(periodo)) << 32) |
+           static_cast<std::uint32_t>(productoId);
+}
+
+bool escribirPeriodo(std::ostream& os, const RollupPeriodo& r)
+{
+    const std::int64_t ingresos = r.ingresosVentas.cents();
+    const std::int64_t gasto = r.gastoCompras.cents();
+
+    os.write(reinterpret_cast<const char*>(&r.periodo), sizeof(r.periodo));
+    os.write(reinterpret_cast<const char*>(&r.cantidadVentas), sizeof(r.cantidadVentas));
+    os.write(reinterpret_cast<const char*>(&r.cantidadCompras), sizeof(r.cantidadCompras));
+    os.write(reinterpret_cast<const char*>(&ingresos), sizeof(ingresos));
+    os.write(reinterpret_cast<const char*>(&gasto), sizeof(gasto));
+    os.write(reinterpret_cast<const char*>(&r.unidadesVendidas), sizeof(r.unidadesVendidas));
+    os.write(reinterpret_cast<const char*>(&r.unidadesCompradas), sizeof(r.unidadesCompradas));
+    return static_cast<bool>(os);
+}
+
+bool leerPeriodo(std::istream& is, RollupPeriodo& r)
+{
+    std::int64_t ingresos = 0;
+    std::int64_t gasto = 0;
+
+    is.read(reinterpret_cast<char*>(&r.periodo), sizeof(r.periodo));
+    is.read(reinterpret_cast<char*>(&r.cantidadVentas), sizeof(r.cantidadVentas));
+    is.read(reinterpret_cast<char*>(&r.cantidadCompras), sizeof(r.cantidadCompras));
+    is.read(reinterpret_cast<char*>(&ingresos), sizeof(ingresos));
+    is.read(reinterpret_cast<char*>(&gasto), sizeof(gasto));
+    is.read(reinterpret_cast<char*>(&r.unidadesVendidas), sizeof(r.unidadesVendidas));
+    is.read(reinterpret_cast<char*>(&r.unidadesCompradas), sizeof(r.unidadesCompradas));
+
+    r.ingresosVentas = Money::fromCents(ingresos);
+    r.gastoCompras = Money::fromCents(gasto);
+    return static_cast<bool>(is);
+}
+
+bool escribirProducto(std::ostream& os, const RollupProducto& r)
+{
+    const std::int64_t ingresos = r.ingresosVentas.cents();
+
+    os.write(reinterpret_cast<const char*>(&r.periodo), sizeof(r.periodo));
+    os.write(reinterpret_cast<const char*>(&r.productoId), sizeof(r.productoId));
+    os.write(reinterpret_cast<const char*>(&r.unidadesVendidas), sizeof(r.unidadesVendidas));
+    os.write(reinterpret_cast<const char*>(&r.unidadesCompradas), sizeof(r.unidadesCompradas));
+    os.write(reinterpret_cast<const char*>(&ingresos), sizeof(ingresos));
+    return static_cast<bool>(os);
+}
+
+bool leerProducto(std::istream& is, RollupProducto& r)
+{
+    std::int64_t ingresos = 0;
+
+    is.read(reinterpret_cast<char*>(&r.periodo), sizeof(r.periodo));
+    is.read(reinterpret_cast<char*>(&r.productoId), sizeof(r.productoId));
+    is.read(reinterpret_cast<char*>(&r.unidadesVendidas), sizeof(r.unidadesVendidas));
+    is.read(reinterpret_cast<char*>(&r.unidadesCompradas), sizeof(r.unidadesCompradas));
+    is.read(reinterpret_cast<char*>(&ingresos), sizeof(ingresos));
+
+    r.ingresosVentas = Money::fromCents(ingresos);
+    return static_cast<bool>(is);
+}
+
+std::variant<HeaderFile, std::string> leerHeader(std::istream& file, const fs::path& path)
+{
+    HeaderFile header = {};
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(&header), sizeof(HeaderFile));
+    if (!file) {
+        return "No se pudo leer el encabezado de " + path.string();
+    }
+
+    if (header.version != Constants::BINARY_FORMAT::VERSION_ACTUAL) {
+        return "Version de formato no soportada en " + path.string();
+    }
+
+    return header;
+}
+
+/// Escribe un archivo nuevo en `<path>.tmp` y lo reemplaza con rename al terminar.
+template <typename Escritor>
+std::variant<bool, std::string> reemplazarArchivo(const fs::path& path, const HeaderFile& header,
+                                                  Escritor escribirRegistros)
+{
+    const fs::path tmpPath = fs::path(path).concat(".tmp");
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return "No se pudo crear archivo temporal: " + tmpPath.string();
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(HeaderFile));
+        if (!escribirRegistros(file) || !file.flush()) {
+            file.close();
+            fs::remove(tmpPath);
+            return "Error escribiendo rollup en " + tmpPath.string();
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        return "No se pudo reemplazar " + path.string() + ": " + ec.message();
+    }
+
+    return true;
+}
+
+}  // namespace
+
+const fs::path& FSRollupRepository::periodosPath(GranularidadRollup granularidad)
+{
+    return granularidad == DIARIO ? Constants::PATHS::ROLLUP_DIARIO_PATH
+                                  : Constants::PATHS::ROLLUP_MENSUAL_PATH;
+}
+
+const fs::path& FSRollupRepository::productosPath(GranularidadRollup granularidad)
+{
+    return granularidad == DIARIO ? Constants::PATHS::ROLLUP_PRODUCTOS_DIARIO_PATH
+                                  : Constants::PATHS::ROLLUP_PRODUCTOS_MENSUAL_PATH;
+}
+
+void FSRollupRepository::construirDeltas(const Transaccion& transaccion, int signo,
+                                         GranularidadRollup granularidad,
+                                         RollupPeriodo& outPeriodo,
+                                         std::vector<RollupProducto>& outProductos)
+{
+    const bool esVenta = transaccion.getTipoTransaccion() == VENTA;
+    const int periodo = RollupCalendario::clave(granularidad, transaccion.getFechaCreacion());
+
+    outPeriodo = RollupPeriodo{};
+    outPeriodo.periodo = periodo;
+    if (esVenta) {
+        outPeriodo.cantidadVentas = signo;
+        outPeriodo.ingresosVentas = transaccion.getTotal() * signo;
+    } else {
+        outPeriodo.cantidadCompras = signo;
+        outPeriodo.gastoCompras = transaccion.getTotal() * signo;
+    }
+
+    outProductos.clear();
+    for (int i = 0; i < transaccion.getProductosTotales(); ++i) {
+        TransaccionDTO item{};
+        if (!transaccion.getProductoEnIndice(i, item)) {
+            continue;
+        }
+
+        RollupProducto producto{};
+        producto.periodo = periodo;
+        producto.productoId = item.productoId;
+        const std::int64_t unidades = static_cast<std::int64_t>(item.cantidad) * signo;
+        if (esVenta) {
+            producto.unidadesVendidas = unidades;
+            producto.ingresosVentas = item.precio * unidades;
+            outPeriodo.unidadesVendidas += unidades;
+        } else {
+            producto.unidadesCompradas = unidades;
+            outPeriodo.unidadesCompradas += unidades;
+        }
+        outProductos.push_back(producto);
+    }
+}
+
+std::variant<bool, std::string> FSRollupRepository::registrarTransaccion(
+    const Transaccion& transaccion, int signo)
+{
+    if (signo != 1 && signo != -1) {
+        return "Signo de rollup invalido";
+    }
+
+    std::unique_lock<std::shared_mutex> lock(accesoRollups);
+    const BloqueoArchivo bloqueo(Constants::PATHS::ROLLUP_LOCK_PATH, BloqueoArchivo::EXCLUSIVO);
+    std::variant<bool, std::string> result =
+        "No se pudo bloquear " + Constants::PATHS::ROLLUP_LOCK_PATH.string();
+    if (bloqueo.activo()) {
+        result = acumularTransaccion(transaccion, signo);
+    }
+    if (std::holds_alternative<std::string>(result)) {
+        // los indices en memoria pueden no coincidir con lo que quedo escrito
+        indiceProductos[DIARIO] = {};
+        indiceProductos[MENSUAL] = {};
+        std::ofstream marca(Constants::PATHS::ROLLUP_DESACTUALIZADO_PATH, std::ios::app);
+        if (!marca.flush()) {
+            return std::get<std::string>(result) + " (y no se pudo marcar para reconstruir)";
+        }
+    }
+    return result;
+}
+
+std::variant<bool, std::string> FSRollupRepository::acumularTransaccion(
+    const Transaccion& transaccion, int signo)
+{
+    RollupPeriodo periodo;
+    std::vector<RollupProducto> productos;
+    for (GranularidadRollup granularidad : {DIARIO, MENSUAL}) {
+        construirDeltas(transaccion, signo, granularidad, periodo, productos);
+
+        auto periodoResult = acumularPeriodo(granularidad, periodo);
+        if (std::holds_alternative<std::string>(periodoResult)) {
+            return std::get<std::string>(periodoResult);
+        }
+
+        auto productosResult = acumularProductos(granularidad, productos);
+        if (std::holds_alternative<std::string>(productosResult)) {
+            return std::get<std::string>(productosResult);
+        }
+    }
+
+    return true;
+}
+
+std::variant<bool, std::string> FSRollupRepository::acumularPeriodo(
+    GranularidadRollup granularidad, const RollupPeriodo& delta)
+{
+    const fs::path& path = periodosPath(granularidad);
+    const int indiceDelta = RollupCalendario::indice(granularidad, delta.periodo);
+
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file.is_open()) {
+        return "No se pudo abrir " + path.string();
+    }
+
+    auto headerResult = leerHeader(file, path);
+    if (std::holds_alternative<std::string>(headerResult)) {
+        return std::get<std::string>(headerResult);
+    }
+    HeaderFile header = std::get<HeaderFile>(headerResult);
+
+    int indiceBase = indiceDelta;
+    if (header.cantidadRegistros > 0) {
+        RollupPeriodo primero;
+        file.seekg(slotOffset(1, PERIODO_RECORD_SIZE), std::ios::beg);
+        if (!leerPeriodo(file, primero)) {
+            return "No se pudo leer el primer periodo de " + path.string();
+        }
+        indiceBase = RollupCalendario::indice(granularidad, primero.periodo);
+    }
+
+    // un periodo anterior al primero (reloj atrasado) obliga a desplazar todo el archivo
+    if (indiceDelta < indiceBase) {
+        file.close();
+        auto periodosResult = leerTodosLosPeriodos(granularidad);
+        if (std::holds_alternative<std::string>(periodosResult)) {
+            return std::get<std::string>(periodosResult);
+        }
+
+        auto periodos = std::get<std::map<int, RollupPeriodo>>(std::move(periodosResult));
+        periodos[indiceDelta].periodo = delta.periodo;
+        periodos[indiceDelta].acumular(delta);
+        return reescribirPeriodos(granularidad, periodos);
+    }
+
+    const int slot = indiceDelta - indiceBase + 1;
+    RollupPeriodo actual;
+    if (slot <= header.cantidadRegistros) {
+        file.seekg(slotOffset(slot, PERIODO_RECORD_SIZE), std::ios::beg);
+        if (!leerPeriodo(file, actual)) {
+            return "No se pudo leer el periodo " + std::to_string(delta.periodo);
+        }
+    } else {
+        // se completan los periodos sin movimiento para mantener el archivo denso
+        file.seekp(slotOffset(header.cantidadRegistros + 1, PERIODO_RECORD_SIZE), std::ios::beg);
+        for (int hueco = header.cantidadRegistros + 1; hueco < slot; ++hueco) {
+            RollupPeriodo vacio;
+            vacio.periodo = RollupCalendario::claveDesdeIndice(granularidad, indiceBase + hueco - 1);
+            escribirPeriodo(file, vacio);
+        }
+        actual.periodo = delta.periodo;
+        header.cantidadRegistros = slot;
+        header.proximoID = slot + 1;
+    }
+
+    const bool estabaVacio = actual.vacio();
+    actual.acumular(delta);
+    if (estabaVacio != actual.vacio()) {
+        header.registrosActivos += estabaVacio ? 1 : -1;
+    }
+
+    file.seekp(slotOffset(slot, PERIODO_RECORD_SIZE), std::ios::beg);
+    if (!escribirPeriodo(file, actual)) {
+        return "No se pudo escribir el periodo " + std::to_string(delta.periodo);
+    }
+
+    file.seekp(0, std::ios::beg);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(HeaderFile));
+    if (!file) {
+        return "No se pudo escribir el encabezado de " + path.string();
+    }
+
+    return true;
+}
+
+std::variant<bool, std::string> FSRollupRepository::cargarIndiceProductos(
+    GranularidadRollup granularidad, std::fstream& file, const HeaderFile& header)
+{
+    IndiceProductos& indice = indiceProductos[granularidad];
+    indice.slots.clear();
+    indice.slots.reserve(static_cast<std::size_t>(header.cantidadRegistros));
+
+    file.seekg(slotOffset(1, PRODUCTO_RECORD_SIZE), std::ios::beg);
+    for (int slot = 1; slot <= header.cantidadRegistros; ++slot) {
+        RollupProducto registro;
+        if (!leerProducto(file, registro)) {
+            return "Rollup de productos truncado en el slot " + std::to_string(slot);
+        }
+        indice.slots[claveProducto(registro.periodo, registro.productoId)] = slot;
+    }
+
+    indice.cargado = true;
+    indice.registros = header.cantidadRegistros;
+    return true;
+}
+
+std::variant<bool, std::string> FSRollupRepository::acumularProductos(
+    GranularidadRollup granularidad, const std::vector<RollupProducto>& deltas)
+{
+    if (deltas.empty()) {
+        return true;
+    }
+
+    const fs::path& path = productosPath(granularidad);
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file.is_open()) {
+        return "No se pudo abrir " + path.string();
+    }
+
+    auto headerResult = leerHeader(file, path);
+    if (std::holds_alternative<std::string>(headerResult)) {
+        return std::get<std::string>(headerResult);
+    }
+    HeaderFile header = std::get<HeaderFile>(headerResult);
+
+    IndiceProductos& indice = indiceProductos[granularidad];
+    // otro proceso pudo agregar slots desde la ultima carga: el indice se reconstruye
+    if (!indice.cargado || indice.registros != header.cantidadRegistros) {
+        auto indiceResult = cargarIndiceProductos(granularidad, file, header);
+        if (std::holds_alternative<std::string>(indiceResult)) {
+            return std::get<std::string>(indiceResult);
+        }
+    }
+
+    for (const RollupProducto& delta : deltas) {
+        const std::uint64_t clave = claveProducto(delta.periodo, delta.productoId);
+        auto it = indice.slots.find(clave);
+
+        RollupProducto actual = delta;
+        int slot = 0;
+        if (it != indice.slots.end()) {
+            slot = it->second;
+            file.seekg(slotOffset(slot, PRODUCTO_RECORD_SIZE), std::ios::beg);
+            if (!leerProducto(file, actual)) {
+                return "No se pudo leer el rollup del producto " +
+                       std::to_string(delta.productoId);
+            }
+            actual.acumular(delta);
+        } else {
+            slot = header.cantidadRegistros + 1;
+            header.cantidadRegistros = slot;
+            header.proximoID = slot + 1;
+            header.registrosActivos += 1;
+            indice.slots.emplace(clave, slot);
+        }
+
+        file.seekp(slotOffset(slot, PRODUCTO_RECORD_SIZE), std::ios::beg);
+        if (!escribirProducto(file, actual)) {
+            return "No se pudo escribir el rollup del producto " +
+                   std::to_string(delta.productoId);
+        }
+    }
+
+    file.seekp(0, std::ios::beg);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(HeaderFile));
+    if (!file) {
+        return "No se pudo escribir el encabezado de " + path.string();
+    }
+
+    indice.registros = header.cantidadRegistros;
+    return true;
+}
+
+std::variant<std::map<int, RollupPeriodo>, std::string> FSRollupRepository::leerTodosLosPeriodos(
+    GranularidadRollup granularidad)
+{
+    const fs::path& path = periodosPath(granularidad);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return "No se pudo abrir " + path.string();
+    }
+
+    auto headerResult = leerHeader(file, path);
+    if (std::holds_alternative<std::string>(headerResult)) {
+        return std::get<std::string>(headerResult);
+    }
+    const HeaderFile header = std::get<HeaderFile>(headerResult);
+
+    std::map<int, RollupPeriodo> periodos;
+    for (int slot = 1; slot <= header.cantidadRegistros; ++slot) {
+        RollupPeriodo registro;
+        if (!leerPeriodo(file, registro)) {
+            return "Rollup de periodos truncado en el slot " + std::to_string(slot);
+        }
+        periodos[RollupCalendario::indice(granularidad, registro.periodo)] = registro;
+    }
+
+    return periodos;
+}
+
+std::variant<bool, std::string> FSRollupRepository::reescribirPeriodos(
+    GranularidadRollup granularidad, const std::map<int, RollupPeriodo>& periodos)
+{
+    HeaderFile header{0, 1, 0, Constants::BINARY_FORMAT::VERSION_ACTUAL};
+    if (!periodos.empty()) {
+        header.cantidadRegistros = periodos.rbegin()->first - periodos.begin()->first + 1;
+        header.proximoID = header.cantidadRegistros + 1;
+        header.registrosActivos = static_cast<int>(std::count_if(
+            periodos.begin(), periodos.end(), [](const auto& p) { return !p.second.vacio(); }));
+    }
+
+    return reemplazarArchivo(periodosPath(granularidad), header, [&](std::ostream& os) {
+        if (periodos.empty()) {
+            return true;
+        }
+
+        auto it = periodos.begin();
+        for (int indice = periodos.begin()->first; indice <= periodos.rbegin()->first; ++indice) {
+            if (it != periodos.end() && it->first == indice) {
+                escribirPeriodo(os, it->second);
+                ++it;
+                continue;
+            }
+
+            RollupPeriodo vacio;
+            vacio.periodo = RollupCalendario::claveDesdeIndice(granularidad, indice);
+            escribirPeriodo(os, vacio);
+        }
+        return static_cast<bool>(os);
+    });
+}
+
+std::variant<bool, std::string> FSRollupRepository::reescribirProductos(
+    GranularidadRollup granularidad, const std::map<std::uint64_t, RollupProducto>& productos)
+{
+    const int cantidad = static_cast<int>(productos.size());
+    const HeaderFile header{cantidad, cantidad + 1, cantidad,
+                            Constants::BINARY_FORMAT::VERSION_ACTUAL};
+
+    auto result = reemplazarArchivo(productosPath(granularidad), header, [&](std::ostream& os) {
+        for (const auto& [clave, producto] : productos) {
+            escribirProducto(os, producto);
+        }
+        return static_cast<bool>(os);
+    });
+
+    // el orden de slots cambio; el indice se reconstruye en la proxima escritura
+    indiceProductos[granularidad] = IndiceProductos{};
+    return result;
+}
+
+std::variant<std::vector<RollupPeriodo>, std::string> FSRollupRepository::leerRango(
+    GranularidadRollup granularidad, int desde, int hasta)
+{
+    if (!RollupCalendario::claveValida(granularidad, desde) ||
+        !RollupCalendario::claveValida(granularidad, hasta)) {
+        return "Periodo invalido";
+    }
+
+    const fs::path& path = periodosPath(granularidad);
+    std::shared_lock<std::shared_mutex> lock(accesoRollups);
+    const BloqueoArchivo bloqueo(Constants::PATHS::ROLLUP_LOCK_PATH, BloqueoArchivo::COMPARTIDO);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return "No se pudo abrir " + path.string();
+    }
+
+    auto headerResult = leerHeader(file, path);
+    if (std::holds_alternative<std::string>(headerResult)) {
+        return std::get<std::string>(headerResult);
+    }
+    const HeaderFile header = std::get<HeaderFile>(headerResult);
+
+    std::vector<RollupPeriodo> resultado;
+    if (header.cantidadRegistros == 0) {
+        return resultado;
+    }
+
+    RollupPeriodo primero;
+    if (!leerPeriodo(file, primero)) {
+        return "No se pudo leer el primer periodo de " + path.string();
+    }
+
+    const int indiceBase = RollupCalendario::indice(granularidad, primero.periodo);
+    const int inicio = std::max(RollupCalendario::indice(granularidad, desde), indiceBase);
+    const int fin = std::min(RollupCalendario::indice(granularidad, hasta),
+                             indiceBase + header.cantidadRegistros - 1);
+    if (inicio > fin) {
+        return resultado;
+    }
+
+    // el rango es contiguo en disco: un seek y lectura secuencial
+    file.seekg(slotOffset(inicio - indiceBase + 1, PERIODO_RECORD_SIZE), std::ios::beg);
+    resultado.reserve(static_cast<std::size_t>(fin - inicio + 1));
+    for (int indice = inicio; indice <= fin; ++indice) {
+        RollupPeriodo registro;
+        if (!leerPeriodo(file, registro)) {
+            return "Rollup de periodos truncado en " + path.string();
+        }
+        if (!registro.vacio()) {
+            resultado.push_back(registro);
+        }
+    }
+
+    return resultado;
+}
+
+std::variant<std::vector<RollupProducto>, std::string> FSRollupRepository::leerProductos(
+    GranularidadRollup granularidad, int periodo)
+{
+    if (!RollupCalendario::claveValida(granularidad, periodo)) {
+        return "Periodo invalido";
+    }
+
+    const fs::path& path = productosPath(granularidad);
+    std::shared_lock<std::shared_mutex> lock(accesoRollups);
+    const BloqueoArchivo bloqueo(Constants::PATHS::ROLLUP_LOCK_PATH, BloqueoArchivo::COMPARTIDO);
+    std::vector<char> buffer(SCAN_BUFFER_SIZE);
+    std::ifstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        return "No se pudo abrir " + path.string();
+    }
+
+    auto headerResult = leerHeader(file, path);
+    if (std::holds_alternative<std::string>(headerResult)) {
+        return std::get<std::string>(headerResult);
+    }
+    const HeaderFile header = std::get<HeaderFile>(headerResult);
+
+    std::vector<RollupProducto> resultado;
+    for (int slot = 1; slot <= header.cantidadRegistros; ++slot) {
+        RollupProducto registro;
+        if (!leerProducto(file, registro)) {
+            return "Rollup de productos truncado en " + path.string();
+        }
+        if (registro.periodo == periodo &&
+            (registro.unidadesVendidas != 0 || registro.unidadesCompradas != 0)) {
+            resultado.push_back(registro);
+        }
+    }
+
+    return resultado;
+}
+
+std::variant<bool, std::string> FSRollupRepository::reconstruir(
+    ITransaccionRepository& transacciones)
+{
+    auto headerResult = transacciones.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(headerResult)) {
+        return "No se pudo recorrer transacciones: " + std::get<std::string>(headerResult);
+    }
+
+    // cada tramo acumula sus propios mapas y se combinan al final (solo sumas, el orden no importa)
+    struct ParcialRollup {
+        std::map<int, RollupPeriodo> periodos[2];
+        std::map<std::uint64_t, RollupProducto> productos[2];
+        RollupPeriodo deltaPeriodo;
+        std::vector<RollupProducto> deltaProductos;
+    };
+    const HeaderFile header = std::get<HeaderFile>(headerResult);
+    std::vector<ParcialRollup> parciales(tramosDeRecorrido(header));
+    try {
+        recorrerEnParalelo<Transaccion>(
+            "reconstruir rollups", transacciones, header.proximoID,
+            [&](std::size_t tramo, const Transaccion& transaccion) {
+                ParcialRollup& parcial = parciales[tramo];
+                for (GranularidadRollup granularidad : {DIARIO, MENSUAL}) {
+                    construirDeltas(transaccion, 1, granularidad, parcial.deltaPeriodo,
+                                    parcial.deltaProductos);
+
+                    RollupPeriodo& periodo =
+                        parcial.periodos[granularidad][RollupCalendario::indice(
+                            granularidad, parcial.deltaPeriodo.periodo)];
+                    periodo.periodo = parcial.deltaPeriodo.periodo;
+                    periodo.acumular(parcial.deltaPeriodo);
+
+                    for (const RollupProducto& delta : parcial.deltaProductos) {
+                        RollupProducto& producto = parcial.productos[granularidad][claveProducto(
+                            delta.periodo, delta.productoId)];
+                        producto.periodo = delta.periodo;
+                        producto.productoId = delta.productoId;
+                        producto.acumular(delta);
+                    }
+                }
+            });
+    } catch (const std::exception& e) {
+        return "No se pudo recorrer transacciones: " + std::string(e.what());
+    }
+
+    std::map<int, RollupPeriodo> periodos[2];
+    std::map<std::uint64_t, RollupProducto> productos[2];
+    for (const ParcialRollup& parcial : parciales) {
+        for (GranularidadRollup granularidad : {DIARIO, MENSUAL}) {
+            for (const auto& [indice, delta] : parcial.periodos[granularidad]) {
+                RollupPeriodo& periodo = periodos[granularidad][indice];
+                periodo.periodo = delta.periodo;
+                periodo.acumular(delta);
+            }
+            for (const auto& [clave, delta] : parcial.productos[granularidad]) {
+                RollupProducto& producto = productos[granularidad][clave];
+                producto.periodo = delta.periodo;
+                producto.productoId = delta.productoId;
+                producto.acumular(delta);
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(accesoRollups);
+    const BloqueoArchivo bloqueo(Constants::PATHS::ROLLUP_LOCK_PATH, BloqueoArchivo::EXCLUSIVO);
+    if (!bloqueo.activo()) {
+        return "No se pudo bloquear " + Constants::PATHS::ROLLUP_LOCK_PATH.string();
+    }
+
+    for (GranularidadRollup granularidad : {DIARIO, MENSUAL}) {
+        auto periodosResult = reescribirPeriodos(granularidad, periodos[granularidad]);
+        if (std::holds_alternative<std::string>(periodosResult)) {
+            return std::get<std::string>(periodosResult);
+        }
+
+        auto productosResult = reescribirProductos(granularidad, productos[granularidad]);
+        if (std::holds_alternative<std::string>(productosResult)) {
+            return std::get<std::string>(productosResult);
+        }
+    }
+
+    std::error_code ec;
+    fs::remove(Constants::PATHS::ROLLUP_DESACTUALIZADO_PATH, ec);
+    return true;
+}
+
+std::variant<HeaderFile, std::string> FSRollupRepository::obtenerEstadisticas()
+{
+    std::shared_lock<std::shared_mutex> lock(accesoRollups);
+    const BloqueoArchivo bloqueo(Constants::PATHS::ROLLUP_LOCK_PATH, BloqueoArchivo::COMPARTIDO);
+    const fs::path& path = periodosPath(DIARIO);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return "Error abriendo archivo para obtener estadísticas: " + path.string();
+    }
+
+    return leerHeader(file, path);
+}
+
+std::variant<bool, std::string> FSRollupRepository::requiereReconstruir(int transaccionesActivas)
+{
+    std::shared_lock<std::shared_mutex> lock(accesoRollups);
+    const BloqueoArchivo bloqueo(Constants::PATHS::ROLLUP_LOCK_PATH, BloqueoArchivo::COMPARTIDO);
+    std::error_code ec;
+    if (fs::exists(Constants::PATHS::ROLLUP_DESACTUALIZADO_PATH, ec)) {
+        return true;
+    }
+
+    // cada transaccion activa suma 1 a las ventas o a las compras de su mes (pocos registros)
+    auto periodosResult = leerTodosLosPeriodos(MENSUAL);
+    if (std::holds_alternative<std::string>(periodosResult)) {
+        return std::get<std::string>(periodosResult);
+    }
+    std::int64_t contadas = 0;
+    for (const auto& [indice, periodo] : std::get<std::map<int, RollupPeriodo>>(periodosResult)) {
+        contadas += periodo.cantidadVentas + periodo.cantidadCompras;
+    }
+    return contadas != transaccionesActivas;
+}
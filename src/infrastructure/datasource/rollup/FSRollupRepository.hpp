@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "domain/HeaderFile.hpp"
+#include "domain/repositories/IRollupRepository.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Rollups de ventas/compras persistidos en ./data junto al resto de archivos .bin.
+ *
+ * Los archivos de periodos son densos: el slot 1 guarda el primer periodo registrado y el
+ * slot de cualquier otro se calcula por diferencia de indices, sin busquedas. Los archivos de
+ * unidades por producto son de registros agregados al final, con un indice en memoria
+ * (periodo, producto) -> slot construido en la primera escritura.
+ *
+ * Una actualizacion que falla a mitad deja los archivos sin la transaccion (o con parte de
+ * ella); en lugar de quedar asi para siempre se crea ROLLUP_DESACTUALIZADO_PATH, que
+ * requiereReconstruir informa y reconstruir borra.
+ */
+class FSRollupRepository : public IRollupRepository
+{
+   private:
+    struct IndiceProductos {
+        bool cargado{false};
+        /// cantidadRegistros del archivo cuando se cargo o actualizo el indice.
+        int registros{0};
+        std::unordered_map<std::uint64_t, int> slots;
+    };
+
+    IndiceProductos indiceProductos[2];
+    /// Compartido para consultas, exclusivo para acumular o reconstruir (incluye los indices).
+    /// Entre procesos se usa el flock de ROLLUP_LOCK_PATH: reconstruir reemplaza los archivos de
+    /// datos con un rename, asi que un lock sobre ellos no seria estable.
+    std::shared_mutex accesoRollups;
+
+    static const fs::path& periodosPath(GranularidadRollup granularidad);
+    static const fs::path& productosPath(GranularidadRollup granularidad);
+
+    /// Aplica la transaccion en los cuatro archivos; registrarTransaccion marca si falla.
+    std::variant<bool, std::string> acumularTransaccion(const Transaccion& transaccion, int signo);
+
+    /// Calcula el aporte de una transaccion a un periodo y a sus productos.
+    static void construirDeltas(const Transaccion& transaccion, int signo,
+                                GranularidadRollup granularidad, RollupPeriodo& outPeriodo,
+                                std::vector<RollupProducto>& outProductos);
+
+    std::variant<bool, std::string> acumularPeriodo(GranularidadRollup granularidad,
+                                                    const RollupPeriodo& delta);
+    std::variant<bool, std::string> acumularProductos(GranularidadRollup granularidad,
+                                                      const std::vector<RollupProducto>& deltas);
+    std::variant<bool, std::string> cargarIndiceProductos(GranularidadRollup granularidad,
+                                                          std::fstream& file,
+                                                          const HeaderFile& header);
+
+    /// Lee todos los slots de periodos indexados por su indice de calendario.
+    std::variant<std::map<int, RollupPeriodo>, std::string> leerTodosLosPeriodos(
+        GranularidadRollup granularidad);
+
+    /// Reescribe el archivo de periodos completo (denso entre el menor y el mayor indice).
+    std::variant<bool, std::string> reescribirPeriodos(
+        GranularidadRollup granularidad, const std::map<int, RollupPeriodo>& periodos);
+    std::variant<bool, std::string> reescribirProductos(
+        GranularidadRollup granularidad, const std::map<std::uint64_t, RollupProducto>& productos);
+
+   public:
+    FSRollupRepository() = default;
+
+    std::variant<bool, std::string> registrarTransaccion(const Transaccion& transaccion,
+                                                         int signo) override;
+    std::variant<std::vector<RollupPeriodo>, std::string> leerRango(
+        GranularidadRollup granularidad, int desde, int hasta) override;
+    std::variant<std::vector<RollupProducto>, std::string> leerProductos(
+        GranularidadRollup granularidad, int periodo) override;
+    std::variant<bool, std::string> reconstruir(ITransaccionRepository& transacciones) override;
+    std::variant<bool, std::string> requiereReconstruir(int transaccionesActivas) override;
+    std::variant<HeaderFile, std::string> obtenerEstadisticas() override;
+};
@@ -1,40 +1,537 @@
 #include "FSTransaccionRepository.hpp"
 
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <sys/stat.h>
+
 #include "domain/constants.hpp"
+#include "domain/utils/utils.hpp"
+#include "infrastructure/datasource/BloqueoArchivo.hpp"
+#include "infrastructure/datasource/RegistroCambios.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+void sumar(EstadisticasContencion& total, const EstadisticasContencion& parte)
+{
+    total.lecturas += parte.lecturas;
+    total.esperasLectura += parte.esperasLectura;
+    total.escrituras += parte.escrituras;
+    total.esperasEscritura += parte.esperasEscritura;
+    total.bloqueosRegistro += parte.bloqueosRegistro;
+    total.esperasRegistro += parte.esperasRegistro;
+    total.esperasEntreProcesos += parte.esperasEntreProcesos;
+}
+
+}  // namespace
 
 FSTransaccionRepository::FSTransaccionRepository()
-    : baseRepository(Constants::PATHS::TRANSACCIONES_PATH)
+    : rutaManifiesto(Constants::PATHS::TRANSACCIONES_PARTICIONES_PATH),
+      rutaLock(Constants::PATHS::TRANSACCIONES_LOCK_PATH)
+{
+}
+
+FSTransaccionRepository::IdentidadArchivo FSTransaccionRepository::identidadManifiesto() const
+{
+    struct stat datos = {};
+    if (::stat(rutaManifiesto.c_str(), &datos) != 0) {
+        return {};
+    }
+    return {datos.st_ino, static_cast<std::int64_t>(datos.st_mtim.tv_sec) * 1000000000 +
+                              datos.st_mtim.tv_nsec};
+}
+
+std::variant<FSTransaccionRepository::ListaCompartida, std::string>
+FSTransaccionRepository::obtenerParticiones()
+{
+    // la identidad se toma antes de leer: si cambia en medio, la proxima operacion relee
+    const IdentidadArchivo actual = identidadManifiesto();
+    {
+        const std::shared_lock<std::shared_mutex> lock(mutexParticiones);
+        if (lista != nullptr && lista->identidad == actual) {
+            return lista;
+        }
+    }
+
+    const std::unique_lock<std::shared_mutex> lock(mutexParticiones);
+    if (lista != nullptr && lista->identidad == actual) {
+        return lista;
+    }
+    std::vector<ParticionTransacciones> leidas;
+    std::string error;
+    if (!ManifiestoParticiones::leer(rutaManifiesto, leidas, error)) {
+        return error;
+    }
+
+    auto nueva = std::make_shared<ListaParticiones>();
+    nueva->identidad = actual;
+    nueva->particiones.reserve(leidas.size());
+    for (const ParticionTransacciones& particion : leidas) {
+        const fs::path ruta = ManifiestoParticiones::rutaArchivo(rutaManifiesto, particion);
+        if (particion.archivada) {
+            std::shared_ptr<SegmentoFrio>& archivo =
+                archivados[{particion.nombreArchivo(), particion.primerId}];
+            if (!archivo) {
+                archivo = std::make_shared<SegmentoFrio>(ruta);
+            }
+            nueva->particiones.push_back(ParticionAbierta{particion, nullptr, archivo});
+            continue;
+        }
+
+        std::shared_ptr<Particion>& repositorio =
+            repositorios[{particion.nombreArchivo(), particion.primerId}];
+        if (!repositorio) {
+            repositorio = std::make_shared<Particion>(ruta, particion.primerId);
+        }
+        nueva->particiones.push_back(ParticionAbierta{particion, repositorio, nullptr});
+    }
+    lista = std::move(nueva);
+    return lista;
+}
+
+std::variant<FSTransaccionRepository::ListaCompartida, std::string>
+FSTransaccionRepository::particionesConocidas()
 {
+    {
+        const std::shared_lock<std::shared_mutex> lock(mutexParticiones);
+        if (lista != nullptr) {
+            return lista;
+        }
+    }
+    return obtenerParticiones();
+}
+
+std::variant<FSTransaccionRepository::ParticionAbierta, std::string>
+FSTransaccionRepository::particionDeId(const ListaParticiones& lista, int id)
+{
+    const auto siguiente = std::upper_bound(
+        lista.particiones.begin(), lista.particiones.end(), id,
+        [](int buscado, const ParticionAbierta& particion) {
+            return buscado < particion.datos.primerId;
+        });
+    if (siguiente == lista.particiones.begin()) {
+        return "ID fuera de rango o registro no existe";
+    }
+    return *std::prev(siguiente);
+}
+
+std::variant<std::shared_ptr<FSTransaccionRepository::Particion>, std::string>
+FSTransaccionRepository::particionModificable(const ListaParticiones& lista, int id)
+{
+    auto particion = particionDeId(lista, id);
+    if (std::holds_alternative<std::string>(particion)) {
+        return std::get<std::string>(particion);
+    }
+    const ParticionAbierta& abierta = std::get<ParticionAbierta>(particion);
+    if (abierta.archivo) {
+        return std::format("La transaccion {} esta archivada y es de solo lectura", id);
+    }
+    return abierta.repositorio;
+}
+
+std::variant<int, std::string> FSTransaccionRepository::finDeParticion(
+    const std::vector<ParticionAbierta>& lista, std::size_t indice)
+{
+    if (indice + 1 < lista.size()) {
+        return lista[indice + 1].datos.primerId;
+    }
+
+    auto headerResult = lista[indice].archivo
+                            ? lista[indice].archivo->obtenerEstadisticas()
+                            : lista[indice].repositorio->obtenerEstadisticasTemplate();
+    if (std::holds_alternative<std::string>(headerResult)) {
+        return std::get<std::string>(headerResult);
+    }
+    return std::get<HeaderFile>(headerResult).proximoID;
+}
+
+std::variant<FSTransaccionRepository::ListaCompartida, std::string>
+FSTransaccionRepository::prepararParticion(const Transaccion& entidad)
+{
+    auto listaResult = obtenerParticiones();
+    if (std::holds_alternative<std::string>(listaResult)) {
+        return std::get<std::string>(listaResult);
+    }
+
+    std::vector<ParticionTransacciones> lista;
+    for (const ParticionAbierta& particion : std::get<ListaCompartida>(listaResult)->particiones) {
+        lista.push_back(particion.datos);
+    }
+
+    const system_clock::time_point fecha = entidad.getFechaCreacion();
+    const ParticionTransacciones nueva = ParticionTransacciones::nueva(fecha, entidad.getId());
+    std::string error;
+    if (lista.empty() || nueva.mes > lista.back().mes) {
+        HeaderFile header{0, 1, 0, Constants::BINARY_FORMAT::VERSION_ACTUAL};
+        if (!lista.empty() &&
+            !ManifiestoParticiones::leerHeader(
+                ManifiestoParticiones::rutaArchivo(rutaManifiesto, lista.back()), header, error)) {
+            return error;
+        }
+        if (entidad.getId() != header.proximoID) {
+            return "El ID de la entidad no coincide con proximoID";
+        }
+        if (!ManifiestoParticiones::crearArchivo(
+                ManifiestoParticiones::rutaArchivo(rutaManifiesto, nueva), nueva.primerId,
+                error)) {
+            return error;
+        }
+        lista.push_back(nueva);
+    } else if (fecha < lista.back().desde) {
+        lista.back().desde = floor<seconds>(fecha);
+    } else {
+        // otro hilo o proceso ya la preparo mientras se esperaba el flock
+        return listaResult;
+    }
+
+    if (!ManifiestoParticiones::escribir(rutaManifiesto, lista, error)) {
+        return error;
+    }
+    return obtenerParticiones();
 }
 
 std::variant<Transaccion, std::string> FSTransaccionRepository::leerPorId(int id)
 {
-    return baseRepository.leerTemplate(id);
+    const auto leerEn = [id](const ListaParticiones& lista)
+        -> std::variant<Transaccion, std::string> {
+        auto particion = particionDeId(lista, id);
+        if (std::holds_alternative<std::string>(particion)) {
+            return std::get<std::string>(particion);
+        }
+        const ParticionAbierta& abierta = std::get<ParticionAbierta>(particion);
+        return abierta.archivo ? abierta.archivo->leer(id) : abierta.repositorio->leerTemplate(id);
+    };
+
+    auto conocidas = particionesConocidas();
+    if (std::holds_alternative<std::string>(conocidas)) {
+        return std::get<std::string>(conocidas);
+    }
+    const ListaCompartida conocida = std::get<ListaCompartida>(conocidas);
+    auto resultado = leerEn(*conocida);
+    if (!std::holds_alternative<std::string>(resultado)) {
+        return resultado;
+    }
+
+    // sin encontrarlo la lista puede ser vieja: otro proceso abrio un mes o archivo el suyo
+    auto vigentes = obtenerParticiones();
+    if (std::holds_alternative<std::string>(vigentes) ||
+        std::get<ListaCompartida>(vigentes) == conocida) {
+        return resultado;
+    }
+    return leerEn(*std::get<ListaCompartida>(vigentes));
 }
 
 std::variant<Transaccion, std::string> FSTransaccionRepository::leerPorNombre(
     const std::string& nombre)
 {
-    return baseRepository.leerPorNombreTemplate(nombre);
+    const std::string buscado = DomainUtils::normalizeName(nombre);
+    if (buscado.empty()) {
+        return "El nombre de búsqueda no puede estar vacío";
+    }
+
+    std::optional<Transaccion> encontrada;
+    auto scan = recorrer([&](const Transaccion& transaccion) {
+        const char* nombreRegistro = transaccion.getNombre();
+        if (DomainUtils::normalizeName(nombreRegistro != nullptr ? nombreRegistro : "") ==
+            buscado) {
+            encontrada = transaccion;
+            return false;
+        }
+        return true;
+    });
+    if (std::holds_alternative<std::string>(scan)) {
+        return std::get<std::string>(scan);
+    }
+
+    if (encontrada.has_value()) {
+        return *encontrada;
+    }
+    return "No existe registro con el nombre solicitado";
 }
 
 std::variant<bool, std::string> FSTransaccionRepository::guardar(const Transaccion& entidad)
 {
-    return baseRepository.guardarTemplate(entidad);
+    const system_clock::time_point fecha = entidad.getFechaCreacion();
+    {
+        const BloqueoArchivo bloqueo(rutaLock, BloqueoArchivo::COMPARTIDO, contencion);
+        if (!bloqueo.activo()) {
+            return "No se pudo bloquear " + rutaLock.string();
+        }
+        auto listaResult = obtenerParticiones();
+        if (std::holds_alternative<std::string>(listaResult)) {
+            return std::get<std::string>(listaResult);
+        }
+        const auto& lista = std::get<ListaCompartida>(listaResult)->particiones;
+        if (!lista.empty() && fecha >= lista.back().datos.desde &&
+            fecha < lista.back().datos.hasta()) {
+            return lista.back().repositorio->guardarTemplate(entidad);
+        }
+    }
+
+    // mes nuevo o reloj atrasado: la lista cambia sin altas en curso en ningun proceso
+    const BloqueoArchivo bloqueo(rutaLock, BloqueoArchivo::EXCLUSIVO, contencion);
+    if (!bloqueo.activo()) {
+        return "No se pudo bloquear " + rutaLock.string();
+    }
+    auto preparada = prepararParticion(entidad);
+    if (std::holds_alternative<std::string>(preparada)) {
+        return std::get<std::string>(preparada);
+    }
+    return std::get<ListaCompartida>(preparada)->particiones.back().repositorio->guardarTemplate(
+        entidad);
 }
 
 std::variant<bool, std::string> FSTransaccionRepository::actualizar(int id,
                                                                     const Transaccion& entidad)
 {
-    return baseRepository.actualizarTemplate(id, entidad);
+    // con el flock compartido la particion no se archiva entre buscarla y escribirla
+    const BloqueoArchivo bloqueo(rutaLock, BloqueoArchivo::COMPARTIDO, contencion);
+    if (!bloqueo.activo()) {
+        return "No se pudo bloquear " + rutaLock.string();
+    }
+    auto listaResult = obtenerParticiones();
+    if (std::holds_alternative<std::string>(listaResult)) {
+        return std::get<std::string>(listaResult);
+    }
+    auto particion = particionModificable(*std::get<ListaCompartida>(listaResult), id);
+    if (std::holds_alternative<std::string>(particion)) {
+        return std::get<std::string>(particion);
+    }
+    return std::get<std::shared_ptr<Particion>>(particion)->actualizarTemplate(id, entidad);
 }
 
 std::variant<bool, std::string> FSTransaccionRepository::eliminarLogicamente(int id)
 {
-    return baseRepository.eliminarLogicamenteTemplate(id);
+    const BloqueoArchivo bloqueo(rutaLock, BloqueoArchivo::COMPARTIDO, contencion);
+    if (!bloqueo.activo()) {
+        return "No se pudo bloquear " + rutaLock.string();
+    }
+    auto listaResult = obtenerParticiones();
+    if (std::holds_alternative<std::string>(listaResult)) {
+        return std::get<std::string>(listaResult);
+    }
+    auto particion = particionModificable(*std::get<ListaCompartida>(listaResult), id);
+    if (std::holds_alternative<std::string>(particion)) {
+        return std::get<std::string>(particion);
+    }
+    return std::get<std::shared_ptr<Particion>>(particion)->eliminarLogicamenteTemplate(id);
 }
 
 std::variant<HeaderFile, std::string> FSTransaccionRepository::obtenerEstadisticas()
 {
-    return baseRepository.obtenerEstadisticasTemplate();
+    auto listaResult = obtenerParticiones();
+    if (std::holds_alternative<std::string>(listaResult)) {
+        return std::get<std::string>(listaResult);
+    }
+
+    HeaderFile total{0, 1, 0, Constants::BINARY_FORMAT::VERSION_ACTUAL};
+    for (const ParticionAbierta& particion : std::get<ListaCompartida>(listaResult)->particiones) {
+        auto headerResult = particion.archivo
+                                ? particion.archivo->obtenerEstadisticas()
+                                : particion.repositorio->obtenerEstadisticasTemplate();
+        if (std::holds_alternative<std::string>(headerResult)) {
+            return std::get<std::string>(headerResult);
+        }
+        const HeaderFile& header = std::get<HeaderFile>(headerResult);
+        total.cantidadRegistros += header.cantidadRegistros;
+        total.registrosActivos += header.registrosActivos;
+        total.proximoID = header.proximoID;
+    }
+    return total;
+}
+
+std::variant<bool, std::string> FSTransaccionRepository::recorrer(
+    const std::function<bool(const Transaccion&)>& visitante)
+{
+    return recorrerDesde(1, visitante);
+}
+
+std::variant<bool, std::string> FSTransaccionRepository::recorrerDesde(
+    int desdeId, const std::function<bool(const Transaccion&)>& visitante)
+{
+    auto listaResult = obtenerParticiones();
+    if (std::holds_alternative<std::string>(listaResult)) {
+        return std::get<std::string>(listaResult);
+    }
+
+    const auto& lista = std::get<ListaCompartida>(listaResult)->particiones;
+    bool detenido = false;
+    const std::function<bool(const Transaccion&)> seguir = [&](const Transaccion& transaccion) {
+        detenido = !visitante(transaccion);
+        return !detenido;
+    };
+    for (std::size_t i = 0; i < lista.size() && !detenido; ++i) {
+        if (i + 1 < lista.size() && lista[i + 1].datos.primerId <= desdeId) {
+            continue;
+        }
+        auto scan = lista[i].archivo
+                        ? lista[i].archivo->recorrerDesde(desdeId, seguir)
+                        : lista[i].repositorio->recorrerDesdeTemplate(desdeId, seguir);
+        if (std::holds_alternative<std::string>(scan)) {
+            return scan;
+        }
+    }
+    return true;
+}
+
+Generador<const Transaccion&> FSTransaccionRepository::generar(int desdeId)
+{
+    auto listaResult = obtenerParticiones();
+    if (std::holds_alternative<std::string>(listaResult)) {
+        throw std::runtime_error(std::get<std::string>(listaResult));
+    }
+
+    // la lista se retiene mientras dure el generador aunque otro hilo la reemplace
+    const ListaCompartida retenida = std::get<ListaCompartida>(std::move(listaResult));
+    const auto& lista = retenida->particiones;
+    for (std::size_t i = 0; i < lista.size(); ++i) {
+        if (i + 1 < lista.size() && lista[i + 1].datos.primerId <= desdeId) {
+            continue;
+        }
+        auto generador = lista[i].archivo ? lista[i].archivo->generar(desdeId)
+                                          : lista[i].repositorio->generarTemplate(desdeId);
+        for (const Transaccion& transaccion : generador) {
+            co_yield transaccion;
+        }
+    }
+}
+
+std::variant<RangoIds, std::string> FSTransaccionRepository::rangoEntreFechas(
+    system_clock::time_point desde, system_clock::time_point hasta)
+{
+    auto listaResult = obtenerParticiones();
+    if (std::holds_alternative<std::string>(listaResult)) {
+        return std::get<std::string>(listaResult);
+    }
+
+    const auto& lista = std::get<ListaCompartida>(listaResult)->particiones;
+    std::optional<RangoIds> rango;
+    for (std::size_t i = 0; i < lista.size(); ++i) {
+        const ParticionTransacciones& datos = lista[i].datos;
+        if (datos.desde >= hasta || desde >= datos.hasta()) {
+            continue;
+        }
+        auto fin = finDeParticion(lista, i);
+        if (std::holds_alternative<std::string>(fin)) {
+            return std::get<std::string>(fin);
+        }
+        if (!rango.has_value()) {
+            rango = RangoIds{datos.primerId, datos.primerId};
+        }
+        rango->hasta = std::get<int>(fin);
+    }
+    return rango.value_or(RangoIds{});
+}
+
+std::variant<bool, std::string> FSTransaccionRepository::recorrerEntreFechas(
+    system_clock::time_point desde, system_clock::time_point hasta,
+    const std::function<bool(const Transaccion&)>& visitante)
+{
+    auto listaResult = obtenerParticiones();
+    if (std::holds_alternative<std::string>(listaResult)) {
+        return std::get<std::string>(listaResult);
+    }
+
+    bool detenido = false;
+    const std::function<bool(const Transaccion&)> seguir = [&](const Transaccion& transaccion) {
+        const system_clock::time_point fecha = transaccion.getFechaCreacion();
+        detenido = fecha >= desde && fecha < hasta && !visitante(transaccion);
+        return !detenido;
+    };
+    for (const ParticionAbierta& particion : std::get<ListaCompartida>(listaResult)->particiones) {
+        if (particion.datos.desde >= hasta || desde >= particion.datos.hasta()) {
+            continue;
+        }
+        auto scan = particion.archivo
+                        ? particion.archivo->recorrerEntreFechas(desde, hasta, seguir)
+                        : particion.repositorio->recorrerTemplate(seguir);
+        if (std::holds_alternative<std::string>(scan)) {
+            return scan;
+        }
+        if (detenido) {
+            break;
+        }
+    }
+    return true;
+}
+
+std::variant<ResumenArchivado, std::string> FSTransaccionRepository::archivarAnteriores(
+    year_month limite)
+{
+    // sin altas, actualizaciones ni meses nuevos en ningun proceso mientras se archiva
+    const BloqueoArchivo bloqueo(rutaLock, BloqueoArchivo::EXCLUSIVO, contencion);
+    if (!bloqueo.activo()) {
+        return "No se pudo bloquear " + rutaLock.string();
+    }
+    auto listaResult = obtenerParticiones();
+    if (std::holds_alternative<std::string>(listaResult)) {
+        return std::get<std::string>(listaResult);
+    }
+
+    std::vector<ParticionTransacciones> lista;
+    for (const ParticionAbierta& particion : std::get<ListaCompartida>(listaResult)->particiones) {
+        lista.push_back(particion.datos);
+    }
+
+    ResumenArchivado resumen;
+    std::vector<fs::path> originales;
+    std::string error;
+    std::error_code ec;
+    for (std::size_t i = 0; i + 1 < lista.size(); ++i) {
+        ParticionTransacciones& particion = lista[i];
+        if (particion.archivada || particion.mes >= limite) {
+            continue;
+        }
+
+        const fs::path origen = ManifiestoParticiones::rutaArchivo(rutaManifiesto, particion);
+        particion.archivada = true;
+        const fs::path destino = ManifiestoParticiones::rutaArchivo(rutaManifiesto, particion);
+        if (!SegmentoFrio::archivar(origen, destino, error)) {
+            return error;
+        }
+        resumen.particiones += 1;
+        resumen.bytesAntes += fs::file_size(origen, ec);
+        resumen.bytesDespues += fs::file_size(destino, ec);
+        originales.push_back(origen);
+    }
+    if (resumen.particiones == 0) {
+        return resumen;
+    }
+
+    if (!ManifiestoParticiones::escribir(rutaManifiesto, lista, error)) {
+        return error;
+    }
+    // la lista ya no las nombra; quien todavia las tenga abiertas lee lo mismo hasta releerla
+    for (const fs::path& origen : originales) {
+        fs::remove(RegistroCambios::rutaMapa(origen), ec);
+        fs::remove(origen, ec);
+    }
+
+    auto refresco = obtenerParticiones();
+    if (std::holds_alternative<std::string>(refresco)) {
+        return std::get<std::string>(refresco);
+    }
+    return resumen;
+}
+
+LatchesRegistro::Guardia FSTransaccionRepository::bloquearRegistros(const std::vector<int>& ids)
+{
+    return latches.bloquear(ids, contencion);
+}
+
+EstadisticasContencion FSTransaccionRepository::obtenerContencion() const
+{
+    EstadisticasContencion total = contencion.instantanea();
+    const std::shared_lock<std::shared_mutex> lock(mutexParticiones);
+    for (const auto& [clave, repositorio] : repositorios) {
+        sumar(total, repositorio->obtenerContencionTemplate());
+    }
+    for (const auto& [clave, archivo] : archivados) {
+        sumar(total, archivo->obtenerContencion());
+    }
+    return total;
 }
@@ -1,12 +1,92 @@
 #pragma once
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <sys/types.h>
+#include <utility>
+#include <vector>
+
 #include "domain/HeaderFile.hpp"
 #include "domain/repositories/ITransaccionRepository.hpp"
 #include "infrastructure/datasource/FSBaseRepository.hpp"
+#include "infrastructure/datasource/transaccion/ParticionesTransacciones.hpp"
+#include "infrastructure/datasource/transaccion/SegmentoFrio.hpp"
 
+/**
+ * @brief - Transacciones repartidas en particiones mensuales (ManifiestoParticiones).
+ *
+ * Cada particion es un FSBaseRepository sobre su archivo, con IDs consecutivos. La lista se lee
+ * de TRANSACCIONES_PARTICIONES_PATH y se vuelve a leer cuando ese archivo cambia (otro proceso
+ * abrio un mes nuevo o se restauro un backup): las escrituras y los recorridos lo comprueban una
+ * vez por llamada, y las lecturas por ID usan la lista en memoria y solo lo comprueban si el ID
+ * no aparece. Una lectura por ID va a la particion que contiene el ID, los recorridos siguen las
+ * particiones en orden de ID y los acotados por fecha abren solo las de esos meses: consultar lo
+ * reciente no lee el historial.
+ *
+ * Las altas y actualizaciones toman el flock compartido de TRANSACCIONES_LOCK_PATH; abrir la
+ * particion de un mes nuevo (o bajar su `desde` por un reloj atrasado) y archivar meses cerrados
+ * lo toman exclusivo, asi que ningun alta termina en una particion que ya no es la ultima y
+ * ninguna escritura en una que se esta archivando. Las particiones archivadas se leen de su
+ * SegmentoFrio.
+ */
 class FSTransaccionRepository : public ITransaccionRepository
 {
    private:
-    FSBaseRepository<Transaccion> baseRepository;
+    using Particion = FSBaseRepository<Transaccion>;
+
+    /// Una particion con `repositorio` o, si esta archivada, con `archivo`.
+    struct ParticionAbierta {
+        ParticionTransacciones datos;
+        std::shared_ptr<Particion> repositorio;
+        std::shared_ptr<SegmentoFrio> archivo;
+    };
+
+    /// Inodo y fecha de modificacion del manifiesto leido; si cambian se vuelve a leer.
+    struct IdentidadArchivo {
+        ino_t inodo{0};
+        std::int64_t modificado{0};
+
+        bool operator==(const IdentidadArchivo&) const = default;
+    };
+
+    /// Particiones de una lectura del manifiesto. Nunca se modifica: al releerlo se reemplaza
+    /// entera, y quien ya la tiene sigue recorriendo la suya sin copiarla.
+    struct ListaParticiones {
+        IdentidadArchivo identidad;
+        std::vector<ParticionAbierta> particiones;
+    };
+    using ListaCompartida = std::shared_ptr<const ListaParticiones>;
+
+    fs::path rutaManifiesto;
+    fs::path rutaLock;
+    mutable std::shared_mutex mutexParticiones;
+    ListaCompartida lista;
+    /// Repositorio de cada archivo (nombre, primerId). Sobreviven a las relecturas de la lista
+    /// porque guardan las versiones que leen las instantaneas abiertas.
+    std::map<std::pair<std::string, int>, std::shared_ptr<Particion>> repositorios;
+    std::map<std::pair<std::string, int>, std::shared_ptr<SegmentoFrio>> archivados;
+    ContadoresContencion contencion;
+    LatchesRegistro latches;
+
+    IdentidadArchivo identidadManifiesto() const;
+    /// Lista vigente: un stat del manifiesto y se relee solo si cambio desde la ultima lectura.
+    std::variant<ListaCompartida, std::string> obtenerParticiones();
+    /// Ultima lista leida, sin mirar el manifiesto; la lee si todavia no hay ninguna.
+    std::variant<ListaCompartida, std::string> particionesConocidas();
+    static std::variant<ParticionAbierta, std::string> particionDeId(const ListaParticiones& lista,
+                                                                     int id);
+    /// Particion de `id` para modificarla; error si esta archivada.
+    static std::variant<std::shared_ptr<Particion>, std::string> particionModificable(
+        const ListaParticiones& lista, int id);
+    /// ID siguiente al ultimo de la particion `indice` de `lista`.
+    static std::variant<int, std::string> finDeParticion(const std::vector<ParticionAbierta>& lista,
+                                                         std::size_t indice);
+    /// Abre el mes de `entidad` o baja el `desde` de la ultima particion y devuelve la lista
+    /// resultante; requiere el flock exclusivo de TRANSACCIONES_LOCK_PATH.
+    std::variant<ListaCompartida, std::string> prepararParticion(const Transaccion& entidad);
 
    public:
     FSTransaccionRepository();
@@ -17,4 +97,19 @@ class FSTransaccionRepository : public ITransaccionRepository
     std::variant<bool, std::string> actualizar(int id, const Transaccion& entidad) override;
     std::variant<bool, std::string> eliminarLogicamente(int id) override;
     std::variant<HeaderFile, std::string> obtenerEstadisticas() override;
+    std::variant<bool, std::string> recorrer(
+        const std::function<bool(const Transaccion&)>& visitante) override;
+    std::variant<bool, std::string> recorrerDesde(
+        int desdeId, const std::function<bool(const Transaccion&)>& visitante) override;
+    Generador<const Transaccion&> generar(int desdeId = 1) override;
+    std::variant<RangoIds, std::string> rangoEntreFechas(
+        std::chrono::system_clock::time_point desde,
+        std::chrono::system_clock::time_point hasta) override;
+    std::variant<bool, std::string> recorrerEntreFechas(
+        std::chrono::system_clock::time_point desde, std::chrono::system_clock::time_point hasta,
+        const std::function<bool(const Transaccion&)>& visitante) override;
+    std::variant<ResumenArchivado, std::string> archivarAnteriores(
+        std::chrono::year_month limite) override;
+    LatchesRegistro::Guardia bloquearRegistros(const std::vector<int>& ids) override;
+    EstadisticasContencion obtenerContencion() const override;
 };
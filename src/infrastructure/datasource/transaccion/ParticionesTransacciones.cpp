@@ -0,0 +1,299 @@
+#include "ParticionesTransacciones.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <fcntl.h>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <unistd.h>
+
+#include "domain/constants.hpp"
+#include "domain/entities/transaccion/transaccion.entity.hpp"
+#include "infrastructure/datasource/ArchivoPosicional.hpp"
+#include "infrastructure/datasource/EntityTraits.hpp"
+#include "infrastructure/datasource/RegistroCambios.hpp"
+#include "infrastructure/datasource/backup/DescriptorArchivo.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr const char* FIRMA = "papaya-particiones 1";
+constexpr std::size_t REGISTROS_POR_LECTURA = 256;
+
+template <typename Numero>
+bool parsearNumero(std::string_view texto, Numero& outValor)
+{
+    const auto [fin, error] = std::from_chars(texto.data(), texto.data() + texto.size(), outValor);
+    return error == std::errc() && fin == texto.data() + texto.size();
+}
+
+/// `AAAA-MM`
+bool parsearMes(std::string_view texto, year_month& outMes)
+{
+    int anio = 0;
+    unsigned mes = 0;
+    if (texto.size() != 7 || texto[4] != '-' || !parsearNumero(texto.substr(0, 4), anio) ||
+        !parsearNumero(texto.substr(5), mes)) {
+        return false;
+    }
+    outMes = year{anio} / month{mes};
+    return outMes.ok();
+}
+
+bool parsearParticion(const std::string& linea, ParticionTransacciones& outParticion)
+{
+    std::istringstream campos(linea);
+    std::string campo;
+    campos >> campo;
+    if (campo != "particion") {
+        return false;
+    }
+    bool conMes = false;
+    bool conPrimerId = false;
+    bool conDesde = false;
+    while (campos >> campo) {
+        const std::size_t igual = campo.find('=');
+        if (igual == std::string::npos) {
+            return false;
+        }
+        const std::string clave = campo.substr(0, igual);
+        const std::string_view valor = std::string_view(campo).substr(igual + 1);
+        if (clave == "mes") {
+            conMes = parsearMes(valor, outParticion.mes);
+        } else if (clave == "primerId") {
+            conPrimerId = parsearNumero(valor, outParticion.primerId) && outParticion.primerId > 0;
+        } else if (clave == "desde") {
+            std::int64_t segundos = 0;
+            conDesde = parsearNumero(valor, segundos);
+            outParticion.desde = sys_seconds{seconds{segundos}};
+        } else if (clave == "archivada") {
+            outParticion.archivada = valor == "1";
+        }
+    }
+    return conMes && conPrimerId && conDesde;
+}
+
+bool escribirHeader(std::ostream& salida, const HeaderFile& header)
+{
+    salida.seekp(0, std::ios::beg);
+    salida.write(reinterpret_cast<const char*>(&header), sizeof(HeaderFile));
+    return static_cast<bool>(salida);
+}
+
+}  // namespace
+
+sys_seconds ParticionTransacciones::hasta() const
+{
+    return sys_seconds{sys_days{(mes + months{1}) / 1}};
+}
+
+std::string ParticionTransacciones::nombreArchivo() const
+{
+    return std::format("transacciones.{:04}-{:02}.{}", static_cast<int>(mes.year()),
+                       static_cast<unsigned>(mes.month()), archivada ? "frio" : "bin");
+}
+
+ParticionTransacciones ParticionTransacciones::nueva(system_clock::time_point fecha, int primerId)
+{
+    const year_month_day dia{floor<days>(fecha)};
+    ParticionTransacciones particion;
+    particion.mes = dia.year() / dia.month();
+    particion.primerId = primerId;
+    particion.desde = sys_seconds{sys_days{particion.mes / 1}};
+    return particion;
+}
+
+bool ManifiestoParticiones::leer(const fs::path& ruta,
+                                 std::vector<ParticionTransacciones>& outParticiones,
+                                 std::string& outError)
+{
+    outParticiones.clear();
+    std::ifstream archivo(ruta);
+    if (!archivo.is_open()) {
+        std::error_code ec;
+        if (!fs::exists(ruta, ec)) {
+            return true;
+        }
+        outError = "No se pudo abrir " + ruta.string();
+        return false;
+    }
+
+    std::string linea;
+    if (!std::getline(archivo, linea) || linea != FIRMA) {
+        outError = "Lista de particiones invalida: " + ruta.string();
+        return false;
+    }
+    while (std::getline(archivo, linea)) {
+        ParticionTransacciones particion;
+        // meses e IDs crecientes: cada particion empieza donde termina la anterior
+        if (!parsearParticion(linea, particion) ||
+            (!outParticiones.empty() && (particion.mes <= outParticiones.back().mes ||
+                                         particion.primerId <= outParticiones.back().primerId))) {
+            outError = "Lista de particiones invalida: " + ruta.string();
+            return false;
+        }
+        outParticiones.push_back(particion);
+    }
+    return true;
+}
+
+bool ManifiestoParticiones::escribir(const fs::path& ruta,
+                                     const std::vector<ParticionTransacciones>& particiones,
+                                     std::string& outError)
+{
+    std::ostringstream texto;
+    texto << FIRMA << '\n';
+    for (const ParticionTransacciones& particion : particiones) {
+        texto << std::format("particion mes={:04}-{:02} primerId={} desde={}{}\n",
+                             static_cast<int>(particion.mes.year()),
+                             static_cast<unsigned>(particion.mes.month()), particion.primerId,
+                             particion.desde.time_since_epoch().count(),
+                             particion.archivada ? " archivada=1" : "");
+    }
+
+    const fs::path temporal = fs::path(ruta).concat(".tmp" + std::to_string(::getpid()));
+    {
+        std::ofstream archivo(temporal, std::ios::trunc);
+        archivo << texto.str();
+        if (!archivo.flush()) {
+            outError = "No se pudo escribir " + temporal.string();
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    try {
+        // en disco, y el rename tambien, antes de que se borre lo que la lista anterior nombraba
+        DescriptorArchivo(temporal, O_RDONLY).sincronizar();
+        fs::rename(temporal, ruta);
+        DescriptorArchivo(ruta.parent_path(), O_RDONLY | O_DIRECTORY).sincronizar();
+    } catch (const std::exception&) {
+        fs::remove(temporal, ec);
+        outError = "No se pudo reemplazar " + ruta.string();
+        return false;
+    }
+    return true;
+}
+
+fs::path ManifiestoParticiones::rutaArchivo(const fs::path& ruta,
+                                            const ParticionTransacciones& particion)
+{
+    return ruta.parent_path() / particion.nombreArchivo();
+}
+
+bool ManifiestoParticiones::crearArchivo(const fs::path& ruta, int primerId, std::string& outError)
+{
+    std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+    const HeaderFile header{0, primerId, 0, Constants::BINARY_FORMAT::VERSION_ACTUAL};
+    if (!archivo.is_open() || !escribirHeader(archivo, header) || !archivo.flush()) {
+        outError = "No se pudo crear la particion " + ruta.string();
+        return false;
+    }
+    return true;
+}
+
+bool ManifiestoParticiones::leerHeader(const fs::path& ruta, HeaderFile& outHeader,
+                                       std::string& outError)
+{
+    std::ifstream archivo(ruta, std::ios::binary);
+    outHeader = {};
+    archivo.read(reinterpret_cast<char*>(&outHeader), sizeof(HeaderFile));
+    if (!archivo) {
+        outError = "No se pudo leer el encabezado de " + ruta.string();
+        return false;
+    }
+    return true;
+}
+
+bool ManifiestoParticiones::particionar(const fs::path& archivoUnico, const fs::path& ruta,
+                                        std::string& outError)
+{
+    std::ifstream origen(archivoUnico, std::ios::binary);
+    HeaderFile header = {};
+    origen.read(reinterpret_cast<char*>(&header), sizeof(HeaderFile));
+    if (!origen || header.version != Constants::BINARY_FORMAT::VERSION_ACTUAL ||
+        header.proximoID != header.cantidadRegistros + 1) {
+        outError = "No se pudo particionar " + archivoUnico.string() + ": header invalido";
+        return false;
+    }
+
+    const std::size_t tamano = static_cast<std::size_t>(EntityTraits<Transaccion>::recordSize());
+    std::vector<char> bloque(REGISTROS_POR_LECTURA * tamano);
+    RegistroEnMemoria memoria;
+    std::vector<ParticionTransacciones> particiones;
+    std::ofstream destino;
+    HeaderFile headerDestino = {};
+    const auto cerrarParticion = [&]() {
+        if (!destino.is_open()) {
+            return true;
+        }
+        const bool ok = escribirHeader(destino, headerDestino) && destino.flush();
+        destino.close();
+        return ok;
+    };
+
+    for (int id = 1; id < header.proximoID;) {
+        const int cantidad =
+            std::min(static_cast<int>(REGISTROS_POR_LECTURA), header.proximoID - id);
+        if (!origen.read(bloque.data(), static_cast<std::streamsize>(cantidad * tamano))) {
+            outError = "No se pudo leer " + archivoUnico.string();
+            return false;
+        }
+
+        for (int i = 0; i < cantidad; ++i, ++id) {
+            const char* bytes = bloque.data() + static_cast<std::size_t>(i) * tamano;
+            Transaccion transaccion;
+            if (!EntityTraits<Transaccion>::readFromStream(memoria.leerDesde(bytes, tamano),
+                                                           transaccion) ||
+                transaccion.getId() != id) {
+                outError = std::format("No se pudo particionar {}: registro {} ilegible",
+                                       archivoUnico.string(), id);
+                return false;
+            }
+
+            // como al guardar: un mes posterior abre particion; uno anterior queda en la actual
+            const system_clock::time_point fecha = transaccion.getFechaCreacion();
+            if (particiones.empty() || ParticionTransacciones::nueva(fecha, id).mes >
+                                           particiones.back().mes) {
+                if (!cerrarParticion()) {
+                    outError = "No se pudo escribir la particion de " + archivoUnico.string();
+                    return false;
+                }
+                particiones.push_back(ParticionTransacciones::nueva(fecha, id));
+                headerDestino = {0, id, 0, Constants::BINARY_FORMAT::VERSION_ACTUAL};
+                destino.open(rutaArchivo(ruta, particiones.back()),
+                             std::ios::binary | std::ios::trunc);
+                if (!escribirHeader(destino, headerDestino)) {
+                    outError = "No se pudo crear la particion " +
+                               rutaArchivo(ruta, particiones.back()).string();
+                    return false;
+                }
+            }
+            particiones.back().desde = std::min(particiones.back().desde, floor<seconds>(fecha));
+
+            destino.write(bytes, static_cast<std::streamsize>(tamano));
+            headerDestino.cantidadRegistros += 1;
+            headerDestino.registrosActivos += transaccion.getEliminado() ? 0 : 1;
+            headerDestino.proximoID += 1;
+        }
+    }
+    if (!cerrarParticion()) {
+        outError = "No se pudo escribir la particion de " + archivoUnico.string();
+        return false;
+    }
+
+    if (!escribir(ruta, particiones, outError)) {
+        return false;
+    }
+    std::error_code ec;
+    fs::remove(RegistroCambios::rutaMapa(archivoUnico), ec);
+    if (!fs::remove(archivoUnico, ec) && ec) {
+        outError = "No se pudo borrar " + archivoUnico.string();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "domain/HeaderFile.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Una particion mensual de transacciones: un archivo de registros con IDs consecutivos.
+ * @param mes - Mes (UTC, igual que los rollups) en que se abrio; no recibe transacciones de meses
+ * posteriores, que abren la particion siguiente.
+ * @param primerId - Primer ID del archivo. La particion llega hasta el primerId de la siguiente; la
+ * ultima, hasta el proximoID de su header.
+ * @param desde - Fecha mas antigua que puede tener: el inicio del mes, o antes si se guardo una
+ * transaccion con el reloj atrasado respecto de la ultima particion.
+ * @param archivada - Comprimida en un SegmentoFrio de solo lectura en lugar del archivo de
+ * registros de tamano fijo.
+ */
+struct ParticionTransacciones {
+    std::chrono::year_month mes;
+    int primerId{1};
+    std::chrono::sys_seconds desde;
+    bool archivada{false};
+
+    /// Inicio del mes siguiente: todas sus transacciones son anteriores.
+    std::chrono::sys_seconds hasta() const;
+
+    /// Nombre del archivo de la particion: `transacciones.AAAA-MM.bin` (`.frio` si esta archivada).
+    std::string nombreArchivo() const;
+
+    /// Particion del mes de `fecha` que empieza en `primerId`.
+    static ParticionTransacciones nueva(std::chrono::system_clock::time_point fecha, int primerId);
+};
+
+/**
+ * @brief - Lista de particiones de transacciones, guardada como texto junto a sus archivos.
+ *
+ * Una linea por particion en orden de primerId (`particion mes=AAAA-MM primerId=N desde=S`, con
+ * `desde` en segundos desde epoch y `archivada=1` si es un SegmentoFrio). Se reescribe en un
+ * temporal que se sincroniza y se renombra, asi que quien la lee sin locks ve la lista anterior o
+ * la nueva completas; quien la modifica toma antes el flock exclusivo de TRANSACCIONES_LOCK_PATH.
+ * Los errores se informan con bool + outError.
+ */
+class ManifiestoParticiones
+{
+   public:
+    /// Lee la lista de `ruta`; si el archivo no existe la lista queda vacia.
+    static bool leer(const fs::path& ruta, std::vector<ParticionTransacciones>& outParticiones,
+                     std::string& outError);
+
+    static bool escribir(const fs::path& ruta,
+                         const std::vector<ParticionTransacciones>& particiones,
+                         std::string& outError);
+
+    /// Ruta del archivo de `particion`, en el directorio del manifiesto `ruta`.
+    static fs::path rutaArchivo(const fs::path& ruta, const ParticionTransacciones& particion);
+
+    /**
+     * Deja en `ruta` una particion vacia que empieza en `primerId`. Si el archivo ya existe (una
+     * particion que una restauracion dejo fuera de la lista) se vacia en el mismo inodo, para que
+     * los descriptores que otros procesos tengan abiertos vean la nueva.
+     */
+    static bool crearArchivo(const fs::path& ruta, int primerId, std::string& outError);
+
+    /// Lee el header de una particion tal como esta en disco.
+    static bool leerHeader(const fs::path& ruta, HeaderFile& outHeader, std::string& outError);
+
+    /**
+     * Reparte un archivo unico de transacciones (en el formato actual) en particiones mensuales
+     * junto al manifiesto `ruta`, escribe el manifiesto y borra el archivo unico. Se puede
+     * repetir si se interrumpe: mientras el archivo unico exista, es el que vale.
+     */
+    static bool particionar(const fs::path& archivoUnico, const fs::path& ruta,
+                            std::string& outError);
+};
@@ -0,0 +1,734 @@
+#include "SegmentoFrio.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <unordered_map>
+
+#include "domain/constants.hpp"
+#include "infrastructure/datasource/ArchivoPosicional.hpp"
+#include "infrastructure/datasource/BloqueoArchivo.hpp"
+#include "infrastructure/datasource/EntityTraits.hpp"
+#include "infrastructure/datasource/backup/CompresorLZ.hpp"
+#include "infrastructure/datasource/backup/DescriptorArchivo.hpp"
+#include "infrastructure/datasource/backup/SumaVerificacion.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr char FIRMA[8] = {'P', 'A', 'P', 'F', 'R', 'I', '0', '1'};
+constexpr std::uint32_t SIN_COMPRIMIR = 0x80000000u;
+/// Limite al leer segmentos ajenos: una tabla danada no debe pedir memoria sin control.
+constexpr std::uint32_t BYTES_MAXIMOS = 64u << 20;
+
+struct EncabezadoFrio {
+    char firma[8];
+    std::int32_t registrosPorBloque;
+    std::int32_t bloques;
+    std::uint32_t textos;
+    /// Bytes del diccionario en disco; con SIN_COMPRIMIR si se guardo tal cual.
+    std::uint32_t bytesDiccionario;
+    std::uint32_t bytesDiccionarioOriginal;
+    std::uint32_t reservado;
+    std::uint64_t sumaDiccionario;
+    std::uint64_t sumaTabla;
+};
+
+struct BloqueFrio {
+    std::uint64_t offset;
+    /// Bytes en disco; con SIN_COMPRIMIR si se guardo tal cual.
+    std::uint32_t bytes;
+    std::uint32_t bytesOriginales;
+    /// Fechas de creacion (segundos) minima y maxima de los registros del bloque.
+    std::int64_t fechaMinima;
+    std::int64_t fechaMaxima;
+    std::uint64_t suma;
+};
+
+static_assert(std::is_trivially_copyable_v<EncabezadoFrio> && sizeof(EncabezadoFrio) == 48);
+static_assert(std::is_trivially_copyable_v<BloqueFrio> && sizeof(BloqueFrio) == 40);
+
+/// Posicion de cada campo en un registro de Transaccion (EntityTraits, version actual).
+namespace Campo {
+constexpr std::size_t ID = 0;
+constexpr std::size_t NOMBRE = ID + sizeof(std::int32_t);
+constexpr std::size_t TAMANO_NOMBRE = 100;
+constexpr std::size_t ELIMINADO = NOMBRE + TAMANO_NOMBRE;
+constexpr std::size_t FECHA_CREACION = ELIMINADO + sizeof(std::int8_t);
+constexpr std::size_t FECHA_MODIFICACION = FECHA_CREACION + sizeof(std::int64_t);
+constexpr std::size_t TIPO = FECHA_MODIFICACION + sizeof(std::int64_t);
+constexpr std::size_t ID_RELACIONADO = TIPO + sizeof(std::int32_t);
+constexpr std::size_t TOTAL = ID_RELACIONADO + sizeof(std::int32_t);
+constexpr std::size_t DESCRIPCION = TOTAL + sizeof(std::int64_t);
+constexpr std::size_t TAMANO_DESCRIPCION = 200;
+constexpr std::size_t ITEMS = DESCRIPCION + TAMANO_DESCRIPCION;
+constexpr std::size_t MAXIMO_ITEMS = 100;
+constexpr std::size_t PRODUCTOS_TOTALES = ITEMS + sizeof(TransaccionDTO) * MAXIMO_ITEMS;
+constexpr std::size_t TAMANO_REGISTRO = PRODUCTOS_TOTALES + sizeof(std::int32_t);
+
+/// Dentro de cada item: productoId, cantidad y precio en centavos.
+constexpr std::size_t ITEM_PRODUCTO = 0;
+constexpr std::size_t ITEM_CANTIDAD = sizeof(std::int32_t);
+constexpr std::size_t ITEM_PRECIO = ITEM_CANTIDAD + sizeof(std::int32_t);
+}  // namespace Campo
+
+template <typename Entero>
+Entero leerCampo(const char* registro, std::size_t offset)
+{
+    Entero valor;
+    std::memcpy(&valor, registro + offset, sizeof(valor));
+    return valor;
+}
+
+template <typename Entero>
+void escribirCampo(char* registro, std::size_t offset, std::int64_t valor)
+{
+    const Entero campo = static_cast<Entero>(valor);
+    std::memcpy(registro + offset, &campo, sizeof(campo));
+}
+
+std::uint64_t zigzag(std::int64_t valor)
+{
+    return (static_cast<std::uint64_t>(valor) << 1) ^ static_cast<std::uint64_t>(valor >> 63);
+}
+
+std::int64_t desdeZigzag(std::uint64_t valor)
+{
+    return static_cast<std::int64_t>(valor >> 1) ^ -static_cast<std::int64_t>(valor & 1);
+}
+
+void agregarVarint(std::string& salida, std::uint64_t valor)
+{
+    while (valor >= 0x80) {
+        salida += static_cast<char>(valor | 0x80);
+        valor >>= 7;
+    }
+    salida += static_cast<char>(valor);
+}
+
+/// Lee varints de un bloque; leer mas alla del final lo deja invalido en vez de fallar.
+class LectorVarints
+{
+   private:
+    const char* cursor;
+    const char* fin;
+    bool valido{true};
+
+   public:
+    explicit LectorVarints(std::string_view datos)
+        : cursor(datos.data()), fin(datos.data() + datos.size())
+    {
+    }
+
+    std::uint64_t varint()
+    {
+        std::uint64_t valor = 0;
+        for (int desplazamiento = 0; desplazamiento < 64 && cursor != fin; desplazamiento += 7) {
+            const auto byte = static_cast<unsigned char>(*cursor++);
+            valor |= static_cast<std::uint64_t>(byte & 0x7f) << desplazamiento;
+            if ((byte & 0x80) == 0) {
+                return valor;
+            }
+        }
+        valido = false;
+        return 0;
+    }
+
+    std::int64_t entero() { return desdeZigzag(varint()); }
+
+    /// `largo` bytes tal cual, como guarda sus textos el diccionario.
+    std::string_view bytes(std::uint64_t largo)
+    {
+        if (!valido || largo > static_cast<std::uint64_t>(fin - cursor)) {
+            valido = false;
+            return {};
+        }
+        const std::string_view leidos(cursor, static_cast<std::size_t>(largo));
+        cursor += largo;
+        return leidos;
+    }
+
+    bool ok() const { return valido; }
+    bool agotado() const { return cursor == fin; }
+};
+
+/// Textos distintos (nombres y descripciones) de un segmento, en orden de aparicion.
+struct Diccionario {
+    std::unordered_map<std::string, std::uint32_t> indices;
+    std::vector<std::string> textos;
+
+    std::uint64_t indice(std::string_view texto)
+    {
+        const auto [it, nuevo] =
+            indices.try_emplace(std::string(texto), static_cast<std::uint32_t>(textos.size()));
+        if (nuevo) {
+            textos.emplace_back(texto);
+        }
+        return it->second;
+    }
+};
+
+/// ID y fecha de creacion del registro anterior del bloque: los siguientes guardan la diferencia.
+struct Anterior {
+    std::int64_t id{0};
+    std::int64_t fecha{0};
+};
+
+std::size_t itemsUsados(std::int64_t productosTotales)
+{
+    return static_cast<std::size_t>(
+        std::clamp<std::int64_t>(productosTotales, 0, Campo::MAXIMO_ITEMS));
+}
+
+void codificar(const char* registro, Anterior& anterior, Diccionario& diccionario,
+               std::string& salida)
+{
+    const std::int64_t id = leerCampo<std::int32_t>(registro, Campo::ID);
+    const std::int64_t fecha = leerCampo<std::int64_t>(registro, Campo::FECHA_CREACION);
+    const std::int64_t modificada = leerCampo<std::int64_t>(registro, Campo::FECHA_MODIFICACION);
+    const std::int64_t tipo = leerCampo<std::int32_t>(registro, Campo::TIPO);
+    const bool eliminado = leerCampo<std::int8_t>(registro, Campo::ELIMINADO) != 0;
+    const char* nombre = registro + Campo::NOMBRE;
+    const char* descripcion = registro + Campo::DESCRIPCION;
+    const std::int64_t productosTotales =
+        leerCampo<std::int32_t>(registro, Campo::PRODUCTOS_TOTALES);
+
+    agregarVarint(salida, zigzag(id - anterior.id));
+    agregarVarint(salida, zigzag(fecha - anterior.fecha));
+    agregarVarint(salida, zigzag(modificada - fecha));
+    agregarVarint(salida, (zigzag(tipo) << 1) | (eliminado ? 1 : 0));
+    agregarVarint(salida, zigzag(leerCampo<std::int32_t>(registro, Campo::ID_RELACIONADO)));
+    agregarVarint(salida, zigzag(leerCampo<std::int64_t>(registro, Campo::TOTAL)));
+    agregarVarint(salida, diccionario.indice({nombre, ::strnlen(nombre, Campo::TAMANO_NOMBRE)}));
+    agregarVarint(salida, diccionario.indice(
+                              {descripcion, ::strnlen(descripcion, Campo::TAMANO_DESCRIPCION)}));
+    agregarVarint(salida, zigzag(productosTotales));
+    for (std::size_t i = 0; i < itemsUsados(productosTotales); ++i) {
+        const char* item = registro + Campo::ITEMS + i * sizeof(TransaccionDTO);
+        agregarVarint(salida, zigzag(leerCampo<std::int32_t>(item, Campo::ITEM_PRODUCTO)));
+        agregarVarint(salida, zigzag(leerCampo<std::int32_t>(item, Campo::ITEM_CANTIDAD)));
+        agregarVarint(salida, zigzag(leerCampo<std::int64_t>(item, Campo::ITEM_PRECIO)));
+    }
+    anterior = {id, fecha};
+}
+
+/// Reconstruye en `registro` (TAMANO_REGISTRO bytes) el siguiente registro de `lector`.
+bool decodificar(LectorVarints& lector, const std::vector<std::string>& textos,
+                 Anterior& anterior, char* registro)
+{
+    std::memset(registro, 0, Campo::TAMANO_REGISTRO);
+    const std::int64_t id = anterior.id + lector.entero();
+    const std::int64_t fecha = anterior.fecha + lector.entero();
+    const std::int64_t modificada = fecha + lector.entero();
+    const std::uint64_t tipoYEliminado = lector.varint();
+    const std::int64_t relacionado = lector.entero();
+    const std::int64_t total = lector.entero();
+    const std::uint64_t nombre = lector.varint();
+    const std::uint64_t descripcion = lector.varint();
+    const std::int64_t productosTotales = lector.entero();
+    if (!lector.ok() || nombre >= textos.size() || descripcion >= textos.size() ||
+        textos[nombre].size() >= Campo::TAMANO_NOMBRE ||
+        textos[descripcion].size() >= Campo::TAMANO_DESCRIPCION) {
+        return false;
+    }
+
+    escribirCampo<std::int32_t>(registro, Campo::ID, id);
+    std::memcpy(registro + Campo::NOMBRE, textos[nombre].data(), textos[nombre].size());
+    escribirCampo<std::int8_t>(registro, Campo::ELIMINADO, tipoYEliminado & 1);
+    escribirCampo<std::int64_t>(registro, Campo::FECHA_CREACION, fecha);
+    escribirCampo<std::int64_t>(registro, Campo::FECHA_MODIFICACION, modificada);
+    escribirCampo<std::int32_t>(registro, Campo::TIPO, desdeZigzag(tipoYEliminado >> 1));
+    escribirCampo<std::int32_t>(registro, Campo::ID_RELACIONADO, relacionado);
+    escribirCampo<std::int64_t>(registro, Campo::TOTAL, total);
+    std::memcpy(registro + Campo::DESCRIPCION, textos[descripcion].data(),
+                textos[descripcion].size());
+    escribirCampo<std::int32_t>(registro, Campo::PRODUCTOS_TOTALES, productosTotales);
+    for (std::size_t i = 0; i < itemsUsados(productosTotales); ++i) {
+        char* item = registro + Campo::ITEMS + i * sizeof(TransaccionDTO);
+        escribirCampo<std::int32_t>(item, Campo::ITEM_PRODUCTO, lector.entero());
+        escribirCampo<std::int32_t>(item, Campo::ITEM_CANTIDAD, lector.entero());
+        escribirCampo<std::int64_t>(item, Campo::ITEM_PRECIO, lector.entero());
+    }
+    anterior = {id, fecha};
+    return lector.ok();
+}
+
+/// Comprime `datos` si se achican; retorna los bytes a guardar y su tamano con SIN_COMPRIMIR.
+std::pair<std::string, std::uint32_t> comprimir(const std::string& datos)
+{
+    std::string comprimido(CompresorLZ::cotaComprimido(datos.size()), '\0');
+    const std::size_t bytes =
+        CompresorLZ::comprimir(datos.data(), datos.size(), comprimido.data(), comprimido.size());
+    if (bytes == 0 || bytes >= datos.size()) {
+        return {datos, static_cast<std::uint32_t>(datos.size()) | SIN_COMPRIMIR};
+    }
+    comprimido.resize(bytes);
+    return {std::move(comprimido), static_cast<std::uint32_t>(bytes)};
+}
+
+bool descomprimir(const std::string& guardado, std::uint32_t bytes, std::uint32_t originales,
+                  std::string& outDatos)
+{
+    if ((bytes & SIN_COMPRIMIR) != 0) {
+        outDatos = guardado;
+        return guardado.size() == originales;
+    }
+    outDatos.assign(originales, '\0');
+    return CompresorLZ::descomprimir(guardado.data(), guardado.size(), outDatos.data(),
+                                     originales);
+}
+
+std::uint64_t sumaDe(const void* datos, std::size_t bytes)
+{
+    SumaVerificacion suma;
+    suma.agregar(datos, bytes);
+    return suma.valor();
+}
+
+/// Inodo, modificacion y tamano del archivo leido; si cambian se vuelve a leer la tabla.
+struct IdentidadFrio {
+    ino_t inodo{0};
+    std::int64_t modificado{0};
+    off_t tamano{0};
+
+    bool operator==(const IdentidadFrio&) const = default;
+};
+
+}  // namespace
+
+struct SegmentoFrio::Indice {
+    IdentidadFrio identidad;
+    HeaderFile header{};
+    int primerId{1};
+    int registrosPorBloque{REGISTROS_POR_BLOQUE};
+    std::vector<BloqueFrio> bloques;
+    std::vector<std::string> textos;
+    std::unique_ptr<ArchivoPosicional> archivo;
+};
+
+SegmentoFrio::SegmentoFrio(fs::path ruta) : ruta(std::move(ruta)) {}
+
+SegmentoFrio::~SegmentoFrio() = default;
+
+bool SegmentoFrio::archivar(const fs::path& origen, const fs::path& destino,
+                            std::string& outError)
+{
+    if (EntityTraits<Transaccion>::recordSize() !=
+        static_cast<std::streamoff>(Campo::TAMANO_REGISTRO)) {
+        outError = "El formato de transacciones no coincide con el de los segmentos archivados";
+        return false;
+    }
+
+    std::ifstream entrada(origen, std::ios::binary);
+    HeaderFile header = {};
+    entrada.read(reinterpret_cast<char*>(&header), sizeof(HeaderFile));
+    std::error_code ec;
+    const std::uintmax_t tamano = fs::file_size(origen, ec);
+    if (!entrada || ec || header.version != Constants::BINARY_FORMAT::VERSION_ACTUAL ||
+        header.cantidadRegistros < 0 || header.proximoID - header.cantidadRegistros < 1 ||
+        tamano != sizeof(HeaderFile) + static_cast<std::uintmax_t>(header.cantidadRegistros) *
+                                           Campo::TAMANO_REGISTRO) {
+        outError = "No se pudo archivar " + origen.string() + ": header invalido";
+        return false;
+    }
+    const int primerId = header.proximoID - header.cantidadRegistros;
+
+    Diccionario diccionario;
+    std::vector<BloqueFrio> tabla;
+    std::vector<std::string> guardados;
+    std::vector<char> lectura(REGISTROS_POR_BLOQUE * Campo::TAMANO_REGISTRO);
+    std::vector<char> decodificado(Campo::TAMANO_REGISTRO);
+    int activos = 0;
+    for (int inicio = 0; inicio < header.cantidadRegistros; inicio += REGISTROS_POR_BLOQUE) {
+        const int cantidad = std::min(REGISTROS_POR_BLOQUE, header.cantidadRegistros - inicio);
+        if (!entrada.read(lectura.data(),
+                          static_cast<std::streamsize>(cantidad * Campo::TAMANO_REGISTRO))) {
+            outError = "No se pudo leer " + origen.string();
+            return false;
+        }
+
+        std::string datos;
+        Anterior anterior{primerId + inicio - 1, 0};
+        Anterior verificado = anterior;
+        BloqueFrio bloque = {};
+        bloque.fechaMinima = std::numeric_limits<std::int64_t>::max();
+        bloque.fechaMaxima = std::numeric_limits<std::int64_t>::min();
+        for (int i = 0; i < cantidad; ++i) {
+            const char* registro = lectura.data() + static_cast<std::size_t>(i) *
+                                                        Campo::TAMANO_REGISTRO;
+            const int id = primerId + inicio + i;
+            const std::size_t desde = datos.size();
+            codificar(registro, anterior, diccionario, datos);
+
+            // sin perdidas: el registro reconstruido es identico byte a byte al original
+            LectorVarints lector(std::string_view(datos).substr(desde));
+            if (leerCampo<std::int32_t>(registro, Campo::ID) != id ||
+                !decodificar(lector, diccionario.textos, verificado, decodificado.data()) ||
+                !lector.agotado() ||
+                std::memcmp(decodificado.data(), registro, Campo::TAMANO_REGISTRO) != 0) {
+                outError = std::format("No se pudo archivar {}: registro {} no se reconstruye",
+                                       origen.string(), id);
+                return false;
+            }
+
+            const std::int64_t fecha = leerCampo<std::int64_t>(registro, Campo::FECHA_CREACION);
+            bloque.fechaMinima = std::min(bloque.fechaMinima, fecha);
+            bloque.fechaMaxima = std::max(bloque.fechaMaxima, fecha);
+            activos += leerCampo<std::int8_t>(registro, Campo::ELIMINADO) != 0 ? 0 : 1;
+        }
+
+        auto [guardado, bytes] = comprimir(datos);
+        bloque.bytes = bytes;
+        bloque.bytesOriginales = static_cast<std::uint32_t>(datos.size());
+        bloque.suma = sumaDe(guardado.data(), guardado.size());
+        tabla.push_back(bloque);
+        guardados.push_back(std::move(guardado));
+    }
+    if (activos != header.registrosActivos) {
+        outError = "No se pudo archivar " + origen.string() + ": activos distintos del header";
+        return false;
+    }
+
+    std::string textos;
+    for (const std::string& texto : diccionario.textos) {
+        agregarVarint(textos, texto.size());
+        textos += texto;
+    }
+    const auto [diccionarioGuardado, bytesDiccionario] = comprimir(textos);
+
+    EncabezadoFrio encabezado = {};
+    std::memcpy(encabezado.firma, FIRMA, sizeof(FIRMA));
+    encabezado.registrosPorBloque = REGISTROS_POR_BLOQUE;
+    encabezado.bloques = static_cast<std::int32_t>(tabla.size());
+    encabezado.textos = static_cast<std::uint32_t>(diccionario.textos.size());
+    encabezado.bytesDiccionario = bytesDiccionario;
+    encabezado.bytesDiccionarioOriginal = static_cast<std::uint32_t>(textos.size());
+    encabezado.sumaDiccionario = sumaDe(diccionarioGuardado.data(), diccionarioGuardado.size());
+    std::uint64_t posicion = sizeof(HeaderFile) + sizeof(EncabezadoFrio) +
+                             tabla.size() * sizeof(BloqueFrio) + diccionarioGuardado.size();
+    for (std::size_t i = 0; i < tabla.size(); ++i) {
+        tabla[i].offset = posicion;
+        posicion += guardados[i].size();
+    }
+    encabezado.sumaTabla = sumaDe(tabla.data(), tabla.size() * sizeof(BloqueFrio));
+
+    const fs::path temporal = fs::path(destino).concat(".tmp" + std::to_string(::getpid()));
+    {
+        std::ofstream salida(temporal, std::ios::binary | std::ios::trunc);
+        salida.write(reinterpret_cast<const char*>(&header), sizeof(HeaderFile));
+        salida.write(reinterpret_cast<const char*>(&encabezado), sizeof(EncabezadoFrio));
+        salida.write(reinterpret_cast<const char*>(tabla.data()),
+                     static_cast<std::streamsize>(tabla.size() * sizeof(BloqueFrio)));
+        salida.write(diccionarioGuardado.data(),
+                     static_cast<std::streamsize>(diccionarioGuardado.size()));
+        for (const std::string& guardado : guardados) {
+            salida.write(guardado.data(), static_cast<std::streamsize>(guardado.size()));
+        }
+        if (!salida.flush()) {
+            fs::remove(temporal, ec);
+            outError = "No se pudo escribir " + temporal.string();
+            return false;
+        }
+    }
+
+    try {
+        // en disco antes de que la lista lo nombre y se borre la particion original
+        DescriptorArchivo(temporal, O_RDONLY).sincronizar();
+    } catch (const std::exception& e) {
+        fs::remove(temporal, ec);
+        outError = e.what();
+        return false;
+    }
+    fs::rename(temporal, destino, ec);
+    if (ec) {
+        fs::remove(temporal, ec);
+        outError = "No se pudo reemplazar " + destino.string();
+        return false;
+    }
+    return true;
+}
+
+std::variant<std::shared_ptr<const SegmentoFrio::Indice>, std::string> SegmentoFrio::cargar()
+{
+    struct stat datos = {};
+    if (::stat(ruta.c_str(), &datos) != 0) {
+        return "Error abriendo archivo para lectura: " + ruta.string();
+    }
+    const IdentidadFrio identidad{
+        datos.st_ino,
+        static_cast<std::int64_t>(datos.st_mtim.tv_sec) * 1000000000 + datos.st_mtim.tv_nsec,
+        datos.st_size};
+    {
+        const std::lock_guard<std::mutex> lock(mutexIndice);
+        if (indice && indice->identidad == identidad) {
+            return indice;
+        }
+    }
+
+    auto nuevo = std::make_shared<Indice>();
+    nuevo->identidad = identidad;
+    nuevo->archivo = std::make_unique<ArchivoPosicional>(ruta);
+    const std::string danado = "Segmento archivado danado: " + ruta.string();
+    const auto tamano = static_cast<std::uint64_t>(datos.st_size);
+
+    const BloqueoArchivo bloqueo(ruta, BloqueoArchivo::COMPARTIDO, contencion);
+    EncabezadoFrio encabezado = {};
+    HeaderFile& header = nuevo->header;
+    if (!nuevo->archivo->abrir() || !nuevo->archivo->leerEn(&header, sizeof(HeaderFile), 0) ||
+        !nuevo->archivo->leerEn(&encabezado, sizeof(EncabezadoFrio), sizeof(HeaderFile))) {
+        return danado;
+    }
+    const std::int64_t porBloque = encabezado.registrosPorBloque;
+    if (std::memcmp(encabezado.firma, FIRMA, sizeof(FIRMA)) != 0 || porBloque <= 0 ||
+        header.version != Constants::BINARY_FORMAT::VERSION_ACTUAL ||
+        header.cantidadRegistros < 0 || header.proximoID - header.cantidadRegistros < 1 ||
+        encabezado.bloques != (header.cantidadRegistros + porBloque - 1) / porBloque ||
+        static_cast<std::uint64_t>(encabezado.bloques) * sizeof(BloqueFrio) > tamano) {
+        return danado;
+    }
+    nuevo->primerId = header.proximoID - header.cantidadRegistros;
+    nuevo->registrosPorBloque = encabezado.registrosPorBloque;
+
+    nuevo->bloques.resize(static_cast<std::size_t>(encabezado.bloques));
+    const std::size_t bytesTabla = nuevo->bloques.size() * sizeof(BloqueFrio);
+    const off_t inicioTabla = sizeof(HeaderFile) + sizeof(EncabezadoFrio);
+    const std::uint32_t bytesDiccionario = encabezado.bytesDiccionario & ~SIN_COMPRIMIR;
+    std::string diccionarioGuardado(bytesDiccionario, '\0');
+    std::string textos;
+    if (bytesDiccionario > BYTES_MAXIMOS || encabezado.bytesDiccionarioOriginal > BYTES_MAXIMOS ||
+        !nuevo->archivo->leerEn(nuevo->bloques.data(), bytesTabla, inicioTabla) ||
+        sumaDe(nuevo->bloques.data(), bytesTabla) != encabezado.sumaTabla ||
+        !nuevo->archivo->leerEn(diccionarioGuardado.data(), bytesDiccionario,
+                                inicioTabla + static_cast<off_t>(bytesTabla)) ||
+        sumaDe(diccionarioGuardado.data(), bytesDiccionario) != encabezado.sumaDiccionario ||
+        !descomprimir(diccionarioGuardado, encabezado.bytesDiccionario,
+                      encabezado.bytesDiccionarioOriginal, textos)) {
+        return danado;
+    }
+
+    LectorVarints lector(textos);
+    for (std::uint32_t i = 0; i < encabezado.textos && lector.ok(); ++i) {
+        const std::uint64_t largo = lector.varint();
+        nuevo->textos.emplace_back(lector.bytes(largo));
+    }
+    if (!lector.ok() || !lector.agotado()) {
+        return danado;
+    }
+    for (const BloqueFrio& bloque : nuevo->bloques) {
+        const std::uint64_t bytes = bloque.bytes & ~SIN_COMPRIMIR;
+        if (bytes > BYTES_MAXIMOS || bloque.bytesOriginales > BYTES_MAXIMOS ||
+            bloque.offset + bytes > tamano) {
+            return danado;
+        }
+    }
+
+    const std::lock_guard<std::mutex> lock(mutexIndice);
+    indice = nuevo;
+    return std::shared_ptr<const Indice>(nuevo);
+}
+
+std::variant<bool, std::string> SegmentoFrio::leerBloque(const Indice& leido, std::size_t numero,
+                                                         int desdeId, int hastaId,
+                                                         bool conEliminados,
+                                                         std::vector<Transaccion>& outRegistros)
+{
+    outRegistros.clear();
+    const BloqueFrio& bloque = leido.bloques[numero];
+    std::string guardado(bloque.bytes & ~SIN_COMPRIMIR, '\0');
+    {
+        const BloqueoArchivo bloqueo(ruta, BloqueoArchivo::COMPARTIDO, contencion);
+        if (!leido.archivo->leerEn(guardado.data(), guardado.size(),
+                                   static_cast<off_t>(bloque.offset))) {
+            return "Error leyendo registro desde archivo";
+        }
+    }
+
+    // fuera del flock: descomprimir y decodificar no toca el archivo
+    const std::string danado = "Segmento archivado danado: " + ruta.string();
+    std::string datos;
+    if (sumaDe(guardado.data(), guardado.size()) != bloque.suma ||
+        !descomprimir(guardado, bloque.bytes, bloque.bytesOriginales, datos)) {
+        return danado;
+    }
+
+    const int primerIdBloque = leido.primerId + static_cast<int>(numero) * leido.registrosPorBloque;
+    const int finBloque = std::min(leido.header.proximoID,
+                                   primerIdBloque + leido.registrosPorBloque);
+    LectorVarints lector(datos);
+    Anterior anterior{primerIdBloque - 1, 0};
+    std::vector<char> registro(Campo::TAMANO_REGISTRO);
+    RegistroEnMemoria memoria;
+    for (int id = primerIdBloque; id < finBloque && id < hastaId; ++id) {
+        if (!decodificar(lector, leido.textos, anterior, registro.data()) || anterior.id != id) {
+            return danado;
+        }
+        if (id < desdeId) {
+            continue;
+        }
+
+        Transaccion transaccion;
+        if (!EntityTraits<Transaccion>::readFromStream(
+                memoria.leerDesde(registro.data(), registro.size()), transaccion)) {
+            return danado;
+        }
+        if (conEliminados || !transaccion.getEliminado()) {
+            outRegistros.push_back(transaccion);
+        }
+    }
+    return true;
+}
+
+std::variant<HeaderFile, std::string> SegmentoFrio::obtenerEstadisticas()
+{
+    auto cargado = cargar();
+    if (std::holds_alternative<std::string>(cargado)) {
+        return std::get<std::string>(cargado);
+    }
+    return std::get<std::shared_ptr<const Indice>>(cargado)->header;
+}
+
+std::variant<Transaccion, std::string> SegmentoFrio::leer(int id)
+{
+    auto cargado = cargar();
+    if (std::holds_alternative<std::string>(cargado)) {
+        return std::get<std::string>(cargado);
+    }
+
+    const Indice& leido = *std::get<std::shared_ptr<const Indice>>(cargado);
+    if (id < leido.primerId || id >= leido.header.proximoID) {
+        return "ID fuera de rango o registro no existe";
+    }
+    std::vector<Transaccion> registros;
+    auto lectura = leerBloque(leido,
+                              static_cast<std::size_t>((id - leido.primerId) /
+                                                       leido.registrosPorBloque),
+                              id, id + 1, true, registros);
+    if (std::holds_alternative<std::string>(lectura)) {
+        return std::get<std::string>(lectura);
+    }
+    if (registros.front().getEliminado()) {
+        return "El registro ha sido eliminado";
+    }
+    return registros.front();
+}
+
+std::variant<bool, std::string> SegmentoFrio::recorrerDesde(
+    int desdeId, const std::function<bool(const Transaccion&)>& visitante)
+{
+    auto cargado = cargar();
+    if (std::holds_alternative<std::string>(cargado)) {
+        return std::get<std::string>(cargado);
+    }
+
+    const auto leido = std::get<std::shared_ptr<const Indice>>(std::move(cargado));
+    const int inicio = std::max(desdeId, leido->primerId);
+    std::vector<Transaccion> registros;
+    for (std::size_t numero = static_cast<std::size_t>((inicio - leido->primerId) /
+                                                       leido->registrosPorBloque);
+         numero < leido->bloques.size(); ++numero) {
+        auto lectura =
+            leerBloque(*leido, numero, inicio, leido->header.proximoID, false, registros);
+        if (std::holds_alternative<std::string>(lectura)) {
+            return lectura;
+        }
+        for (const Transaccion& transaccion : registros) {
+            if (!visitante(transaccion)) {
+                return true;
+            }
+        }
+    }
+    return true;
+}
+
+std::variant<bool, std::string> SegmentoFrio::recorrerEntreFechas(
+    system_clock::time_point desde, system_clock::time_point hasta,
+    const std::function<bool(const Transaccion&)>& visitante)
+{
+    auto cargado = cargar();
+    if (std::holds_alternative<std::string>(cargado)) {
+        return std::get<std::string>(cargado);
+    }
+
+    const auto leido = std::get<std::shared_ptr<const Indice>>(std::move(cargado));
+    std::vector<Transaccion> registros;
+    for (std::size_t numero = 0; numero < leido->bloques.size(); ++numero) {
+        const BloqueFrio& bloque = leido->bloques[numero];
+        if (system_clock::time_point(seconds(bloque.fechaMaxima)) < desde ||
+            system_clock::time_point(seconds(bloque.fechaMinima)) >= hasta) {
+            continue;
+        }
+
+        auto lectura = leerBloque(*leido, numero, leido->primerId, leido->header.proximoID,
+                                  false, registros);
+        if (std::holds_alternative<std::string>(lectura)) {
+            return lectura;
+        }
+        for (const Transaccion& transaccion : registros) {
+            const system_clock::time_point fecha = transaccion.getFechaCreacion();
+            if (fecha >= desde && fecha < hasta && !visitante(transaccion)) {
+                return true;
+            }
+        }
+    }
+    return true;
+}
+
+Generador<const Transaccion&> SegmentoFrio::generar(int desdeId)
+{
+    auto cargado = cargar();
+    if (std::holds_alternative<std::string>(cargado)) {
+        throw std::runtime_error(std::get<std::string>(cargado));
+    }
+
+    const auto leido = std::get<std::shared_ptr<const Indice>>(std::move(cargado));
+    const int inicio = std::max(desdeId, leido->primerId);
+    std::vector<Transaccion> registros;
+    for (std::size_t numero = static_cast<std::size_t>((inicio - leido->primerId) /
+                                                       leido->registrosPorBloque);
+         numero < leido->bloques.size(); ++numero) {
+        auto lectura =
+            leerBloque(*leido, numero, inicio, leido->header.proximoID, false, registros);
+        if (std::holds_alternative<std::string>(lectura)) {
+            throw std::runtime_error(std::get<std::string>(lectura));
+        }
+        for (const Transaccion& transaccion : registros) {
+            co_yield transaccion;
+        }
+    }
+}
+
+std::variant<HeaderFile, std::string> SegmentoFrio::verificar()
+{
+    auto cargado = cargar();
+    if (std::holds_alternative<std::string>(cargado)) {
+        return std::get<std::string>(cargado);
+    }
+
+    const Indice& leido = *std::get<std::shared_ptr<const Indice>>(cargado);
+    std::vector<Transaccion> registros;
+    int activos = 0;
+    for (std::size_t numero = 0; numero < leido.bloques.size(); ++numero) {
+        auto lectura =
+            leerBloque(leido, numero, leido.primerId, leido.header.proximoID, true, registros);
+        if (std::holds_alternative<std::string>(lectura)) {
+            return std::get<std::string>(lectura);
+        }
+        for (const Transaccion& transaccion : registros) {
+            activos += transaccion.getEliminado() ? 0 : 1;
+        }
+    }
+    if (activos != leido.header.registrosActivos) {
+        return "Registros activos distintos del header en " + ruta.string();
+    }
+    return leido.header;
+}
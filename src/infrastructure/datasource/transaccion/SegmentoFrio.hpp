@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <variant>
+#include <vector>
+
+#include "domain/HeaderFile.hpp"
+#include "domain/entities/transaccion/transaccion.entity.hpp"
+#include "domain/utils/Concurrencia.hpp"
+#include "domain/utils/Generador.hpp"
+
+namespace fs = std::filesystem;
+
+class ArchivoPosicional;
+
+/**
+ * @brief - Particion de transacciones cerrada, comprimida y de solo lectura.
+ *
+ * Arranca con el HeaderFile de la particion original (cantidad, proximoID y activos no cambian),
+ * seguido de un encabezado propio, la tabla de bloques, un diccionario de textos y los bloques.
+ * Cada bloque guarda REGISTROS_POR_BLOQUE registros por campo como varints: el ID y la fecha de
+ * creacion como diferencia con el registro anterior, la fecha de modificacion como diferencia con
+ * la de creacion, nombre y descripcion como indice en el diccionario y solo los items usados. El
+ * bloque se comprime ademas con CompresorLZ y lleva su suma XXH64 y las fechas minima y maxima de
+ * sus registros, con las que los recorridos por fecha saltan bloques enteros.
+ *
+ * Una lectura por ID descomprime un solo bloque y los recorridos, uno por vez: un registro de
+ * ~1.9 KB ocupa unas decenas de bytes, asi que el historial archivado cabe en la cache de
+ * paginas sin desplazar a las particiones que reciben escrituras. La tabla y el diccionario se
+ * leen una vez y se vuelven a leer si el archivo cambia (una restauracion lo reescribe en su
+ * lugar). Las lecturas toman el flock compartido del archivo, como FSBaseRepository.
+ */
+class SegmentoFrio
+{
+   public:
+    static constexpr int REGISTROS_POR_BLOQUE = 256;
+
+    /// Tabla y diccionario de un archivo; se comparte con las lecturas en curso.
+    struct Indice;
+
+   private:
+    fs::path ruta;
+    mutable std::mutex mutexIndice;
+    std::shared_ptr<const Indice> indice;
+    ContadoresContencion contencion;
+
+    std::variant<std::shared_ptr<const Indice>, std::string> cargar();
+    /// Registros de [desdeId, hastaId) del bloque `numero`: los activos o todos.
+    std::variant<bool, std::string> leerBloque(const Indice& leido, std::size_t numero, int desdeId,
+                                               int hastaId, bool conEliminados,
+                                               std::vector<Transaccion>& outRegistros);
+
+   public:
+    explicit SegmentoFrio(fs::path ruta);
+    ~SegmentoFrio();
+
+    SegmentoFrio(const SegmentoFrio&) = delete;
+    SegmentoFrio& operator=(const SegmentoFrio&) = delete;
+
+    /**
+     * Escribe en `destino` la version comprimida de la particion `origen` (registros de tamano
+     * fijo en el formato actual). Cada registro se decodifica de vuelta y se compara byte a byte
+     * con el original antes de escribirlo; el archivo se escribe en un temporal, se sincroniza y
+     * se renombra. Retorna false con `outError` si algo no coincide.
+     */
+    static bool archivar(const fs::path& origen, const fs::path& destino, std::string& outError);
+
+    std::variant<HeaderFile, std::string> obtenerEstadisticas();
+    std::variant<Transaccion, std::string> leer(int id);
+    std::variant<bool, std::string> recorrerDesde(
+        int desdeId, const std::function<bool(const Transaccion&)>& visitante);
+    /// Recorre las transacciones de [desde, hasta); solo descomprime los bloques que las tienen.
+    std::variant<bool, std::string> recorrerEntreFechas(
+        std::chrono::system_clock::time_point desde, std::chrono::system_clock::time_point hasta,
+        const std::function<bool(const Transaccion&)>& visitante);
+    /// Como FSBaseRepository::generarTemplate: un bloque por vez; los errores se lanzan.
+    Generador<const Transaccion&> generar(int desdeId);
+
+    /// Decodifica todo el archivo verificando sumas, IDs consecutivos y activos del header.
+    std::variant<HeaderFile, std::string> verificar();
+
+    EstadisticasContencion obtenerContencion() const { return contencion.instantanea(); }
+};
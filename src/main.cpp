@@ -1,8 +1,15 @@
+#include <string>
+#include <vector>
+
 #include "Bootstrapper.hpp"
 
-int main()
+int main(int argc, char* argv[])
 {
     Bootstrapper app;
+    if (argc > 1) {
+        return app.runBatch(std::vector<std::string>(argv + 1, argv + argc));
+    }
+
     app.runMainLoop();
     return 0;
 }
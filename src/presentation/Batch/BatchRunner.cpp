@@ -0,0 +1,1091 @@
+#include "BatchRunner.hpp"
+
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <variant>
+
+#include "domain/HeaderFile.hpp"
+#include "domain/utils/EjecutorTareas.hpp"
+#include "domain/utils/utils.hpp"
+#include "presentation/Batch/ExportadorDatos.hpp"
+#include "presentation/CliUtils.hpp"
+
+namespace {
+
+bool obtenerTexto(const ArgumentosBatch& args, const char* clave, std::string& outValue,
+                  std::string& outError)
+{
+    auto it = args.find(clave);
+    if (it == args.end() || it->second.empty()) {
+        outError = std::format("Falta el argumento '{}'", clave);
+        return false;
+    }
+
+    outValue = it->second;
+    return true;
+}
+
+bool obtenerEntero(const ArgumentosBatch& args, const char* clave, int& outValue,
+                   bool zeroInclusive, std::string& outError)
+{
+    std::string texto;
+    if (!obtenerTexto(args, clave, texto, outError)) {
+        return false;
+    }
+
+    if (!CliUtils::parsePositiveNumber(texto, outValue, zeroInclusive)) {
+        outError = std::format("Valor invalido para '{}': {}", clave, texto);
+        return false;
+    }
+
+    return true;
+}
+
+bool obtenerMonto(const ArgumentosBatch& args, const char* clave, Money& outValue,
+                  std::string& outError)
+{
+    std::string texto;
+    if (!obtenerTexto(args, clave, texto, outError)) {
+        return false;
+    }
+
+    if (!CliUtils::parseMoney(texto, outValue)) {
+        outError = std::format("Monto invalido para '{}': {}", clave, texto);
+        return false;
+    }
+
+    return true;
+}
+
+template <typename Repositorio>
+bool leerHeader(Repositorio& repositorio, HeaderFile& outHeader, std::string& outError)
+{
+    auto header = repositorio.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(header)) {
+        outError = std::get<std::string>(header);
+        return false;
+    }
+
+    outHeader = std::get<HeaderFile>(header);
+    return true;
+}
+
+/// Dia `AAAA-MM-DD` (UTC) de un argumento opcional; false solo si esta y no es una fecha valida.
+bool obtenerDia(const ArgumentosBatch& args, const char* clave,
+                std::optional<std::chrono::sys_days>& outDia, std::string& outError)
+{
+    outDia.reset();
+    auto it = args.find(clave);
+    if (it == args.end() || it->second.empty()) {
+        return true;
+    }
+
+    const std::string& texto = it->second;
+    int anio = 0;
+    int mes = 0;
+    int dia = 0;
+    const bool formato = texto.size() == 10 && texto[4] == '-' && texto[7] == '-' &&
+                         CliUtils::parsePositiveNumber(texto.substr(0, 4), anio, false) &&
+                         CliUtils::parsePositiveNumber(texto.substr(5, 2), mes, false) &&
+                         CliUtils::parsePositiveNumber(texto.substr(8, 2), dia, false);
+    const std::chrono::year_month_day fecha{std::chrono::year{anio},
+                                            std::chrono::month{static_cast<unsigned>(mes)},
+                                            std::chrono::day{static_cast<unsigned>(dia)}};
+    if (!formato || !fecha.ok()) {
+        outError = std::format("Fecha invalida para '{}' (use AAAA-MM-DD): {}", clave, texto);
+        return false;
+    }
+
+    outDia = std::chrono::sys_days{fecha};
+    return true;
+}
+
+bool obtenerItems(const ArgumentosBatch& args, std::vector<TransaccionDTO>& outItems,
+                  std::string& outError)
+{
+    std::string texto;
+    return obtenerTexto(args, "items", texto, outError) &&
+           BatchRunner::parsearItems(texto, outItems, outError);
+}
+
+}  // namespace
+
+BatchRunner::BatchRunner(AppRepositories& repositories, std::ostream& out)
+    : repositories(repositories), servicio(repositories), out(out)
+{
+    servicio.diferirSincronizacionTienda(true);
+}
+
+bool BatchRunner::parsearItems(const std::string& texto, std::vector<TransaccionDTO>& outItems,
+                               std::string& outError)
+{
+    outItems.clear();
+    std::size_t inicio = 0;
+    while (inicio <= texto.size()) {
+        std::size_t fin = texto.find(',', inicio);
+        if (fin == std::string::npos) {
+            fin = texto.size();
+        }
+
+        const std::string par = texto.substr(inicio, fin - inicio);
+        const std::size_t separador = par.find(':');
+        TransaccionDTO item{};
+        if (separador == std::string::npos ||
+            !CliUtils::parsePositiveNumber(par.substr(0, separador), item.productoId, false) ||
+            !CliUtils::parsePositiveNumber(par.substr(separador + 1), item.cantidad, false)) {
+            outError = "Item invalido (se espera ID:CANTIDAD): " + par;
+            return false;
+        }
+
+        outItems.push_back(item);
+        inicio = fin + 1;
+    }
+
+    return true;
+}
+
+
+bool BatchRunner::tokenizar(const std::string& linea, std::vector<std::string>& outTokens,
+                            std::string& outError)
+{
+    outTokens.clear();
+    std::string actual;
+    bool enComillas = false;
+    bool hayToken = false;
+
+    for (const char c : linea) {
+        if (c == '"') {
+            enComillas = !enComillas;
+            hayToken = true;
+            continue;
+        }
+
+        if (!enComillas && std::isspace(static_cast<unsigned char>(c))) {
+            if (hayToken) {
+                outTokens.push_back(actual);
+                actual.clear();
+                hayToken = false;
+            }
+            continue;
+        }
+
+        actual += c;
+        hayToken = true;
+    }
+
+    if (enComillas) {
+        outError = "Comillas sin cerrar";
+        return false;
+    }
+
+    if (hayToken) {
+        outTokens.push_back(actual);
+    }
+
+    return true;
+}
+
+bool BatchRunner::IndiceUnicidad::disponible(const std::string& nombre, const std::string& clave,
+                                              std::string& outError) const
+{
+    if (nombres.contains(DomainUtils::normalizeName(nombre))) {
+        outError = std::format("Ya existe un {} con el nombre ingresado.", entidad);
+        return false;
+    }
+    if (claves.contains(clave)) {
+        outError = std::format("Ya existe un {} con {}.", entidad, descripcionClave);
+        return false;
+    }
+
+    return true;
+}
+
+void BatchRunner::IndiceUnicidad::agregar(const std::string& nombre, const std::string& clave)
+{
+    nombres.insert(DomainUtils::normalizeName(nombre));
+    claves.insert(clave);
+}
+
+bool BatchRunner::IndiceUnicidad::registrar(const std::string& nombre, const std::string& clave,
+                                            std::string& outError)
+{
+    if (!disponible(nombre, clave, outError)) {
+        return false;
+    }
+
+    agregar(nombre, clave);
+    return true;
+}
+
+bool BatchRunner::IndiceUnicidad::vigente(const HeaderFile& header) const
+{
+    return cargado && proximoID == header.proximoID && registrosActivos == header.registrosActivos;
+}
+
+void BatchRunner::IndiceUnicidad::reiniciar(const HeaderFile& header)
+{
+    cargado = false;
+    proximoID = header.proximoID;
+    registrosActivos = header.registrosActivos;
+    nombres.clear();
+    claves.clear();
+}
+
+void BatchRunner::IndiceUnicidad::contarAltas(int nuevoProximoID, int altas)
+{
+    proximoID = nuevoProximoID;
+    registrosActivos += altas;
+}
+
+void BatchRunner::invalidarIndices()
+{
+    for (IndiceUnicidad* indice : {&indiceProductos, &indiceProveedores, &indiceClientes}) {
+        indice->cargado = false;
+        indice->nombres.clear();
+        indice->claves.clear();
+    }
+    proveedoresActivos.clear();
+}
+
+bool BatchRunner::cargarIndices(std::string& outError)
+{
+    HeaderFile productos{};
+    HeaderFile proveedores{};
+    HeaderFile clientes{};
+    if (!leerHeader(repositories.productos, productos, outError) ||
+        !leerHeader(repositories.proveedores, proveedores, outError) ||
+        !leerHeader(repositories.clientes, clientes, outError)) {
+        return false;
+    }
+
+    // el header se lee antes de recorrer: un alta durante el recorrido fuerza otra carga
+    if (!indiceProductos.vigente(productos)) {
+        indiceProductos.reiniciar(productos);
+        auto scan = repositories.productos.recorrer([this](const Producto& producto) {
+            indiceProductos.agregar(producto.getNombre(), producto.getCodigo());
+            return true;
+        });
+        if (std::holds_alternative<std::string>(scan)) {
+            outError = std::get<std::string>(scan);
+            return false;
+        }
+        indiceProductos.cargado = true;
+    }
+
+    if (!indiceProveedores.vigente(proveedores)) {
+        indiceProveedores.reiniciar(proveedores);
+        proveedoresActivos.clear();
+        auto scan = repositories.proveedores.recorrer([this](const Proveedor& proveedor) {
+            indiceProveedores.agregar(proveedor.getNombre(), proveedor.getRif());
+            proveedoresActivos.insert(proveedor.getId());
+            return true;
+        });
+        if (std::holds_alternative<std::string>(scan)) {
+            outError = std::get<std::string>(scan);
+            return false;
+        }
+        indiceProveedores.cargado = true;
+    }
+
+    if (!indiceClientes.vigente(clientes)) {
+        indiceClientes.reiniciar(clientes);
+        auto scan = repositories.clientes.recorrer([this](const Cliente& cliente) {
+            indiceClientes.agregar(cliente.getNombre(), cliente.getCedula());
+            return true;
+        });
+        if (std::holds_alternative<std::string>(scan)) {
+            outError = std::get<std::string>(scan);
+            return false;
+        }
+        indiceClientes.cargado = true;
+    }
+
+    return true;
+}
+
+bool BatchRunner::construirProducto(const ArgumentosBatch& args, Producto& outProducto,
+                                    std::string& outError)
+{
+    std::string nombre;
+    std::string codigo;
+    Money precio;
+    int stock = 0;
+    int stockMinimo = 0;
+    int idProveedor = 0;
+    if (!obtenerTexto(args, "nombre", nombre, outError) ||
+        !obtenerTexto(args, "codigo", codigo, outError) ||
+        !obtenerMonto(args, "precio", precio, outError) ||
+        !obtenerEntero(args, "stock", stock, true, outError) ||
+        !obtenerEntero(args, "stockMinimo", stockMinimo, true, outError) ||
+        !obtenerEntero(args, "proveedor", idProveedor, false, outError)) {
+        return false;
+    }
+
+    const auto descripcion = args.find("descripcion");
+    if (!outProducto.setNombre(nombre.c_str()) || !outProducto.setCodigo(codigo.c_str()) ||
+        !outProducto.setDescripcion(descripcion != args.end() ? descripcion->second.c_str()
+                                                              : "") ||
+        !outProducto.setPrecio(precio) || !outProducto.setStock(stock) ||
+        !outProducto.setIdProveedor(idProveedor) || !outProducto.setStockMinimo(stockMinimo)) {
+        outError = "Datos de producto invalidos.";
+        return false;
+    }
+
+    return true;
+}
+
+bool BatchRunner::construirProveedor(const ArgumentosBatch& args, Proveedor& outProveedor,
+                                     std::string& outError)
+{
+    std::string nombre;
+    std::string rif;
+    std::string telefono;
+    std::string email;
+    std::string direccion;
+    if (!obtenerTexto(args, "nombre", nombre, outError) ||
+        !obtenerTexto(args, "rif", rif, outError) ||
+        !obtenerTexto(args, "telefono", telefono, outError) ||
+        !obtenerTexto(args, "email", email, outError) ||
+        !obtenerTexto(args, "direccion", direccion, outError)) {
+        return false;
+    }
+
+    if (!outProveedor.setNombre(nombre.c_str()) || !outProveedor.setRif(rif.c_str()) ||
+        !outProveedor.setTelefono(telefono.c_str()) || !outProveedor.setEmail(email.c_str()) ||
+        !outProveedor.setDireccion(direccion.c_str())) {
+        outError = "Datos de proveedor invalidos.";
+        return false;
+    }
+
+    return true;
+}
+
+bool BatchRunner::construirCliente(const ArgumentosBatch& args, Cliente& outCliente,
+                                   std::string& outError)
+{
+    std::string nombre;
+    std::string cedula;
+    std::string telefono;
+    std::string email;
+    std::string direccion;
+    if (!obtenerTexto(args, "nombre", nombre, outError) ||
+        !obtenerTexto(args, "cedula", cedula, outError) ||
+        !obtenerTexto(args, "telefono", telefono, outError) ||
+        !obtenerTexto(args, "email", email, outError) ||
+        !obtenerTexto(args, "direccion", direccion, outError)) {
+        return false;
+    }
+
+    if (!outCliente.setNombre(nombre.c_str()) || !outCliente.setCedula(cedula.c_str()) ||
+        !outCliente.setTelefono(telefono.c_str()) || !outCliente.setEmail(email.c_str()) ||
+        !outCliente.setDireccion(direccion.c_str())) {
+        outError = "Datos de cliente invalidos.";
+        return false;
+    }
+
+    return true;
+}
+
+bool BatchRunner::crearProducto(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    Producto producto{};
+    if (!construirProducto(args, producto, outMensaje) || !cargarIndices(outMensaje)) {
+        return false;
+    }
+
+    if (!proveedoresActivos.contains(producto.getIdProveedor())) {
+        outMensaje = std::format("El proveedor {} no existe.", producto.getIdProveedor());
+        return false;
+    }
+
+    auto productosHeader = repositories.productos.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(productosHeader)) {
+        outMensaje = std::get<std::string>(productosHeader);
+        return false;
+    }
+
+    if (!indiceProductos.disponible(producto.getNombre(), producto.getCodigo(), outMensaje)) {
+        return false;
+    }
+
+    producto.setId(std::get<HeaderFile>(productosHeader).proximoID);
+    const auto operacion = repositories.admin.iniciarOperacion();
+    auto saveResult = repositories.productos.guardar(producto);
+    if (std::holds_alternative<std::string>(saveResult)) {
+        outMensaje = "Error al guardar: " + std::get<std::string>(saveResult);
+        return false;
+    }
+
+    indiceProductos.agregar(producto.getNombre(), producto.getCodigo());
+    indiceProductos.contarAltas(producto.getId() + 1, 1);
+    requiereSincronizar = true;
+    outMensaje = std::format("id={}", producto.getId());
+    return true;
+}
+
+bool BatchRunner::crearProveedor(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    Proveedor proveedor{};
+    if (!construirProveedor(args, proveedor, outMensaje) || !cargarIndices(outMensaje)) {
+        return false;
+    }
+
+    auto proveedoresHeader = repositories.proveedores.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(proveedoresHeader)) {
+        outMensaje = std::get<std::string>(proveedoresHeader);
+        return false;
+    }
+
+    if (!indiceProveedores.disponible(proveedor.getNombre(), proveedor.getRif(), outMensaje)) {
+        return false;
+    }
+
+    proveedor.setId(std::get<HeaderFile>(proveedoresHeader).proximoID);
+    const auto operacion = repositories.admin.iniciarOperacion();
+    auto saveResult = repositories.proveedores.guardar(proveedor);
+    if (std::holds_alternative<std::string>(saveResult)) {
+        outMensaje = "Error al guardar: " + std::get<std::string>(saveResult);
+        return false;
+    }
+
+    indiceProveedores.agregar(proveedor.getNombre(), proveedor.getRif());
+    indiceProveedores.contarAltas(proveedor.getId() + 1, 1);
+    proveedoresActivos.insert(proveedor.getId());
+    requiereSincronizar = true;
+    outMensaje = std::format("id={}", proveedor.getId());
+    return true;
+}
+
+bool BatchRunner::crearCliente(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    Cliente cliente{};
+    if (!construirCliente(args, cliente, outMensaje) || !cargarIndices(outMensaje)) {
+        return false;
+    }
+
+    auto clientesHeader = repositories.clientes.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(clientesHeader)) {
+        outMensaje = std::get<std::string>(clientesHeader);
+        return false;
+    }
+
+    if (!indiceClientes.disponible(cliente.getNombre(), cliente.getCedula(), outMensaje)) {
+        return false;
+    }
+
+    cliente.setId(std::get<HeaderFile>(clientesHeader).proximoID);
+    const auto operacion = repositories.admin.iniciarOperacion();
+    auto saveResult = repositories.clientes.guardar(cliente);
+    if (std::holds_alternative<std::string>(saveResult)) {
+        outMensaje = "Error al guardar: " + std::get<std::string>(saveResult);
+        return false;
+    }
+
+    indiceClientes.agregar(cliente.getNombre(), cliente.getCedula());
+    indiceClientes.contarAltas(cliente.getId() + 1, 1);
+    requiereSincronizar = true;
+    outMensaje = std::format("id={}", cliente.getId());
+    return true;
+}
+
+template <typename T, typename Repositorio, typename Validar>
+bool BatchRunner::importar(const char* comando, const ArgumentosBatch& args,
+                           Repositorio& repositorio, IndiceUnicidad& indice,
+                           const ImportadorCsv::Constructor<T>& construir, Validar validar,
+                           std::string& outMensaje)
+{
+    std::string ruta;
+    if (!obtenerTexto(args, "archivo", ruta, outMensaje) || !cargarIndices(outMensaje)) {
+        return false;
+    }
+
+    std::vector<FilaImportada<T>> filas;
+    if (!ImportadorCsv::leerArchivo(ruta, construir, filas, outMensaje)) {
+        return false;
+    }
+
+    auto headerResult = repositorio.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(headerResult)) {
+        outMensaje = std::get<std::string>(headerResult);
+        return false;
+    }
+
+    // validacion secuencial: la unicidad depende de las filas anteriores del mismo archivo
+    std::vector<T> lote;
+    lote.reserve(filas.size());
+    int proximoID = std::get<HeaderFile>(headerResult).proximoID;
+    int rechazadas = 0;
+    for (FilaImportada<T>& fila : filas) {
+        fila.entidad.setId(proximoID);
+        if (fila.valida) {
+            fila.valida = validar(fila.entidad, fila.error);
+        }
+
+        if (!fila.valida) {
+            reportar(false, comando, std::format("fila {}: {}", fila.linea, fila.error));
+            ++rechazadas;
+            continue;
+        }
+
+        ++proximoID;
+        lote.push_back(std::move(fila.entidad));
+    }
+
+    const auto operacion = repositories.admin.iniciarOperacion();
+    auto saveResult = repositorio.guardarLote(lote);
+    if (std::holds_alternative<std::string>(saveResult)) {
+        // el header no se actualizo: los indices en memoria ya no reflejan el archivo
+        invalidarIndices();
+        outMensaje = "Error al guardar: " + std::get<std::string>(saveResult);
+        return false;
+    }
+
+    indice.contarAltas(proximoID, static_cast<int>(lote.size()));
+    requiereSincronizar = requiereSincronizar || !lote.empty();
+    outMensaje = std::format("importados={} rechazados={}", lote.size(), rechazadas);
+    return true;
+}
+
+bool BatchRunner::importarProductos(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    return importar<Producto>(
+        "importar-productos", args, repositories.productos, indiceProductos, construirProducto,
+        [this](const Producto& producto, std::string& outError) {
+            if (!proveedoresActivos.contains(producto.getIdProveedor())) {
+                outError = std::format("El proveedor {} no existe.", producto.getIdProveedor());
+                return false;
+            }
+            return indiceProductos.registrar(producto.getNombre(), producto.getCodigo(), outError);
+        },
+        outMensaje);
+}
+
+bool BatchRunner::importarProveedores(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    return importar<Proveedor>(
+        "importar-proveedores", args, repositories.proveedores, indiceProveedores,
+        construirProveedor,
+        [this](const Proveedor& proveedor, std::string& outError) {
+            if (!indiceProveedores.registrar(proveedor.getNombre(), proveedor.getRif(),
+                                             outError)) {
+                return false;
+            }
+            proveedoresActivos.insert(proveedor.getId());
+            return true;
+        },
+        outMensaje);
+}
+
+bool BatchRunner::importarClientes(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    return importar<Cliente>(
+        "importar-clientes", args, repositories.clientes, indiceClientes, construirCliente,
+        [this](const Cliente& cliente, std::string& outError) {
+            return indiceClientes.registrar(cliente.getNombre(), cliente.getCedula(), outError);
+        },
+        outMensaje);
+}
+
+bool BatchRunner::registrarTransaccion(TipoDeTransaccion tipo, const ArgumentosBatch& args,
+                                       std::string& outMensaje)
+{
+    const bool esVenta = tipo == VENTA;
+    int idRelacionado = 0;
+    std::vector<TransaccionDTO> items;
+    if (!obtenerEntero(args, esVenta ? "cliente" : "proveedor", idRelacionado, false,
+                       outMensaje) ||
+        !obtenerItems(args, items, outMensaje)) {
+        return false;
+    }
+
+    const auto descripcionArg = args.find("descripcion");
+    const std::string descripcion = descripcionArg != args.end()
+                                        ? descripcionArg->second
+                                        : (esVenta ? "Venta registrada en batch"
+                                                   : "Compra registrada en batch");
+
+    auto result = esVenta ? registrarVenta(idRelacionado, items, descripcion)
+                          : servicio.registrarCompra(idRelacionado, items, descripcion);
+    if (std::holds_alternative<std::string>(result)) {
+        outMensaje = std::get<std::string>(result);
+        return false;
+    }
+
+    const ResultadoTransaccion& resultado = std::get<ResultadoTransaccion>(result);
+    requiereSincronizar = true;
+    outMensaje = std::format("id={} total={}", resultado.transaccion.getId(),
+                             resultado.transaccion.getTotal().toString());
+    for (const std::string& advertencia : resultado.advertencias) {
+        outMensaje += " advertencia=\"" + advertencia + "\"";
+    }
+    return true;
+}
+
+std::variant<ResultadoTransaccion, std::string> BatchRunner::registrarVenta(
+    int idCliente, std::vector<TransaccionDTO> items, const std::string& descripcion)
+{
+    auto result = servicio.registrarVenta(idCliente, std::move(items), descripcion);
+    if (std::holds_alternative<ResultadoTransaccion>(result)) {
+        requiereSincronizar = true;
+    }
+    return result;
+}
+
+bool BatchRunner::cancelarTransaccion(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    int id = 0;
+    if (!obtenerEntero(args, "id", id, false, outMensaje)) {
+        return false;
+    }
+
+    auto result = servicio.cancelarTransaccion(id);
+    if (std::holds_alternative<std::string>(result)) {
+        outMensaje = std::get<std::string>(result);
+        return false;
+    }
+
+    requiereSincronizar = true;
+    outMensaje = std::format("id={}", id);
+    for (const std::string& advertencia : std::get<ResultadoTransaccion>(result).advertencias) {
+        outMensaje += " advertencia=\"" + advertencia + "\"";
+    }
+    return true;
+}
+
+bool BatchRunner::exportar(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    std::string entidad;
+    std::string textoFormato;
+    std::string ruta;
+    FormatoExportacion formato = CSV;
+    if (!obtenerTexto(args, "entidad", entidad, outMensaje) ||
+        !obtenerTexto(args, "formato", textoFormato, outMensaje) ||
+        !obtenerTexto(args, "archivo", ruta, outMensaje)) {
+        return false;
+    }
+
+    if (!ExportadorDatos::parsearFormato(textoFormato, formato)) {
+        outMensaje = "Formato invalido (use csv o jsonl): " + textoFormato;
+        return false;
+    }
+
+    // desde y hasta son dias inclusive; falta uno de los dos, el periodo queda abierto de ese lado
+    std::optional<std::chrono::sys_days> desde;
+    std::optional<std::chrono::sys_days> hasta;
+    if (!obtenerDia(args, "desde", desde, outMensaje) ||
+        !obtenerDia(args, "hasta", hasta, outMensaje)) {
+        return false;
+    }
+    std::optional<PeriodoExportacion> periodo;
+    if (desde || hasta) {
+        using Reloj = std::chrono::system_clock;
+        periodo = PeriodoExportacion{
+            desde ? Reloj::time_point{*desde} : Reloj::time_point::min(),
+            hasta ? Reloj::time_point{*hasta + std::chrono::days{1}} : Reloj::time_point::max()};
+    }
+
+    std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+    if (!archivo.is_open()) {
+        outMensaje = "No se pudo crear el archivo: " + ruta;
+        return false;
+    }
+
+    auto result = ExportadorDatos(repositories).exportar(entidad, formato, archivo, periodo);
+    if (std::holds_alternative<std::string>(result)) {
+        outMensaje = std::get<std::string>(result);
+        return false;
+    }
+
+    outMensaje = std::format("filas={} archivo={}", std::get<std::int64_t>(result), ruta);
+    return true;
+}
+
+bool BatchRunner::verificarIntegridad(std::string& outMensaje)
+{
+    try {
+        const auto [productos, relacionados, items, tipos] =
+            repositories.admin.verificarIntegridadReferencial();
+        outMensaje = std::format(
+            "productosSinProveedor={} transaccionesSinRelacionado={} "
+            "transaccionesConProductosInvalidos={} transaccionesTipoInvalido={}",
+            productos, relacionados, items, tipos);
+        return productos == 0 && relacionados == 0 && items == 0 && tipos == 0;
+    } catch (const std::exception& e) {
+        outMensaje = e.what();
+        return false;
+    }
+}
+
+bool BatchRunner::reporteStockCritico(std::string& outMensaje)
+{
+    try {
+        outMensaje = std::format("productosCriticos={}", repositories.admin.reporteStockCritico());
+        return true;
+    } catch (const std::exception& e) {
+        outMensaje = e.what();
+        return false;
+    }
+}
+
+bool BatchRunner::reporteContencion(std::string& outMensaje)
+{
+    const std::pair<const char*, EstadisticasContencion> entidades[] = {
+        {"productos", repositories.productos.obtenerContencion()},
+        {"proveedores", repositories.proveedores.obtenerContencion()},
+        {"clientes", repositories.clientes.obtenerContencion()},
+        {"transacciones", repositories.transacciones.obtenerContencion()},
+    };
+
+    outMensaje.clear();
+    for (const auto& [entidad, estadisticas] : entidades) {
+        outMensaje += std::format(
+            "{}{}=lecturas:{}/{} escrituras:{}/{} latches:{}/{} otrosProcesos:{}",
+            outMensaje.empty() ? "" : " ", entidad, estadisticas.esperasLectura,
+            estadisticas.lecturas, estadisticas.esperasEscritura, estadisticas.escrituras,
+            estadisticas.esperasRegistro, estadisticas.bloqueosRegistro,
+            estadisticas.esperasEntreProcesos);
+    }
+    return true;
+}
+
+bool BatchRunner::reporteTareas(std::string& outMensaje)
+{
+    const std::vector<EjecutorTareas::Medicion> mediciones =
+        EjecutorTareas::global().ultimasMediciones();
+    if (mediciones.empty()) {
+        outMensaje = "sin trabajos paralelos en este proceso";
+        return true;
+    }
+
+    outMensaje = std::format("hilos:{}", EjecutorTareas::global().cantidadHilos() + 1);
+    for (const EjecutorTareas::Medicion& medicion : mediciones) {
+        const double aceleracion = medicion.msTotal > 0 ? medicion.msTrabajo / medicion.msTotal : 0;
+        outMensaje += std::format(" | {}: tramos:{} ms:{:.1f} trabajo:{:.1f} maximo:{:.1f} x{:.2f}",
+                                  medicion.nombre, medicion.tramos, medicion.msTotal,
+                                  medicion.msTrabajo, medicion.msTramoMaximo, aceleracion);
+    }
+    return true;
+}
+
+bool BatchRunner::crearBackup(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    const auto tipo = args.find("tipo");
+    const bool completo = tipo != args.end() && tipo->second == "completo";
+    if (tipo != args.end() && !completo && tipo->second != "incremental") {
+        outMensaje = "tipo invalido (use completo o incremental)";
+        return false;
+    }
+    const auto textoFormato = args.find("formato");
+    FormatoBackup formato = BACKUP_DEDUPLICADO;
+    if (textoFormato != args.end() && textoFormato->second == "comprimido") {
+        formato = BACKUP_COMPRIMIDO;
+    } else if (textoFormato != args.end() && textoFormato->second == "plano") {
+        formato = BACKUP_PLANO;
+    } else if (textoFormato != args.end() && textoFormato->second != "dedup") {
+        outMensaje = "formato invalido (use dedup, comprimido o plano)";
+        return false;
+    }
+
+    try {
+        const ResumenBackup resumen = repositories.admin.crearBackup(completo, formato);
+        outMensaje = std::format(
+            "backup {} creado: {} archivos={} bytes={} guardados={} clonados={} pausa={:.1f}ms",
+            formato == BACKUP_DEDUPLICADO ? "deduplicado"
+            : resumen.incremental         ? "incremental"
+                                          : "completo",
+            resumen.ruta, resumen.archivos, resumen.bytes, resumen.bytesGuardados,
+            resumen.clonados, resumen.msPausa);
+        if (formato == BACKUP_DEDUPLICADO) {
+            outMensaje += std::format(" fragmentos={} nuevos={}", resumen.fragmentos,
+                                      resumen.fragmentosNuevos);
+        }
+        return true;
+    } catch (const std::exception& e) {
+        outMensaje = e.what();
+        return false;
+    }
+}
+
+bool BatchRunner::extraerBackup(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    std::string destino;
+    if (!obtenerTexto(args, "destino", destino, outMensaje)) {
+        return false;
+    }
+    const auto id = args.find("id");
+
+    try {
+        const ResumenBackup resumen = repositories.admin.extraerBackup(
+            id == args.end() ? std::string() : id->second, destino);
+        outMensaje = std::format("backup extraido en {}: archivos={} bytes={} leidos={}",
+                                 resumen.ruta, resumen.archivos, resumen.bytes,
+                                 resumen.bytesGuardados);
+        return true;
+    } catch (const std::exception& e) {
+        outMensaje = e.what();
+        return false;
+    }
+}
+
+bool BatchRunner::restaurarBackup(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    const auto id = args.find("id");
+
+    try {
+        const ResumenBackup resumen =
+            repositories.admin.restaurarBackup(id == args.end() ? std::string() : id->second);
+        // los datos restaurados pueden tener los mismos headers con otros registros
+        invalidarIndices();
+        requiereSincronizar = true;
+        outMensaje = std::format("backup {} restaurado: archivos={} bytes={} registros={} "
+                                 "pausa={:.1f}ms",
+                                 resumen.ruta, resumen.archivos, resumen.bytes, resumen.registros,
+                                 resumen.msPausa);
+        return true;
+    } catch (const std::exception& e) {
+        outMensaje = e.what();
+        return false;
+    }
+}
+
+bool BatchRunner::aplicarRetencion(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    PoliticaRetencion politica;
+    const std::pair<const char*, int*> criterios[] = {{"ultimos", &politica.ultimos},
+                                                      {"horas", &politica.horas},
+                                                      {"dias", &politica.dias},
+                                                      {"meses", &politica.meses}};
+    for (const auto& [clave, valor] : criterios) {
+        if (args.contains(clave) && !obtenerEntero(args, clave, *valor, true, outMensaje)) {
+            return false;
+        }
+    }
+
+    try {
+        const ResumenRetencion resumen = repositories.admin.aplicarRetencion(politica);
+        outMensaje = std::format(
+            "retencion aplicada: conservados={} eliminados={} fragmentos={} liberados={}",
+            resumen.conservados, resumen.eliminados, resumen.objetosEliminados,
+            resumen.bytesLiberados);
+        return true;
+    } catch (const std::exception& e) {
+        outMensaje = e.what();
+        return false;
+    }
+}
+
+bool BatchRunner::archivarTransacciones(const ArgumentosBatch& args, std::string& outMensaje)
+{
+    int meses = 3;
+    if (args.contains("meses") && !obtenerEntero(args, "meses", meses, false, outMensaje)) {
+        return false;
+    }
+
+    // conserva sin archivar el mes en curso y los meses-1 anteriores
+    const std::chrono::year_month_day hoy{
+        std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now())};
+    const std::chrono::year_month limite =
+        hoy.year() / hoy.month() - std::chrono::months{meses - 1};
+    auto result = repositories.transacciones.archivarAnteriores(limite);
+    if (std::holds_alternative<std::string>(result)) {
+        outMensaje = std::get<std::string>(result);
+        return false;
+    }
+
+    const ResumenArchivado& resumen = std::get<ResumenArchivado>(result);
+    outMensaje = std::format("particiones={} bytesAntes={} bytesDespues={}", resumen.particiones,
+                             resumen.bytesAntes, resumen.bytesDespues);
+    return true;
+}
+
+bool BatchRunner::sincronizarTienda(std::string& outMensaje)
+{
+    try {
+        const auto operacion = repositories.admin.iniciarOperacion();
+        repositories.admin.sincronizarContadoresTienda();
+        requiereSincronizar = false;
+        outMensaje = "tienda sincronizada";
+        return true;
+    } catch (const std::exception& e) {
+        outMensaje = e.what();
+        return false;
+    }
+}
+
+void BatchRunner::reportar(bool ok, const std::string& comando, const std::string& mensaje)
+{
+    if (ok) {
+        out << "OK " << comando << ": " << mensaje << '\n';
+    } else if (lineaActual > 0) {
+        out << "ERROR linea " << lineaActual << ' ' << comando << ": " << mensaje << '\n';
+    } else {
+        out << "ERROR " << comando << ": " << mensaje << '\n';
+    }
+}
+
+bool BatchRunner::ejecutar(const std::vector<std::string>& tokens)
+{
+    if (tokens.empty()) {
+        return true;
+    }
+
+    const std::string& comando = tokens.front();
+    ArgumentosBatch args;
+    std::string mensaje;
+    for (std::size_t i = 1; i < tokens.size(); ++i) {
+        const std::size_t igual = tokens[i].find('=');
+        if (igual == std::string::npos || igual == 0) {
+            reportar(false, comando, "argumento invalido (se espera clave=valor): " + tokens[i]);
+            return false;
+        }
+        args[tokens[i].substr(0, igual)] = tokens[i].substr(igual + 1);
+    }
+
+    bool ok = false;
+    if (comando == "producto-crear") {
+        ok = crearProducto(args, mensaje);
+    } else if (comando == "proveedor-crear") {
+        ok = crearProveedor(args, mensaje);
+    } else if (comando == "cliente-crear") {
+        ok = crearCliente(args, mensaje);
+    } else if (comando == "importar-productos") {
+        ok = importarProductos(args, mensaje);
+    } else if (comando == "importar-proveedores") {
+        ok = importarProveedores(args, mensaje);
+    } else if (comando == "importar-clientes") {
+        ok = importarClientes(args, mensaje);
+    } else if (comando == "compra") {
+        ok = registrarTransaccion(COMPRA, args, mensaje);
+    } else if (comando == "venta") {
+        ok = registrarTransaccion(VENTA, args, mensaje);
+    } else if (comando == "cancelar") {
+        ok = cancelarTransaccion(args, mensaje);
+    } else if (comando == "exportar") {
+        ok = exportar(args, mensaje);
+    } else if (comando == "archivar") {
+        ok = archivarTransacciones(args, mensaje);
+    } else if (comando == "integridad") {
+        ok = verificarIntegridad(mensaje);
+    } else if (comando == "stock-critico") {
+        ok = reporteStockCritico(mensaje);
+    } else if (comando == "contencion") {
+        ok = reporteContencion(mensaje);
+    } else if (comando == "tareas") {
+        ok = reporteTareas(mensaje);
+    } else if (comando == "backup") {
+        ok = crearBackup(args, mensaje);
+    } else if (comando == "backup-extraer") {
+        ok = extraerBackup(args, mensaje);
+    } else if (comando == "backup-restaurar") {
+        ok = restaurarBackup(args, mensaje);
+    } else if (comando == "backup-retener") {
+        ok = aplicarRetencion(args, mensaje);
+    } else if (comando == "sincronizar") {
+        ok = sincronizarTienda(mensaje);
+    } else if (comando == "ayuda") {
+        imprimirAyuda(out);
+        return true;
+    } else {
+        mensaje = "comando desconocido (use 'ayuda')";
+    }
+
+    reportar(ok, comando, mensaje);
+    return ok;
+}
+
+int BatchRunner::ejecutarScript(std::istream& in, bool detenerEnError)
+{
+    int errores = 0;
+    int numeroLinea = 0;
+    std::string linea;
+    std::vector<std::string> tokens;
+
+    while (std::getline(in, linea)) {
+        lineaActual = ++numeroLinea;
+        std::string error;
+        if (!tokenizar(linea, tokens, error)) {
+            reportar(false, "script", error);
+            ++errores;
+        } else if (!tokens.empty() && tokens.front().front() != '#' && !ejecutar(tokens)) {
+            ++errores;
+        }
+
+        if (errores > 0 && detenerEnError) {
+            break;
+        }
+    }
+
+    lineaActual = 0;
+    return errores;
+}
+
+bool BatchRunner::finalizar()
+{
+    if (!requiereSincronizar) {
+        return true;
+    }
+
+    std::string mensaje;
+    if (!sincronizarTienda(mensaje)) {
+        reportar(false, "sincronizar", mensaje);
+        return false;
+    }
+
+    return true;
+}
+
+void BatchRunner::imprimirAyuda(std::ostream& out)
+{
+    out << "Uso:\n"
+           "  PapayaStore                          menu interactivo\n"
+           "  PapayaStore <comando> [clave=valor]  ejecuta un comando\n"
+           "  PapayaStore --batch <archivo|->      ejecuta un comando por linea\n"
+           "      [--detener-en-error]             termina en el primer error\n"
+           "  PapayaStore --servidor [--socket r]   atiende clientes en un socket local\n"
+           "  PapayaStore --cliente [--socket r] <comando|--batch archivo>\n"
+           "                                       envia comandos al servidor\n"
+           "\n"
+           "Comandos:\n"
+           "  producto-crear nombre= codigo= precio= stock= stockMinimo= proveedor= "
+           "[descripcion=]\n"
+           "  proveedor-crear nombre= rif= telefono= email= direccion=\n"
+           "  cliente-crear nombre= cedula= telefono= email= direccion=\n"
+           "  importar-productos|importar-proveedores|importar-clientes archivo=<csv>\n"
+           "  compra proveedor= items=ID:CANT[,ID:CANT...] [descripcion=]\n"
+           "  venta cliente= items=ID:CANT[,ID:CANT...] [descripcion=]\n"
+           "  cancelar id=\n"
+           "  exportar entidad=productos|proveedores|clientes|transacciones formato=csv|jsonl "
+           "archivo=\n"
+           "      [desde=AAAA-MM-DD] [hasta=AAAA-MM-DD]  (transacciones) dias inclusive, UTC\n"
+           "  archivar [meses=3]                   comprime las transacciones de meses cerrados\n"
+           "  backup [tipo=completo|incremental] [formato=dedup|comprimido|plano]\n"
+           "  backup-extraer destino=<directorio vacio> [id=<backup>]\n"
+           "  backup-restaurar [id=<backup>]\n"
+           "  backup-retener [ultimos=] [horas=] [dias=] [meses=]\n"
+           "  integridad | stock-critico | contencion | tareas | sincronizar | ayuda\n"
+           "  producto id=                         (solo --cliente) consulta un producto\n"
+           "\n"
+           "Los valores con espacios van entre comillas dobles: nombre=\"Papaya roja\".\n"
+           "Los CSV de importacion llevan encabezado con los mismos nombres de argumento.\n"
+           "`contencion` muestra esperas/total de locks de lectura, escritura y latches, y las\n"
+           "esperas por flocks tomados por otros procesos.\n"
+           "`tareas` muestra los ultimos trabajos repartidos en hilos (integridad, reportes,\n"
+           "exportaciones): tramos, duracion, suma de los tramos y la aceleracion obtenida.\n"
+           "`backup` guarda por defecto fragmentos de 64 KiB deduplicados entre todos los\n"
+           "backups (tipo=completo los vuelve a leer todos). Comprimido o plano guarda solo los\n"
+           "bloques cambiados desde el backup anterior; cada 24 incrementales, o con\n"
+           "tipo=completo, copia los archivos enteros. `backup-extraer` reconstruye los .bin de\n"
+           "un backup (el ultimo si no se indica id) aplicando su cadena de incrementales.\n"
+           "`backup-restaurar` reemplaza los datos por los de un backup despues de verificar\n"
+           "sumas, headers y registros. `backup-retener` conserva los ultimos N backups y el\n"
+           "ultimo de cada una de las N horas/dias/meses mas recientes, borra el resto y los\n"
+           "fragmentos que ya no usa ninguno.\n"
+           "`archivar` deja sin comprimir el mes en curso y los meses-1 anteriores; los meses\n"
+           "archivados se siguen leyendo y exportando, pero sus transacciones no se cancelan.\n";
+}
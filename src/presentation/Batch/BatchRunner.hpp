@@ -0,0 +1,135 @@
+#pragma once
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include "domain/HeaderFile.hpp"
+#include "domain/repositories/AppRepositories.hpp"
+#include "domain/services/TransaccionService.hpp"
+#include "presentation/Batch/ImportadorCsv.hpp"
+
+/**
+ * @brief - Modo no interactivo: ejecuta comandos contra los repositorios sin prompts ni colores.
+ *
+ * Cada comando es una linea `comando clave=valor ...` (los valores con espacios van entre
+ * comillas dobles). La salida es una linea `OK`/`ERROR` por comando, escrita sin flush por linea.
+ * Las validaciones de unicidad usan indices en memoria construidos con una pasada por archivo;
+ * cada comando compara el header de los archivos con el de la carga y recarga el indice si otro
+ * proceso dio altas o bajas. La sincronizacion de tienda se ejecuta una sola vez al terminar.
+ */
+class BatchRunner
+{
+   private:
+    /// Nombres normalizados y claves unicas (codigo, cedula o rif) de una entidad.
+    struct IndiceUnicidad {
+        const char* entidad{nullptr};
+        const char* descripcionClave{nullptr};
+        bool cargado{false};
+        /// Header del archivo que refleja el indice: si otro proceso da altas o bajas cambia y
+        /// el indice se vuelve a cargar.
+        int proximoID{0};
+        int registrosActivos{0};
+        std::unordered_set<std::string> nombres{};
+        std::unordered_set<std::string> claves{};
+
+        /// Cargado y sin altas ni bajas en el archivo desde entonces.
+        bool vigente(const HeaderFile& header) const;
+        /// Vacia el indice para cargarlo de nuevo con el archivo de `header`.
+        void reiniciar(const HeaderFile& header);
+        /// Cuenta altas propias ya guardadas, para no recargar por ellas.
+        void contarAltas(int nuevoProximoID, int altas);
+
+        /// Valida que nombre y clave no existan, sin registrarlos.
+        bool disponible(const std::string& nombre, const std::string& clave,
+                        std::string& outError) const;
+        /// Registra nombre y clave de un registro ya guardado.
+        void agregar(const std::string& nombre, const std::string& clave);
+        /// disponible() y agregar(): valida las filas de un lote contra las anteriores.
+        bool registrar(const std::string& nombre, const std::string& clave, std::string& outError);
+    };
+
+    AppRepositories& repositories;
+    TransaccionService servicio;
+    std::ostream& out;
+
+    IndiceUnicidad indiceProductos{"producto", "el codigo ingresado"};
+    IndiceUnicidad indiceProveedores{"proveedor", "el RIF ingresado"};
+    IndiceUnicidad indiceClientes{"cliente", "la cedula ingresada"};
+    /// IDs de proveedores activos, para validar productos importados sin leer por ID.
+    std::unordered_set<int> proveedoresActivos;
+    bool requiereSincronizar{false};
+    int lineaActual{0};
+
+    /// Escribe `OK comando: mensaje` o `ERROR [linea N] comando: mensaje`.
+    void reportar(bool ok, const std::string& comando, const std::string& mensaje);
+
+    bool cargarIndices(std::string& outError);
+    void invalidarIndices();
+
+    bool crearProducto(const ArgumentosBatch& args, std::string& outMensaje);
+    bool crearProveedor(const ArgumentosBatch& args, std::string& outMensaje);
+    bool crearCliente(const ArgumentosBatch& args, std::string& outMensaje);
+    bool importarProductos(const ArgumentosBatch& args, std::string& outMensaje);
+    bool importarProveedores(const ArgumentosBatch& args, std::string& outMensaje);
+    bool importarClientes(const ArgumentosBatch& args, std::string& outMensaje);
+    bool registrarTransaccion(TipoDeTransaccion tipo, const ArgumentosBatch& args,
+                              std::string& outMensaje);
+    bool cancelarTransaccion(const ArgumentosBatch& args, std::string& outMensaje);
+
+    /// Importa un CSV: conversion en paralelo, validacion secuencial y un solo guardarLote.
+    template <typename T, typename Repositorio, typename Validar>
+    bool importar(const char* comando, const ArgumentosBatch& args, Repositorio& repositorio,
+                  IndiceUnicidad& indice, const ImportadorCsv::Constructor<T>& construir,
+                  Validar validar, std::string& outMensaje);
+
+    bool exportar(const ArgumentosBatch& args, std::string& outMensaje);
+    bool verificarIntegridad(std::string& outMensaje);
+    bool reporteStockCritico(std::string& outMensaje);
+    /// Esperas sobre adquisiciones totales de locks por entidad, desde el inicio del proceso.
+    bool reporteContencion(std::string& outMensaje);
+    bool reporteTareas(std::string& outMensaje);
+    bool crearBackup(const ArgumentosBatch& args, std::string& outMensaje);
+    bool extraerBackup(const ArgumentosBatch& args, std::string& outMensaje);
+    bool restaurarBackup(const ArgumentosBatch& args, std::string& outMensaje);
+    bool aplicarRetencion(const ArgumentosBatch& args, std::string& outMensaje);
+    bool archivarTransacciones(const ArgumentosBatch& args, std::string& outMensaje);
+    bool sincronizarTienda(std::string& outMensaje);
+
+   public:
+    BatchRunner(AppRepositories& repositories, std::ostream& out);
+
+    /// Construyen la entidad desde argumentos `clave=valor`, sin ID ni validacion de unicidad.
+    static bool construirProducto(const ArgumentosBatch& args, Producto& outProducto,
+                                  std::string& outError);
+    static bool construirProveedor(const ArgumentosBatch& args, Proveedor& outProveedor,
+                                   std::string& outError);
+    static bool construirCliente(const ArgumentosBatch& args, Cliente& outCliente,
+                                 std::string& outError);
+
+    /// Divide una linea en tokens respetando comillas dobles.
+    static bool tokenizar(const std::string& linea, std::vector<std::string>& outTokens,
+                          std::string& outError);
+
+    /// Parsea `ID:CANTIDAD[,ID:CANTIDAD...]`; el precio lo completa TransaccionService.
+    static bool parsearItems(const std::string& texto, std::vector<TransaccionDTO>& outItems,
+                             std::string& outError);
+
+    /// Registra una venta con el servicio compartido; la tienda se sincroniza en finalizar().
+    std::variant<ResultadoTransaccion, std::string> registrarVenta(
+        int idCliente, std::vector<TransaccionDTO> items, const std::string& descripcion);
+
+    /// Ejecuta un comando ya tokenizado; retorna false si fallo.
+    bool ejecutar(const std::vector<std::string>& tokens);
+
+    /// Ejecuta un comando por linea (ignora vacias y comentarios '#'); retorna cantidad de errores.
+    int ejecutarScript(std::istream& in, bool detenerEnError);
+
+    /// Sincroniza contadores de tienda si algun comando modifico datos.
+    bool finalizar();
+
+    static void imprimirAyuda(std::ostream& out);
+};
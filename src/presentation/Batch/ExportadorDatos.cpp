@@ -0,0 +1,402 @@
+#include "ExportadorDatos.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "domain/services/TransaccionService.hpp"
+#include "domain/utils/EjecutorTareas.hpp"
+#include "domain/utils/Versiones.hpp"
+
+namespace {
+
+/// Tramos por hilo en cada ola: da margen al robo de trabajo sin retener todo el archivo.
+constexpr std::size_t TRAMOS_POR_HILO = 2;
+
+/**
+ * Acumula en memoria las filas de un tramo del recorrido.
+ * Los campos se escriben en el orden de las columnas declaradas en el constructor.
+ */
+class EscritorFilas
+{
+   private:
+    FormatoExportacion formato;
+    std::vector<std::string_view> columnas;
+    std::string buffer;
+    std::size_t columna{0};
+    std::int64_t filas{0};
+
+    void separador()
+    {
+        if (formato == CSV) {
+            if (columna > 0) {
+                buffer += ',';
+            }
+        } else {
+            buffer += columna == 0 ? "{\"" : ",\"";
+            buffer += columnas[columna];
+            buffer += "\":";
+        }
+        ++columna;
+    }
+
+    void escaparCsv(std::string_view valor)
+    {
+        if (valor.find_first_of(",\"\r\n") == std::string_view::npos) {
+            buffer += valor;
+            return;
+        }
+
+        buffer += '"';
+        for (const char c : valor) {
+            if (c == '"') {
+                buffer += '"';
+            }
+            buffer += c;
+        }
+        buffer += '"';
+    }
+
+    void escaparJson(std::string_view valor)
+    {
+        buffer += '"';
+        for (const char c : valor) {
+            switch (c) {
+                case '"':
+                    buffer += "\\\"";
+                    break;
+                case '\\':
+                    buffer += "\\\\";
+                    break;
+                case '\n':
+                    buffer += "\\n";
+                    break;
+                case '\r':
+                    buffer += "\\r";
+                    break;
+                case '\t':
+                    buffer += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escape[8];
+                        std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+                        buffer += escape;
+                    } else {
+                        buffer += c;
+                    }
+            }
+        }
+        buffer += '"';
+    }
+
+   public:
+    EscritorFilas(FormatoExportacion formato, std::vector<std::string_view> columnas)
+        : formato(formato), columnas(std::move(columnas))
+    {
+    }
+
+    /// Fila de nombres de columna; solo CSV la lleva.
+    void encabezado()
+    {
+        if (formato == CSV) {
+            for (const std::string_view nombre : columnas) {
+                separador();
+                buffer += nombre;
+            }
+            buffer += '\n';
+            columna = 0;
+        }
+    }
+
+    void texto(const char* valor)
+    {
+        separador();
+        const std::string_view vista = valor != nullptr ? valor : "";
+        if (formato == CSV) {
+            escaparCsv(vista);
+        } else {
+            escaparJson(vista);
+        }
+    }
+
+    void numero(std::int64_t valor)
+    {
+        separador();
+        buffer += std::to_string(valor);
+    }
+
+    void monto(Money valor)
+    {
+        separador();
+        buffer += valor.toString();
+    }
+
+    /// Fecha en UTC con formato ISO 8601 (2026-10-18T14:05:00Z).
+    void fecha(std::chrono::system_clock::time_point valor)
+    {
+        const auto dia = std::chrono::floor<std::chrono::days>(valor);
+        const std::chrono::year_month_day ymd{dia};
+        const std::chrono::hh_mm_ss hora{std::chrono::floor<std::chrono::seconds>(valor - dia)};
+
+        char iso[32];
+        std::snprintf(iso, sizeof(iso), "%04d-%02u-%02uT%02d:%02d:%02dZ", int(ymd.year()),
+                      unsigned(ymd.month()), unsigned(ymd.day()),
+                      static_cast<int>(hora.hours().count()),
+                      static_cast<int>(hora.minutes().count()),
+                      static_cast<int>(hora.seconds().count()));
+        separador();
+        if (formato == JSONL) {
+            buffer += '"';
+        }
+        buffer += iso;
+        if (formato == JSONL) {
+            buffer += '"';
+        }
+    }
+
+    void finFila()
+    {
+        if (formato == JSONL) {
+            buffer += '}';
+        }
+        buffer += '\n';
+        columna = 0;
+        ++filas;
+    }
+
+    void vaciar(std::ostream& out)
+    {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+    std::int64_t filasEscritas() const { return filas; }
+};
+
+/**
+ * Exporta [1, proximoID) (o solo `rango`, si se indica) en olas de tramos: los tramos de una ola
+ * se leen y formatean en paralelo en el EjecutorTareas, cada uno en su propio EscritorFilas, y se
+ * escriben en orden de ID antes de pasar a la siguiente ola. Todo el trabajo queda como una sola
+ * Medicion.
+ */
+template <typename T, typename Repositorio, typename Fila>
+std::variant<std::int64_t, std::string> exportarPorTramos(
+    const std::string& entidad, Repositorio& repositorio, FormatoExportacion formato,
+    std::initializer_list<std::string_view> nombresColumnas, std::ostream& out,
+    const Fila& escribirFila, std::optional<RangoIds> rango = std::nullopt)
+{
+    using Reloj = std::chrono::steady_clock;
+    const auto inicio = Reloj::now();
+    if (!rango) {
+        auto headerResult = repositorio.obtenerEstadisticas();
+        if (std::holds_alternative<std::string>(headerResult)) {
+            return std::get<std::string>(headerResult);
+        }
+        rango = RangoIds{1, std::get<HeaderFile>(headerResult).proximoID};
+    }
+    const int proximoID = rango->hasta;
+
+    const std::vector<std::string_view> columnas(nombresColumnas);
+    EscritorFilas encabezado(formato, columnas);
+    encabezado.encabezado();
+    encabezado.vaciar(out);
+
+    EjecutorTareas& ejecutor = EjecutorTareas::global();
+    const int registrosPorOla = static_cast<int>(TRAMOS_POR_HILO * (ejecutor.cantidadHilos() + 1)) *
+                                EjecutorTareas::REGISTROS_POR_TRAMO;
+    EjecutorTareas::Medicion total;
+    total.nombre = "exportar " + entidad;
+    std::int64_t filas = 0;
+    std::string error;
+    std::vector<EscritorFilas> escritores;
+    for (int desde = rango->desde; desde < proximoID && error.empty(); desde += registrosPorOla) {
+        const int hasta = std::min(proximoID, desde + registrosPorOla);
+        escritores.assign(EjecutorTareas::cantidadTramos(desde, hasta),
+                          EscritorFilas(formato, columnas));
+        try {
+            const EjecutorTareas::Medicion ola = ejecutor.paraCadaTramo(
+                total.nombre, desde, hasta,
+                [&](std::size_t tramo, int desdeTramo, int hastaTramo) {
+                    EscritorFilas& escritor = escritores[tramo];
+                    auto scan = repositorio.recorrerDesde(desdeTramo, [&](const T& registro) {
+                        if (registro.getId() >= hastaTramo) {
+                            return false;
+                        }
+                        escribirFila(escritor, registro);
+                        return true;
+                    });
+                    if (std::holds_alternative<std::string>(scan)) {
+                        throw std::runtime_error(std::get<std::string>(scan));
+                    }
+                },
+                false);
+            total.tramos += ola.tramos;
+            total.msTrabajo += ola.msTrabajo;
+            total.msTramoMaximo = std::max(total.msTramoMaximo, ola.msTramoMaximo);
+        } catch (const std::exception& e) {
+            error = e.what();
+            break;
+        }
+
+        for (EscritorFilas& escritor : escritores) {
+            escritor.vaciar(out);
+            filas += escritor.filasEscritas();
+        }
+    }
+
+    total.msTotal = std::chrono::duration<double, std::milli>(Reloj::now() - inicio).count();
+    ejecutor.registrar(total);
+    if (!error.empty()) {
+        return error;
+    }
+
+    return filas;
+}
+
+}  // namespace
+
+ExportadorDatos::ExportadorDatos(AppRepositories& repositories) : repositories(repositories) {}
+
+bool ExportadorDatos::parsearFormato(const std::string& texto, FormatoExportacion& outFormato)
+{
+    if (texto == "csv") {
+        outFormato = CSV;
+        return true;
+    }
+
+    if (texto == "jsonl") {
+        outFormato = JSONL;
+        return true;
+    }
+
+    return false;
+}
+
+std::variant<std::int64_t, std::string> ExportadorDatos::exportar(
+    const std::string& entidad, FormatoExportacion formato, std::ostream& out,
+    const std::optional<PeriodoExportacion>& periodo)
+{
+    if (periodo && entidad != "transacciones") {
+        return "Solo las transacciones se exportan por periodo";
+    }
+
+    // el archivo exportado refleja un unico punto en el tiempo aunque haya ventas en paralelo
+    const auto instantanea = ControlVersiones::global().abrir();
+    const LecturaEnInstantanea lectura(instantanea);
+    std::variant<std::int64_t, std::string> resultado;
+
+    if (entidad == "productos") {
+        resultado = exportarPorTramos<Producto>(
+            entidad, repositories.productos, formato,
+            {"id", "codigo", "nombre", "descripcion", "precio", "stock", "stockMinimo",
+             "proveedor", "totalVendido", "fechaCreacion"},
+            out, [](EscritorFilas& escritor, const Producto& producto) {
+                escritor.numero(producto.getId());
+                escritor.texto(producto.getCodigo());
+                escritor.texto(producto.getNombre());
+                escritor.texto(producto.getDescripcion());
+                escritor.monto(producto.getPrecio());
+                escritor.numero(producto.getStock());
+                escritor.numero(producto.getStockMinimo());
+                escritor.numero(producto.getIdProveedor());
+                escritor.numero(producto.getTotalVendido());
+                escritor.fecha(producto.getFechaCreacion());
+                escritor.finFila();
+            });
+    } else if (entidad == "proveedores") {
+        resultado = exportarPorTramos<Proveedor>(
+            entidad, repositories.proveedores, formato,
+            {"id", "nombre", "rif", "telefono", "email", "direccion", "fechaCreacion"}, out,
+            [](EscritorFilas& escritor, const Proveedor& proveedor) {
+                escritor.numero(proveedor.getId());
+                escritor.texto(proveedor.getNombre());
+                escritor.texto(proveedor.getRif());
+                escritor.texto(proveedor.getTelefono());
+                escritor.texto(proveedor.getEmail());
+                escritor.texto(proveedor.getDireccion());
+                escritor.fecha(proveedor.getFechaCreacion());
+                escritor.finFila();
+            });
+    } else if (entidad == "clientes") {
+        resultado = exportarPorTramos<Cliente>(
+            entidad, repositories.clientes, formato,
+            {"id", "nombre", "cedula", "telefono", "email", "direccion", "totalCompras",
+             "cantidadTransacciones", "fechaCreacion"},
+            out, [](EscritorFilas& escritor, const Cliente& cliente) {
+                escritor.numero(cliente.getId());
+                escritor.texto(cliente.getNombre());
+                escritor.texto(cliente.getCedula());
+                escritor.texto(cliente.getTelefono());
+                escritor.texto(cliente.getEmail());
+                escritor.texto(cliente.getDireccion());
+                escritor.monto(cliente.getTotalCompras());
+                escritor.numero(cliente.getCantidadTransacciones());
+                escritor.fecha(cliente.getFechaCreacion());
+                escritor.finFila();
+            });
+    } else if (entidad == "transacciones") {
+        // con periodo: solo los IDs de las particiones de esas fechas
+        std::optional<RangoIds> rango;
+        if (periodo) {
+            auto rangoResult =
+                repositories.transacciones.rangoEntreFechas(periodo->desde, periodo->hasta);
+            if (std::holds_alternative<std::string>(rangoResult)) {
+                return std::get<std::string>(rangoResult);
+            }
+            rango = std::get<RangoIds>(rangoResult);
+        }
+
+        resultado = exportarPorTramos<Transaccion>(
+            entidad, repositories.transacciones, formato,
+            {"id", "tipo", "idRelacionado", "fecha", "total", "descripcion", "productoId",
+             "cantidad", "precio"},
+            out,
+            [&periodo](EscritorFilas& escritor, const Transaccion& transaccion) {
+                if (periodo && (transaccion.getFechaCreacion() < periodo->desde ||
+                                transaccion.getFechaCreacion() >= periodo->hasta)) {
+                    return;
+                }
+
+                std::vector<TransaccionDTO> items;
+                std::string itemsError;
+                if (!TransaccionService::obtenerItems(transaccion, items, itemsError)) {
+                    throw std::runtime_error("Transaccion " + std::to_string(transaccion.getId()) +
+                                             ": " + itemsError);
+                }
+
+                for (const TransaccionDTO& item : items) {
+                    escritor.numero(transaccion.getId());
+                    escritor.texto(transaccion.getTipoTransaccion() == VENTA ? "VENTA" : "COMPRA");
+                    escritor.numero(transaccion.getIdRelacionado());
+                    escritor.fecha(transaccion.getFechaCreacion());
+                    escritor.monto(transaccion.getTotal());
+                    escritor.texto(transaccion.getDescripcion());
+                    escritor.numero(item.productoId);
+                    escritor.numero(item.cantidad);
+                    escritor.monto(item.precio);
+                    escritor.finFila();
+                }
+            },
+            rango);
+    } else {
+        return "Entidad desconocida: " + entidad +
+               " (use productos, proveedores, clientes o transacciones)";
+    }
+
+    if (std::holds_alternative<std::string>(resultado)) {
+        return resultado;
+    }
+
+    if (!out) {
+        return "Error escribiendo la exportacion";
+    }
+
+    return resultado;
+}
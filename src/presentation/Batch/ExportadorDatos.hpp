@@ -0,0 +1,41 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <variant>
+
+#include "domain/repositories/AppRepositories.hpp"
+
+enum FormatoExportacion { CSV, JSONL };
+
+/// Intervalo [desde, hasta) de fechas de creacion; solo acota transacciones.
+struct PeriodoExportacion {
+    std::chrono::system_clock::time_point desde;
+    std::chrono::system_clock::time_point hasta;
+};
+
+/**
+ * @brief - Exportacion de los archivos de entidades a CSV o JSON Lines.
+ *
+ * Los registros activos se leen y formatean por tramos en paralelo (EjecutorTareas) y los tramos
+ * se escriben en orden de ID por olas, por lo que la memoria usada no depende del tamano del
+ * archivo. Las transacciones se aplanan: una fila por item con los datos de la transaccion
+ * repetidos; con un periodo se recorren solo las particiones de esas fechas.
+ */
+class ExportadorDatos
+{
+   private:
+    AppRepositories& repositories;
+
+   public:
+    explicit ExportadorDatos(AppRepositories& repositories);
+
+    static bool parsearFormato(const std::string& texto, FormatoExportacion& outFormato);
+
+    /// Exporta `productos`, `proveedores`, `clientes` o `transacciones`; retorna filas escritas.
+    std::variant<std::int64_t, std::string> exportar(
+        const std::string& entidad, FormatoExportacion formato, std::ostream& out,
+        const std::optional<PeriodoExportacion>& periodo = std::nullopt);
+};
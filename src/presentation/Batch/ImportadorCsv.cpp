@@ -0,0 +1,93 @@
+#include "ImportadorCsv.hpp"
+
+#include <fstream>
+
+bool ImportadorCsv::cargarArchivo(const std::string& ruta, ArchivoCsv& outArchivo,
+                                  std::string& outError)
+{
+    std::ifstream file(ruta, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        outError = "No se pudo abrir el archivo: " + ruta;
+        return false;
+    }
+
+    const std::streamsize tamano = file.tellg();
+    outArchivo.contenido.resize(static_cast<std::size_t>(tamano));
+    file.seekg(0, std::ios::beg);
+    if (!file.read(outArchivo.contenido.data(), tamano)) {
+        outError = "No se pudo leer el archivo: " + ruta;
+        return false;
+    }
+
+    const std::string_view contenido = outArchivo.contenido;
+    outArchivo.registros.clear();
+    std::size_t inicio = 0;
+    int linea = 1;
+    while (inicio < contenido.size()) {
+        // un salto de linea entre comillas es parte del campo, no fin del registro
+        bool enComillas = false;
+        int saltos = 0;
+        std::size_t fin = inicio;
+        for (; fin < contenido.size(); ++fin) {
+            if (contenido[fin] == '"') {
+                enComillas = !enComillas;
+            } else if (contenido[fin] == '\n') {
+                if (!enComillas) {
+                    break;
+                }
+                ++saltos;
+            }
+        }
+
+        std::string_view registro = contenido.substr(inicio, fin - inicio);
+        if (!registro.empty() && registro.back() == '\r') {
+            registro.remove_suffix(1);
+        }
+
+        outArchivo.registros.push_back({registro, linea});
+        linea += saltos + 1;
+        inicio = fin + 1;
+    }
+
+    if (outArchivo.registros.empty()) {
+        outError = "El archivo esta vacio (se requiere una linea de encabezado)";
+        return false;
+    }
+
+    return true;
+}
+
+bool ImportadorCsv::dividirCampos(std::string_view linea, std::vector<std::string>& outCampos,
+                                  std::string& outError)
+{
+    outCampos.clear();
+    outCampos.emplace_back();
+    bool enComillas = false;
+
+    for (std::size_t i = 0; i < linea.size(); ++i) {
+        const char c = linea[i];
+        if (enComillas) {
+            if (c == '"' && i + 1 < linea.size() && linea[i + 1] == '"') {
+                outCampos.back() += '"';
+                ++i;
+            } else if (c == '"') {
+                enComillas = false;
+            } else {
+                outCampos.back() += c;
+            }
+        } else if (c == '"') {
+            enComillas = true;
+        } else if (c == ',') {
+            outCampos.emplace_back();
+        } else {
+            outCampos.back() += c;
+        }
+    }
+
+    if (enComillas) {
+        outError = "Comillas sin cerrar";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// Argumentos `clave=valor` de un comando batch o de una fila CSV (columna -> valor).
+using ArgumentosBatch = std::unordered_map<std::string, std::string>;
+
+/// Fila de datos de un CSV convertida a entidad, o con el motivo por el que se rechazo.
+template <typename T>
+struct FilaImportada {
+    int linea{0};
+    bool valida{false};
+    T entidad{};
+    std::string error;
+};
+
+/**
+ * @brief - Lectura de archivos CSV para importacion masiva.
+ *
+ * La primera linea nombra las columnas (mismos nombres que los argumentos del comando de
+ * creacion) y cada linea siguiente es un registro; los campos pueden ir entre comillas dobles
+ * con `""` como comilla escapada, y entre comillas pueden tener saltos de linea. El archivo se lee completo y las filas se convierten a
+ * entidades en varios hilos; la validacion contra los repositorios queda a cargo del llamador.
+ */
+class ImportadorCsv
+{
+   private:
+    /// Un registro sin el salto de linea final y la linea del archivo en la que empieza.
+    struct RegistroCsv {
+        std::string_view texto;
+        int linea{0};
+    };
+
+    /// Contenido del archivo y sus registros; registros[0] es el encabezado.
+    struct ArchivoCsv {
+        std::string contenido;
+        std::vector<RegistroCsv> registros;
+    };
+
+    static bool cargarArchivo(const std::string& ruta, ArchivoCsv& outArchivo,
+                              std::string& outError);
+
+   public:
+    /// Construye la entidad desde los valores de una fila; no debe acceder a repositorios.
+    template <typename T>
+    using Constructor = std::function<bool(const ArgumentosBatch&, T&, std::string&)>;
+
+    /// Divide un registro CSV en campos respetando comillas dobles.
+    static bool dividirCampos(std::string_view linea, std::vector<std::string>& outCampos,
+                              std::string& outError);
+
+    /// Convierte cada fila del archivo en una entidad; retorna false solo si no se pudo leer.
+    template <typename T>
+    static bool leerArchivo(const std::string& ruta, const Constructor<T>& construir,
+                            std::vector<FilaImportada<T>>& outFilas, std::string& outError)
+    {
+        ArchivoCsv archivo;
+        if (!cargarArchivo(ruta, archivo, outError)) {
+            return false;
+        }
+
+        std::vector<std::string> columnas;
+        if (!dividirCampos(archivo.registros.front().texto, columnas, outError)) {
+            outError = "Encabezado invalido: " + outError;
+            return false;
+        }
+
+        const std::size_t totalFilas = archivo.registros.size() - 1;
+        outFilas.assign(totalFilas, FilaImportada<T>{});
+
+        const std::size_t hilos = std::clamp<std::size_t>(
+            std::thread::hardware_concurrency(), 1, std::max<std::size_t>(1, totalFilas / 1024));
+        const std::size_t porHilo = (totalFilas + hilos - 1) / hilos;
+
+        // cada hilo escribe solo su rango de outFilas, sin estado compartido mutable
+        auto convertirRango = [&](std::size_t desde, std::size_t hasta) {
+            std::vector<std::string> campos;
+            ArgumentosBatch args;
+            for (std::size_t i = desde; i < hasta; ++i) {
+                const RegistroCsv& registro = archivo.registros[i + 1];
+                if (registro.texto.empty()) {
+                    continue;
+                }
+
+                FilaImportada<T>& fila = outFilas[i];
+                fila.linea = registro.linea;
+                if (!dividirCampos(registro.texto, campos, fila.error)) {
+                    continue;
+                }
+
+                if (campos.size() != columnas.size()) {
+                    fila.error = "Cantidad de columnas distinta al encabezado";
+                    continue;
+                }
+
+                args.clear();
+                for (std::size_t c = 0; c < columnas.size(); ++c) {
+                    if (!campos[c].empty()) {
+                        args.emplace(columnas[c], std::move(campos[c]));
+                    }
+                }
+
+                fila.valida = construir(args, fila.entidad, fila.error);
+            }
+        };
+
+        std::vector<std::thread> trabajadores;
+        trabajadores.reserve(hilos);
+        for (std::size_t desde = 0; desde < totalFilas; desde += porHilo) {
+            trabajadores.emplace_back(convertirRango, desde, std::min(totalFilas, desde + porHilo));
+        }
+        for (std::thread& trabajador : trabajadores) {
+            trabajador.join();
+        }
+
+        // las lineas vacias quedan con linea 0 y no son registros
+        std::erase_if(outFilas, [](const FilaImportada<T>& fila) { return fila.linea == 0; });
+
+        return true;
+    }
+};
@@ -36,6 +36,21 @@ void CliUtils::toLowerCase(char* cadena)
     }
 }
 
+bool CliUtils::parseMoney(const std::string& input, Money& outValue, bool zeroInclusive)
+{
+    Money parsed;
+    if (!Money::parse(input, parsed)) {
+        return false;
+    }
+
+    if (!zeroInclusive && parsed == Money()) {
+        return false;
+    }
+
+    outValue = parsed;
+    return true;
+}
+
 int CliUtils::readValidId(const char* msg)
 {
     while (true) {
@@ -5,12 +5,14 @@
 #include <string>
 #include <type_traits>
 
+#include "domain/Money.hpp"
 #include "domain/constants.hpp"
 
 using namespace Constants::ASCII_CODES;
 using namespace Constants::PATHS;
 
-enum ListarPorPropiedad { PorId, PorNombre, PorAmbos };
+/// Criterio de orden de los listados paginados.
+enum ListarPorPropiedad { PorId, PorNombre, PorPrecio, PorStock };
 
 class CliUtils
 {
@@ -24,6 +26,11 @@ class CliUtils
 
     static void toLowerCase(char* cadena);
 
+    /**
+     * Parsea un monto decimal exacto (hasta 2 decimales) a centavos
+     */
+    static bool parseMoney(const std::string& input, Money& outValue, bool zeroInclusive = true);
+
     template <typename T>
     static bool readValidNumber(const char* prompt, T& outValue, const char* errorMsg,
                                 bool zeroInclusive = true)
@@ -43,6 +43,27 @@ void Menu::printError(const std::string& error) const
     std::cout << COLOR_RED << error << COLOR_RESET << std::endl;
 }
 
+ListarPorPropiedad Menu::leerOrdenListado(bool incluirPrecioStock)
+{
+    const int maxOpcion = incluirPrecioStock ? 4 : 2;
+    const char* prompt = incluirPrecioStock
+                             ? "Ordenar por (1) ID (2) Nombre (3) Precio (4) Stock: "
+                             : "Ordenar por (1) ID (2) Nombre: ";
+    while (true) {
+        int opcion = 0;
+        if (CliUtils::readValidNumber(prompt, opcion, "", false) && opcion <= maxOpcion) {
+            return static_cast<ListarPorPropiedad>(opcion - 1);
+        }
+
+        printError("Opcion invalida.");
+    }
+}
+
+bool Menu::continuarListado()
+{
+    return confirmAction("Ver siguiente pagina? (s/n): ");
+}
+
 std::variant<HeaderFile, std::string> Menu::leerHeader(const fs::path& path) const
 {
     try {
@@ -1,8 +1,12 @@
 #pragma once
+#include <cstddef>
+#include <exception>
+#include <format>
 #include <functional>
 #include <string>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 #include "domain/HeaderFile.hpp"
 #include "domain/constants.hpp"
@@ -11,6 +15,10 @@
 #include "domain/entities/proveedor/Proveedor.entity.hpp"
 #include "domain/entities/transaccion/transaccion.entity.hpp"
 #include "domain/repositories/AppRepositories.hpp"
+#include "domain/utils/Generador.hpp"
+#include "domain/utils/Paginacion.hpp"
+#include "presentation/CliUtils.hpp"
+#include "presentation/TablaRenderer.hpp"
 
 using namespace Constants::ASCII_CODES;
 
@@ -27,7 +35,7 @@ struct OpcionMenu {
 class Menu
 {
    private:
-    static constexpr int MAX_OPTIONS = 10;
+    static constexpr int MAX_OPTIONS = 16;
     std::string title{};
     int numOptions{};
     std::string texToExit{};
@@ -48,20 +56,98 @@ class Menu
     void printSuccess(const std::string& message) const;
     void printError(const std::string& error) const;
 
-    template <typename T>
-    std::variant<HeaderFile, std::string> obtenerEntidadHeader() const
+    static constexpr std::size_t TAMANO_PAGINA = 20;
+
+    /// Pide el criterio de orden; precio y stock solo se ofrecen para productos.
+    ListarPorPropiedad leerOrdenListado(bool incluirPrecioStock);
+
+    /// Pregunta si se muestra la siguiente pagina de un listado.
+    bool continuarListado();
+
+    /**
+     * Lista en orden de ID con cursor: cada pagina reanuda `generar` en el ID siguiente al ultimo
+     * mostrado y toma TAMANO_PAGINA registros, asi que solo lee los bloques que muestra.
+     * @param fila - Convierte un registro en las celdas de la tabla.
+     */
+    template <typename T, typename Repositorio, typename Fila>
+    void listarPaginadoPorId(Repositorio& repositorio, const std::string& titulo,
+                             const std::vector<TablaRenderer::Columna>& columnas, Fila fila)
+    {
+        int cursor = 1;
+        for (int numeroPagina = 1;; ++numeroPagina) {
+            TablaRenderer tabla(columnas);
+            tabla.reservar(TAMANO_PAGINA);
+            try {
+                repositorio.generar(cursor) | tomar(TAMANO_PAGINA) |
+                    paraCada([&](const T& registro) {
+                        tabla.agregarFila(fila(registro));
+                        cursor = registro.getId() + 1;
+                    });
+            } catch (const std::exception& e) {
+                printError(std::string("Error: ") + e.what());
+                return;
+            }
+
+            tabla.mostrar(std::format("--- {} - pagina {} ---", titulo, numeroPagina));
+            if (tabla.cantidadFilas() < TAMANO_PAGINA || !continuarListado()) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * Lista ordenado por (clave, id). Un solo recorrido llena un ListadoOrdenado, que ordena por
+     * tramos en archivos temporales y los mezcla; cada pagina se lee de ese archivo por posicion,
+     * asi que pasar de pagina no vuelve a recorrer el archivo de datos.
+     */
+    template <typename Clave, typename T, typename Repositorio, typename ClaveDe, typename Fila>
+    void listarPaginadoPorClave(Repositorio& repositorio, ClaveDe claveDe,
+                                const std::string& titulo,
+                                const std::vector<TablaRenderer::Columna>& columnas, Fila fila)
     {
-        if constexpr (std::is_same_v<T, Producto>) {
-            return leerHeader(Constants::PATHS::PRODUCTOS_PATH);
-        } else if constexpr (std::is_same_v<T, Proveedor>) {
-            return leerHeader(Constants::PATHS::PROVEEDORES_PATH);
-        } else if constexpr (std::is_same_v<T, Cliente>) {
-            return leerHeader(Constants::PATHS::CLIENTES_PATH);
-        } else if constexpr (std::is_same_v<T, Transaccion>) {
-            return leerHeader(Constants::PATHS::TRANSACCIONES_PATH);
+        ListadoOrdenado<Clave, T> listado(claveDe, repositorio.codecRegistros());
+        std::string error;
+        auto scan = repositorio.recorrer([&](const T& registro) {
+            auto agregado = listado.agregar(registro);
+            if (std::holds_alternative<std::string>(agregado)) {
+                error = std::get<std::string>(agregado);
+                return false;
+            }
+            return true;
+        });
+        if (std::holds_alternative<std::string>(scan)) {
+            error = std::get<std::string>(scan);
+        }
+        if (error.empty()) {
+            auto terminado = listado.terminar();
+            if (std::holds_alternative<std::string>(terminado)) {
+                error = std::get<std::string>(terminado);
+            }
+        }
+        if (!error.empty()) {
+            printError("Error: " + error);
+            return;
         }
 
-        return "Entidad no soportada para obtener header.";
+        for (std::size_t numeroPagina = 1;; ++numeroPagina) {
+            auto leida = listado.pagina(numeroPagina - 1, TAMANO_PAGINA);
+            if (std::holds_alternative<std::string>(leida)) {
+                printError("Error: " + std::get<std::string>(leida));
+                return;
+            }
+
+            const std::vector<T>& pagina = std::get<std::vector<T>>(leida);
+            TablaRenderer tabla(columnas);
+            tabla.reservar(pagina.size());
+            for (const T& registro : pagina) {
+                tabla.agregarFila(fila(registro));
+            }
+
+            tabla.mostrar(std::format("--- {} - pagina {} ---", titulo, numeroPagina));
+            if (numeroPagina * TAMANO_PAGINA >= listado.cantidad() || !continuarListado()) {
+                return;
+            }
+        }
     }
 
     std::string getTitle() { return title; }
@@ -7,6 +7,7 @@
 #include <variant>
 
 #include "domain/constants.hpp"
+#include "domain/utils/utils.hpp"
 #include "presentation/CliUtils.hpp"
 
 MenuClientes::MenuClientes(AppRepositories& repositorios, CliUtils utils) : Menu(repositorios)
@@ -169,6 +170,7 @@ void MenuClientes::crearCliente()
         return;
     }
 
+    const auto operacion = repositories.admin.iniciarOperacion();
     auto saveResult = repositories.clientes.guardar(cliente);
     if (std::holds_alternative<std::string>(saveResult)) {
         Menu::printError("Error al guardar: " + std::get<std::string>(saveResult));
@@ -296,6 +298,7 @@ void MenuClientes::actualizarCliente()
                 }
 
                 clienteActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.clientes.actualizar(id, clienteActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar nombre: " +
@@ -335,6 +338,7 @@ void MenuClientes::actualizarCliente()
                 }
 
                 clienteActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.clientes.actualizar(id, clienteActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar cedula: " +
@@ -368,6 +372,7 @@ void MenuClientes::actualizarCliente()
                 }
 
                 clienteActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.clientes.actualizar(id, clienteActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar telefono: " +
@@ -407,6 +412,7 @@ void MenuClientes::actualizarCliente()
                 }
 
                 clienteActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.clientes.actualizar(id, clienteActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar email: " +
@@ -441,6 +447,7 @@ void MenuClientes::actualizarCliente()
                 }
 
                 clienteActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.clientes.actualizar(id, clienteActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar direccion: " +
@@ -473,29 +480,33 @@ void MenuClientes::listarClientes()
         return;
     }
 
-    std::cout << std::format("{}--- Lista de Clientes ({}{}{}) ---", COLOR_CYAN, COLOR_GREEN,
-                             COLOR_YELLOW, stats.registrosActivos)
-              << std::endl;
-    std::cout << std::format("{}{:<5} | {:<20} | {:<15} | {:<15} | {:<25} | {:<20}", COLOR_YELLOW,
-                             "ID", "Nombre", "Cedula", "Telefono", "Email", "Direccion")
-              << std::endl;
-    std::cout << "---------------------------------------------------------------------------------"
-                 "----------------------------"
-              << std::endl;
-
-    for (int id = 1; id < stats.proximoID; ++id) {
-        auto result = repositories.clientes.leerPorId(id);
-        if (!std::holds_alternative<Cliente>(result)) {
-            continue;
-        }
-
-        Cliente cliente = std::get<Cliente>(result);
-        std::cout << std::format("{}{:<5} | {:<20} | {:<15} | {:<15} | {:<25} | {:<20}",
-                                 COLOR_GREEN, cliente.getId(), cliente.getNombre(),
-                                 cliente.getCedula(), cliente.getTelefono(), cliente.getEmail(),
-                                 cliente.getDireccion())
-                  << std::endl;
+    const ListarPorPropiedad orden = Menu::leerOrdenListado(false);
+    const std::string titulo = std::format("Lista de Clientes ({})", stats.registrosActivos);
+    const std::vector<TablaRenderer::Columna> columnas = {
+        {"ID", TablaRenderer::DERECHA},
+        {"Nombre", TablaRenderer::IZQUIERDA, 30},
+        {"Cedula"},
+        {"Telefono"},
+        {"Email", TablaRenderer::IZQUIERDA, 30},
+        {"Direccion", TablaRenderer::IZQUIERDA, 30},
+    };
+    auto fila = [](const Cliente& cliente) {
+        return std::vector<std::string>{std::to_string(cliente.getId()), cliente.getNombre(),
+                                        cliente.getCedula(), cliente.getTelefono(),
+                                        cliente.getEmail(), cliente.getDireccion()};
+    };
+
+    if (orden == PorNombre) {
+        Menu::listarPaginadoPorClave<std::string, Cliente>(
+            repositories.clientes,
+            [](const Cliente& cliente) {
+                return DomainUtils::normalizeName(cliente.getNombre());
+            },
+            titulo, columnas, fila);
+        return;
     }
+
+    Menu::listarPaginadoPorId<Cliente>(repositories.clientes, titulo, columnas, fila);
 }
 
 void MenuClientes::eliminarCliente()
@@ -555,6 +566,7 @@ void MenuClientes::eliminarCliente()
         return;
     }
 
+    const auto operacion = repositories.admin.iniciarOperacion();
     auto deleteResult = repositories.clientes.eliminarLogicamente(id);
     if (std::holds_alternative<std::string>(deleteResult)) {
         Menu::printError("Error al eliminar: " + std::get<std::string>(deleteResult));
@@ -7,6 +7,7 @@
 #include <variant>
 
 #include "domain/constants.hpp"
+#include "domain/utils/utils.hpp"
 #include "presentation/CliUtils.hpp"
 
 MenuProductos::MenuProductos(AppRepositories& repository, CliUtils utils) : Menu(repository)
@@ -54,12 +55,12 @@ bool MenuProductos::codigoDuplicado(const std::string& codigo, int ignoredId)
     return false;
 }
 
-void MenuProductos::readValidFloat(const char* prompt, float& outValue, const char* errorMsg,
+void MenuProductos::readValidMoney(const char* prompt, Money& outValue, const char* errorMsg,
                                    bool zeroInclusive)
 {
     while (true) {
         const std::string input = Menu::readLine(prompt);
-        if (CliUtils::parsePositiveNumber(input, outValue, zeroInclusive)) {
+        if (CliUtils::parseMoney(input, outValue, zeroInclusive)) {
             return;
         }
 
@@ -129,8 +130,8 @@ void MenuProductos::crearProducto()
         return;
     }
 
-    float precio = 0.0f;
-    readValidFloat("Ingrese el precio del producto: ", precio,
+    Money precio;
+    readValidMoney("Ingrese el precio del producto: ", precio,
                    "Precio inválido. Debe ser un numero mayor o igual a 0.", true);
 
     int stock = 0;
@@ -200,6 +201,7 @@ void MenuProductos::crearProducto()
         return;
     }
 
+    const auto operacion = repositories.admin.iniciarOperacion();
     auto saveResult = repositories.productos.guardar(producto);
     if (std::holds_alternative<std::string>(saveResult)) {
         Menu::printError("Error al guardar: " + std::get<std::string>(saveResult));
@@ -241,7 +243,8 @@ void MenuProductos::buscarProducto()
     std::cout << std::format("{}Descripcion: {}{}", COLOR_YELLOW, COLOR_GREEN,
                              producto.getDescripcion())
               << std::endl;
-    std::cout << std::format("{}Precio: {}{:.2f}", COLOR_YELLOW, COLOR_GREEN, producto.getPrecio())
+    std::cout << std::format("{}Precio: {}{}", COLOR_YELLOW, COLOR_GREEN,
+                             producto.getPrecio().toString())
               << std::endl;
     std::cout << std::format("{}Stock: {}{}", COLOR_YELLOW, COLOR_GREEN, producto.getStock())
               << std::endl;
@@ -273,8 +276,8 @@ void MenuProductos::actualizarProducto()
         std::cout << std::format("{}Descripcion: {}{}", COLOR_YELLOW, COLOR_GREEN,
                                  producto.getDescripcion())
                   << std::endl;
-        std::cout << std::format("{}Precio: {}{:.2f}", COLOR_YELLOW, COLOR_GREEN,
-                                 producto.getPrecio())
+        std::cout << std::format("{}Precio: {}{}", COLOR_YELLOW, COLOR_GREEN,
+                                 producto.getPrecio().toString())
                   << std::endl;
         std::cout << std::format("{}Stock: {}{}", COLOR_YELLOW, COLOR_GREEN, producto.getStock())
                   << std::endl;
@@ -337,6 +340,7 @@ void MenuProductos::actualizarProducto()
                 }
 
                 productoActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.productos.actualizar(id, productoActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar nombre: " +
@@ -376,6 +380,7 @@ void MenuProductos::actualizarProducto()
                 }
 
                 productoActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.productos.actualizar(id, productoActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar codigo: " +
@@ -411,6 +416,7 @@ void MenuProductos::actualizarProducto()
                 }
 
                 productoActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.productos.actualizar(id, productoActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar descripcion: " +
@@ -430,14 +436,14 @@ void MenuProductos::actualizarProducto()
                     break;
                 }
 
-                float nuevoPrecio = 0.0f;
-                if (!CliUtils::parsePositiveNumber(nuevoPrecioText, nuevoPrecio, true)) {
+                Money nuevoPrecio;
+                if (!CliUtils::parseMoney(nuevoPrecioText, nuevoPrecio, true)) {
                     Menu::printError("Precio invalido.");
                     break;
                 }
 
-                std::cout << std::format("Precio actual: {:.2f} | Nuevo precio: {:.2f}",
-                                         producto.getPrecio(), nuevoPrecio)
+                std::cout << std::format("Precio actual: {} | Nuevo precio: {}",
+                                         producto.getPrecio().toString(), nuevoPrecio.toString())
                           << std::endl;
                 if (!confirmAction("Confirma actualizacion de precio? (s/n): ")) {
                     Menu::printError("Actualizacion cancelada.");
@@ -451,6 +457,7 @@ void MenuProductos::actualizarProducto()
                 }
 
                 productoActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.productos.actualizar(id, productoActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar precio: " +
@@ -491,6 +498,7 @@ void MenuProductos::actualizarProducto()
                 }
 
                 productoActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.productos.actualizar(id, productoActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar stock: " +
@@ -532,6 +540,7 @@ void MenuProductos::actualizarProducto()
                 }
 
                 productoActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.productos.actualizar(id, productoActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar stock minimo: " +
@@ -580,6 +589,7 @@ void MenuProductos::actualizarProducto()
                 }
 
                 productoActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.productos.actualizar(id, productoActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar proveedor: " +
@@ -612,25 +622,45 @@ void MenuProductos::listarProductos()
         return;
     }
 
-    std::cout << std::format("{}--- Lista de Productos ({}{}{}) ---", COLOR_CYAN, COLOR_GREEN,
-                             COLOR_YELLOW, stats.registrosActivos)
-              << std::endl;
-    std::cout << std::format("{}{:<5} | {:<20} | {:<15} | {:<10} | {:<5}", COLOR_YELLOW, "ID",
-                             "Nombre", "Codigo", "Precio", "Stock")
-              << std::endl;
-    std::cout << "----------------------------------------------------------------" << std::endl;
-
-    for (int id = 1; id < stats.proximoID; ++id) {
-        auto result = repositories.productos.leerPorId(id);
-        if (!std::holds_alternative<Producto>(result)) {
-            continue;
-        }
-
-        const Producto& producto = std::get<Producto>(result);
-        std::cout << std::format("{}{:<5} | {:<20} | {:<15} | {:<10.2f} | {:<5}", COLOR_GREEN,
-                                 producto.getId(), producto.getNombre(), producto.getCodigo(),
-                                 producto.getPrecio(), producto.getStock())
-                  << std::endl;
+    const ListarPorPropiedad orden = Menu::leerOrdenListado(true);
+    const std::string titulo = std::format("Lista de Productos ({})", stats.registrosActivos);
+    const std::vector<TablaRenderer::Columna> columnas = {
+        {"ID", TablaRenderer::DERECHA},
+        {"Nombre", TablaRenderer::IZQUIERDA, 30},
+        {"Codigo"},
+        {"Precio", TablaRenderer::DERECHA},
+        {"Stock", TablaRenderer::DERECHA},
+    };
+    auto fila = [](const Producto& producto) {
+        return std::vector<std::string>{std::to_string(producto.getId()), producto.getNombre(),
+                                        producto.getCodigo(),
+                                        "$" + producto.getPrecio().toString(),
+                                        std::to_string(producto.getStock())};
+    };
+
+    switch (orden) {
+        case PorNombre:
+            Menu::listarPaginadoPorClave<std::string, Producto>(
+                repositories.productos,
+                [](const Producto& producto) {
+                    return DomainUtils::normalizeName(producto.getNombre());
+                },
+                titulo, columnas, fila);
+            break;
+        case PorPrecio:
+            Menu::listarPaginadoPorClave<std::int64_t, Producto>(
+                repositories.productos,
+                [](const Producto& producto) { return producto.getPrecio().cents(); }, titulo,
+                columnas, fila);
+            break;
+        case PorStock:
+            Menu::listarPaginadoPorClave<int, Producto>(
+                repositories.productos,
+                [](const Producto& producto) { return producto.getStock(); }, titulo, columnas,
+                fila);
+            break;
+        default:
+            Menu::listarPaginadoPorId<Producto>(repositories.productos, titulo, columnas, fila);
     }
 }
 
@@ -696,6 +726,7 @@ void MenuProductos::eliminarProducto()
         return;
     }
 
+    const auto operacion = repositories.admin.iniciarOperacion();
     auto deleteResult = repositories.productos.eliminarLogicamente(id);
     if (std::holds_alternative<std::string>(deleteResult)) {
         std::cout << "Error al eliminar: " << std::get<std::string>(deleteResult) << std::endl;
@@ -7,6 +7,7 @@
 #include <variant>
 
 #include "domain/constants.hpp"
+#include "domain/utils/utils.hpp"
 #include "presentation/CliUtils.hpp"
 
 MenuProveedores::MenuProveedores(AppRepositories& repositories, CliUtils utils) : Menu(repositories)
@@ -169,6 +170,7 @@ void MenuProveedores::crearProveedor()
         return;
     }
 
+    const auto operacion = repositories.admin.iniciarOperacion();
     auto saveResult = repositories.proveedores.guardar(proveedor);
     if (std::holds_alternative<std::string>(saveResult)) {
         Menu::printError("Error al guardar: " + std::get<std::string>(saveResult));
@@ -298,6 +300,7 @@ void MenuProveedores::actualizarProveedor()
                 }
 
                 proveedorActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.proveedores.actualizar(id, proveedorActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar nombre: " +
@@ -336,6 +339,7 @@ void MenuProveedores::actualizarProveedor()
                 }
 
                 proveedorActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.proveedores.actualizar(id, proveedorActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar RIF: " +
@@ -369,6 +373,7 @@ void MenuProveedores::actualizarProveedor()
                 }
 
                 proveedorActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.proveedores.actualizar(id, proveedorActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar telefono: " +
@@ -408,6 +413,7 @@ void MenuProveedores::actualizarProveedor()
                 }
 
                 proveedorActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.proveedores.actualizar(id, proveedorActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar email: " +
@@ -442,6 +448,7 @@ void MenuProveedores::actualizarProveedor()
                 }
 
                 proveedorActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
+                const auto operacion = repositories.admin.iniciarOperacion();
                 auto updateResult = repositories.proveedores.actualizar(id, proveedorActualizado);
                 if (std::holds_alternative<std::string>(updateResult)) {
                     Menu::printError("Error al actualizar direccion: " +
@@ -474,29 +481,33 @@ void MenuProveedores::listarProveedores()
         return;
     }
 
-    std::cout << std::format("{}--- Lista de Proveedores ({}{}{}) ---", COLOR_CYAN, COLOR_GREEN,
-                             COLOR_YELLOW, stats.registrosActivos)
-              << std::endl;
-    std::cout << std::format("{}{:<5} | {:<20} | {:<15} | {:<15} | {:<25} | {:<20}", COLOR_YELLOW,
-                             "ID", "Nombre", "RIF", "Telefono", "Email", "Direccion")
-              << std::endl;
-    std::cout << "---------------------------------------------------------------------------------"
-                 "----------------------------"
-              << std::endl;
-
-    for (int id = 1; id < stats.proximoID; ++id) {
-        auto result = repositories.proveedores.leerPorId(id);
-        if (!std::holds_alternative<Proveedor>(result)) {
-            continue;
-        }
-
-        Proveedor proveedor = std::get<Proveedor>(result);
-        std::cout << std::format("{}{:<5} | {:<20} | {:<15} | {:<15} | {:<25} | {:<20}",
-                                 COLOR_GREEN, proveedor.getId(), proveedor.getNombre(),
-                                 proveedor.getRif(), proveedor.getTelefono(), proveedor.getEmail(),
-                                 proveedor.getDireccion())
-                  << std::endl;
+    const ListarPorPropiedad orden = Menu::leerOrdenListado(false);
+    const std::string titulo = std::format("Lista de Proveedores ({})", stats.registrosActivos);
+    const std::vector<TablaRenderer::Columna> columnas = {
+        {"ID", TablaRenderer::DERECHA},
+        {"Nombre", TablaRenderer::IZQUIERDA, 30},
+        {"RIF"},
+        {"Telefono"},
+        {"Email", TablaRenderer::IZQUIERDA, 30},
+        {"Direccion", TablaRenderer::IZQUIERDA, 30},
+    };
+    auto fila = [](const Proveedor& proveedor) {
+        return std::vector<std::string>{std::to_string(proveedor.getId()), proveedor.getNombre(),
+                                        proveedor.getRif(), proveedor.getTelefono(),
+                                        proveedor.getEmail(), proveedor.getDireccion()};
+    };
+
+    if (orden == PorNombre) {
+        Menu::listarPaginadoPorClave<std::string, Proveedor>(
+            repositories.proveedores,
+            [](const Proveedor& proveedor) {
+                return DomainUtils::normalizeName(proveedor.getNombre());
+            },
+            titulo, columnas, fila);
+        return;
     }
+
+    Menu::listarPaginadoPorId<Proveedor>(repositories.proveedores, titulo, columnas, fila);
 }
 
 void MenuProveedores::eliminarProveedor()
@@ -556,6 +567,7 @@ void MenuProveedores::eliminarProveedor()
         return;
     }
 
+    const auto operacion = repositories.admin.iniciarOperacion();
     auto deleteResult = repositories.proveedores.eliminarLogicamente(id);
     if (std::holds_alternative<std::string>(deleteResult)) {
         Menu::printError("Error al eliminar: " + std::get<std::string>(deleteResult));
@@ -1,13 +1,19 @@
 #include "MenuReportes.hpp"
 
+#include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <format>
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "domain/constants.hpp"
 #include "domain/entities/tienda/tienda.entity.hpp"
 #include "infrastructure/datasource/EntityTraits.hpp"
+#include "presentation/CliUtils.hpp"
+#include "presentation/TablaRenderer.hpp"
 
 using std::string;
 
@@ -19,6 +25,39 @@ MenuReportes::MenuReportes(string title, string texToExit, int numOptions, AppRe
     this->setNumOptions(numOptions);
 }
 
+bool MenuReportes::leerEnteroReporte(const char* prompt, int& outValue, bool zeroInclusive)
+{
+    while (true) {
+        const std::string input = readLine(prompt);
+        if (input == "q" || input == "Q") {
+            printError("Operacion cancelada.");
+            return false;
+        }
+
+        if (CliUtils::parsePositiveNumber(input, outValue, zeroInclusive)) {
+            return true;
+        }
+
+        printError(zeroInclusive ? "Valor invalido. Debe ser un entero mayor o igual a 0."
+                                 : "Valor invalido. Debe ser un entero mayor a 0.");
+    }
+}
+
+bool MenuReportes::leerAnioReporte(int& outAnio)
+{
+    while (true) {
+        if (!leerEnteroReporte("Anio a consultar (q para cancelar): ", outAnio, false)) {
+            return false;
+        }
+
+        if (outAnio <= 9999) {
+            return true;
+        }
+
+        printError("Anio invalido. Debe estar entre 1 y 9999.");
+    }
+}
+
 void MenuReportes::verificarIntegridadReferencial()
 {
     int erroresProductosProveedor = 0;
@@ -52,14 +91,52 @@ void MenuReportes::verificarIntegridadReferencial()
 
 void MenuReportes::crearBackup()
 {
+    ResumenBackup resumen;
     try {
-        this->repositories.admin.crearBackup();
+        resumen = this->repositories.admin.crearBackup();
     } catch (const std::exception& e) {
         Menu::printError("Error al crear backup: " + std::string(e.what()));
         return;
     }
 
-    std::cout << COLOR_GREEN << "Backup creado correctamente." << COLOR_RESET << std::endl;
+    std::cout << COLOR_GREEN
+              << std::format("Backup deduplicado creado en {}: {} archivos, {} bytes en {} "
+                             "fragmentos ({} nuevos, {} bytes guardados), operaciones detenidas "
+                             "{:.1f} ms.",
+                             resumen.ruta, resumen.archivos, resumen.bytes, resumen.fragmentos,
+                             resumen.fragmentosNuevos, resumen.bytesGuardados, resumen.msPausa)
+              << COLOR_RESET << std::endl;
+}
+
+void MenuReportes::restaurarBackup()
+{
+    std::string id = readLine("Backup a restaurar (u para el ultimo, q para cancelar): ");
+    if (id == "q" || id == "Q") {
+        printError("Operacion cancelada.");
+        return;
+    }
+    if (id == "u" || id == "U") {
+        id.clear();
+    }
+    if (!confirmAction("Los datos actuales se reemplazan por los del backup. Continuar? (s/n): ")) {
+        printError("Operacion cancelada.");
+        return;
+    }
+
+    ResumenBackup resumen;
+    try {
+        resumen = this->repositories.admin.restaurarBackup(id);
+    } catch (const std::exception& e) {
+        Menu::printError("Error al restaurar backup: " + std::string(e.what()));
+        return;
+    }
+
+    std::cout << COLOR_GREEN
+              << std::format("Backup {} restaurado: {} archivos, {} bytes, {} registros "
+                             "verificados, operaciones detenidas {:.1f} ms.",
+                             resumen.ruta, resumen.archivos, resumen.bytes, resumen.registros,
+                             resumen.msPausa)
+              << COLOR_RESET << std::endl;
 }
 
 void MenuReportes::reporteStockCritico()
@@ -113,6 +190,21 @@ void MenuReportes::reporteHistorialCliente()
     }
 }
 
+void MenuReportes::reporteHistorialProducto()
+{
+    int idProducto = 0;
+    if (!leerEnteroReporte("Ingrese el id del producto (q para cancelar): ", idProducto, false)) {
+        return;
+    }
+
+    try {
+        this->repositories.admin.reporteHistorialProducto(idProducto);
+    } catch (const std::exception& e) {
+        Menu::printError("Error al generar historial del producto: " + std::string(e.what()));
+        return;
+    }
+}
+
 void MenuReportes::mostrarResumenTienda()
 {
     auto productosHeader = repositories.productos.obtenerEstadisticas();
@@ -176,21 +268,345 @@ void MenuReportes::mostrarResumenTienda()
     std::cout << std::format("{}Transacciones activas: {}{}", COLOR_YELLOW, COLOR_GREEN,
                              std::get<HeaderFile>(transaccionesHeader).registrosActivos)
               << std::endl;
-    std::cout << std::format("{}Monto total ventas: {}${:.2f}", COLOR_YELLOW, COLOR_GREEN,
-                             tienda.getMontoTotalVentas())
+    std::cout << std::format("{}Monto total ventas: {}${}", COLOR_YELLOW, COLOR_GREEN,
+                             tienda.getMontoTotalVentas().toString())
               << std::endl;
-    std::cout << std::format("{}Monto total compras: {}${:.2f}", COLOR_YELLOW, COLOR_GREEN,
-                             tienda.getMontoTotalCompras())
+    std::cout << std::format("{}Monto total compras: {}${}", COLOR_YELLOW, COLOR_GREEN,
+                             tienda.getMontoTotalCompras().toString())
               << std::endl;
 }
 
+void MenuReportes::reporteTopProductos()
+{
+    int limite = 0;
+    if (!leerEnteroReporte("Cantidad de productos a mostrar (q para cancelar): ", limite, false)) {
+        return;
+    }
+
+    int idProveedor = 0;
+    if (!leerEnteroReporte("ID de proveedor a filtrar (0 para todos, q para cancelar): ",
+                           idProveedor, true)) {
+        return;
+    }
+
+    std::vector<Producto> top;
+    try {
+        top = this->repositories.admin.reporteTopProductosVendidos(limite, idProveedor);
+    } catch (const std::exception& e) {
+        Menu::printError("Error al generar top de productos: " + std::string(e.what()));
+        return;
+    }
+
+    if (top.empty()) {
+        Menu::printError("No hay productos para el criterio indicado.");
+        return;
+    }
+
+    TablaRenderer tabla({
+        {"#", TablaRenderer::DERECHA},
+        {"ID", TablaRenderer::DERECHA},
+        {"Nombre", TablaRenderer::IZQUIERDA, 30},
+        {"Codigo"},
+        {"Vendidos", TablaRenderer::DERECHA},
+        {"Proveedor", TablaRenderer::DERECHA},
+    });
+    tabla.reservar(top.size());
+    for (std::size_t i = 0; i < top.size(); ++i) {
+        const Producto& producto = top[i];
+        tabla.agregarFila({std::to_string(i + 1), std::to_string(producto.getId()),
+                           producto.getNombre(), producto.getCodigo(),
+                           std::to_string(producto.getTotalVendido()),
+                           std::to_string(producto.getIdProveedor())});
+    }
+
+    tabla.mostrar(std::format("--- Top {} productos mas vendidos ---", top.size()));
+}
+
+void MenuReportes::reporteTopClientes()
+{
+    int limite = 0;
+    if (!leerEnteroReporte("Cantidad de clientes a mostrar (q para cancelar): ", limite, false)) {
+        return;
+    }
+
+    std::vector<Cliente> top;
+    try {
+        top = this->repositories.admin.reporteTopClientes(limite);
+    } catch (const std::exception& e) {
+        Menu::printError("Error al generar top de clientes: " + std::string(e.what()));
+        return;
+    }
+
+    if (top.empty()) {
+        Menu::printError("No hay clientes registrados.");
+        return;
+    }
+
+    TablaRenderer tabla({
+        {"#", TablaRenderer::DERECHA},
+        {"ID", TablaRenderer::DERECHA},
+        {"Nombre", TablaRenderer::IZQUIERDA, 30},
+        {"Cedula"},
+        {"Total compras", TablaRenderer::DERECHA},
+        {"Ventas", TablaRenderer::DERECHA},
+    });
+    tabla.reservar(top.size());
+    for (std::size_t i = 0; i < top.size(); ++i) {
+        const Cliente& cliente = top[i];
+        tabla.agregarFila({std::to_string(i + 1), std::to_string(cliente.getId()),
+                           cliente.getNombre(), cliente.getCedula(),
+                           "$" + cliente.getTotalCompras().toString(),
+                           std::to_string(cliente.getCantidadTransacciones())});
+    }
+
+    tabla.mostrar(std::format("--- Top {} clientes por compras ---", top.size()));
+}
+
+void MenuReportes::reporteVentasMensuales()
+{
+    int anio = 0;
+    if (!leerAnioReporte(anio)) {
+        return;
+    }
+
+    // dos anios de rollups mensuales: 24 slots contiguos, sin recorrer transacciones
+    auto rangoResult =
+        repositories.rollups.leerRango(MENSUAL, (anio - 1) * 100 + 1, anio * 100 + 12);
+    if (std::holds_alternative<std::string>(rangoResult)) {
+        Menu::printError("Error al leer rollups mensuales: " +
+                         std::get<std::string>(rangoResult));
+        return;
+    }
+
+    RollupPeriodo meses[2][12] = {};
+    for (const RollupPeriodo& periodo : std::get<std::vector<RollupPeriodo>>(rangoResult)) {
+        const int fila = periodo.periodo / 100 == anio ? 1 : 0;
+        meses[fila][periodo.periodo % 100 - 1] = periodo;
+    }
+
+    TablaRenderer tabla({
+        {"Mes", TablaRenderer::DERECHA},
+        {"Ventas", TablaRenderer::DERECHA},
+        {"Ingresos", TablaRenderer::DERECHA},
+        {"Compras", TablaRenderer::DERECHA},
+        {"Gasto", TablaRenderer::DERECHA},
+        {"Ingresos ant.", TablaRenderer::DERECHA},
+        {"Variacion", TablaRenderer::DERECHA},
+    });
+    tabla.reservar(12);
+
+    RollupPeriodo totalActual;
+    RollupPeriodo totalAnterior;
+    for (int mes = 0; mes < 12; ++mes) {
+        const RollupPeriodo& actual = meses[1][mes];
+        const RollupPeriodo& anterior = meses[0][mes];
+        totalActual.acumular(actual);
+        totalAnterior.acumular(anterior);
+
+        std::string variacion = "N/A";
+        if (anterior.ingresosVentas.cents() != 0) {
+            const double porcentaje = static_cast<double>((actual.ingresosVentas -
+                                                           anterior.ingresosVentas)
+                                                              .cents()) *
+                                      100.0 /
+                                      static_cast<double>(anterior.ingresosVentas.cents());
+            variacion = std::format("{:+.1f}%", porcentaje);
+        }
+
+        tabla.agregarFila({std::to_string(mes + 1), std::to_string(actual.cantidadVentas),
+                           "$" + actual.ingresosVentas.toString(),
+                           std::to_string(actual.cantidadCompras),
+                           "$" + actual.gastoCompras.toString(),
+                           "$" + anterior.ingresosVentas.toString(), variacion});
+    }
+
+    tabla.agregarPie(std::format("Total {}: {} ventas por ${}, {} compras por ${}", anio,
+                                 totalActual.cantidadVentas,
+                                 totalActual.ingresosVentas.toString(),
+                                 totalActual.cantidadCompras, totalActual.gastoCompras.toString()));
+    tabla.agregarPie(std::format("Total {}: {} ventas por ${}", anio - 1,
+                                 totalAnterior.cantidadVentas,
+                                 totalAnterior.ingresosVentas.toString()));
+    tabla.mostrar(std::format("--- Ventas mensuales {} (comparado con {}) ---", anio, anio - 1));
+}
+
+void MenuReportes::reporteVentasDiarias()
+{
+    int anio = 0;
+    if (!leerAnioReporte(anio)) {
+        return;
+    }
+
+    int mes = 0;
+    while (true) {
+        if (!leerEnteroReporte("Mes a consultar (1-12, q para cancelar): ", mes, false)) {
+            return;
+        }
+        if (mes <= 12) {
+            break;
+        }
+        printError("Mes invalido. Debe estar entre 1 y 12.");
+    }
+
+    const std::chrono::year_month_day_last finDeMes{
+        std::chrono::year{anio} / std::chrono::month{static_cast<unsigned>(mes)} /
+        std::chrono::last};
+    const int ultimoDia = static_cast<int>(static_cast<unsigned>(finDeMes.day()));
+    const int claveMes = anio * 100 + mes;
+
+    auto diasResult =
+        repositories.rollups.leerRango(DIARIO, claveMes * 100 + 1, claveMes * 100 + ultimoDia);
+    if (std::holds_alternative<std::string>(diasResult)) {
+        Menu::printError("Error al leer rollups diarios: " + std::get<std::string>(diasResult));
+        return;
+    }
+
+    const auto& dias = std::get<std::vector<RollupPeriodo>>(diasResult);
+    if (dias.empty()) {
+        Menu::printError("No hay transacciones registradas en el mes indicado.");
+        return;
+    }
+
+    TablaRenderer tablaDias({
+        {"Fecha"},
+        {"Ventas", TablaRenderer::DERECHA},
+        {"Ingresos", TablaRenderer::DERECHA},
+        {"Compras", TablaRenderer::DERECHA},
+        {"Gasto", TablaRenderer::DERECHA},
+        {"Unidades", TablaRenderer::DERECHA},
+    });
+    tablaDias.reservar(dias.size());
+    for (const RollupPeriodo& dia : dias) {
+        tablaDias.agregarFila({std::format("{:04}-{:02}-{:02}", dia.periodo / 10000,
+                                           (dia.periodo / 100) % 100, dia.periodo % 100),
+                               std::to_string(dia.cantidadVentas),
+                               "$" + dia.ingresosVentas.toString(),
+                               std::to_string(dia.cantidadCompras),
+                               "$" + dia.gastoCompras.toString(),
+                               std::to_string(dia.unidadesVendidas)});
+    }
+    tablaDias.mostrar(std::format("--- Ventas diarias {:04}-{:02} ---", anio, mes));
+
+    auto productosResult = repositories.rollups.leerProductos(MENSUAL, claveMes);
+    if (std::holds_alternative<std::string>(productosResult)) {
+        Menu::printError("Error al leer unidades por producto: " +
+                         std::get<std::string>(productosResult));
+        return;
+    }
+
+    auto productos = std::get<std::vector<RollupProducto>>(std::move(productosResult));
+    std::sort(productos.begin(), productos.end(),
+              [](const RollupProducto& a, const RollupProducto& b) {
+                  if (a.unidadesVendidas != b.unidadesVendidas) {
+                      return a.unidadesVendidas > b.unidadesVendidas;
+                  }
+                  return a.productoId < b.productoId;
+              });
+
+    TablaRenderer tablaProductos({
+        {"ID", TablaRenderer::DERECHA},
+        {"Nombre", TablaRenderer::IZQUIERDA, 30},
+        {"Vendidas", TablaRenderer::DERECHA},
+        {"Compradas", TablaRenderer::DERECHA},
+        {"Ingresos", TablaRenderer::DERECHA},
+    });
+    tablaProductos.reservar(productos.size());
+    for (const RollupProducto& producto : productos) {
+        auto productoResult = repositories.productos.leerPorId(producto.productoId);
+        const std::string nombre = std::holds_alternative<Producto>(productoResult)
+                                       ? std::get<Producto>(productoResult).getNombre()
+                                       : "(no disponible)";
+        tablaProductos.agregarFila({std::to_string(producto.productoId), nombre,
+                                    std::to_string(producto.unidadesVendidas),
+                                    std::to_string(producto.unidadesCompradas),
+                                    "$" + producto.ingresosVentas.toString()});
+    }
+    tablaProductos.mostrar(std::format("--- Unidades por producto {:04}-{:02} ---", anio, mes));
+}
+
+void MenuReportes::imprimirResumenProveedores(const std::string& titulo,
+                                              const std::vector<ResumenProveedor>& filas,
+                                              const char* columnaUnidades,
+                                              const char* columnaMonto)
+{
+    TablaRenderer tabla({
+        {"ID", TablaRenderer::DERECHA},
+        {"Proveedor", TablaRenderer::IZQUIERDA, 30},
+        {"Productos", TablaRenderer::DERECHA},
+        {columnaUnidades, TablaRenderer::DERECHA},
+        {columnaMonto, TablaRenderer::DERECHA},
+    });
+    tabla.reservar(filas.size());
+
+    Money total;
+    std::int64_t totalUnidades = 0;
+    for (const ResumenProveedor& fila : filas) {
+        total += fila.monto;
+        totalUnidades += fila.unidades;
+        tabla.agregarFila({std::to_string(fila.idProveedor), fila.nombre,
+                           std::to_string(fila.productos), std::to_string(fila.unidades),
+                           "$" + fila.monto.toString()});
+    }
+
+    tabla.agregarPie(std::format("Total: {} unidades, ${}", totalUnidades, total.toString()));
+    tabla.mostrar(titulo);
+}
+
+void MenuReportes::reporteVentasPorProveedor()
+{
+    std::vector<ResumenProveedor> filas;
+    try {
+        filas = this->repositories.admin.reporteVentasPorProveedor();
+    } catch (const std::exception& e) {
+        Menu::printError("Error al generar ventas por proveedor: " + std::string(e.what()));
+        return;
+    }
+
+    if (filas.empty()) {
+        Menu::printError("No hay ventas registradas.");
+        return;
+    }
+
+    imprimirResumenProveedores("--- Ventas por proveedor ---", filas, "Vendidas", "Ingresos");
+}
+
+void MenuReportes::reporteValorInventario()
+{
+    std::vector<ResumenProveedor> filas;
+    try {
+        filas = this->repositories.admin.reporteValorInventario();
+    } catch (const std::exception& e) {
+        Menu::printError("Error al generar valor de inventario: " + std::string(e.what()));
+        return;
+    }
+
+    if (filas.empty()) {
+        Menu::printError("No hay productos registrados.");
+        return;
+    }
+
+    imprimirResumenProveedores("--- Valor de inventario por proveedor ---", filas, "Stock",
+                               "Valor");
+}
+
 void MenuReportes::showMenu()
 {
-    this->setNumOptions(5);
+    this->setNumOptions(13);
     setOption(0, "Integridad Referencial", [this]() { this->verificarIntegridadReferencial(); });
     setOption(1, "Crear Backup", [this]() { this->crearBackup(); });
     setOption(2, "Productos con stock crítico", [this]() { this->reporteStockCritico(); });
     setOption(3, "Historial de Cliente", [this]() { this->reporteHistorialCliente(); });
     setOption(4, "Resumen de Tienda", [this]() { this->mostrarResumenTienda(); });
+    setOption(5, "Top productos mas vendidos", [this]() { this->reporteTopProductos(); });
+    setOption(6, "Top clientes por compras", [this]() { this->reporteTopClientes(); });
+    setOption(7, "Ventas mensuales (comparativo anual)",
+              [this]() { this->reporteVentasMensuales(); });
+    setOption(8, "Ventas diarias y unidades por producto de un mes",
+              [this]() { this->reporteVentasDiarias(); });
+    setOption(9, "Historial de Producto", [this]() { this->reporteHistorialProducto(); });
+    setOption(10, "Ventas por proveedor", [this]() { this->reporteVentasPorProveedor(); });
+    setOption(11, "Valor de inventario por proveedor",
+              [this]() { this->reporteValorInventario(); });
+    setOption(12, "Restaurar Backup", [this]() { this->restaurarBackup(); });
     drawMenu();
 }
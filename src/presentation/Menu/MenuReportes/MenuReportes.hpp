@@ -1,18 +1,34 @@
 #pragma once
 #include <string>
+#include <vector>
 
 #include "domain/repositories/AppRepositories.hpp"
 #include "presentation/Menu/Menu.hpp"
 
 class MenuReportes : public Menu
 {
+   private:
+    bool leerEnteroReporte(const char* prompt, int& outValue, bool zeroInclusive);
+    bool leerAnioReporte(int& outAnio);
+    void imprimirResumenProveedores(const std::string& titulo,
+                                    const std::vector<ResumenProveedor>& filas,
+                                    const char* columnaUnidades, const char* columnaMonto);
+
    public:
     MenuReportes(std::string title, std::string texToExit, int numOptions, AppRepositories& repos);
     void verificarIntegridadReferencial();
     void crearBackup();
+    void restaurarBackup();
     void reporteStockCritico();
     void reporteHistorialCliente();
+    void reporteHistorialProducto();
     void mostrarResumenTienda();
+    void reporteTopProductos();
+    void reporteTopClientes();
+    void reporteVentasMensuales();
+    void reporteVentasDiarias();
+    void reporteVentasPorProveedor();
+    void reporteValorInventario();
 
     void showMenu() override;
 };
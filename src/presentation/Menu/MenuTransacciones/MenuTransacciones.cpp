@@ -10,7 +10,7 @@
 #include "presentation/CliUtils.hpp"
 
 MenuTransacciones::MenuTransacciones(AppRepositories& repositories, CliUtils utils)
-    : Menu(repositories)
+    : Menu(repositories), servicio(repositories)
 {
     this->setTitle("Gestion de Transacciones");
     this->setTexToExit("Salir");
@@ -33,131 +33,6 @@ bool MenuTransacciones::readValidCantidad(const char* prompt, int& outCantidad)
     }
 }
 
-bool MenuTransacciones::getItemsFromTransaccion(const Transaccion& transaccion,
-                                                std::vector<TransaccionDTO>& outItems,
-                                                std::string& outError)
-{
-    outItems.clear();
-    const int itemsCount = transaccion.getProductosTotales();
-    if (itemsCount <= 0) {
-        outError = "La transacción no tiene productos asociados.";
-        return false;
-    }
-
-    for (int i = 0; i < itemsCount; ++i) {
-        TransaccionDTO item{};
-        if (!transaccion.getProductoEnIndice(i, item)) {
-            outError = "No se pudo leer el item de transacción.";
-            return false;
-        }
-
-        outItems.push_back(item);
-    }
-
-    return true;
-}
-
-bool MenuTransacciones::aplicarCambiosStock(const std::vector<TransaccionDTO>& items,
-                                            bool incrementarStock, bool ajustarTotalVendido,
-                                            std::vector<Producto>& productosOriginales,
-                                            std::string& outError)
-{
-    productosOriginales.clear();
-
-    for (const auto& item : items) {
-        auto productoResult = repositories.productos.leerPorId(item.productoId);
-        if (std::holds_alternative<std::string>(productoResult)) {
-            outError = "Producto no encontrado para actualizar stock. ID: " +
-                       std::to_string(item.productoId);
-            return false;
-        }
-
-        Producto producto = std::get<Producto>(productoResult);
-        const int stockActual = producto.getStock();
-        const int totalVendidoActual = producto.getTotalVendido();
-
-        int nuevoStock = stockActual;
-        if (incrementarStock) {
-            nuevoStock += item.cantidad;
-        } else {
-            if (stockActual < item.cantidad) {
-                outError = "Stock insuficiente para producto ID " +
-                           std::to_string(item.productoId) +
-                           ". Stock actual: " + std::to_string(stockActual);
-                return false;
-            }
-            nuevoStock -= item.cantidad;
-        }
-
-        int nuevoTotalVendido = totalVendidoActual;
-        if (ajustarTotalVendido) {
-            if (incrementarStock) {
-                nuevoTotalVendido = (totalVendidoActual >= item.cantidad)
-                                        ? (totalVendidoActual - item.cantidad)
-                                        : 0;
-            } else {
-                nuevoTotalVendido += item.cantidad;
-            }
-        }
-
-        Producto productoActualizado = producto;
-        if (!productoActualizado.setStock(nuevoStock)) {
-            outError =
-                "No se pudo actualizar stock del producto ID " + std::to_string(item.productoId);
-            return false;
-        }
-
-        if (ajustarTotalVendido && !productoActualizado.setTotalVendido(nuevoTotalVendido)) {
-            outError = "No se pudo actualizar total vendido del producto ID " +
-                       std::to_string(item.productoId);
-            return false;
-        }
-
-        productoActualizado.setFechaUltimaModificacion(std::chrono::system_clock::now());
-
-        auto updateResult = repositories.productos.actualizar(item.productoId, productoActualizado);
-        if (std::holds_alternative<std::string>(updateResult)) {
-            outError = "Error al guardar cambios de stock. Producto ID " +
-                       std::to_string(item.productoId) + ": " + std::get<std::string>(updateResult);
-            return false;
-        }
-
-        productosOriginales.push_back(producto);
-    }
-
-    return true;
-}
-
-bool MenuTransacciones::rollbackStock(const std::vector<Producto>& productosOriginales)
-{
-    for (const auto& productoOriginal : productosOriginales) {
-        auto rollbackResult =
-            repositories.productos.actualizar(productoOriginal.getId(), productoOriginal);
-        if (std::holds_alternative<std::string>(rollbackResult)) {
-            return false;
-        }
-    }
-
-    return true;
-}
-
-float MenuTransacciones::calcularTotalTransaccion(const std::vector<TransaccionDTO>& items,
-                                                  std::string& outError)
-{
-    float total = 0.0f;
-    for (const auto& item : items) {
-        if (item.cantidad < 0 || item.precio < 0) {
-            outError = "Items de transaccion invalidos para calcular total.";
-            return -1.0f;
-        }
-
-        total += static_cast<float>(item.cantidad) * item.precio;
-    }
-
-    outError.clear();
-    return total;
-}
-
 void MenuTransacciones::imprimirDetalleTransaccion(const Transaccion& transaccion)
 {
     const auto tipo = transaccion.getTipoTransaccion();
@@ -178,8 +53,8 @@ void MenuTransacciones::imprimirDetalleTransaccion(const Transaccion& transaccio
     std::cout << std::format("{}ID Relacionado: {}{}", COLOR_YELLOW, COLOR_GREEN,
                              transaccion.getIdRelacionado())
               << std::endl;
-    std::cout << std::format("{}Total: {}${:.2f}", COLOR_YELLOW, COLOR_GREEN,
-                             transaccion.getTotal())
+    std::cout << std::format("{}Total: {}${}", COLOR_YELLOW, COLOR_GREEN,
+                             transaccion.getTotal().toString())
               << std::endl;
     std::cout << std::format("{}Descripcion: {}{}", COLOR_YELLOW, COLOR_GREEN,
                              transaccion.getDescripcion())
@@ -187,7 +62,7 @@ void MenuTransacciones::imprimirDetalleTransaccion(const Transaccion& transaccio
 
     std::vector<TransaccionDTO> items;
     std::string itemsError;
-    if (!getItemsFromTransaccion(transaccion, items, itemsError)) {
+    if (!TransaccionService::obtenerItems(transaccion, items, itemsError)) {
         Menu::printError(itemsError);
         return;
     }
@@ -200,11 +75,61 @@ void MenuTransacciones::imprimirDetalleTransaccion(const Transaccion& transaccio
                   << std::endl;
         std::cout << std::format("{}    Cantidad: {}{}", COLOR_YELLOW, COLOR_GREEN, item.cantidad)
                   << std::endl;
-        std::cout << std::format("{}    Precio: {}${:.2f}", COLOR_YELLOW, COLOR_GREEN, item.precio)
+        std::cout << std::format("{}    Precio: {}${}", COLOR_YELLOW, COLOR_GREEN,
+                                 item.precio.toString())
                   << std::endl;
     }
 }
 
+bool MenuTransacciones::confirmarYRegistrar(const Transaccion& borrador, const char* operacion)
+{
+    std::vector<TransaccionDTO> items;
+    std::string itemsError;
+    if (!TransaccionService::obtenerItems(borrador, items, itemsError)) {
+        Menu::printError(itemsError);
+        return false;
+    }
+
+    std::string totalError;
+    const Money total = TransaccionService::calcularTotal(items, totalError);
+    if (total.isNegative()) {
+        Menu::printError(totalError);
+        return false;
+    }
+
+    auto transHeaderResult = repositories.transacciones.obtenerEstadisticas();
+    if (std::holds_alternative<std::string>(transHeaderResult)) {
+        Menu::printError("Error: " + std::get<std::string>(transHeaderResult));
+        return false;
+    }
+
+    const int nuevoId = std::get<HeaderFile>(transHeaderResult).proximoID;
+    std::cout << std::format("Se registrara la {} ID {} por un total de ${}", operacion, nuevoId,
+                             total.toString())
+              << std::endl;
+    if (!confirmAction(std::format("Confirmar {}? (s/n): ", operacion).c_str())) {
+        Menu::printError("Operacion cancelada.");
+        return false;
+    }
+
+    const bool esVenta = borrador.getTipoTransaccion() == VENTA;
+    auto result = esVenta ? servicio.registrarVenta(borrador.getIdRelacionado(), items,
+                                                    borrador.getDescripcion())
+                          : servicio.registrarCompra(borrador.getIdRelacionado(), items,
+                                                     borrador.getDescripcion());
+    if (std::holds_alternative<std::string>(result)) {
+        Menu::printError(std::get<std::string>(result));
+        return false;
+    }
+
+    for (const std::string& advertencia : std::get<ResultadoTransaccion>(result).advertencias) {
+        Menu::printError("Advertencia: " + advertencia);
+    }
+
+    Menu::printSuccess(esVenta ? "Venta registrada con exito." : "Compra registrada con exito.");
+    return true;
+}
+
 void MenuTransacciones::registrarCompra()
 {
     const int idProveedor = CliUtils::readValidId("Ingrese el id del proveedor para la compra");
@@ -266,63 +191,7 @@ void MenuTransacciones::registrarCompra()
         }
     }
 
-    std::vector<TransaccionDTO> items;
-    std::string itemsError;
-    if (!getItemsFromTransaccion(transaccion, items, itemsError)) {
-        Menu::printError(itemsError);
-        return;
-    }
-
-    std::string totalError;
-    const float total = calcularTotalTransaccion(items, totalError);
-    if (total < 0.0f) {
-        Menu::printError(totalError);
-        return;
-    }
-    transaccion.setTotal(total);
-
-    auto transHeaderResult = repositories.transacciones.obtenerEstadisticas();
-    if (std::holds_alternative<std::string>(transHeaderResult)) {
-        Menu::printError("Error: " + std::get<std::string>(transHeaderResult));
-        return;
-    }
-
-    const int nuevoId = std::get<HeaderFile>(transHeaderResult).proximoID;
-    transaccion.setId(nuevoId);
-    transaccion.setEliminado(false);
-    transaccion.setFechaUltimaModificacion(std::chrono::system_clock::now());
-
-    std::cout << std::format("Se registrara la compra ID {} por un total de ${:.2f}", nuevoId,
-                             total)
-              << std::endl;
-    if (!confirmAction("Confirmar compra? (s/n): ")) {
-        Menu::printError("Operacion cancelada.");
-        return;
-    }
-
-    auto saveResult = repositories.transacciones.guardar(transaccion);
-    if (std::holds_alternative<std::string>(saveResult)) {
-        Menu::printError("Error al guardar transaccion: " + std::get<std::string>(saveResult));
-        return;
-    }
-
-    std::vector<Producto> productosOriginales;
-    std::string stockError;
-    if (!aplicarCambiosStock(items, true, false, productosOriginales, stockError)) {
-        repositories.transacciones.eliminarLogicamente(nuevoId);
-        rollbackStock(productosOriginales);
-        Menu::printError("Error al actualizar stock de compra: " + stockError);
-        return;
-    }
-
-    try {
-        repositories.admin.sincronizarContadoresTienda();
-    } catch (const std::exception& e) {
-        Menu::printError("Advertencia: compra registrada, pero no se pudo sincronizar tienda: " +
-                         std::string(e.what()));
-    }
-
-    Menu::printSuccess("Compra registrada con exito.");
+    confirmarYRegistrar(transaccion, "compra");
 }
 
 void MenuTransacciones::registrarVenta()
@@ -385,164 +254,7 @@ void MenuTransacciones::registrarVenta()
         }
     }
 
-    std::vector<TransaccionDTO> items;
-    std::string itemsError;
-    if (!getItemsFromTransaccion(transaccion, items, itemsError)) {
-        Menu::printError(itemsError);
-        return;
-    }
-
-    for (const auto& item : items) {
-        auto productoResult = repositories.productos.leerPorId(item.productoId);
-        if (std::holds_alternative<std::string>(productoResult)) {
-            Menu::printError("Producto invalido durante validacion final. ID: " +
-                             std::to_string(item.productoId));
-            return;
-        }
-
-        const Producto& producto = std::get<Producto>(productoResult);
-        if (producto.getStock() < item.cantidad) {
-            Menu::printError("Stock insuficiente en validacion final para producto ID " +
-                             std::to_string(item.productoId));
-            return;
-        }
-    }
-
-    std::string totalError;
-    const float total = calcularTotalTransaccion(items, totalError);
-    if (total < 0.0f) {
-        Menu::printError(totalError);
-        return;
-    }
-    transaccion.setTotal(total);
-
-    auto transHeaderResult = repositories.transacciones.obtenerEstadisticas();
-    if (std::holds_alternative<std::string>(transHeaderResult)) {
-        Menu::printError("Error: " + std::get<std::string>(transHeaderResult));
-        return;
-    }
-
-    const int nuevoId = std::get<HeaderFile>(transHeaderResult).proximoID;
-    transaccion.setId(nuevoId);
-    transaccion.setEliminado(false);
-    transaccion.setFechaUltimaModificacion(std::chrono::system_clock::now());
-
-    std::cout << std::format("Se registrara la venta ID {} por un total de ${:.2f}", nuevoId, total)
-              << std::endl;
-    if (!confirmAction("Confirmar venta? (s/n): ")) {
-        Menu::printError("Operacion cancelada.");
-        return;
-    }
-
-    auto saveResult = repositories.transacciones.guardar(transaccion);
-    if (std::holds_alternative<std::string>(saveResult)) {
-        Menu::printError("Error al guardar transaccion: " + std::get<std::string>(saveResult));
-        return;
-    }
-
-    std::vector<Producto> productosOriginales;
-    std::string stockError;
-    if (!aplicarCambiosStock(items, false, true, productosOriginales, stockError)) {
-        const bool stockRollback = rollbackStock(productosOriginales);
-        auto deleteResult = repositories.transacciones.eliminarLogicamente(nuevoId);
-
-        std::string error = "Error al actualizar stock de venta: " + stockError;
-        if (!stockRollback) {
-            error += " No se pudo revertir el stock aplicado.";
-        }
-        if (std::holds_alternative<std::string>(deleteResult)) {
-            error += " No se pudo revertir la transacción: " + std::get<std::string>(deleteResult);
-        }
-
-        Menu::printError(error);
-        return;
-    }
-
-    auto clienteResultActual = repositories.clientes.leerPorId(idCliente);
-    if (std::holds_alternative<std::string>(clienteResultActual)) {
-        const bool stockRollback = rollbackStock(productosOriginales);
-        auto deleteResult = repositories.transacciones.eliminarLogicamente(nuevoId);
-
-        std::string error = "No se pudo actualizar métricas del cliente: " +
-                            std::get<std::string>(clienteResultActual);
-        if (!stockRollback) {
-            error += " No se pudo revertir el stock aplicado.";
-        }
-        if (std::holds_alternative<std::string>(deleteResult)) {
-            error += " No se pudo revertir la transacción: " + std::get<std::string>(deleteResult);
-        }
-
-        Menu::printError(error);
-        return;
-    }
-
-    Cliente cliente = std::get<Cliente>(clienteResultActual);
-    Cliente clienteOriginal = cliente;
-
-    if (!cliente.setTotalCompras(cliente.getTotalCompras() + total)) {
-        const bool stockRollback = rollbackStock(productosOriginales);
-        auto deleteResult = repositories.transacciones.eliminarLogicamente(nuevoId);
-
-        std::string error = "No se pudo actualizar total de compras del cliente.";
-        if (!stockRollback) {
-            error += " No se pudo revertir el stock aplicado.";
-        }
-        if (std::holds_alternative<std::string>(deleteResult)) {
-            error += " No se pudo revertir la transacción: " + std::get<std::string>(deleteResult);
-        }
-
-        Menu::printError(error);
-        return;
-    }
-
-    if (!cliente.agregarTransaccionId(nuevoId)) {
-        const bool stockRollback = rollbackStock(productosOriginales);
-        auto deleteResult = repositories.transacciones.eliminarLogicamente(nuevoId);
-
-        std::string error =
-            "No se pudo actualizar historial del cliente (capacidad máxima alcanzada).";
-        if (!stockRollback) {
-            error += " No se pudo revertir el stock aplicado.";
-        }
-        if (std::holds_alternative<std::string>(deleteResult)) {
-            error += " No se pudo revertir la transacción: " + std::get<std::string>(deleteResult);
-        }
-
-        Menu::printError(error);
-        return;
-    }
-
-    cliente.setFechaUltimaModificacion(std::chrono::system_clock::now());
-    auto clientePersistResult = repositories.clientes.actualizar(idCliente, cliente);
-    if (std::holds_alternative<std::string>(clientePersistResult)) {
-        const bool stockRollback = rollbackStock(productosOriginales);
-        auto deleteResult = repositories.transacciones.eliminarLogicamente(nuevoId);
-        auto clienteRollback = repositories.clientes.actualizar(idCliente, clienteOriginal);
-
-        std::string error = "No se pudo guardar métricas del cliente: " +
-                            std::get<std::string>(clientePersistResult);
-        if (!stockRollback) {
-            error += " No se pudo revertir el stock aplicado.";
-        }
-        if (std::holds_alternative<std::string>(deleteResult)) {
-            error += " No se pudo revertir la transacción: " + std::get<std::string>(deleteResult);
-        }
-        if (std::holds_alternative<std::string>(clienteRollback)) {
-            error += " No se pudo revertir el cliente: " + std::get<std::string>(clienteRollback);
-        }
-
-        Menu::printError(error);
-        return;
-    }
-
-    try {
-        repositories.admin.sincronizarContadoresTienda();
-    } catch (const std::exception& e) {
-        Menu::printError("Advertencia: venta registrada, pero no se pudo sincronizar tienda: " +
-                         std::string(e.what()));
-    }
-
-    Menu::printSuccess("Venta registrada con exito.");
+    confirmarYRegistrar(transaccion, "venta");
 }
 
 void MenuTransacciones::buscarTransacciones()
@@ -576,21 +288,16 @@ void MenuTransacciones::listarTransacciones()
         return;
     }
 
-    std::cout << std::format("{}--- Lista de Transacciones ({}{}{}) ---", COLOR_CYAN, COLOR_GREEN,
-                             COLOR_YELLOW, header.registrosActivos)
-              << std::endl;
-    std::cout << std::format("{}{:<5} | {:<8} | {:<8} | {:<10} | {:<10}", COLOR_YELLOW, "ID",
-                             "Tipo", "Items", "Total", "Relacionado")
-              << std::endl;
-    std::cout << "---------------------------------------------------------------" << std::endl;
-
-    for (int id = 1; id < header.proximoID; ++id) {
-        auto result = repositories.transacciones.leerPorId(id);
-        if (!std::holds_alternative<Transaccion>(result)) {
-            continue;
-        }
+    TablaRenderer tabla({
+        {"ID", TablaRenderer::DERECHA},
+        {"Tipo"},
+        {"Items", TablaRenderer::DERECHA},
+        {"Total", TablaRenderer::DERECHA},
+        {"Relacionado", TablaRenderer::DERECHA},
+    });
+    tabla.reservar(static_cast<std::size_t>(header.registrosActivos));
 
-        const Transaccion& transaccion = std::get<Transaccion>(result);
+    auto scan = repositories.transacciones.recorrer([&tabla](const Transaccion& transaccion) {
         const auto tipo = transaccion.getTipoTransaccion();
         std::string tipoStr = "INVALIDO";
         if (tipo == COMPRA) {
@@ -599,11 +306,18 @@ void MenuTransacciones::listarTransacciones()
             tipoStr = "VENTA";
         }
 
-        std::cout << std::format("{}{:<5} | {:<8} | {:<8} | ${:<9.2f} | {:<10}", COLOR_GREEN,
-                                 transaccion.getId(), tipoStr, transaccion.getProductosTotales(),
-                                 transaccion.getTotal(), transaccion.getIdRelacionado())
-                  << std::endl;
+        tabla.agregarFila({std::to_string(transaccion.getId()), tipoStr,
+                           std::to_string(transaccion.getProductosTotales()),
+                           "$" + transaccion.getTotal().toString(),
+                           std::to_string(transaccion.getIdRelacionado())});
+        return true;
+    });
+    if (std::holds_alternative<std::string>(scan)) {
+        Menu::printError("Error: " + std::get<std::string>(scan));
+        return;
     }
+
+    tabla.mostrar(std::format("--- Lista de Transacciones ({}) ---", header.registrosActivos));
 }
 
 void MenuTransacciones::cancelarTransaccion()
@@ -629,120 +343,28 @@ void MenuTransacciones::cancelarTransaccion()
 
     std::vector<TransaccionDTO> items;
     std::string itemsError;
-    if (!getItemsFromTransaccion(transaccion, items, itemsError)) {
+    if (!TransaccionService::obtenerItems(transaccion, items, itemsError)) {
         Menu::printError(itemsError);
         return;
     }
 
     const char* tipoStr = (tipo == COMPRA) ? "COMPRA" : "VENTA";
-    std::cout << std::format("Se cancelara la transaccion {} de tipo {} por total ${:.2f}",
-                             transaccion.getId(), tipoStr, transaccion.getTotal())
+    std::cout << std::format("Se cancelara la transaccion {} de tipo {} por total ${}",
+                             transaccion.getId(), tipoStr, transaccion.getTotal().toString())
               << std::endl;
     if (!confirmAction("Confirmar cancelacion? (s/n): ")) {
         Menu::printError("Operacion cancelada.");
         return;
     }
 
-    if (tipo == COMPRA) {
-        for (const auto& item : items) {
-            auto productoResult = repositories.productos.leerPorId(item.productoId);
-            if (std::holds_alternative<std::string>(productoResult)) {
-                Menu::printError("No se pudo validar stock para cancelar compra. Producto ID: " +
-                                 std::to_string(item.productoId));
-                return;
-            }
-
-            const Producto& producto = std::get<Producto>(productoResult);
-            if (producto.getStock() < item.cantidad) {
-                Menu::printError(
-                    "No se puede cancelar la compra: el stock actual es menor al ajustado.");
-                return;
-            }
-        }
-    }
-
-    std::vector<Producto> productosOriginales;
-    std::string stockError;
-    const bool incrementarStock = tipo == VENTA;
-    const bool ajustarTotalVendido = tipo == VENTA;
-    if (!aplicarCambiosStock(items, incrementarStock, ajustarTotalVendido, productosOriginales,
-                             stockError)) {
-        rollbackStock(productosOriginales);
-        Menu::printError("Error al revertir stock: " + stockError);
-        return;
-    }
-
-    Cliente clienteOriginal;
-    bool clienteActualizado = false;
-    if (tipo == VENTA) {
-        auto clienteResult = repositories.clientes.leerPorId(transaccion.getIdRelacionado());
-        if (std::holds_alternative<std::string>(clienteResult)) {
-            rollbackStock(productosOriginales);
-            Menu::printError("No se pudo actualizar métricas del cliente al cancelar: " +
-                             std::get<std::string>(clienteResult));
-            return;
-        }
-
-        Cliente cliente = std::get<Cliente>(clienteResult);
-        clienteOriginal = cliente;
-
-        float totalComprasActualizado = cliente.getTotalCompras() - transaccion.getTotal();
-        if (totalComprasActualizado < 0.0f) {
-            totalComprasActualizado = 0.0f;
-        }
-
-        if (!cliente.setTotalCompras(totalComprasActualizado)) {
-            rollbackStock(productosOriginales);
-            Menu::printError("No se pudo ajustar total de compras del cliente.");
-            return;
-        }
-
-        if (!cliente.removerTransaccionId(transaccion.getId())) {
-            rollbackStock(productosOriginales);
-            Menu::printError("No se pudo ajustar historial del cliente.");
-            return;
-        }
-
-        cliente.setFechaUltimaModificacion(std::chrono::system_clock::now());
-        auto updateClienteResult = repositories.clientes.actualizar(cliente.getId(), cliente);
-        if (std::holds_alternative<std::string>(updateClienteResult)) {
-            rollbackStock(productosOriginales);
-            Menu::printError("No se pudo guardar cambios del cliente: " +
-                             std::get<std::string>(updateClienteResult));
-            return;
-        }
-
-        clienteActualizado = true;
-    }
-
-    auto deleteResult = repositories.transacciones.eliminarLogicamente(id);
-    if (std::holds_alternative<std::string>(deleteResult)) {
-        const bool stockRollback = rollbackStock(productosOriginales);
-        std::string error = "Error al cancelar transaccion: " + std::get<std::string>(deleteResult);
-
-        if (!stockRollback) {
-            error += " No se pudo revertir el stock ajustado.";
-        }
-
-        if (clienteActualizado) {
-            auto clienteRollback =
-                repositories.clientes.actualizar(clienteOriginal.getId(), clienteOriginal);
-            if (std::holds_alternative<std::string>(clienteRollback)) {
-                error += " No se pudo revertir estado del cliente: " +
-                         std::get<std::string>(clienteRollback);
-            }
-        }
-
-        Menu::printError(error);
+    auto result = servicio.cancelarTransaccion(id);
+    if (std::holds_alternative<std::string>(result)) {
+        Menu::printError(std::get<std::string>(result));
         return;
     }
 
-    try {
-        repositories.admin.sincronizarContadoresTienda();
-    } catch (const std::exception& e) {
-        Menu::printError(
-            "Advertencia: transaccion cancelada, pero no se pudo sincronizar tienda: " +
-            std::string(e.what()));
+    for (const std::string& advertencia : std::get<ResultadoTransaccion>(result).advertencias) {
+        Menu::printError("Advertencia: " + advertencia);
     }
 
     Menu::printSuccess("Transaccion cancelada con exito.");
@@ -2,22 +2,21 @@
 #include <string>
 #include <vector>
 
+#include "domain/services/TransaccionService.hpp"
 #include "presentation/CliUtils.hpp"
 #include "presentation/Menu/Menu.hpp"
 
 class MenuTransacciones : public Menu
 {
    private:
+    TransaccionService servicio;
+
     bool readValidCantidad(const char* prompt, int& outCantidad);
-    bool getItemsFromTransaccion(const Transaccion& transaccion,
-                                 std::vector<TransaccionDTO>& outItems, std::string& outError);
-    bool aplicarCambiosStock(const std::vector<TransaccionDTO>& items, bool incrementarStock,
-                             bool ajustarTotalVendido, std::vector<Producto>& productosOriginales,
-                             std::string& outError);
-    bool rollbackStock(const std::vector<Producto>& productosOriginales);
-    float calcularTotalTransaccion(const std::vector<TransaccionDTO>& items, std::string& outError);
     void imprimirDetalleTransaccion(const Transaccion& transaccion);
 
+    /// Muestra el total, pide confirmacion y delega el registro en TransaccionService.
+    bool confirmarYRegistrar(const Transaccion& borrador, const char* operacion);
+
    public:
     explicit MenuTransacciones(AppRepositories& repositories, CliUtils utils = CliUtils());
 
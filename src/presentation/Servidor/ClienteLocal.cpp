@@ -0,0 +1,305 @@
+#include "ClienteLocal.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <ostream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+
+#include "domain/Money.hpp"
+#include "presentation/Batch/BatchRunner.hpp"
+#include "presentation/CliUtils.hpp"
+#include "presentation/Servidor/Protocolo.hpp"
+
+namespace {
+
+/// Busca `clave=valor` entre los argumentos; retorna false si no esta.
+bool buscarArgumento(const std::vector<std::string>& tokens, const std::string& clave,
+                     std::string& outValor)
+{
+    for (std::size_t i = 1; i < tokens.size(); ++i) {
+        if (tokens[i].size() > clave.size() && tokens[i].compare(0, clave.size(), clave) == 0 &&
+            tokens[i][clave.size()] == '=') {
+            outValor = tokens[i].substr(clave.size() + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void reportar(std::ostream& out, bool ok, const std::string& comando, const std::string& mensaje)
+{
+    out << (ok ? "OK " : "ERROR ") << comando << ": " << mensaje << '\n';
+}
+
+}  // namespace
+
+ClienteLocal::ClienteLocal(fs::path rutaSocket) : rutaSocket(std::move(rutaSocket)) {}
+
+ClienteLocal::~ClienteLocal()
+{
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+}
+
+bool ClienteLocal::conectar(std::string& outError)
+{
+    sockaddr_un direccion{};
+    direccion.sun_family = AF_UNIX;
+    const std::string ruta = rutaSocket.string();
+    if (ruta.size() >= sizeof(direccion.sun_path)) {
+        outError = "Ruta de socket demasiado larga: " + ruta;
+        return false;
+    }
+    std::memcpy(direccion.sun_path, ruta.c_str(), ruta.size() + 1);
+
+    descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descriptor < 0 ||
+        connect(descriptor, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0) {
+        outError = "No se pudo conectar al servidor en " + ruta + ": " + std::strerror(errno);
+        return false;
+    }
+
+    return true;
+}
+
+bool ClienteLocal::enviar(std::uint8_t operacion, const std::string& cuerpo,
+                          std::string& outError)
+{
+    const std::string mensaje = Protocolo::empaquetar(operacion, cuerpo);
+    std::size_t enviados = 0;
+    while (enviados < mensaje.size()) {
+        const ssize_t escritos =
+            ::send(descriptor, mensaje.data() + enviados, mensaje.size() - enviados, MSG_NOSIGNAL);
+        if (escritos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (escritos <= 0) {
+            outError = std::string("Error enviando al servidor: ") + std::strerror(errno);
+            return false;
+        }
+        enviados += static_cast<std::size_t>(escritos);
+    }
+
+    return true;
+}
+
+bool ClienteLocal::recibir(std::uint8_t& outEstado, std::string& outCuerpo, std::string& outError)
+{
+    std::string buffer;
+    char bloque[16 * 1024];
+    int estado = 0;
+    while ((estado = Protocolo::desempaquetar(buffer, outEstado, outCuerpo)) == 0) {
+        const ssize_t leidos = ::read(descriptor, bloque, sizeof(bloque));
+        if (leidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (leidos <= 0) {
+            outError = "El servidor cerro la conexion";
+            return false;
+        }
+        buffer.append(bloque, static_cast<std::size_t>(leidos));
+    }
+
+    if (estado < 0) {
+        outError = "Respuesta invalida del servidor";
+        return false;
+    }
+
+    return true;
+}
+
+bool ClienteLocal::buscarProducto(const std::vector<std::string>& tokens, std::ostream& out)
+{
+    std::string texto;
+    int id = 0;
+    if (!buscarArgumento(tokens, "id", texto) || !CliUtils::parsePositiveNumber(texto, id, false)) {
+        reportar(out, false, "producto", "se espera id=<numero>");
+        return false;
+    }
+
+    Protocolo::Escritor escritor;
+    escritor.entero(static_cast<std::int32_t>(id));
+    std::uint8_t estado = 0;
+    std::string cuerpo;
+    std::string error;
+    if (!enviar(Protocolo::BUSCAR_PRODUCTO, escritor.cuerpo(), error) ||
+        !recibir(estado, cuerpo, error)) {
+        reportar(out, false, "producto", error);
+        return false;
+    }
+
+    Protocolo::Lector lector(cuerpo);
+    if (estado != Protocolo::RESPUESTA_OK) {
+        lector.texto(error);
+        reportar(out, false, "producto", error);
+        return false;
+    }
+
+    std::int32_t idProducto = 0;
+    std::string nombre;
+    std::string codigo;
+    std::int64_t precio = 0;
+    std::int32_t stock = 0;
+    std::int32_t stockMinimo = 0;
+    std::int32_t proveedor = 0;
+    if (!lector.entero(idProducto) || !lector.texto(nombre) || !lector.texto(codigo) ||
+        !lector.entero(precio) || !lector.entero(stock) || !lector.entero(stockMinimo) ||
+        !lector.entero(proveedor)) {
+        reportar(out, false, "producto", "Respuesta invalida del servidor");
+        return false;
+    }
+
+    reportar(out, true, "producto",
+             std::format("id={} nombre=\"{}\" codigo={} precio={} stock={} stockMinimo={} "
+                         "proveedor={}",
+                         idProducto, nombre, codigo, Money::fromCents(precio).toString(), stock,
+                         stockMinimo, proveedor));
+    return true;
+}
+
+bool ClienteLocal::registrarVenta(const std::vector<std::string>& tokens, std::ostream& out)
+{
+    std::string texto;
+    std::string itemsTexto;
+    std::string error;
+    int idCliente = 0;
+    std::vector<TransaccionDTO> items;
+    if (!buscarArgumento(tokens, "cliente", texto) ||
+        !CliUtils::parsePositiveNumber(texto, idCliente, false)) {
+        reportar(out, false, "venta", "se espera cliente=<numero>");
+        return false;
+    }
+    if (!buscarArgumento(tokens, "items", itemsTexto)) {
+        reportar(out, false, "venta", "Falta el argumento 'items'");
+        return false;
+    }
+    if (!BatchRunner::parsearItems(itemsTexto, items, error)) {
+        reportar(out, false, "venta", error);
+        return false;
+    }
+    if (items.size() > UINT16_MAX) {
+        reportar(out, false, "venta", "Demasiados items en una sola venta");
+        return false;
+    }
+
+    Protocolo::Escritor escritor;
+    escritor.entero(static_cast<std::int32_t>(idCliente));
+    escritor.entero(static_cast<std::uint16_t>(items.size()));
+    for (const TransaccionDTO& item : items) {
+        escritor.entero(static_cast<std::int32_t>(item.productoId));
+        escritor.entero(static_cast<std::int32_t>(item.cantidad));
+    }
+
+    std::uint8_t estado = 0;
+    std::string cuerpo;
+    if (!enviar(Protocolo::REGISTRAR_VENTA, escritor.cuerpo(), error) ||
+        !recibir(estado, cuerpo, error)) {
+        reportar(out, false, "venta", error);
+        return false;
+    }
+
+    Protocolo::Lector lector(cuerpo);
+    if (estado != Protocolo::RESPUESTA_OK) {
+        lector.texto(error);
+        reportar(out, false, "venta", error);
+        return false;
+    }
+
+    std::int32_t id = 0;
+    std::int64_t total = 0;
+    std::uint16_t cantidadAdvertencias = 0;
+    if (!lector.entero(id) || !lector.entero(total) || !lector.entero(cantidadAdvertencias)) {
+        reportar(out, false, "venta", "Respuesta invalida del servidor");
+        return false;
+    }
+
+    std::string mensaje = std::format("id={} total={}", id, Money::fromCents(total).toString());
+    std::string advertencia;
+    for (std::uint16_t i = 0; i < cantidadAdvertencias && lector.texto(advertencia); ++i) {
+        mensaje += " advertencia=\"" + advertencia + "\"";
+    }
+    reportar(out, true, "venta", mensaje);
+    return true;
+}
+
+bool ClienteLocal::enviarComando(const std::string& linea, std::ostream& out)
+{
+    Protocolo::Escritor escritor;
+    escritor.texto(linea);
+    std::uint8_t estado = 0;
+    std::string cuerpo;
+    std::string error;
+    std::string salida;
+    if (!enviar(Protocolo::COMANDO, escritor.cuerpo(), error) || !recibir(estado, cuerpo, error) ||
+        !Protocolo::Lector(cuerpo).texto(salida)) {
+        reportar(out, false, "servidor", error.empty() ? "Respuesta invalida del servidor" : error);
+        return false;
+    }
+
+    out << salida;
+    return estado == Protocolo::RESPUESTA_OK;
+}
+
+bool ClienteLocal::ejecutarLinea(const std::string& linea, std::ostream& out)
+{
+    std::vector<std::string> tokens;
+    std::string error;
+    if (!BatchRunner::tokenizar(linea, tokens, error)) {
+        reportar(out, false, "script", error);
+        return false;
+    }
+
+    if (tokens.empty() || tokens.front().front() == '#') {
+        return true;
+    }
+
+    std::string descripcion;
+    if (tokens.front() == "producto") {
+        return buscarProducto(tokens, out);
+    }
+    // con descripcion propia se usa la ruta de texto, que la respeta
+    if (tokens.front() == "venta" && !buscarArgumento(tokens, "descripcion", descripcion)) {
+        return registrarVenta(tokens, out);
+    }
+
+    return enviarComando(linea, out);
+}
+
+int ClienteLocal::ejecutarScript(std::istream& in, bool detenerEnError, std::ostream& out)
+{
+    int errores = 0;
+    std::string linea;
+    while (std::getline(in, linea)) {
+        if (!ejecutarLinea(linea, out)) {
+            ++errores;
+            if (detenerEnError) {
+                break;
+            }
+        }
+    }
+
+    return errores;
+}
+
+std::string ClienteLocal::unirTokens(const std::vector<std::string>& tokens)
+{
+    std::string linea;
+    for (const std::string& token : tokens) {
+        if (!linea.empty()) {
+            linea += ' ';
+        }
+
+        const std::size_t igual = token.find('=');
+        if (token.find(' ') == std::string::npos || igual == std::string::npos) {
+            linea += token;
+        } else {
+            linea += token.substr(0, igual + 1) + '"' + token.substr(igual + 1) + '"';
+        }
+    }
+    return linea;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Cliente liviano del servidor local: no abre los archivos de datos.
+ *
+ * `producto id=` y `venta cliente= items=` viajan como mensajes binarios; el resto de los comandos
+ * batch se envian como texto y el servidor responde con su salida. La salida impresa tiene el mismo
+ * formato `OK`/`ERROR` que el modo batch.
+ */
+class ClienteLocal
+{
+   private:
+    fs::path rutaSocket;
+    int descriptor{-1};
+
+    bool enviar(std::uint8_t operacion, const std::string& cuerpo, std::string& outError);
+    bool recibir(std::uint8_t& outEstado, std::string& outCuerpo, std::string& outError);
+
+    bool buscarProducto(const std::vector<std::string>& tokens, std::ostream& out);
+    bool registrarVenta(const std::vector<std::string>& tokens, std::ostream& out);
+    bool enviarComando(const std::string& linea, std::ostream& out);
+
+   public:
+    explicit ClienteLocal(fs::path rutaSocket);
+    ~ClienteLocal();
+
+    ClienteLocal(const ClienteLocal&) = delete;
+    ClienteLocal& operator=(const ClienteLocal&) = delete;
+
+    bool conectar(std::string& outError);
+
+    /// Ejecuta una linea de comando contra el servidor; retorna false si fallo.
+    bool ejecutarLinea(const std::string& linea, std::ostream& out);
+
+    /// Ejecuta un comando por linea (ignora vacias y comentarios '#'); retorna cantidad de errores.
+    int ejecutarScript(std::istream& in, bool detenerEnError, std::ostream& out);
+
+    /// Une tokens de la linea de comandos en una linea batch, entrecomillando valores con espacios.
+    static std::string unirTokens(const std::vector<std::string>& tokens);
+};
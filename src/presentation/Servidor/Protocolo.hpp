@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief - Protocolo binario entre el servidor local y sus clientes (socket Unix).
+ *
+ * Cada mensaje es una cabecera de 5 bytes (longitud del cuerpo en uint32 y un codigo uint8) seguida
+ * del cuerpo. En las solicitudes el codigo es la Operacion; en las respuestas es el Estado. Los
+ * enteros viajan en el orden de bytes del host (cliente y servidor corren en la misma maquina) y
+ * los textos como uint32 de longitud mas sus bytes.
+ */
+namespace Protocolo {
+
+inline constexpr std::size_t TAMANO_CABECERA = sizeof(std::uint32_t) + sizeof(std::uint8_t);
+inline constexpr std::uint32_t MAX_CUERPO = 1 << 20;
+
+enum Operacion : std::uint8_t {
+    /// Cuerpo: int32 id. Respuesta: id, nombre, codigo, precio (centavos), stock, stockMinimo,
+    /// proveedor.
+    BUSCAR_PRODUCTO = 1,
+    /// Cuerpo: int32 cliente, uint16 cantidad de items, items {int32 producto, int32 cantidad}.
+    /// Respuesta: int32 id, int64 total (centavos), uint16 advertencias, textos.
+    REGISTRAR_VENTA = 2,
+    /// Cuerpo: texto con una linea de comando batch. Respuesta: texto con la salida del comando.
+    COMANDO = 3,
+};
+
+enum Estado : std::uint8_t { RESPUESTA_OK = 0, RESPUESTA_ERROR = 1 };
+
+/// Serializa los campos de un cuerpo de mensaje.
+class Escritor
+{
+   private:
+    std::string datos;
+
+   public:
+    template <typename T>
+    void entero(T valor)
+    {
+        static_assert(std::is_integral_v<T>);
+        datos.append(reinterpret_cast<const char*>(&valor), sizeof(T));
+    }
+
+    void texto(const std::string& valor)
+    {
+        entero(static_cast<std::uint32_t>(valor.size()));
+        datos += valor;
+    }
+
+    const std::string& cuerpo() const { return datos; }
+};
+
+/// Lee los campos de un cuerpo de mensaje; cada lectura falla si faltan bytes.
+class Lector
+{
+   private:
+    const std::string& datos;
+    std::size_t posicion{0};
+
+   public:
+    explicit Lector(const std::string& datos) : datos(datos) {}
+
+    template <typename T>
+    bool entero(T& outValor)
+    {
+        static_assert(std::is_integral_v<T>);
+        if (datos.size() - posicion < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&outValor, datos.data() + posicion, sizeof(T));
+        posicion += sizeof(T);
+        return true;
+    }
+
+    bool texto(std::string& outValor)
+    {
+        std::uint32_t longitud = 0;
+        if (!entero(longitud) || datos.size() - posicion < longitud) {
+            return false;
+        }
+        outValor.assign(datos, posicion, longitud);
+        posicion += longitud;
+        return true;
+    }
+};
+
+/// Arma cabecera + cuerpo en un solo buffer para enviarlo con una escritura.
+inline std::string empaquetar(std::uint8_t codigo, const std::string& cuerpo)
+{
+    std::string mensaje;
+    mensaje.reserve(TAMANO_CABECERA + cuerpo.size());
+    const auto longitud = static_cast<std::uint32_t>(cuerpo.size());
+    mensaje.append(reinterpret_cast<const char*>(&longitud), sizeof(longitud));
+    mensaje += static_cast<char>(codigo);
+    mensaje += cuerpo;
+    return mensaje;
+}
+
+/**
+ * Extrae un mensaje completo del inicio de `buffer` si ya llego entero.
+ * @return 1 si extrajo un mensaje, 0 si faltan bytes, -1 si la cabecera es invalida.
+ */
+inline int desempaquetar(std::string& buffer, std::uint8_t& outCodigo, std::string& outCuerpo)
+{
+    if (buffer.size() < TAMANO_CABECERA) {
+        return 0;
+    }
+
+    std::uint32_t longitud = 0;
+    std::memcpy(&longitud, buffer.data(), sizeof(longitud));
+    if (longitud > MAX_CUERPO) {
+        return -1;
+    }
+
+    if (buffer.size() < TAMANO_CABECERA + longitud) {
+        return 0;
+    }
+
+    outCodigo = static_cast<std::uint8_t>(buffer[sizeof(longitud)]);
+    outCuerpo.assign(buffer, TAMANO_CABECERA, longitud);
+    buffer.erase(0, TAMANO_CABECERA + longitud);
+    return 1;
+}
+
+}  // namespace Protocolo
@@ -0,0 +1,524 @@
+#include "ServidorLocal.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+#include <variant>
+
+#include "domain/utils/EjecutorTareas.hpp"
+#include "presentation/Servidor/Protocolo.hpp"
+
+namespace {
+
+constexpr int ESPERA_INACTIVO_MS = 1000;
+/// Con trafico continuo no hay pausas; la tienda se sincroniza igual cada este intervalo.
+constexpr auto INTERVALO_SINCRONIZACION = std::chrono::seconds(5);
+constexpr std::size_t BLOQUE_LECTURA = 64 * 1024;
+/// Entrada sin procesar por conexion: alcanza para un mensaje del tamano maximo.
+constexpr std::size_t LIMITE_ENTRADA = Protocolo::TAMANO_CABECERA + Protocolo::MAX_CUERPO;
+/// Respuestas sin enviar por encima de las cuales no se lee ni se atiende mas a la conexion.
+constexpr std::size_t LIMITE_SALIDA = 4 * Protocolo::MAX_CUERPO;
+constexpr std::size_t MAX_PENDIENTES = 16;
+
+volatile std::sig_atomic_t detenerServidor = 0;
+
+void manejarSenal(int) { detenerServidor = 1; }
+
+/// Sin SA_RESTART, para que poll() retorne con EINTR y el ciclo vea la senal.
+void instalarManejadores()
+{
+    struct sigaction accion{};
+    accion.sa_handler = manejarSenal;
+    sigemptyset(&accion.sa_mask);
+    sigaction(SIGINT, &accion, nullptr);
+    sigaction(SIGTERM, &accion, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+}
+
+bool configurarNoBloqueante(int descriptor)
+{
+    const int flags = fcntl(descriptor, F_GETFL, 0);
+    return flags >= 0 && fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+std::string respuestaError(const std::string& mensaje)
+{
+    Protocolo::Escritor escritor;
+    escritor.texto(mensaje);
+    return Protocolo::empaquetar(Protocolo::RESPUESTA_ERROR, escritor.cuerpo());
+}
+
+}  // namespace
+
+ServidorLocal::ServidorLocal(AppRepositories& repositories, fs::path rutaSocket)
+    : repositories(repositories), rutaSocket(std::move(rutaSocket)),
+      runner(repositories, salidaComandos)
+{
+}
+
+ServidorLocal::~ServidorLocal() { cerrar(); }
+
+bool ServidorLocal::abrirSocket(std::string& outError)
+{
+    sockaddr_un direccion{};
+    direccion.sun_family = AF_UNIX;
+    const std::string ruta = rutaSocket.string();
+    if (ruta.size() >= sizeof(direccion.sun_path)) {
+        outError = "Ruta de socket demasiado larga: " + ruta;
+        return false;
+    }
+    std::memcpy(direccion.sun_path, ruta.c_str(), ruta.size() + 1);
+
+    descriptorEscucha = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descriptorEscucha < 0) {
+        outError = std::string("No se pudo crear el socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    auto* direccionGenerica = reinterpret_cast<sockaddr*>(&direccion);
+    int resultado = bind(descriptorEscucha, direccionGenerica, sizeof(direccion));
+    if (resultado < 0 && errno == EADDRINUSE) {
+        // un archivo de socket que nadie atiende queda de una ejecucion anterior interrumpida
+        const int prueba = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        const bool enUso =
+            prueba >= 0 && connect(prueba, direccionGenerica, sizeof(direccion)) == 0;
+        if (prueba >= 0) {
+            ::close(prueba);
+        }
+        if (enUso) {
+            outError = "Ya hay un servidor atendiendo en " + ruta;
+            ::close(descriptorEscucha);
+            descriptorEscucha = -1;
+            return false;
+        }
+        ::unlink(ruta.c_str());
+        resultado = bind(descriptorEscucha, direccionGenerica, sizeof(direccion));
+    }
+
+    if (resultado < 0 || listen(descriptorEscucha, SOMAXCONN) < 0 ||
+        !configurarNoBloqueante(descriptorEscucha)) {
+        outError = "No se pudo escuchar en " + ruta + ": " + std::strerror(errno);
+        ::close(descriptorEscucha);
+        descriptorEscucha = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void ServidorLocal::cerrar()
+{
+    for (const Conexion& conexion : conexiones) {
+        ::close(conexion.descriptor);
+    }
+    conexiones.clear();
+
+    if (descriptorEscucha >= 0) {
+        ::close(descriptorEscucha);
+        descriptorEscucha = -1;
+        ::unlink(rutaSocket.c_str());
+    }
+
+    if (avisoRespuestas >= 0) {
+        ::close(avisoRespuestas);
+        avisoRespuestas = -1;
+    }
+}
+
+void ServidorLocal::aceptarConexiones()
+{
+    while (true) {
+        const int descriptor = accept4(descriptorEscucha, nullptr, nullptr, SOCK_CLOEXEC);
+        if (descriptor < 0) {
+            return;
+        }
+
+        if (!configurarNoBloqueante(descriptor)) {
+            ::close(descriptor);
+            continue;
+        }
+        conexiones.push_back(Conexion{proximaConexion++, descriptor, {}, {}, {}});
+    }
+}
+
+bool ServidorLocal::leer(Conexion& conexion, bool todo)
+{
+    char bloque[BLOQUE_LECTURA];
+    while (todo || conexion.entrada.size() < LIMITE_ENTRADA) {
+        const ssize_t leidos = ::read(conexion.descriptor, bloque, sizeof(bloque));
+        if (leidos > 0) {
+            conexion.entrada.append(bloque, static_cast<std::size_t>(leidos));
+            continue;
+        }
+        if (leidos == 0) {
+            // los mensajes que ya llegaron se atienden igual: el cliente espera las respuestas
+            conexion.finEntrada = true;
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        return false;
+    }
+
+    extraerSolicitudes(conexion);
+    return true;
+}
+
+void ServidorLocal::extraerSolicitudes(Conexion& conexion)
+{
+    Solicitud solicitud;
+    while (!conexion.corrupta && conexion.pendientes.size() < MAX_PENDIENTES) {
+        const int estado =
+            Protocolo::desempaquetar(conexion.entrada, solicitud.operacion, solicitud.cuerpo);
+        if (estado == 0) {
+            return;
+        }
+        if (estado < 0) {
+            // cabecera invalida: el resto del stream ya no es confiable
+            conexion.corrupta = true;
+            conexion.finEntrada = true;
+            conexion.entrada.clear();
+            return;
+        }
+        conexion.pendientes.push_back(std::move(solicitud));
+    }
+}
+
+bool ServidorLocal::escribir(Conexion& conexion)
+{
+    std::size_t enviados = 0;
+    while (enviados < conexion.salida.size()) {
+        const ssize_t escritos = ::send(conexion.descriptor, conexion.salida.data() + enviados,
+                                        conexion.salida.size() - enviados, MSG_NOSIGNAL);
+        if (escritos > 0) {
+            enviados += static_cast<std::size_t>(escritos);
+        } else if (escritos < 0 && errno == EINTR) {
+            continue;
+        } else if (escritos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+
+    conexion.salida.erase(0, enviados);
+    return true;
+}
+
+bool ServidorLocal::puedeLeer(const Conexion& conexion) const
+{
+    return !conexion.finEntrada && conexion.entrada.size() < LIMITE_ENTRADA &&
+           conexion.salida.size() < LIMITE_SALIDA && conexion.pendientes.size() < MAX_PENDIENTES;
+}
+
+void ServidorLocal::despachar()
+{
+    // se empieza por una conexion distinta cada vez para que ninguna acapare el BatchRunner
+    const std::size_t total = conexiones.size();
+    for (std::size_t k = 0; k < total; ++k) {
+        Conexion& conexion = conexiones[(turno + k) % total];
+        if (conexion.enCurso || conexion.pendientes.empty() ||
+            conexion.salida.size() >= LIMITE_SALIDA) {
+            continue;
+        }
+        const std::uint8_t operacion = conexion.pendientes.front().operacion;
+        const bool usaRunner =
+            operacion == Protocolo::REGISTRAR_VENTA || operacion == Protocolo::COMANDO;
+        if (usaRunner && runnerOcupado) {
+            continue;
+        }
+
+        Solicitud solicitud = std::move(conexion.pendientes.front());
+        conexion.pendientes.pop_front();
+        extraerSolicitudes(conexion);
+        conexion.enCurso = true;
+        runnerOcupado = runnerOcupado || usaRunner;
+        ++solicitudesEnCurso;
+        EjecutorTareas::global().enviar(
+            [this, numero = conexion.numero, usaRunner, solicitud = std::move(solicitud)] {
+                std::string mensaje;
+                try {
+                    mensaje = atender(solicitud.operacion, solicitud.cuerpo);
+                } catch (const std::exception& e) {
+                    mensaje = respuestaError(e.what());
+                }
+                {
+                    const std::lock_guard<std::mutex> lock(mutexRespuestas);
+                    respuestas.push_back(Respuesta{numero, usaRunner, std::move(mensaje)});
+                }
+                const std::uint64_t uno = 1;
+                [[maybe_unused]] const ssize_t escritos =
+                    ::write(avisoRespuestas, &uno, sizeof(uno));
+            });
+    }
+    turno = total == 0 ? 0 : (turno + 1) % total;
+}
+
+void ServidorLocal::recogerRespuestas()
+{
+    std::uint64_t avisos = 0;
+    [[maybe_unused]] const ssize_t leidos = ::read(avisoRespuestas, &avisos, sizeof(avisos));
+
+    std::vector<Respuesta> listas;
+    {
+        const std::lock_guard<std::mutex> lock(mutexRespuestas);
+        listas.swap(respuestas);
+    }
+    for (Respuesta& respuesta : listas) {
+        --solicitudesEnCurso;
+        runnerOcupado = runnerOcupado && !respuesta.usoRunner;
+        for (Conexion& conexion : conexiones) {
+            if (conexion.numero == respuesta.conexion) {
+                conexion.salida += respuesta.mensaje;
+                conexion.enCurso = false;
+                break;
+            }
+        }
+    }
+}
+
+void ServidorLocal::esperarEnCurso()
+{
+    while (solicitudesEnCurso > 0) {
+        pollfd aviso{avisoRespuestas, POLLIN, 0};
+        if (poll(&aviso, 1, -1) > 0) {
+            recogerRespuestas();
+        }
+    }
+}
+
+std::string ServidorLocal::atender(std::uint8_t operacion, const std::string& cuerpo)
+{
+    switch (operacion) {
+        case Protocolo::BUSCAR_PRODUCTO:
+            return buscarProducto(cuerpo);
+        case Protocolo::REGISTRAR_VENTA:
+            return registrarVenta(cuerpo);
+        case Protocolo::COMANDO:
+            return ejecutarComando(cuerpo);
+        default:
+            return respuestaError("Operacion desconocida: " + std::to_string(operacion));
+    }
+}
+
+std::string ServidorLocal::buscarProducto(const std::string& cuerpo)
+{
+    Protocolo::Lector lector(cuerpo);
+    std::int32_t id = 0;
+    if (!lector.entero(id)) {
+        return respuestaError("Solicitud de producto incompleta");
+    }
+
+    auto result = repositories.productos.leerPorId(id);
+    if (std::holds_alternative<std::string>(result)) {
+        return respuestaError(std::get<std::string>(result));
+    }
+
+    const Producto& producto = std::get<Producto>(result);
+    Protocolo::Escritor escritor;
+    escritor.entero(static_cast<std::int32_t>(producto.getId()));
+    escritor.texto(producto.getNombre());
+    escritor.texto(producto.getCodigo());
+    escritor.entero(producto.getPrecio().cents());
+    escritor.entero(static_cast<std::int32_t>(producto.getStock()));
+    escritor.entero(static_cast<std::int32_t>(producto.getStockMinimo()));
+    escritor.entero(static_cast<std::int32_t>(producto.getIdProveedor()));
+    return Protocolo::empaquetar(Protocolo::RESPUESTA_OK, escritor.cuerpo());
+}
+
+std::string ServidorLocal::registrarVenta(const std::string& cuerpo)
+{
+    Protocolo::Lector lector(cuerpo);
+    std::int32_t idCliente = 0;
+    std::uint16_t cantidadItems = 0;
+    if (!lector.entero(idCliente) || !lector.entero(cantidadItems) || cantidadItems == 0) {
+        return respuestaError("Solicitud de venta incompleta");
+    }
+
+    std::vector<TransaccionDTO> items(cantidadItems);
+    for (TransaccionDTO& item : items) {
+        std::int32_t productoId = 0;
+        std::int32_t cantidad = 0;
+        if (!lector.entero(productoId) || !lector.entero(cantidad)) {
+            return respuestaError("Solicitud de venta incompleta");
+        }
+        item.productoId = productoId;
+        item.cantidad = cantidad;
+    }
+
+    auto result =
+        runner.registrarVenta(idCliente, std::move(items), "Venta registrada en servidor");
+    if (std::holds_alternative<std::string>(result)) {
+        return respuestaError(std::get<std::string>(result));
+    }
+
+    const ResultadoTransaccion& resultado = std::get<ResultadoTransaccion>(result);
+    Protocolo::Escritor escritor;
+    escritor.entero(static_cast<std::int32_t>(resultado.transaccion.getId()));
+    escritor.entero(resultado.transaccion.getTotal().cents());
+    escritor.entero(static_cast<std::uint16_t>(resultado.advertencias.size()));
+    for (const std::string& advertencia : resultado.advertencias) {
+        escritor.texto(advertencia);
+    }
+    return Protocolo::empaquetar(Protocolo::RESPUESTA_OK, escritor.cuerpo());
+}
+
+std::string ServidorLocal::ejecutarComando(const std::string& cuerpo)
+{
+    Protocolo::Lector lector(cuerpo);
+    std::string linea;
+    if (!lector.texto(linea)) {
+        return respuestaError("Solicitud de comando incompleta");
+    }
+
+    std::vector<std::string> tokens;
+    std::string error;
+    if (!BatchRunner::tokenizar(linea, tokens, error)) {
+        return respuestaError(error);
+    }
+
+    const bool ok = tokens.empty() || runner.ejecutar(tokens);
+    Protocolo::Escritor escritor;
+    escritor.texto(salidaComandos.str());
+    salidaComandos.str({});
+    return Protocolo::empaquetar(ok ? Protocolo::RESPUESTA_OK : Protocolo::RESPUESTA_ERROR,
+                                 escritor.cuerpo());
+}
+
+void ServidorLocal::sincronizarPendiente()
+{
+    if (!runner.finalizar()) {
+        std::cerr << salidaComandos.str();
+    }
+    salidaComandos.str({});
+}
+
+int ServidorLocal::ejecutar()
+{
+    std::string error;
+    if (!abrirSocket(error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    avisoRespuestas = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (avisoRespuestas < 0) {
+        std::cerr << "No se pudo crear el eventfd: " << std::strerror(errno) << "\n";
+        cerrar();
+        return 1;
+    }
+
+    detenerServidor = 0;
+    instalarManejadores();
+    std::cerr << "Servidor escuchando en " << rutaSocket.string() << "\n";
+
+    std::vector<pollfd> descriptores;
+    auto ultimaSincronizacion = std::chrono::steady_clock::now();
+    while (detenerServidor == 0) {
+        descriptores.clear();
+        descriptores.push_back(pollfd{descriptorEscucha, POLLIN, 0});
+        descriptores.push_back(pollfd{avisoRespuestas, POLLIN, 0});
+        for (const Conexion& conexion : conexiones) {
+            const short eventos = static_cast<short>((puedeLeer(conexion) ? POLLIN : 0) |
+                                                     (conexion.salida.empty() ? 0 : POLLOUT));
+            // sin eventos que esperar se ignora: poll reportaria POLLHUP en cada vuelta
+            const bool esperar = eventos != 0 || !conexion.finEntrada;
+            descriptores.push_back(pollfd{esperar ? conexion.descriptor : -1, eventos, 0});
+        }
+
+        const int listos = poll(descriptores.data(), descriptores.size(), ESPERA_INACTIVO_MS);
+        if (listos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Error en poll: " << std::strerror(errno) << "\n";
+            break;
+        }
+
+        if (listos == 0) {
+            // sin actividad: buen momento para la sincronizacion diferida de la tienda
+            if (!runnerOcupado) {
+                sincronizarPendiente();
+                ultimaSincronizacion = std::chrono::steady_clock::now();
+            }
+            continue;
+        }
+
+        if ((descriptores[1].revents & POLLIN) != 0) {
+            recogerRespuestas();
+        }
+
+        // las conexiones nuevas se agregan al final y no tienen entrada en `descriptores` todavia
+        const std::size_t atendidas = conexiones.size();
+        if ((descriptores[0].revents & POLLIN) != 0) {
+            aceptarConexiones();
+        }
+
+        std::vector<bool> cerrarConexion(atendidas, false);
+        for (std::size_t i = 0; i < atendidas; ++i) {
+            const short eventos = descriptores[i + 2].revents;
+            Conexion& conexion = conexiones[i];
+            if ((eventos & POLLERR) != 0) {
+                cerrarConexion[i] = true;
+                continue;
+            }
+            // con POLLHUP el cliente ya no manda nada: se lee lo que quedo en el socket
+            const bool colgo = (eventos & POLLHUP) != 0;
+            if (((eventos & POLLIN) != 0 || colgo) && !leer(conexion, colgo)) {
+                cerrarConexion[i] = true;
+                continue;
+            }
+            if (!conexion.salida.empty() && !escribir(conexion)) {
+                cerrarConexion[i] = true;
+            }
+        }
+
+        despachar();
+        cerrarConexion.resize(conexiones.size(), false);
+        for (std::size_t i = 0; i < conexiones.size(); ++i) {
+            Conexion& conexion = conexiones[i];
+            if (!conexion.finEntrada || conexion.enCurso || !conexion.pendientes.empty()) {
+                continue;
+            }
+            if (conexion.corrupta) {
+                conexion.salida += respuestaError("Mensaje demasiado grande o corrupto");
+                conexion.corrupta = false;
+            }
+            // lo que no se pueda enviar ahora sale con POLLOUT en las proximas vueltas
+            if (!escribir(conexion) || conexion.salida.empty()) {
+                cerrarConexion[i] = true;
+            }
+        }
+
+        for (std::size_t i = cerrarConexion.size(); i-- > 0;) {
+            if (cerrarConexion[i]) {
+                ::close(conexiones[i].descriptor);
+                conexiones.erase(conexiones.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+        }
+
+        const auto ahora = std::chrono::steady_clock::now();
+        if (ahora - ultimaSincronizacion >= INTERVALO_SINCRONIZACION && !runnerOcupado) {
+            sincronizarPendiente();
+            ultimaSincronizacion = ahora;
+        }
+    }
+
+    esperarEnCurso();
+    sincronizarPendiente();
+    cerrar();
+    std::cerr << "Servidor detenido\n";
+    return 0;
+}
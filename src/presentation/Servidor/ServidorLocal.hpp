@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "domain/repositories/AppRepositories.hpp"
+#include "presentation/Batch/BatchRunner.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief - Proceso servidor que atiende varias terminales sobre un socket Unix local.
+ *
+ * Es duenio de los repositorios y de un unico BatchRunner, de modo que todas las conexiones
+ * comparten los mismos indices en memoria. Un hilo con poll() lee y escribe los sockets; las
+ * solicitudes se ejecutan en EjecutorTareas, una a la vez por conexion para que cada una reciba
+ * sus respuestas en orden. Las consultas de producto corren en paralelo; las ventas y los
+ * comandos usan el BatchRunner y van de a una entre todas las conexiones, lo que ordena las
+ * modificaciones de este proceso. Las de otros procesos sobre los mismos datos no pasan por esa
+ * fila: las coordinan los flocks de cada archivo, y el BatchRunner recarga sus indices cuando el
+ * header de un archivo muestra altas o bajas ajenas. Las respuestas vuelven al hilo de poll por
+ * una cola y un eventfd. La sincronizacion de tienda se difiere hasta que el servidor queda
+ * inactivo o se detiene.
+ *
+ * Una conexion con mas de LIMITE_SALIDA bytes sin enviar, o MAX_PENDIENTES solicitudes en espera,
+ * deja de leerse hasta que el cliente consuma sus respuestas. Si el cliente cierra su lado se
+ * atienden igual los mensajes completos que ya mando y se cierra al enviar las respuestas.
+ */
+class ServidorLocal
+{
+   private:
+    struct Solicitud {
+        std::uint8_t operacion;
+        std::string cuerpo;
+    };
+
+    struct Conexion {
+        /// Identifica la conexion en las respuestas del pool aunque el vector se reordene.
+        std::uint64_t numero;
+        int descriptor;
+        std::string entrada;
+        std::string salida;
+        std::deque<Solicitud> pendientes;
+        /// Hay una solicitud suya ejecutandose en el pool.
+        bool enCurso{false};
+        /// El cliente cerro su lado (o mando basura): no se lee mas y se cierra al responder.
+        bool finEntrada{false};
+        /// Cabecera invalida: despues de lo pendiente se responde el error y se cierra.
+        bool corrupta{false};
+    };
+
+    struct Respuesta {
+        std::uint64_t conexion;
+        bool usoRunner;
+        std::string mensaje;
+    };
+
+    AppRepositories& repositories;
+    fs::path rutaSocket;
+    std::ostringstream salidaComandos;
+    BatchRunner runner;
+    int descriptorEscucha{-1};
+    /// eventfd que el pool escribe al dejar una respuesta, para despertar a poll().
+    int avisoRespuestas{-1};
+    std::vector<Conexion> conexiones;
+    std::uint64_t proximaConexion{1};
+    /// Solo los toca el hilo de poll.
+    std::size_t solicitudesEnCurso{0};
+    bool runnerOcupado{false};
+    std::size_t turno{0};
+
+    std::mutex mutexRespuestas;
+    std::vector<Respuesta> respuestas;
+
+    bool abrirSocket(std::string& outError);
+    void cerrar();
+    void aceptarConexiones();
+    /// Lee lo disponible (hasta el limite de entrada salvo con `todo`) y separa los mensajes
+    /// completos; false si la conexion debe cerrarse.
+    bool leer(Conexion& conexion, bool todo);
+    /// Pasa de `entrada` a `pendientes` los mensajes completos que entran en la cola.
+    void extraerSolicitudes(Conexion& conexion);
+    /// Envia la salida pendiente sin bloquear; false si la conexion debe cerrarse.
+    bool escribir(Conexion& conexion);
+    bool puedeLeer(const Conexion& conexion) const;
+    /// Envia al pool la siguiente solicitud de cada conexion libre que pueda atenderse ya.
+    void despachar();
+    /// Lleva a cada conexion las respuestas que dejo el pool.
+    void recogerRespuestas();
+    /// Espera a que el pool termine las solicitudes en curso, descartando sus respuestas.
+    void esperarEnCurso();
+
+    /// Ejecuta una solicitud y retorna la respuesta ya empaquetada.
+    std::string atender(std::uint8_t operacion, const std::string& cuerpo);
+    std::string buscarProducto(const std::string& cuerpo);
+    std::string registrarVenta(const std::string& cuerpo);
+    std::string ejecutarComando(const std::string& cuerpo);
+    void sincronizarPendiente();
+
+   public:
+    ServidorLocal(AppRepositories& repositories, fs::path rutaSocket);
+    ~ServidorLocal();
+
+    ServidorLocal(const ServidorLocal&) = delete;
+    ServidorLocal& operator=(const ServidorLocal&) = delete;
+
+    /// Atiende conexiones hasta recibir SIGINT o SIGTERM; retorna el codigo de salida.
+    int ejecutar();
+};
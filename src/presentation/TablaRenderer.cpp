@@ -0,0 +1,146 @@
+#include "TablaRenderer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "domain/constants.hpp"
+
+using namespace Constants::ASCII_CODES;
+
+TablaRenderer::TablaRenderer(std::vector<Columna> columnas) : columnas(std::move(columnas)) {}
+
+std::size_t TablaRenderer::anchoVisible(const std::string& texto)
+{
+    // los bytes de continuacion UTF-8 (10xxxxxx) no ocupan una columna propia
+    return static_cast<std::size_t>(std::count_if(texto.begin(), texto.end(), [](char c) {
+        return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+    }));
+}
+
+void TablaRenderer::agregarCelda(std::string& buffer, const std::string& texto, std::size_t ancho,
+                                 Alineacion alineacion)
+{
+    const std::size_t visible = anchoVisible(texto);
+    if (visible > ancho) {
+        // se corta por caracteres completos y se marca el truncado con "~"
+        std::size_t caracteres = 0;
+        std::size_t bytes = 0;
+        while (bytes < texto.size()) {
+            const bool inicioCaracter = (static_cast<unsigned char>(texto[bytes]) & 0xC0) != 0x80;
+            if (inicioCaracter && ++caracteres == ancho) {
+                break;
+            }
+            ++bytes;
+        }
+        buffer.append(texto, 0, bytes);
+        buffer += '~';
+        return;
+    }
+
+    const std::size_t relleno = ancho - visible;
+    if (alineacion == DERECHA) {
+        buffer.append(relleno, ' ');
+    }
+    buffer += texto;
+    if (alineacion == IZQUIERDA) {
+        buffer.append(relleno, ' ');
+    }
+}
+
+void TablaRenderer::reservar(std::size_t filas) { celdas.reserve(filas * columnas.size()); }
+
+void TablaRenderer::agregarFila(std::vector<std::string> fila)
+{
+    fila.resize(columnas.size());
+    for (std::string& celda : fila) {
+        celdas.push_back(std::move(celda));
+    }
+}
+
+void TablaRenderer::agregarPie(std::string linea) { pie.push_back(std::move(linea)); }
+
+std::size_t TablaRenderer::cantidadFilas() const
+{
+    return columnas.empty() ? 0 : celdas.size() / columnas.size();
+}
+
+std::string TablaRenderer::renderizar(const std::string& titulo) const
+{
+    const std::size_t totalColumnas = columnas.size();
+    std::vector<std::size_t> anchos(totalColumnas);
+    for (std::size_t c = 0; c < totalColumnas; ++c) {
+        anchos[c] = anchoVisible(columnas[c].titulo);
+    }
+    for (std::size_t i = 0; i < celdas.size(); ++i) {
+        const std::size_t c = i % totalColumnas;
+        anchos[c] = std::max(anchos[c], anchoVisible(celdas[i]));
+    }
+    std::size_t anchoTotal = 0;
+    for (std::size_t c = 0; c < totalColumnas; ++c) {
+        if (columnas[c].anchoMaximo > 0) {
+            anchos[c] = std::min(anchos[c], columnas[c].anchoMaximo);
+        }
+        anchoTotal += anchos[c] + (c > 0 ? 3 : 0);
+    }
+
+    std::string buffer;
+    buffer.reserve((anchoTotal + 8) * (cantidadFilas() + 4) + titulo.size() + 64);
+
+    buffer += COLOR_CYAN;
+    buffer += titulo;
+    buffer += '\n';
+
+    buffer += COLOR_YELLOW;
+    for (std::size_t c = 0; c < totalColumnas; ++c) {
+        if (c > 0) {
+            buffer += " | ";
+        }
+        agregarCelda(buffer, columnas[c].titulo, anchos[c], columnas[c].alineacion);
+    }
+    buffer += '\n';
+    buffer.append(anchoTotal, '-');
+    buffer += '\n';
+
+    buffer += COLOR_GREEN;
+    for (std::size_t i = 0; i < celdas.size(); ++i) {
+        const std::size_t c = i % totalColumnas;
+        if (c > 0) {
+            buffer += " | ";
+        }
+        agregarCelda(buffer, celdas[i], anchos[c], columnas[c].alineacion);
+        if (c + 1 == totalColumnas) {
+            buffer += '\n';
+        }
+    }
+
+    if (!pie.empty()) {
+        buffer += COLOR_YELLOW;
+        for (const std::string& linea : pie) {
+            buffer += linea;
+            buffer += '\n';
+        }
+    }
+
+    buffer += COLOR_RESET;
+    return buffer;
+}
+
+void TablaRenderer::mostrar(const std::string& titulo, std::ostream& out) const
+{
+    const std::string contenido = renderizar(titulo);
+
+    const char* pager = std::getenv("PAPAYA_PAGER");
+    if (pager != nullptr && *pager != '\0' && &out == &std::cout && isatty(STDOUT_FILENO)) {
+        out.flush();
+        if (FILE* tuberia = popen(pager, "w")) {
+            std::fwrite(contenido.data(), 1, contenido.size(), tuberia);
+            pclose(tuberia);
+            return;
+        }
+    }
+
+    out.write(contenido.data(), static_cast<std::streamsize>(contenido.size()));
+    out.flush();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief - Tabla de texto que se formatea completa en memoria y se escribe de una vez.
+ *
+ * Las filas se acumulan como texto; al renderizar se calcula el ancho de cada columna segun su
+ * contenido y toda la tabla (titulo, encabezado, filas y pie) se arma en un solo buffer, que se
+ * escribe con una unica operacion en lugar de un flush por linea. Si la variable de entorno
+ * PAPAYA_PAGER tiene un comando (por ejemplo `less -R`), la salida a terminal pasa por ese pager.
+ */
+class TablaRenderer
+{
+   public:
+    enum Alineacion { IZQUIERDA, DERECHA };
+
+    /**
+     * @param anchoMaximo - 0 para no limitar; el contenido mas largo se trunca con "~".
+     */
+    struct Columna {
+        std::string titulo;
+        Alineacion alineacion{IZQUIERDA};
+        std::size_t anchoMaximo{0};
+    };
+
+   private:
+    std::vector<Columna> columnas;
+    std::vector<std::string> celdas;
+    std::vector<std::string> pie;
+
+    /// Ancho visible de un texto UTF-8 (cantidad de caracteres, no de bytes).
+    static std::size_t anchoVisible(const std::string& texto);
+    static void agregarCelda(std::string& buffer, const std::string& texto, std::size_t ancho,
+                             Alineacion alineacion);
+
+   public:
+    explicit TablaRenderer(std::vector<Columna> columnas);
+
+    void reservar(std::size_t filas);
+    /// Agrega una fila; debe tener una celda por columna (las faltantes quedan vacias).
+    void agregarFila(std::vector<std::string> fila);
+    /// Linea de texto libre que se muestra despues de la tabla (totales, avisos).
+    void agregarPie(std::string linea);
+
+    std::size_t cantidadFilas() const;
+
+    std::string renderizar(const std::string& titulo) const;
+
+    /// Renderiza y escribe con una sola operacion, o a traves de PAPAYA_PAGER si esta definido.
+    void mostrar(const std::string& titulo, std::ostream& out = std::cout) const;
+};